@@ -1,7 +1,7 @@
 #ifndef MY_ALGORITHM_PERFORMANCE_H
 #define MY_ALGORITHM_PERFORMANCE_H
 
-// 对 sort, binary_search 测试
+// 对 sort, binary_search, inplace_merge 测试
 
 // 标准
 #include <algorithm>
@@ -93,6 +93,55 @@ void sort_test() {
     FUN_TEST1(MySTL, sort, LEN3);
     std::cout << std::endl;
 }
+// 自底向上归并排序：每轮以 width 为步长两两 inplace_merge 相邻的有序段
+#define FUN_TEST3(mode, count, ...)                                                         \
+    do {                                                                                    \
+        srand((int)time(0));                                                                \
+        char    buf[10];                                                                    \
+        clock_t start, end;                                                                 \
+        int*    arr = new int[count];                                                       \
+        for (size_t i = 0; i < count; ++i) *(arr + i) = rand();                             \
+        start = clock();                                                                    \
+        for (size_t width = 1; width < count; width *= 2) {                                 \
+            for (size_t i = 0; i + width < count; i += 2 * width) {                         \
+                size_t hi = i + 2 * width < count ? i + 2 * width : count;                  \
+                mode::inplace_merge(arr + i, arr + i + width, arr + hi, ##__VA_ARGS__);     \
+            }                                                                               \
+        }                                                                                   \
+        end = clock();                                                                      \
+        int n = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", n);                                           \
+        std::string t = buf;                                                                \
+        t += "ms   |";                                                                      \
+        std::cout << std::setw(WIDE) << t;                                                  \
+        delete[] arr;                                                                       \
+    } while (0)
+
+void inplace_merge_test() {
+    std::cout << "[------------------- function : inplace_merge ------------------]" << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+    std::cout << "|         std         |";
+    FUN_TEST3(std, LEN1);
+    FUN_TEST3(std, LEN2);
+    FUN_TEST3(std, LEN3);
+    std::cout << std::endl
+              << "|        MySTL        |";
+    FUN_TEST3(MySTL, LEN1);
+    FUN_TEST3(MySTL, LEN2);
+    FUN_TEST3(MySTL, LEN3);
+    std::cout << std::endl
+              << "|  MySTL user buffer  |";
+    {
+        // 调用者持有的缓冲区，整个排序过程只申请一次
+        MySTL::vector<int> scratch(LEN3 / 2 + 1);
+        FUN_TEST3(MySTL, LEN1, scratch.data(), scratch.size());
+        FUN_TEST3(MySTL, LEN2, scratch.data(), scratch.size());
+        FUN_TEST3(MySTL, LEN3, scratch.data(), scratch.size());
+    }
+    std::cout << std::endl;
+}
+
 void algorithm_performance_test() {
 
 #if PERFORMANCE_TEST_ON
@@ -100,6 +149,7 @@ void algorithm_performance_test() {
     std::cout << "[--------------- Run algorithm performance test ----------------]" << std::endl;
     sort_test();
     binary_search_test();
+    inplace_merge_test();
     std::cout << "[--------------- End algorithm performance test ----------------]" << std::endl;
     std::cout << "[===============================================================]" << std::endl;
 #endif  // PERFORMANCE_TEST_ON
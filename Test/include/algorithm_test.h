@@ -962,6 +962,14 @@ TEST(inplace_merge) {
     MySTL::inplace_merge(arr4, arr4 + 3, arr4 + 8, std::less<int>());
     EXPECT_CON_EQ(arr1, arr2);
     EXPECT_CON_EQ(arr3, arr4);
+    // 调用者提供的缓冲区，长度足够与不足两种情况
+    int arr5[] = {1, 3, 5, 7, 9, 2, 4, 6, 8, 10};
+    int arr6[] = {1, 2, 3, 1, 2, 3, 4, 5};
+    int buf[3];
+    MySTL::inplace_merge(arr5, arr5 + 5, arr5 + 10, buf, 3);
+    MySTL::inplace_merge(arr6, arr6 + 3, arr6 + 8, buf, 3, std::less<int>());
+    EXPECT_CON_EQ(arr1, arr5);
+    EXPECT_CON_EQ(arr3, arr6);
 }
 
 TEST(partial_sort) {
@@ -0,0 +1,603 @@
+#ifndef MY_ALLOCATOR_TEST_H
+#define MY_ALLOCATOR_TEST_H
+// 测试 pool_allocator、arena_allocator、thread_cache_allocator、aligned_allocator、
+// 有状态分配器接口以及容器在不同分配器下的性能
+
+// 标准
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <mutex>
+#include <thread>
+
+#include "../../src/aligned_allocator.h"
+#include "../../src/arena_allocator.h"
+#include "../../src/basic_string.h"
+#include "../../src/deque.h"
+#include "../../src/list.h"
+#include "../../src/map.h"
+#include "../../src/mmap_allocator.h"
+#include "../../src/set.h"
+#include "../../src/pool_allocator.h"
+#include "../../src/thread_cache_allocator.h"
+#include "../../src/vector.h"
+
+#include "../test.h"
+
+namespace MySTL {
+
+namespace test {
+
+namespace allocator_test {
+
+// 有状态分配器：id 区分不同实例，live 记录该实例尚未归还的元素个数
+// 只传播移动赋值和 swap，复制赋值保留自己的分配器
+template <class T>
+class counting_allocator {
+public:
+    typedef T         value_type;
+    typedef size_t    size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::true_type  propagate_on_container_move_assignment;
+    typedef std::true_type  propagate_on_container_swap;
+
+    int     id;
+    size_t* live;
+
+    counting_allocator(int i, size_t* l) noexcept : id(i), live(l) {}
+
+    template <class U>
+    counting_allocator(const counting_allocator<U>& rhs) noexcept : id(rhs.id), live(rhs.live) {}
+
+    T* allocate(size_type n) {
+        *live += n;
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_type n) {
+        *live -= n;
+        ::operator delete(ptr);
+    }
+};
+
+template <class T, class U>
+bool operator==(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) noexcept {
+    return lhs.id == rhs.id;
+}
+
+template <class T, class U>
+bool operator!=(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) noexcept {
+    return lhs.id != rhs.id;
+}
+
+// 对容器 C 依次测试分配器拷贝、复制赋值、移动赋值与 swap，最后检查两个实例的内存全部归还
+#define ALLOC_STATEFUL_TEST(C)                                                \
+    do {                                                                      \
+        size_t live1 = 0, live2 = 0;                                          \
+        {                                                                     \
+            counting_allocator<int> a1(1, &live1), a2(2, &live2);             \
+            C c1(a1);                                                         \
+            C c2(a2);                                                         \
+            for (int i = 0; i < 40; ++i)                                      \
+                c1.insert(c1.end(), static_cast<C::value_type>('a' + i));     \
+            C c3(c1);                                                         \
+            std::cout << " " #C " :";                                         \
+            std::cout << " copy " << (c3.get_allocator() == a1);              \
+            c2 = c1;                                                          \
+            std::cout << ", copy assign " << (c2.get_allocator() == a2);      \
+            c2 = MySTL::move(c1);                                             \
+            std::cout << ", move assign " << (c2.get_allocator() == a1);      \
+            c2.swap(c3);                                                      \
+            std::cout << ", swap " << (c2.get_allocator() == a1);             \
+            std::cout << ", size " << c2.size();                              \
+        }                                                                     \
+        std::cout << ", leak " << (live1 != 0 || live2 != 0) << std::endl;    \
+    } while (0)
+
+// map 使用指定分配器 emplace count 个结点后全部 erase
+// 计时前先申请并释放一块大内存，否则上一轮释放的大量小块会在内存池第一次申请 slab 时
+// 触发 malloc 的合并，这部分开销与被测分配器无关
+#define ALLOC_MAP_DO_TEST(alloc, count)                                                     \
+    do {                                                                                    \
+        srand((int)time(0));                                                                \
+        clock_t start, end;                                                                 \
+        MySTL::map<int, int, MySTL::less<int>, alloc<MySTL::pair<const int, int>>> c;       \
+        char    buf[10];                                                                    \
+        ::operator delete(::operator new(1 << 16)); /* 让 malloc 先合并上一轮释放的小块 */  \
+        start = clock();                                                                    \
+        for (size_t i = 0; i < count; ++i)                                                  \
+            c.emplace(rand(), static_cast<int>(i));                                         \
+        while (!c.empty())                                                                  \
+            c.erase(c.begin());                                                             \
+        end = clock();                                                                      \
+        int n = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", n);                                           \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+// list 使用指定分配器 emplace_back count 个结点后全部 pop_front
+#define ALLOC_LIST_DO_TEST(alloc, count)                                                    \
+    do {                                                                                    \
+        clock_t start, end;                                                                 \
+        MySTL::list<int, alloc<int>> l;                                                     \
+        char    buf[10];                                                                    \
+        ::operator delete(::operator new(1 << 16));                                         \
+        start = clock();                                                                    \
+        for (size_t i = 0; i < count; ++i)                                                  \
+            l.emplace_back(static_cast<int>(i));                                            \
+        while (!l.empty())                                                                  \
+            l.pop_front();                                                                  \
+        end = clock();                                                                      \
+        int n = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", n);                                           \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+// 模拟一次请求：构造若干短生命周期的 vector / string / map，离开作用域时一并销毁
+template <template <class> class Alloc>
+void build_request_graph(const Alloc<int>& alloc) {
+    MySTL::vector<int, Alloc<int>>                                             v(alloc);
+    MySTL::basic_string<char, MySTL::char_traits<char>, Alloc<char>>           s(alloc);
+    MySTL::map<int, int, MySTL::less<int>, Alloc<MySTL::pair<const int, int>>> m(alloc);
+    for (int i = 0; i < 32; ++i) {
+        v.push_back(i);
+        s.push_back(static_cast<char>('a' + i % 26));
+        m.emplace(i, i);
+    }
+}
+
+#define ALLOC_GRAPH_HEAP()                                               \
+    build_request_graph<MySTL::allocator>(MySTL::allocator<int>())
+
+// 每个请求使用一块栈上缓冲区作为 arena 的第一块
+#define ALLOC_GRAPH_ARENA()                                              \
+    do {                                                                 \
+        char                    stack_buf[4096];                         \
+        MySTL::monotonic_buffer arena(stack_buf, sizeof(stack_buf));     \
+        build_request_graph<MySTL::arena_allocator>(                     \
+            MySTL::arena_allocator<int>(&arena));                        \
+    } while (0)
+
+// 构造并销毁 count 个请求的容器图
+#define ALLOC_GRAPH_DO_TEST(mode, count)                                                    \
+    do {                                                                                    \
+        clock_t start, end;                                                                 \
+        char    buf[10];                                                                    \
+        ::operator delete(::operator new(1 << 16));                                         \
+        start = clock();                                                                    \
+        for (size_t i = 0; i < count; ++i)                                                  \
+            ALLOC_GRAPH_##mode();                                                           \
+        end = clock();                                                                      \
+        int n = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", n);                                           \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+// 生产者线程每次构造 batch 个 list 结点并 splice 到共享链表，消费者线程取走后销毁
+// 结点在生产者线程分配、在消费者线程释放
+template <template <class> class Alloc>
+void list_handoff(size_t count, size_t batch) {
+    typedef MySTL::list<int, Alloc<int>> list_type;
+    list_type               shared;
+    std::mutex              mtx;
+    std::condition_variable cv;
+    bool                    done = false;
+
+    std::thread producer([&]() {
+        for (size_t made = 0; made < count;) {
+            list_type local;
+            for (size_t i = 0; i < batch && made < count; ++i, ++made)
+                local.emplace_back(static_cast<int>(made));
+            std::lock_guard<std::mutex> guard(mtx);
+            shared.splice(shared.end(), local);
+            cv.notify_one();
+        }
+        std::lock_guard<std::mutex> guard(mtx);
+        done = true;
+        cv.notify_one();
+    });
+    std::thread consumer([&]() {
+        for (;;) {
+            list_type local;
+            {
+                std::unique_lock<std::mutex> guard(mtx);
+                cv.wait(guard, [&]() { return done || !shared.empty(); });
+                if (shared.empty()) return;
+                local.splice(local.end(), shared);
+            }
+            local.clear();
+        }
+    });
+    producer.join();
+    consumer.join();
+}
+
+// 多线程下用墙上时间计时
+#define ALLOC_HANDOFF_DO_TEST(alloc, len)                                                 \
+    do {                                                                                  \
+        char buf[10];                                                                     \
+        ::operator delete(::operator new(1 << 16));                                       \
+        auto start = std::chrono::steady_clock::now();                                    \
+        list_handoff<alloc>(len, 256);                                                    \
+        auto end = std::chrono::steady_clock::now();                                      \
+        int  n = static_cast<int>(                                                        \
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());  \
+        std::snprintf(buf, sizeof(buf), "%d", n);                                         \
+        std::string t = buf;                                                              \
+        t += "ms    |";                                                                   \
+        std::cout << std::setw(WIDE) << t;                                                \
+    } while (0)
+
+// vector<float> 顺序扫描 8 遍，或按伪随机下标访问 count 次，计时不包括构造
+// 随机访问几乎每次都落在不同的页上，能体现大页对 TLB miss 的影响
+#define ALLOC_SCAN_PASS(v, count)                 \
+    for (int pass = 0; pass < 8; ++pass)          \
+        for (size_t i = 0; i < count; ++i)        \
+            sum += v[i]
+
+#define ALLOC_GATHER_PASS(v, count)               \
+    for (size_t i = 0, k = 1; i < count; ++i) {   \
+        k = k * 6364136223846793005ULL + 1;       \
+        sum += v[(k >> 33) % count];              \
+    }
+
+#define ALLOC_FLOAT_DO_TEST(mode, alloc_type, count)                                        \
+    do {                                                                                    \
+        clock_t         start, end;                                                         \
+        char            buf[10];                                                            \
+        volatile float  sink;                                                               \
+        float           sum = 0.0f;                                                         \
+        MySTL::vector<float, alloc_type> v(count, 1.0f);                                    \
+        start = clock();                                                                    \
+        ALLOC_##mode##_PASS(v, count);                                                      \
+        end = clock();                                                                      \
+        sink = sum;                                                                         \
+        (void)sink;                                                                         \
+        int n = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", n);                                           \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+#define ALLOC_FLOAT_TEST(mode, len1, len2, len3)                                    \
+    TEST_LEN(len1, len2, len3, WIDE);                                               \
+    std::cout << "|      allocator      |";                                         \
+    ALLOC_FLOAT_DO_TEST(mode, MySTL::allocator<float>, len1);                       \
+    ALLOC_FLOAT_DO_TEST(mode, MySTL::allocator<float>, len2);                       \
+    ALLOC_FLOAT_DO_TEST(mode, MySTL::allocator<float>, len3);                       \
+    std::cout << "\n|  aligned_allocator  |";                                       \
+    ALLOC_FLOAT_DO_TEST(mode, MySTL::aligned_allocator<float>, len1);               \
+    ALLOC_FLOAT_DO_TEST(mode, MySTL::aligned_allocator<float>, len2);               \
+    ALLOC_FLOAT_DO_TEST(mode, MySTL::aligned_allocator<float>, len3);
+
+// 峰值 RSS 通过 /proc/self/status 的 VmHWM 读取，每次测试前写 /proc/self/clear_refs 重置(Linux 4.0+)
+inline long read_status_kb(const char* key) {
+    std::ifstream in("/proc/self/status");
+    std::string   line;
+    const size_t  len = std::strlen(key);
+    while (std::getline(in, line)) {
+        if (line.compare(0, len, key) == 0)
+            return std::atol(line.c_str() + len);
+    }
+    return 0;
+}
+
+inline void reset_peak_rss() {
+    std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+// push_back 到 len 个元素，单元格中显示 墙上时间/相对测试前增加的峰值 RSS
+#define ALLOC_GROW_DO_TEST(alloc_type, len)                                               \
+    do {                                                                                  \
+        char buf[16];                                                                     \
+        reset_peak_rss();                                                                 \
+        const long base = read_status_kb("VmRSS:");                                       \
+        auto       start = std::chrono::steady_clock::now();                              \
+        {                                                                                 \
+            MySTL::vector<int, alloc_type> v;                                             \
+            for (size_t i = 0; i < static_cast<size_t>(len); ++i)                         \
+                v.push_back(static_cast<int>(i));                                         \
+        }                                                                                 \
+        auto end = std::chrono::steady_clock::now();                                      \
+        int  n = static_cast<int>(                                                        \
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());  \
+        int  mb = static_cast<int>((read_status_kb("VmHWM:") - base) / 1024);             \
+        std::snprintf(buf, sizeof(buf), "%dms/%dMB", n, mb);                              \
+        std::string t = buf;                                                              \
+        t += "|";                                                                         \
+        std::cout << std::setw(WIDE) << t;                                                \
+    } while (0)
+
+#define ALLOC_GROW_TEST(len1, len2, len3)                                           \
+    TEST_LEN(len1, len2, len3, WIDE);                                               \
+    std::cout << "|      allocator      |";                                         \
+    ALLOC_GROW_DO_TEST(MySTL::allocator<int>, len1);                                \
+    ALLOC_GROW_DO_TEST(MySTL::allocator<int>, len2);                                \
+    ALLOC_GROW_DO_TEST(MySTL::allocator<int>, len3);                                \
+    std::cout << "\n|   mmap_allocator    |";                                       \
+    ALLOC_GROW_DO_TEST(MySTL::mmap_allocator<int>, len1);                           \
+    ALLOC_GROW_DO_TEST(MySTL::mmap_allocator<int>, len2);                           \
+    ALLOC_GROW_DO_TEST(MySTL::mmap_allocator<int>, len3);
+
+// 第三列可以在编译时用 -DALLOC_GROW_LEN3=1000000000 改为 1e9 个元素
+#ifndef ALLOC_GROW_LEN3
+#if LARGER_TEST_DATA_ON
+#define ALLOC_GROW_LEN3 SCALE_LL(LEN3)
+#else
+#define ALLOC_GROW_LEN3 SCALE_M(LEN3)
+#endif
+#endif
+
+// 在一块连续内存上分批构造、析构共 len 个空容器，相当于结构体中大量从未使用的容器成员
+#define ALLOC_EMPTY_BATCH 4096
+#define ALLOC_EMPTY_DO_TEST(con, len)                                                               \
+    do {                                                                                            \
+        typedef con     con_type;                                                                   \
+        clock_t         start, end;                                                                 \
+        char            buf[10];                                                                    \
+        const size_t    n = static_cast<size_t>(len);                                               \
+        con_type*       p = static_cast<con_type*>(::operator new(sizeof(con_type) * ALLOC_EMPTY_BATCH)); \
+        start = clock();                                                                            \
+        for (size_t done = 0; done < n; done += ALLOC_EMPTY_BATCH) {                                \
+            const size_t m = n - done < ALLOC_EMPTY_BATCH ? n - done : ALLOC_EMPTY_BATCH;           \
+            for (size_t i = 0; i < m; ++i)                                                          \
+                ::new (static_cast<void*>(p + i)) con_type();                                       \
+            for (size_t i = 0; i < m; ++i)                                                          \
+                p[i].~con_type();                                                                   \
+        }                                                                                           \
+        end = clock();                                                                              \
+        ::operator delete(p);                                                                       \
+        int k = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000);         \
+        std::snprintf(buf, sizeof(buf), "%d", k);                                                   \
+        std::string t = buf;                                                                        \
+        t += "ms    |";                                                                             \
+        std::cout << std::setw(WIDE) << t;                                                          \
+    } while (0)
+
+#define ALLOC_EMPTY_TEST(name, con, len1, len2, len3) \
+    std::cout << name;                                \
+    ALLOC_EMPTY_DO_TEST(con, len1);                   \
+    ALLOC_EMPTY_DO_TEST(con, len2);                   \
+    ALLOC_EMPTY_DO_TEST(con, len3);                   \
+    std::cout << std::endl;
+
+#define ALLOC_CON_TEST(con, len1, len2, len3)                  \
+    TEST_LEN(len1, len2, len3, WIDE);                          \
+    std::cout << "|      allocator      |";                    \
+    ALLOC_##con##_DO_TEST(MySTL::allocator, len1);             \
+    ALLOC_##con##_DO_TEST(MySTL::allocator, len2);             \
+    ALLOC_##con##_DO_TEST(MySTL::allocator, len3);             \
+    std::cout << "\n|   pool_allocator    |";                  \
+    ALLOC_##con##_DO_TEST(MySTL::pool_allocator, len1);        \
+    ALLOC_##con##_DO_TEST(MySTL::pool_allocator, len2);        \
+    ALLOC_##con##_DO_TEST(MySTL::pool_allocator, len3);
+
+void allocator_test() {
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[--------------- Run container test : allocator ----------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    int* p1 = MySTL::pool_allocator<int>::allocate();
+    int* p2 = MySTL::pool_allocator<int>::allocate(4);
+    MySTL::pool_allocator<int>::deallocate(p1);
+    int* p3 = MySTL::pool_allocator<int>::allocate();
+    std::cout << std::boolalpha;
+    FUN_VALUE((p1 == p3));  // 同一 size class 的内存块被复用
+    std::cout << std::noboolalpha;
+    MySTL::pool_allocator<int>::deallocate(p2, 4);
+    MySTL::pool_allocator<int>::deallocate(p3);
+
+    MySTL::list<int, MySTL::pool_allocator<int>> l1{5, 3, 1, 4, 2};
+    MySTL::list<int, MySTL::pool_allocator<int>> l2(l1);
+    CON_FUN_AFTER(l1, l1.sort());
+    CON_FUN_AFTER(l1, l1.merge(l2));
+    CON_FUN_AFTER(l1, l1.unique());
+    MySTL::set<int, MySTL::less<int>, MySTL::pool_allocator<int>> s1{5, 3, 1, 4, 2, 3};
+    MySTL::multiset<int, MySTL::less<int>, MySTL::pool_allocator<int>> s2{5, 3, 1, 4, 2, 3};
+    CON_FUN_AFTER(s1, s1.erase(3));
+    CON_FUN_AFTER(s2, s2.erase(s2.begin()));
+    MySTL::map<int, int, MySTL::less<int>, MySTL::pool_allocator<MySTL::pair<const int, int>>> m1;
+    MySTL::multimap<int, int, MySTL::less<int>, MySTL::pool_allocator<MySTL::pair<const int, int>>> m2;
+    for (int i = 0; i < 5; ++i) {
+        m1.emplace(i, i);
+        m2.emplace(i % 2, i);
+    }
+    FUN_VALUE(m1.size());
+    FUN_VALUE(m2.count(1));
+    FUN_VALUE(MySTL::node_pool::heap_size());
+
+    // arena：栈上缓冲区够用时不申请堆内存，超出后按块增长，release 后回到初始状态
+    char                    arena_buf[256];
+    MySTL::monotonic_buffer arena(arena_buf, sizeof(arena_buf));
+    {
+        MySTL::arena_allocator<int>                     aa(&arena);
+        MySTL::vector<int, MySTL::arena_allocator<int>> av(aa);
+        av.reserve(16);
+        for (int i = 0; i < 16; ++i)
+            av.push_back(i);
+        FUN_VALUE(arena.heap_size());
+        for (int i = 0; i < 1000; ++i)
+            av.push_back(i);
+        FUN_VALUE(av.size());
+        std::cout << std::boolalpha;
+        FUN_VALUE((arena.heap_size() > 0));
+        std::cout << std::noboolalpha;
+    }
+    arena.release();
+    FUN_VALUE(arena.heap_size());
+
+    // thread_cache：本线程释放的块留在本线程缓存中，其他线程释放的块进入其他线程的缓存
+    int* t1 = MySTL::thread_cache_allocator<int>::allocate();
+    MySTL::thread_cache_allocator<int>::deallocate(t1);
+    int* t2 = MySTL::thread_cache_allocator<int>::allocate();
+    std::cout << std::boolalpha;
+    FUN_VALUE((t1 == t2));
+    std::cout << std::noboolalpha;
+    std::thread remote([t2]() { MySTL::thread_cache_allocator<int>::deallocate(t2); });
+    remote.join();
+    MySTL::list<int, MySTL::thread_cache_allocator<int>> tl{1, 2, 3};
+    std::thread([&tl]() { tl.clear(); }).join();
+    CON_FUN_AFTER(tl, tl.push_back(4));
+
+    // aligned：缓冲区按 cache line 对齐，超过阈值的缓冲区按大页对齐
+    MySTL::vector<float, MySTL::aligned_allocator<float>> fv(100, 1.0f);
+    MySTL::vector<float, MySTL::aligned_allocator<float>> hv(1 << 20, 1.0f);
+    MySTL::deque<double, MySTL::aligned_allocator<double>> fd(1000, 1.0);
+    std::cout << std::boolalpha;
+    FUN_VALUE((reinterpret_cast<uintptr_t>(fv.data()) % MySTL::CACHELINE_ALIGN == 0));
+    FUN_VALUE((reinterpret_cast<uintptr_t>(hv.data()) % MySTL::HUGEPAGE_BYTES == 0));
+    FUN_VALUE((reinterpret_cast<uintptr_t>(&fd[0]) % MySTL::CACHELINE_ALIGN == 0));
+    std::cout << std::noboolalpha;
+
+    // mmap：超过阈值后通过 reallocate 扩容，跨越阈值和收缩时元素保持不变
+    MySTL::vector<int, MySTL::mmap_allocator<int, 4096>> mv;
+    for (int i = 0; i < 10000; ++i)
+        mv.push_back(i);
+    mv.insert(mv.end(), 5000, 7);
+    mv.resize(1000);
+    mv.shrink_to_fit();
+    std::cout << std::boolalpha;
+    FUN_VALUE(MySTL::allocator_traits<MySTL::mmap_allocator<int>>::has_reallocate::value);
+    FUN_VALUE(MySTL::allocator_traits<MySTL::allocator<int>>::has_reallocate::value);
+    FUN_VALUE((mv.size() == 1000 && mv.capacity() == 1000 && mv[999] == 999));
+    std::cout << std::noboolalpha;
+
+    std::cout << std::boolalpha;
+    typedef MySTL::vector<int, counting_allocator<int>>                                 cvector;
+    typedef MySTL::deque<int, counting_allocator<int>>                                  cdeque;
+    typedef MySTL::list<int, counting_allocator<int>>                                   clist;
+    typedef MySTL::set<int, MySTL::less<int>, counting_allocator<int>>                  cset;
+    typedef MySTL::basic_string<char, MySTL::char_traits<char>, counting_allocator<char>> cstring;
+    ALLOC_STATEFUL_TEST(cvector);
+    ALLOC_STATEFUL_TEST(cdeque);
+    ALLOC_STATEFUL_TEST(clist);
+    ALLOC_STATEFUL_TEST(cset);
+    ALLOC_STATEFUL_TEST(cstring);
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| map emplace / erase |";
+#if LARGER_TEST_DATA_ON
+    ALLOC_CON_TEST(MAP, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    ALLOC_CON_TEST(MAP, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|  list push / pop    |";
+#if LARGER_TEST_DATA_ON
+    ALLOC_CON_TEST(LIST, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+    ALLOC_CON_TEST(LIST, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| vector<float> scan  |";
+#if LARGER_TEST_DATA_ON
+    ALLOC_FLOAT_TEST(SCAN, SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+    ALLOC_FLOAT_TEST(SCAN, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|vector<float> gather |";
+#if LARGER_TEST_DATA_ON
+    ALLOC_FLOAT_TEST(GATHER, SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+    ALLOC_FLOAT_TEST(GATHER, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|   empty construct   |";
+    TEST_LEN(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3), WIDE);
+    ALLOC_EMPTY_TEST("|     std::vector     |", std::vector<int>, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    ALLOC_EMPTY_TEST("|    MySTL::vector    |", MySTL::vector<int>, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    ALLOC_EMPTY_TEST("|     std::string     |", std::string, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    ALLOC_EMPTY_TEST("|    MySTL::string    |", MySTL::string, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    ALLOC_EMPTY_TEST("|     std::deque      |", std::deque<int>, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    ALLOC_EMPTY_TEST("|    MySTL::deque     |", MySTL::deque<int>, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    ALLOC_EMPTY_TEST("|      std::list      |", std::list<int>, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    ALLOC_EMPTY_TEST("|     MySTL::list     |", MySTL::list<int>, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|  vector grow (RSS)  |";
+#if LARGER_TEST_DATA_ON
+    ALLOC_GROW_TEST(SCALE_LL(LEN1), SCALE_LL(LEN2), ALLOC_GROW_LEN3);
+#else
+    ALLOC_GROW_TEST(SCALE_M(LEN1), SCALE_M(LEN2), ALLOC_GROW_LEN3);
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| list thread handoff |";
+#if LARGER_TEST_DATA_ON
+    TEST_LEN(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3), WIDE);
+    std::cout << "|      allocator      |";
+    ALLOC_HANDOFF_DO_TEST(MySTL::allocator, SCALE_L(LEN1));
+    ALLOC_HANDOFF_DO_TEST(MySTL::allocator, SCALE_L(LEN2));
+    ALLOC_HANDOFF_DO_TEST(MySTL::allocator, SCALE_L(LEN3));
+    std::cout << "\n| thread_cache_alloc  |";
+    ALLOC_HANDOFF_DO_TEST(MySTL::thread_cache_allocator, SCALE_L(LEN1));
+    ALLOC_HANDOFF_DO_TEST(MySTL::thread_cache_allocator, SCALE_L(LEN2));
+    ALLOC_HANDOFF_DO_TEST(MySTL::thread_cache_allocator, SCALE_L(LEN3));
+#else
+    TEST_LEN(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3), WIDE);
+    std::cout << "|      allocator      |";
+    ALLOC_HANDOFF_DO_TEST(MySTL::allocator, SCALE_M(LEN1));
+    ALLOC_HANDOFF_DO_TEST(MySTL::allocator, SCALE_M(LEN2));
+    ALLOC_HANDOFF_DO_TEST(MySTL::allocator, SCALE_M(LEN3));
+    std::cout << "\n| thread_cache_alloc  |";
+    ALLOC_HANDOFF_DO_TEST(MySTL::thread_cache_allocator, SCALE_M(LEN1));
+    ALLOC_HANDOFF_DO_TEST(MySTL::thread_cache_allocator, SCALE_M(LEN2));
+    ALLOC_HANDOFF_DO_TEST(MySTL::thread_cache_allocator, SCALE_M(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|    request graph    |";
+#if LARGER_TEST_DATA_ON
+    TEST_LEN(SCALE_SS(LEN1), SCALE_SS(LEN2), SCALE_SS(LEN3), WIDE);
+    std::cout << "|      allocator      |";
+    ALLOC_GRAPH_DO_TEST(HEAP, SCALE_SS(LEN1));
+    ALLOC_GRAPH_DO_TEST(HEAP, SCALE_SS(LEN2));
+    ALLOC_GRAPH_DO_TEST(HEAP, SCALE_SS(LEN3));
+    std::cout << "\n|   arena_allocator   |";
+    ALLOC_GRAPH_DO_TEST(ARENA, SCALE_SS(LEN1));
+    ALLOC_GRAPH_DO_TEST(ARENA, SCALE_SS(LEN2));
+    ALLOC_GRAPH_DO_TEST(ARENA, SCALE_SS(LEN3));
+#else
+    TEST_LEN(SCALE_SSS(LEN1), SCALE_SSS(LEN2), SCALE_SSS(LEN3), WIDE);
+    std::cout << "|      allocator      |";
+    ALLOC_GRAPH_DO_TEST(HEAP, SCALE_SSS(LEN1));
+    ALLOC_GRAPH_DO_TEST(HEAP, SCALE_SSS(LEN2));
+    ALLOC_GRAPH_DO_TEST(HEAP, SCALE_SSS(LEN3));
+    std::cout << "\n|   arena_allocator   |";
+    ALLOC_GRAPH_DO_TEST(ARENA, SCALE_SSS(LEN1));
+    ALLOC_GRAPH_DO_TEST(ARENA, SCALE_SSS(LEN2));
+    ALLOC_GRAPH_DO_TEST(ARENA, SCALE_SSS(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[--------------- End container test : allocator ----------------]" << std::endl;
+}
+
+} // allocator_test
+
+} // MySTL::test
+
+} // MySTL
+
+#endif /* MY_ALLOCATOR_TEST_H */
\ No newline at end of file
@@ -1,15 +1,23 @@
 #ifndef MY_DEQUE_TEST_H
 #define MY_DEQUE_TEST_H
-// 测试 deque 接口和 push_front/push_back性能
+// 测试 deque 接口和 push_front/push_back性能，队列在缓冲区边界附近往复时的分配次数，不同缓冲区大小的影响，
+// 以及 copy/accumulate 逐缓冲区处理的效果
 
 // 标准
 #include <deque> 
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <iostream>
 #include <numeric>
+#include <sstream>
 #include <functional>
 
 #include "../../src/deque.h"
+#include "../../src/list.h"
+#include "../../src/numeric.h"
+#include "../../src/queue.h"
+#include "../../src/stack.h"
 
 #include "../test.h"
 
@@ -19,6 +27,163 @@ namespace test {
 
 namespace deque_test {
 
+// 只统计 allocate 次数的分配器，用于观察容器向分配器申请内存的频率
+template <class T>
+struct churn_allocator {
+    typedef T value_type;
+
+    static size_t& allocs() {
+        static size_t n = 0;
+        return n;
+    }
+
+    churn_allocator() noexcept = default;
+    template <class U>
+    churn_allocator(const churn_allocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        ++allocs();
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t) noexcept { ::operator delete(p); }
+};
+
+template <class T, class U>
+bool operator==(const churn_allocator<T>&, const churn_allocator<U>&) noexcept { return true; }
+
+template <class T, class U>
+bool operator!=(const churn_allocator<T>&, const churn_allocator<U>&) noexcept { return false; }
+
+// 先放入 4096 个元素，之后每轮尾部放入、头部取出 3000 个，共 len 个元素经过队列
+// 单元格中显示 耗时/稳态下 allocate 的次数
+#define CHURN_DO_TEST(con, len)                                                              \
+    do {                                                                                     \
+        char   buf[24];                                                                      \
+        con    q;                                                                            \
+        for (int i = 0; i < 4096; ++i)                                                       \
+            q.push_back(i);                                                                  \
+        size_t before = churn_allocator<int>::allocs();                                      \
+        auto   start = std::chrono::steady_clock::now();                                     \
+        for (size_t done = 0; done < static_cast<size_t>(len); done += 3000) {               \
+            for (int i = 0; i < 3000; ++i)                                                   \
+                q.push_back(i);                                                              \
+            for (int i = 0; i < 3000; ++i)                                                   \
+                q.pop_front();                                                               \
+        }                                                                                    \
+        auto end = std::chrono::steady_clock::now();                                         \
+        int  n = static_cast<int>(                                                           \
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());     \
+        std::snprintf(buf, sizeof(buf), "%dms/%d", n,                                        \
+                      static_cast<int>(churn_allocator<int>::allocs() - before));            \
+        std::string t = buf;                                                                 \
+        t += "|";                                                                            \
+        std::cout << std::setw(WIDE) << t;                                                   \
+    } while (0)
+
+#define CHURN_TEST(name, con, len1, len2, len3) \
+    std::cout << name;                          \
+    CHURN_DO_TEST(con, len1);                   \
+    CHURN_DO_TEST(con, len2);                   \
+    CHURN_DO_TEST(con, len3);                   \
+    std::cout << std::endl;
+
+// 先 push_back 出 len 个元素，mode 为 0 时计 push_back 的耗时，为 1 时计顺序遍历求和的耗时，为 2 时计 len 次随机下标访问的耗时
+#define BLOCK_DO_TEST(con, len, mode)                                                        \
+    do {                                                                                     \
+        const size_t n = static_cast<size_t>(len);                                           \
+        auto         t0 = std::chrono::steady_clock::now();                                  \
+        con          c;                                                                      \
+        for (size_t i = 0; i < n; ++i)                                                       \
+            c.push_back(static_cast<int>(i));                                                \
+        auto      t1 = std::chrono::steady_clock::now();                                     \
+        long long sum = 0;                                                                   \
+        if ((mode) == 1) {                                                                   \
+            for (auto it = c.begin(); it != c.end(); ++it)                                   \
+                sum += *it;                                                                  \
+        } else if ((mode) == 2) {                                                            \
+            size_t k = 1;                                                                    \
+            for (size_t i = 0; i < n; ++i) {                                                 \
+                k = (k * 1103515245 + 12345) % n;                                            \
+                sum += c[k];                                                                 \
+            }                                                                                \
+        }                                                                                    \
+        auto               t2 = std::chrono::steady_clock::now();                            \
+        volatile long long sink = sum;                                                       \
+        (void)sink;                                                                          \
+        int ms = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(     \
+                                      (mode) == 0 ? t1 - t0 : t2 - t1).count());             \
+        std::string t = std::to_string(ms);                                                  \
+        t += "ms|";                                                                          \
+        std::cout << std::setw(WIDE) << t;                                                   \
+    } while (0)
+
+#define BLOCK_TEST(name, con, mode, len1, len2, len3) \
+    std::cout << name;                                \
+    BLOCK_DO_TEST(con, len1, mode);                   \
+    BLOCK_DO_TEST(con, len2, mode);                   \
+    BLOCK_DO_TEST(con, len3, mode);                   \
+    std::cout << std::endl;
+
+// 对 len 个元素的 deque 做 copy 和 accumulate，单元格中显示 copy 耗时/accumulate 耗时
+// ns 为 std 或 MySTL；loop 为 true 时用迭代器逐个元素处理，即不区分分段迭代器时的做法
+#define SEG_ALGO_DO_TEST(con, ns, loop, len)                                                        \
+    do {                                                                                            \
+        char         buf[24];                                                                       \
+        const size_t n = static_cast<size_t>(len);                                                  \
+        con          src(n), dst(n);                                                                \
+        for (size_t i = 0; i < n; ++i)                                                              \
+            src[i] = static_cast<int>(i & 1023);                                                    \
+        auto t0 = std::chrono::steady_clock::now();                                                 \
+        if (loop) {                                                                                 \
+            auto out = dst.begin();                                                                 \
+            for (auto it = src.begin(); it != src.end(); ++it, ++out)                               \
+                *out = *it;                                                                         \
+        } else {                                                                                    \
+            ns::copy(src.begin(), src.end(), dst.begin());                                          \
+        }                                                                                           \
+        auto      t1 = std::chrono::steady_clock::now();                                            \
+        long long sum = 0;                                                                          \
+        if (loop) {                                                                                 \
+            for (auto it = dst.begin(); it != dst.end(); ++it)                                      \
+                sum += *it;                                                                         \
+        } else {                                                                                    \
+            sum = ns::accumulate(dst.begin(), dst.end(), 0LL);                                      \
+        }                                                                                           \
+        auto               t2 = std::chrono::steady_clock::now();                                   \
+        volatile long long sink = sum;                                                              \
+        (void)sink;                                                                                 \
+        int n1 = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count()); \
+        int n2 = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count()); \
+        std::snprintf(buf, sizeof(buf), "%dms/%dms", n1, n2);                                       \
+        std::string t = buf;                                                                        \
+        t += "|";                                                                                   \
+        std::cout << std::setw(WIDE) << t;                                                          \
+    } while (0)
+
+#define SEG_ALGO_TEST(name, con, ns, loop, len1, len2, len3) \
+    std::cout << name;                                        \
+    SEG_ALGO_DO_TEST(con, ns, loop, len1);                    \
+    SEG_ALGO_DO_TEST(con, ns, loop, len2);                    \
+    SEG_ALGO_DO_TEST(con, ns, loop, len3);                    \
+    std::cout << std::endl;
+
+// 宏参数中不能出现逗号
+typedef MySTL::deque<int, MySTL::allocator<int>, 16>   deque_block16;
+typedef MySTL::deque<int, MySTL::allocator<int>, 64>   deque_block64;
+typedef MySTL::deque<int, MySTL::allocator<int>, 256>  deque_block256;
+typedef MySTL::deque<int>                              deque_block_default;
+typedef MySTL::deque<int, MySTL::allocator<int>, 4096> deque_block4096;
+
+#define BLOCK_SWEEP(title, mode)                                                                                   \
+    std::cout << title;                                                                                            \
+    TEST_LEN(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3), WIDE);                                                   \
+    BLOCK_TEST("|  16 elems / block   |", deque_block16, mode, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));        \
+    BLOCK_TEST("|  64 elems / block   |", deque_block64, mode, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));        \
+    BLOCK_TEST("|  256 elems / block  |", deque_block256, mode, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));       \
+    BLOCK_TEST("| 1024 (default)      |", deque_block_default, mode, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));  \
+    BLOCK_TEST("|  4096 elems / block |", deque_block4096, mode, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));      \
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+
 void deque_test() {
     std::cout << "[===============================================================]" << std::endl;
     std::cout << "[----------------- Run container test : deque ------------------]" << std::endl;
@@ -60,6 +225,8 @@ void deque_test() {
     CON_FUN_AFTER(d1, d1.clear());
     CON_FUN_AFTER(d1, d1.shrink_to_fit());
     CON_FUN_AFTER(d1, d1.swap(d4));
+    CON_FUN_AFTER(d1, MySTL::copy(d9.begin() + 1, d9.begin() + 4, d1.begin()));
+    CON_FUN_AFTER(d1, MySTL::fill(d1.end() - 2, d1.end(), 0));
 
     FUN_VALUE(*(d1.begin()));    // check
     FUN_VALUE(*(d1.end() - 1));  // check
@@ -74,6 +241,68 @@ void deque_test() {
     std::cout << std::noboolalpha;
     FUN_VALUE(d1.size());
     FUN_VALUE(d1.max_size());
+
+    // 整个区间的追加、插入、赋值，输入流迭代器只能单趟读取，list 的迭代器不能比较大小
+    int                ra[] = {1, 2, 3};
+    MySTL::list<int>   rl{4, 5, 6};
+    MySTL::deque<int>  dr;
+    std::istringstream din("7 8 9");
+    CON_FUN_AFTER(dr, dr.append_range(ra));
+    CON_FUN_AFTER(dr, dr.insert_range(dr.begin() + 1, ra));
+    CON_FUN_AFTER(dr, dr.append_range(rl));
+    CON_FUN_AFTER(dr, dr.insert_range(dr.begin() + 3, rl));
+    CON_FUN_AFTER(dr, dr.insert(dr.begin() + 2, MySTL::istream_iterator<int>(din), MySTL::istream_iterator<int>()));
+    CON_FUN_AFTER(dr, dr.assign_range(d1));
+
+    // 跨越缓冲区边界往复，以及两端交替增长时 map 的重新居中
+    MySTL::deque<int> dc;
+    for (int i = 0; i < 1000; ++i)
+        dc.push_back(i);
+    for (int r = 0; r < 50; ++r) {
+        for (int i = 0; i < 300; ++i)
+            dc.pop_front();
+        for (int i = 0; i < 300; ++i)
+            dc.push_back(i);
+    }
+    for (int i = 0; i < 2000; ++i)
+        dc.push_front(-i);
+    FUN_VALUE(dc.size());
+    FUN_VALUE(dc.front());
+    FUN_VALUE(dc[2000]);
+    FUN_VALUE(dc.back());
+
+    // 指定缓冲区大小，包括放不下一个指针的缓冲区，以及作为 queue、stack 的底层容器
+    MySTL::deque<int, MySTL::allocator<int>, 3>  db1(a, a + 5);
+    MySTL::deque<char, MySTL::allocator<char>, 1> db2;
+    for (int i = 0; i < 26; ++i)
+        db2.push_front(static_cast<char>('z' - i));
+    db2.erase(db2.begin() + 5, db2.end() - 5);
+    db1.insert(db1.begin() + 2, 10, 0);
+    MySTL::queue<int, MySTL::deque<int, MySTL::allocator<int>, 8>> dq1;
+    MySTL::stack<int, MySTL::deque<int, MySTL::allocator<int>, 8>> ds1;
+    for (int i = 0; i < 100; ++i) {
+        dq1.push(i);
+        ds1.push(i);
+    }
+    FUN_VALUE((MySTL::deque<int, MySTL::allocator<int>, 3>::buffer_size));
+    FUN_VALUE((MySTL::deque<std::string>::buffer_size));
+    CON_COUT(db1);
+    CON_COUT(db2);
+    FUN_VALUE(dq1.front());
+    FUN_VALUE(ds1.top());
+
+    // 跨越多个缓冲区的算法逐缓冲区处理，结果与逐个元素处理相同
+    MySTL::deque<int, MySTL::allocator<int>, 4> ds2(a, a + 5), ds3;
+    for (int i = 0; i < 20; ++i)
+        ds3.push_front(i);
+    MySTL::copy_backward(ds2.begin(), ds2.end(), ds3.end() - 3);
+    MySTL::fill_n(ds3.begin() + 1, 6, -1);
+    CON_COUT(ds3);
+    FUN_VALUE(*MySTL::find(ds3.begin(), ds3.end(), 3));
+    std::cout << std::boolalpha;
+    FUN_VALUE((MySTL::find(ds3.begin(), ds3.end(), 100) == ds3.end()));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(MySTL::accumulate(ds3.begin() + 3, ds3.end(), 0));
     PASSED;
 
 #if PERFORMANCE_TEST_ON
@@ -95,6 +324,35 @@ void deque_test() {
 #endif
     std::cout << std::endl;
     std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    typedef std::deque<int, churn_allocator<int>>   std_churn_deque;
+    typedef MySTL::deque<int, churn_allocator<int>> my_churn_deque;
+    std::cout << "|   queue churn       |";
+#if LARGER_TEST_DATA_ON
+    TEST_LEN(SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3), WIDE);
+    CHURN_TEST("|     std::deque      |", std_churn_deque, SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+    CHURN_TEST("|    MySTL::deque     |", my_churn_deque, SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+    TEST_LEN(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3), WIDE);
+    CHURN_TEST("|     std::deque      |", std_churn_deque, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+    CHURN_TEST("|    MySTL::deque     |", my_churn_deque, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| copy/accumulate     |";
+#if LARGER_TEST_DATA_ON
+    TEST_LEN(SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3), WIDE);
+    SEG_ALGO_TEST("|     std::deque      |", std::deque<int>, std, false, SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+    SEG_ALGO_TEST("|  per-element loop   |", MySTL::deque<int>, MySTL, true, SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+    SEG_ALGO_TEST("|    MySTL::deque     |", MySTL::deque<int>, MySTL, false, SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+    TEST_LEN(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3), WIDE);
+    SEG_ALGO_TEST("|     std::deque      |", std::deque<int>, std, false, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    SEG_ALGO_TEST("|  per-element loop   |", MySTL::deque<int>, MySTL, true, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    SEG_ALGO_TEST("|    MySTL::deque     |", MySTL::deque<int>, MySTL, false, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    BLOCK_SWEEP("|  push_back by block |", 0);
+    BLOCK_SWEEP("|  iterate by block   |", 1);
+    BLOCK_SWEEP("| random [] by block  |", 2);
     PASSED;
 #endif
     std::cout << "[----------------- End container test : deque ------------------]" << std::endl;
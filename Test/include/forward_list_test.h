@@ -0,0 +1,224 @@
+#ifndef MY_FORWARD_LIST_TEST_H
+#define MY_FORWARD_LIST_TEST_H
+// 测试 forward_list 接口，以及与 list 的内存占用和遍历速度比较
+
+// 标准
+#include <forward_list>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "../../src/algo.h"
+#include "../../src/forward_list.h"
+#include "../../src/list.h"
+
+#include "../test.h"
+
+namespace MySTL {
+
+namespace test {
+
+namespace forward_list_test {
+
+// 当前仍被占用的字节数，所有 rebind 出来的 bytes_allocator 共用
+inline size_t& allocated_bytes() {
+    static size_t n = 0;
+    return n;
+}
+
+// 统计容器向分配器申请的字节数
+template <class T>
+struct bytes_allocator {
+    typedef T value_type;
+
+    bytes_allocator() noexcept = default;
+    template <class U>
+    bytes_allocator(const bytes_allocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        allocated_bytes() += n * sizeof(T);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t n) noexcept {
+        allocated_bytes() -= n * sizeof(T);
+        ::operator delete(p);
+    }
+};
+
+template <class T, class U>
+bool operator==(const bytes_allocator<T>&, const bytes_allocator<U>&) noexcept { return true; }
+
+template <class T, class U>
+bool operator!=(const bytes_allocator<T>&, const bytes_allocator<U>&) noexcept { return false; }
+
+bool is_odd(int x) { return x & 1; }
+
+// 前向迭代器向后移动 n 步
+template <class Iter>
+Iter step(Iter it, int n) {
+    MySTL::advance(it, n);
+    return it;
+}
+
+// 放入 len 个 int 后顺序遍历求和 10 次，单元格中显示 遍历耗时/容器申请的内存(MB)
+#define FLIST_MEM_DO_TEST(con, len)                                                          \
+    do {                                                                                     \
+        char buf[24];                                                                        \
+        settle_heap();                                                                       \
+        size_t before = allocated_bytes();                                       \
+        con    c;                                                                            \
+        for (size_t i = 0; i < static_cast<size_t>(len); ++i)                                \
+            c.push_front(static_cast<int>(i));                                               \
+        double    mb = (allocated_bytes() - before) / (1024.0 * 1024.0);                    \
+        long long sum = 0;                                                                   \
+        auto      start = std::chrono::steady_clock::now();                                  \
+        for (int pass = 0; pass < 10; ++pass) {                                              \
+            for (auto it = c.begin(); it != c.end(); ++it)                                   \
+                sum += *it;                                                                  \
+        }                                                                                    \
+        auto end = std::chrono::steady_clock::now();                                         \
+        volatile long long sink = sum;                                                       \
+        (void)sink;                                                                          \
+        int  n = static_cast<int>(                                                           \
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());     \
+        std::snprintf(buf, sizeof(buf), "%dms/%.1fM", n, mb);                                \
+        std::string t = buf;                                                                 \
+        t += "|";                                                                            \
+        std::cout << std::setw(WIDE) << t;                                                   \
+    } while (0)
+
+#define FLIST_MEM_TEST(name, con, len1, len2, len3) \
+    std::cout << name;                              \
+    FLIST_MEM_DO_TEST(con, len1);                   \
+    FLIST_MEM_DO_TEST(con, len2);                   \
+    FLIST_MEM_DO_TEST(con, len3);                   \
+    std::cout << std::endl;
+
+typedef std::forward_list<int, bytes_allocator<int>>   std_flist_bytes;
+typedef MySTL::list<int, bytes_allocator<int>>         list_bytes;
+typedef MySTL::forward_list<int, bytes_allocator<int>> flist_bytes;
+
+void forward_list_test() {
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[-------------- Run container test : forward_list --------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    int                      a[] = {1, 2, 3, 4, 5};
+    MySTL::forward_list<int> l1;
+    MySTL::forward_list<int> l2(5);
+    MySTL::forward_list<int> l3(5, 1);
+    MySTL::forward_list<int> l4(a, a + 5);
+    MySTL::forward_list<int> l5(l2);
+    MySTL::forward_list<int> l6(std::move(l2));
+    MySTL::forward_list<int> l7{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    MySTL::forward_list<int> l8;
+    l8 = l3;
+    MySTL::forward_list<int> l9;
+    l9 = std::move(l3);
+    MySTL::forward_list<int> l10;
+    l10 = {1, 2, 2, 3, 5, 6, 7, 8, 9};
+
+    CON_FUN_AFTER(l1, l1.assign(8, 8));
+    CON_FUN_AFTER(l1, l1.assign(a, a + 5));
+    CON_FUN_AFTER(l1, l1.assign({1, 2, 3, 4, 5, 6}));
+    CON_FUN_AFTER(l1, l1.insert_after(l1.before_begin(), 0));
+    CON_FUN_AFTER(l1, l1.insert_after(l1.begin(), 2, 7));
+    CON_FUN_AFTER(l1, l1.insert_after(l1.before_begin(), a, a + 5));
+    CON_FUN_AFTER(l1, l1.insert_after(l1.begin(), {10, 11}));
+    CON_FUN_AFTER(l1, l1.push_front(1));
+    CON_FUN_AFTER(l1, l1.emplace_after(l1.begin(), 1));
+    CON_FUN_AFTER(l1, l1.emplace_front(0));
+    CON_FUN_AFTER(l1, l1.pop_front());
+    CON_FUN_AFTER(l1, l1.erase_after(l1.begin()));
+    CON_FUN_AFTER(l1, l1.erase_after(l1.begin(), step(l1.begin(), 4)));
+    CON_FUN_AFTER(l1, l1.erase_after(l1.before_begin(), l1.end()));
+    std::cout << std::boolalpha;
+    FUN_VALUE(l1.empty());
+    std::cout << std::noboolalpha;
+    CON_FUN_AFTER(l1, l1.resize(10));
+    CON_FUN_AFTER(l1, l1.resize(5, 1));
+    CON_FUN_AFTER(l1, l1.resize(8, 2));
+    CON_FUN_AFTER(l1, l1.splice_after(l1.before_begin(), l4));
+    CON_FUN_AFTER(l1, l1.splice_after(l1.begin(), l5, l5.before_begin()));
+    CON_FUN_AFTER(l1, l1.splice_after(l1.before_begin(), l7, l7.begin(), step(l7.begin(), 3)));
+    CON_COUT(l7);
+    CON_FUN_AFTER(l1, l1.remove(0));
+    CON_FUN_AFTER(l1, l1.remove_if(is_odd));
+    CON_FUN_AFTER(l1, l1.assign({9, 5, 3, 3, 7, 1, 3, 2, 2, 0, 10}));
+    CON_FUN_AFTER(l1, l1.sort());
+    CON_FUN_AFTER(l1, l1.unique());
+    CON_FUN_AFTER(l1, l1.unique([&](int a, int b) { return b == a + 1; }));
+    CON_FUN_AFTER(l1, l1.merge(l7));
+    CON_FUN_AFTER(l1, l1.sort(MySTL::greater<int>()));
+    CON_FUN_AFTER(l1, l1.merge(l8, MySTL::greater<int>()));
+    CON_FUN_AFTER(l1, l1.reverse());
+    CON_FUN_AFTER(l1, l1.remove(l1.front()));
+    CON_FUN_AFTER(l1, l1.clear());
+    CON_FUN_AFTER(l1, l1.swap(l9));
+    FUN_VALUE(*l1.begin());
+    FUN_VALUE(l1.front());
+    std::cout << std::boolalpha;
+    FUN_VALUE(l1.empty());
+    FUN_VALUE((l1 == l10));
+    FUN_VALUE((l1 < l10));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(l1.max_size());
+    FUN_VALUE(sizeof(MySTL::forward_list_node<int>));
+    FUN_VALUE(sizeof(MySTL::list_node<int>));
+
+    // 整个区间的前置、插入、赋值，输入流迭代器只能单趟读取
+    int                      ra[] = {1, 2, 3};
+    MySTL::forward_list<int> lr;
+    std::istringstream       lin("7 8 9");
+    CON_FUN_AFTER(lr, lr.prepend_range(ra));
+    CON_FUN_AFTER(lr, lr.insert_range_after(lr.begin(), ra));
+    CON_FUN_AFTER(lr, lr.insert_after(lr.before_begin(), MySTL::istream_iterator<int>(lin),
+                                      MySTL::istream_iterator<int>()));
+    CON_FUN_AFTER(lr, lr.assign_range(ra));
+
+    // 按个位数排序，个位相同的元素保持原来的先后顺序
+    MySTL::forward_list<int> ls;
+    for (int i = 199; i >= 0; --i)
+        ls.push_front((i * 37) % 200);
+    ls.sort([](int a, int b) { return a % 10 < b % 10; });
+    bool stable = true;
+    for (auto it = ls.begin(), nx = step(ls.begin(), 1); nx != ls.end(); ++it, ++nx) {
+        if (*it % 10 == *nx % 10 && (*it * 173) % 200 > (*nx * 173) % 200)
+            stable = false;
+    }
+    std::cout << std::boolalpha;
+    FUN_VALUE(stable);
+    FUN_VALUE(MySTL::is_sorted(ls.begin(), ls.end(), [](int a, int b) { return a % 10 < b % 10; }));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(ls.front());
+    FUN_VALUE(MySTL::distance(ls.begin(), ls.end()));
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| traverse x10/memory |";
+#if LARGER_TEST_DATA_ON
+    TEST_LEN(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3), WIDE);
+    FLIST_MEM_TEST("|  std::forward_list  |", std_flist_bytes, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+    FLIST_MEM_TEST("|     MySTL::list     |", list_bytes, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+    FLIST_MEM_TEST("| MySTL::forward_list |", flist_bytes, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+    TEST_LEN(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3), WIDE);
+    FLIST_MEM_TEST("|  std::forward_list  |", std_flist_bytes, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    FLIST_MEM_TEST("|     MySTL::list     |", list_bytes, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    FLIST_MEM_TEST("| MySTL::forward_list |", flist_bytes, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[-------------- End container test : forward_list --------------]" << std::endl;
+}
+
+} // MySTL::test::forward_list_test
+
+} // MySTL::test
+
+} // MySTL
+
+#endif /* MY_FORWARD_LIST_TEST_H */
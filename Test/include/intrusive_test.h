@@ -0,0 +1,266 @@
+#ifndef MY_INTRUSIVE_TEST_H
+#define MY_INTRUSIVE_TEST_H
+
+// 对 intrusive_list / intrusive_rb_tree 测试，以及一条记录同时挂在三个索引上时侵入式与非侵入式的比较
+
+// 标准
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "../../src/intrusive_list.h"
+#include "../../src/intrusive_rb_tree.h"
+#include "../../src/list.h"
+#include "../../src/map.h"
+#include "../../src/vector.h"
+
+#include "../test.h"
+
+namespace MySTL {
+
+namespace test {
+
+namespace intrusive_test {
+
+// 三个索引的钩子标签
+struct by_order {};
+struct by_id {};
+struct by_score {};
+
+// 同时挂在到达顺序链表、id 树、score 树上的记录
+struct record : public MySTL::list_base_hook<by_order>,
+                public MySTL::rb_tree_base_hook<by_id>,
+                public MySTL::rb_tree_base_hook<by_score> {
+    int id;
+    int score;
+
+    record(int i = 0, int s = 0) : id(i), score(s) {}
+};
+
+inline std::ostream& operator<<(std::ostream& os, const record& r) {
+    return os << r.id << ":" << r.score;
+}
+
+struct record_id {
+    int operator()(const record& r) const { return r.id; }
+};
+
+struct record_score {
+    int operator()(const record& r) const { return r.score; }
+};
+
+typedef MySTL::intrusive_list<record, by_order>                                 order_index;
+typedef MySTL::intrusive_rb_tree<record, record_id, MySTL::less<int>, by_id>    id_index;
+typedef MySTL::intrusive_rb_tree<record, record_score, MySTL::less<int>, by_score> score_index;
+
+// 非侵入式的记录，保存自己在链表中的位置以便 O(1) 删除
+struct plain_record {
+    int id;
+    int score;
+    MySTL::list<plain_record*>::iterator pos;
+
+    plain_record(int i = 0, int s = 0) : id(i), score(s), pos() {}
+};
+
+// 第 i 条记录的 id 与 score，都是 [0, n) 的一个排列
+inline int index_id(size_t i, size_t n) { return static_cast<int>((i * 7919) % n); }
+inline int index_score(size_t i, size_t n) { return static_cast<int>((i * 7919 * 7) % n); }
+
+// 全部挂上三个索引 -> 按 id 查找并从三个索引中删除一半 -> 清空，返回毫秒数
+inline int intrusive_index_run(size_t n) {
+    MySTL::vector<record> recs;
+    recs.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+        recs.emplace_back(index_id(i, n), index_score(i, n));
+    auto start = std::chrono::steady_clock::now();
+    {
+        order_index order;
+        id_index    ids;
+        score_index scores;
+        for (size_t i = 0; i < n; ++i) {
+            order.push_back(recs[i]);
+            ids.insert_unique(recs[i]);
+            scores.insert_equal(recs[i]);
+        }
+        for (size_t i = 0; i < n; i += 2) {
+            auto it = ids.find(static_cast<int>(i));
+            record& r = *it;
+            ids.erase(it);
+            scores.remove(r);
+            order.remove(r);
+        }
+        MYSTL_DEBUG(order.size() == ids.size() && ids.size() == scores.size());
+    }
+    auto end = std::chrono::steady_clock::now();
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+}
+
+inline int plain_index_run(size_t n) {
+    MySTL::vector<plain_record> recs;
+    recs.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+        recs.emplace_back(index_id(i, n), index_score(i, n));
+    auto start = std::chrono::steady_clock::now();
+    {
+        MySTL::list<plain_record*>          order;
+        MySTL::map<int, plain_record*>      ids;
+        MySTL::multimap<int, plain_record*> scores;
+        for (size_t i = 0; i < n; ++i) {
+            plain_record* p = &recs[i];
+            order.push_back(p);
+            p->pos = --order.end();
+            ids.emplace(p->id, p);
+            scores.emplace(p->score, p);
+        }
+        for (size_t i = 0; i < n; i += 2) {
+            auto          it = ids.find(static_cast<int>(i));
+            plain_record* p = it->second;
+            ids.erase(it);
+            auto range = scores.equal_range(p->score);
+            for (auto s = range.first; s != range.second; ++s) {
+                if (s->second == p) {
+                    scores.erase(s);
+                    break;
+                }
+            }
+            order.erase(p->pos);
+        }
+        MYSTL_DEBUG(order.size() == ids.size() && ids.size() == scores.size());
+    }
+    auto end = std::chrono::steady_clock::now();
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+}
+
+#define THREE_INDEX_DO_TEST(fun, len)                           \
+    do {                                                        \
+        settle_heap();                                          \
+        int         n = fun(static_cast<size_t>(len));          \
+        std::string t = std::to_string(n);                      \
+        t += "ms    |";                                         \
+        std::cout << std::setw(WIDE) << t;                      \
+    } while (0)
+
+#define THREE_INDEX_TEST(name, fun, len1, len2, len3) \
+    std::cout << name;                                \
+    THREE_INDEX_DO_TEST(fun, len1);                   \
+    THREE_INDEX_DO_TEST(fun, len2);                   \
+    THREE_INDEX_DO_TEST(fun, len3);                   \
+    std::cout << std::endl;
+
+void intrusive_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[----------- Run container test : intrusive containers ----------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    record r[] = {record(5, 50), record(3, 30), record(8, 30), record(1, 10), record(7, 70)};
+
+    order_index l1;
+    for (int i = 0; i < 5; ++i)
+        l1.push_back(r[i]);
+    id_index    t1;
+    score_index t2;
+    for (int i = 0; i < 5; ++i) {
+        t1.insert_unique(r[i]);
+        t2.insert_equal(r[i]);
+    }
+    CON_COUT(l1);
+    CON_COUT(t1);
+    CON_COUT(t2);
+
+    // 从一个索引中删除不影响其他索引
+    CON_FUN_AFTER(t1, t1.remove(r[2]));
+    CON_COUT(t2);
+    CON_COUT(l1);
+    CON_FUN_AFTER(l1, l1.erase(l1.iterator_to(r[0])));
+    CON_FUN_AFTER(l1, l1.push_front(r[0]));
+    CON_FUN_AFTER(l1, l1.pop_back());
+    CON_FUN_AFTER(l1, l1.erase(l1.begin(), ++l1.begin()));
+    FUN_VALUE(l1.front());
+    FUN_VALUE(l1.back());
+    FUN_VALUE(l1.size());
+
+    record dup(3, 99);
+    std::cout << std::boolalpha;
+    FUN_VALUE(t1.insert_unique(dup).second);
+    FUN_VALUE(*t1.insert_unique(dup).first);
+    FUN_VALUE(static_cast<MySTL::rb_tree_base_hook<by_id>&>(dup).is_linked());
+    FUN_VALUE(static_cast<MySTL::rb_tree_base_hook<by_id>&>(r[2]).is_linked());
+    FUN_VALUE(static_cast<MySTL::rb_tree_base_hook<by_score>&>(r[2]).is_linked());
+    std::cout << std::noboolalpha;
+    FUN_VALUE(*t1.find(7));
+    FUN_VALUE((t1.find(6) == t1.end()));
+    FUN_VALUE(*t1.lower_bound(4));
+    FUN_VALUE(*t1.upper_bound(5));
+    FUN_VALUE(t2.count_multi(30));
+    FUN_VALUE(*t2.rbegin());
+    CON_FUN_AFTER(t2, t2.erase_multi(30));
+    FUN_VALUE(t2.size());
+
+    id_index t3;
+    CON_FUN_AFTER(t3, t3.swap(t1));
+    CON_COUT(t1);
+    CON_FUN_AFTER(t3, t3.insert_unique(r[2]));
+    id_index t4(MySTL::move(t3));
+    CON_COUT(t4);
+    FUN_VALUE(t3.size());
+
+    // 容器析构时只断开链接，记录仍然可以挂到新的容器上
+    {
+        order_index l2;
+        l2.push_back(dup);
+    }
+    std::cout << std::boolalpha;
+    FUN_VALUE(static_cast<MySTL::list_base_hook<by_order>&>(dup).is_linked());
+    std::cout << std::noboolalpha;
+    t4.clear();
+    t2.clear();
+    l1.clear();
+    FUN_VALUE(t4.size());
+
+    // 大量插入、删除后仍然有序
+    MySTL::vector<record> many;
+    for (int i = 0; i < 1000; ++i)
+        many.emplace_back((i * 7919) % 1000, i % 37);
+    score_index t5;
+    for (auto& x : many)
+        t5.insert_equal(x);
+    for (int i = 0; i < 1000; i += 3)
+        t5.remove(many[i]);
+    bool sorted = true;
+    int  prev = -1;
+    for (auto& x : t5) {
+        sorted = sorted && prev <= x.score;
+        prev = x.score;
+    }
+    std::cout << std::boolalpha;
+    FUN_VALUE(sorted);
+    std::cout << std::noboolalpha;
+    FUN_VALUE(t5.size());
+    t5.clear();
+    PASSED;
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| three indexes       |";
+#if LARGER_TEST_DATA_ON
+    TEST_LEN(SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3), WIDE);
+    THREE_INDEX_TEST("|  list + map + mmap  |", plain_index_run, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    THREE_INDEX_TEST("|      intrusive      |", intrusive_index_run, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#else
+    TEST_LEN(SCALE_SS(LEN1), SCALE_SS(LEN2), SCALE_SS(LEN3), WIDE);
+    THREE_INDEX_TEST("|  list + map + mmap  |", plain_index_run, SCALE_SS(LEN1), SCALE_SS(LEN2), SCALE_SS(LEN3));
+    THREE_INDEX_TEST("|      intrusive      |", intrusive_index_run, SCALE_SS(LEN1), SCALE_SS(LEN2), SCALE_SS(LEN3));
+#endif
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[----------- End container test : intrusive containers ----------]\n";
+}
+
+} // namespace MySTL::test::intrusive_test
+
+} // namespace MySTL::test
+
+} // namespace MySTL
+#endif /* MY_INTRUSIVE_TEST_H */
@@ -7,8 +7,10 @@
 #include <algorithm>
 #include <iostream>
 #include <numeric>
+#include <sstream>
 #include <functional>
 
+#include "../../src/algo.h"
 #include "../../src/list.h"
 
 #include "../test.h"
@@ -76,6 +78,7 @@ void list_test() {
     CON_FUN_AFTER(l1, l1.merge(l7));
     CON_FUN_AFTER(l1, l1.sort(MySTL::greater<int>()));
     CON_FUN_AFTER(l1, l1.merge(l8, MySTL::greater<int>()));
+    CON_FUN_AFTER(l1, l1.inplace_sort());
     CON_FUN_AFTER(l1, l1.reverse());
     CON_FUN_AFTER(l1, l1.clear());
     CON_FUN_AFTER(l1, l1.swap(l9));
@@ -88,6 +91,34 @@ void list_test() {
     std::cout << std::noboolalpha;
     FUN_VALUE(l1.size());
     FUN_VALUE(l1.max_size());
+
+    // 整个区间的追加、插入、赋值，输入流迭代器只能单趟读取
+    int                ra[] = {1, 2, 3};
+    MySTL::list<int>   lr;
+    std::istringstream lin("7 8 9");
+    CON_FUN_AFTER(lr, lr.append_range(ra));
+    CON_FUN_AFTER(lr, lr.insert_range(++lr.begin(), ra));
+    CON_FUN_AFTER(lr, lr.insert(lr.begin(), MySTL::istream_iterator<int>(lin), MySTL::istream_iterator<int>()));
+    FUN_VALUE(lr.size());
+    CON_FUN_AFTER(lr, lr.assign_range(ra));
+    FUN_VALUE(lr.size());
+
+    // 按个位数排序，个位相同的元素保持原来的先后顺序
+    MySTL::list<int> ls;
+    for (int i = 0; i < 200; ++i)
+        ls.push_back((i * 37) % 200);
+    ls.sort([](int a, int b) { return a % 10 < b % 10; });
+    bool stable = true;
+    for (auto it = ls.begin(), nx = ++ls.begin(); nx != ls.end(); ++it, ++nx) {
+        if (*it % 10 == *nx % 10 && (*it * 173) % 200 > (*nx * 173) % 200)
+            stable = false;
+    }
+    std::cout << std::boolalpha;
+    FUN_VALUE(stable);
+    FUN_VALUE(MySTL::is_sorted(ls.begin(), ls.end(), [](int a, int b) { return a % 10 < b % 10; }));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(ls.front());
+    FUN_VALUE(ls.back());
     PASSED;
 #if PERFORMANCE_TEST_ON
   std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
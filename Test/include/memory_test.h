@@ -0,0 +1,193 @@
+#ifndef MY_MEMORY_TEST_H
+#define MY_MEMORY_TEST_H
+// 测试 unique_ptr、shared_ptr、weak_ptr 的接口，以及 shared_ptr 创建、复制、销毁的性能
+
+// 标准
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "../../src/memory.h"
+#include "../../src/pool_allocator.h"
+
+#include "../test.h"
+
+namespace MySTL {
+
+namespace test {
+
+namespace memory_test {
+
+struct base {
+    int          value;
+    static int   live;
+    explicit base(int v) : value(v) { ++live; }
+    virtual ~base() { --live; }
+};
+
+int base::live = 0;
+
+struct derived : base, MySTL::enable_shared_from_this<derived> {
+    explicit derived(int v) : base(v) {}
+};
+
+// 有状态的删除器，unique_ptr 需要为它保留空间
+struct counting_deleter {
+    int* count;
+    void operator()(base* p) const {
+        ++*count;
+        delete p;
+    }
+};
+
+enum sp_phase { SP_CREATE, SP_COPY, SP_DESTROY };
+
+// 创建 count 个 shared_ptr，复制一份，再全部销毁，返回 phase 阶段的耗时(ms)
+template <class Ptr, class Make>
+int sp_phase_ms(Make make, size_t count, sp_phase phase) {
+    std::vector<Ptr> v1, v2;
+    v1.reserve(count);
+    v2.reserve(count);
+    clock_t start, end;
+    clock_t cost[3];
+    start = clock();
+    for (size_t i = 0; i < count; ++i)
+        v1.push_back(make(static_cast<int>(i)));
+    end = clock();
+    cost[SP_CREATE] = end - start;
+    start = clock();
+    for (size_t i = 0; i < count; ++i)
+        v2.push_back(v1[i]);
+    end = clock();
+    cost[SP_COPY] = end - start;
+    start = clock();
+    v2.clear();
+    v1.clear();
+    end = clock();
+    cost[SP_DESTROY] = end - start;
+    return static_cast<int>(static_cast<double>(cost[phase]) / CLOCKS_PER_SEC * 1000);
+}
+
+#define SP_DO_TEST(ptr, make, count, phase)                 \
+    do {                                                    \
+        char buf[10];                                       \
+        int  n = sp_phase_ms<ptr>(make, count, phase);      \
+        std::snprintf(buf, sizeof(buf), "%d", n);           \
+        std::string t = buf;                                \
+        t += "ms    |";                                     \
+        std::cout << std::setw(WIDE) << t;                  \
+    } while (0)
+
+#define SP_TEST(name, ptr, make, phase, len1, len2, len3) \
+    std::cout << name;                                    \
+    SP_DO_TEST(ptr, make, len1, phase);                   \
+    SP_DO_TEST(ptr, make, len2, phase);                   \
+    SP_DO_TEST(ptr, make, len3, phase);                   \
+    std::cout << std::endl;
+
+#define SP_PHASE_TEST(title, phase, len1, len2, len3)                                                    \
+    std::cout << title;                                                                                  \
+    TEST_LEN(len1, len2, len3, WIDE);                                                                    \
+    SP_TEST("|   std::make_shared  |", std::shared_ptr<int>, std_make, phase, len1, len2, len3);         \
+    SP_TEST("|   std::shared_ptr   |", std::shared_ptr<int>, std_new, phase, len1, len2, len3);          \
+    SP_TEST("|  MySTL::make_shared |", MySTL::shared_ptr<int>, my_make, phase, len1, len2, len3);        \
+    SP_TEST("|  MySTL::shared_ptr  |", MySTL::shared_ptr<int>, my_new, phase, len1, len2, len3);         \
+    SP_TEST("|  make_local_shared  |", MySTL::local_shared_ptr<int>, my_local, phase, len1, len2, len3); \
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+
+void memory_test() {
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[---------------- Run container test : memory ------------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    std::cout << std::boolalpha;
+
+    // unique_ptr：空删除器不占空间，有状态删除器随指针一起保存
+    int deleted = 0;
+    {
+        MySTL::unique_ptr<base>                   u1(new base(1));
+        MySTL::unique_ptr<base, counting_deleter> u2(new base(2), counting_deleter{&deleted});
+        MySTL::unique_ptr<int[]>                  u3 = MySTL::make_unique<int[]>(4);
+        FUN_VALUE((sizeof(u1) == sizeof(base*)));
+        FUN_VALUE((sizeof(u2) == sizeof(base*) + sizeof(int*)));
+        MySTL::unique_ptr<base> u4(MySTL::make_unique<derived>(4));
+        u1 = MySTL::move(u4);
+        FUN_VALUE(u1->value);
+        FUN_VALUE((u4 == nullptr));
+        u2.reset(new base(5));
+        FUN_VALUE(deleted);
+        u3[3] = 7;
+        FUN_VALUE(u3[3]);
+    }
+    FUN_VALUE(deleted);
+    FUN_VALUE(base::live);
+
+    // shared_ptr：make_shared 只分配一次，计数在复制、移动、转换间保持一致
+    {
+        MySTL::shared_ptr<derived> s1 = MySTL::make_shared<derived>(1);
+        MySTL::shared_ptr<base>    s2 = s1;
+        MySTL::shared_ptr<base>    s3(MySTL::move(s2));
+        FUN_VALUE(s1.use_count());
+        FUN_VALUE((s2 == nullptr));
+        MySTL::weak_ptr<base> w1 = s3;
+        FUN_VALUE(w1.lock()->value);
+        MySTL::shared_ptr<derived> s4 = s1->shared_from_this();
+        FUN_VALUE(s1.use_count());
+        FUN_VALUE((MySTL::dynamic_pointer_cast<derived>(s3) == s1));
+        s1.reset();
+        s3.reset();
+        s4.reset();
+        FUN_VALUE(w1.expired());
+        FUN_VALUE((w1.lock() == nullptr));
+
+        MySTL::shared_ptr<base> s5(MySTL::unique_ptr<base, counting_deleter>(new base(6), counting_deleter{&deleted}));
+        MySTL::shared_ptr<base> s6 = MySTL::allocate_shared<derived>(MySTL::pool_allocator<derived>(), 7);
+        FUN_VALUE(s5->value);
+        FUN_VALUE(s6->value);
+        FUN_VALUE(base::live);
+    }
+    FUN_VALUE(deleted);
+    FUN_VALUE(base::live);
+
+    // local_shared_ptr：单线程所有权，计数不使用原子操作
+    {
+        MySTL::local_shared_ptr<int> l1 = MySTL::make_local_shared<int>(8);
+        MySTL::local_shared_ptr<int> l2 = l1;
+        MySTL::local_weak_ptr<int>   lw = l1;
+        FUN_VALUE(l2.use_count());
+        l1.reset();
+        l2.reset();
+        FUN_VALUE(lw.expired());
+    }
+    std::cout << std::noboolalpha;
+    PASSED;
+
+#if PERFORMANCE_TEST_ON
+    auto std_make = [](int i) { return std::make_shared<int>(i); };
+    auto std_new = [](int i) { return std::shared_ptr<int>(new int(i)); };
+    auto my_make = [](int i) { return MySTL::make_shared<int>(i); };
+    auto my_new = [](int i) { return MySTL::shared_ptr<int>(new int(i)); };
+    auto my_local = [](int i) { return MySTL::make_local_shared<int>(i); };
+
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+#if LARGER_TEST_DATA_ON
+    SP_PHASE_TEST("|       create        |", SP_CREATE, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    SP_PHASE_TEST("|        copy         |", SP_COPY, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    SP_PHASE_TEST("|       destroy       |", SP_DESTROY, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    SP_PHASE_TEST("|       create        |", SP_CREATE, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    SP_PHASE_TEST("|        copy         |", SP_COPY, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    SP_PHASE_TEST("|       destroy       |", SP_DESTROY, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    PASSED;
+#endif
+    std::cout << "[---------------- End container test : memory ------------------]" << std::endl;
+}
+
+} // MySTL::test::memory_test
+
+} // MySTL::test
+
+} // MySTL
+
+#endif /* MY_MEMORY_TEST_H */
@@ -0,0 +1,141 @@
+#ifndef MY_SMALL_VECTOR_TEST_H
+#define MY_SMALL_VECTOR_TEST_H
+
+// 对 small_vector 容器测试，以及大量短序列的构造性能
+
+// 标准
+#include <iostream>
+#include <string>
+
+#include "../../src/small_vector.h"
+#include "../../src/vector.h"
+
+#include "../test.h"
+
+namespace MySTL {
+
+namespace test {
+
+namespace small_vector_test {
+
+// 构造 count 个只有 len 个元素的短序列，每个构造后立即析构
+#define SHORT_SEQ_DO_TEST(con, len, count)                                                  \
+    do {                                                                                    \
+        clock_t         start, end;                                                         \
+        char            buf[10];                                                            \
+        volatile size_t sink = 0;                                                           \
+        start = clock();                                                                    \
+        for (size_t i = 0; i < count; ++i) {                                                \
+            con c;                                                                          \
+            for (int j = 0; j < len; ++j)                                                   \
+                c.push_back(j);                                                             \
+            sink = sink + c.size();                                                         \
+        }                                                                                   \
+        end = clock();                                                                      \
+        int n = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", n);                                           \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+// 宏参数中不能出现逗号
+typedef MySTL::small_vector<int, 8> small_int_vector;
+
+#define SHORT_SEQ_TEST(name, con, len, len1, len2, len3) \
+    std::cout << name;                                   \
+    SHORT_SEQ_DO_TEST(con, len, len1);                   \
+    SHORT_SEQ_DO_TEST(con, len, len2);                   \
+    SHORT_SEQ_DO_TEST(con, len, len3);                   \
+    std::cout << std::endl;
+
+void small_vector_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[-------------- Run container test : small_vector --------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int                           a[] = {1, 2, 3, 4, 5};
+    MySTL::small_vector<int, 8>   v1;
+    MySTL::small_vector<int, 8>   v2(10);
+    MySTL::small_vector<int, 8>   v3(10, 1);
+    MySTL::small_vector<int, 8>   v4(a, a + 5);
+    MySTL::small_vector<int, 8>   v5(v2);
+    MySTL::small_vector<int, 8>   v6(std::move(v2));
+    MySTL::small_vector<int, 8>   v7{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    MySTL::small_vector<int, 8>   v8, v9, v10;
+    v8 = v3;
+    v9 = std::move(v3);
+    v10 = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    CON_FUN_AFTER(v1, v1.assign(8, 8));
+    CON_FUN_AFTER(v1, v1.assign(a, a + 5));
+    CON_FUN_AFTER(v1, v1.emplace(v1.begin(), 0));
+    CON_FUN_AFTER(v1, v1.emplace_back(6));
+    CON_FUN_AFTER(v1, v1.push_back(6));
+    CON_FUN_AFTER(v1, v1.insert(v1.end(), 7));
+    CON_FUN_AFTER(v1, v1.insert(v1.begin() + 3, 2, 3));
+    CON_FUN_AFTER(v1, v1.insert(v1.begin(), a, a + 5));
+    CON_FUN_AFTER(v1, v1.pop_back());
+    CON_FUN_AFTER(v1, v1.erase(v1.begin()));
+    CON_FUN_AFTER(v1, v1.erase(v1.begin(), v1.begin() + 2));
+    CON_FUN_AFTER(v1, v1.swap(v4));
+
+    FUN_VALUE(v1.front());
+    FUN_VALUE(v1.back());
+    FUN_VALUE(v1.at(1));
+    std::cout << std::boolalpha;
+    FUN_VALUE(v1.is_inline());
+    FUN_VALUE(v4.is_inline());
+    FUN_VALUE(v6.is_inline());
+    FUN_VALUE(v2.is_inline());
+    std::cout << std::noboolalpha;
+    FUN_VALUE(v1.capacity());
+    FUN_VALUE(v4.capacity());
+    CON_FUN_AFTER(v4, v4.resize(6));
+    CON_FUN_AFTER(v4, v4.shrink_to_fit());
+    std::cout << std::boolalpha;
+    FUN_VALUE(v4.is_inline());
+    std::cout << std::noboolalpha;
+    CON_FUN_AFTER(v4, v4.reserve(20));
+    FUN_VALUE(v4.capacity());
+
+    // 元素不可平凡重定位时，内联与堆之间逐个移动
+    MySTL::small_vector<std::string, 4> s1;
+    for (int i = 0; i < 6; ++i)
+        s1.emplace_back(static_cast<size_t>(i + 1), static_cast<char>('a' + i));
+    MySTL::small_vector<std::string, 4> s2{"x", "y"};
+    CON_FUN_AFTER(s1, s1.insert(s1.begin() + 1, s2.begin(), s2.end()));
+    CON_FUN_AFTER(s1, s1.swap(s2));
+    CON_FUN_AFTER(s2, s2.erase(s2.begin(), s2.begin() + 5));
+    CON_FUN_AFTER(s2, s2.shrink_to_fit());
+    MySTL::small_vector<std::string, 4> s3(std::move(s2));
+    CON_FUN_AFTER(s3, s3.emplace(s3.begin(), "z"));
+    std::cout << std::boolalpha;
+    FUN_VALUE(s3.is_inline());
+    FUN_VALUE((s1 < s3));
+    std::cout << std::noboolalpha;
+    PASSED;
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  build 6 elements   |";
+    TEST_LEN(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3), WIDE);
+    SHORT_SEQ_TEST("|    MySTL::vector    |", MySTL::vector<int>, 6, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    SHORT_SEQ_TEST("| small_vector<int,8> |", small_int_vector, 6, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  build 12 elements  |";
+    TEST_LEN(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3), WIDE);
+    SHORT_SEQ_TEST("|    MySTL::vector    |", MySTL::vector<int>, 12, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    SHORT_SEQ_TEST("| small_vector<int,8> |", small_int_vector, 12, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[-------------- End container test : small_vector --------------]\n";
+}
+
+} // namespace MySTL::test::small_vector_test
+
+} // namespace MySTL::test
+
+} // namespace MySTL
+#endif /* MY_SMALL_VECTOR_TEST_H */
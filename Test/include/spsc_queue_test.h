@@ -0,0 +1,301 @@
+#ifndef MY_SPSC_QUEUE_TEST_H
+#define MY_SPSC_QUEUE_TEST_H
+// 测试 spsc_queue 接口，以及两个线程之间与 加锁的 queue 的吞吐量、往返延迟比较
+
+// 标准
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "../../src/queue.h"
+#include "../../src/spsc_queue.h"
+
+#include "../test.h"
+
+namespace MySTL {
+
+namespace test {
+
+namespace spsc_queue_test {
+
+// 依次弹出并输出 spsc_queue 中的全部元素
+template <class Q>
+void spsc_drain_cout(Q& q) {
+    typename Q::value_type v;
+    while (q.try_pop(v))
+        std::cout << " " << v;
+    std::cout << std::endl;
+}
+
+#define SPSC_DRAIN_COUT(q)                  \
+    do {                                    \
+        std::string q_name = #q;            \
+        std::cout << " " << q_name << " :"; \
+        spsc_drain_cout(q);                 \
+    } while (0)
+
+// 两个线程之间依次传递 0 ~ n-1，返回毫秒数
+
+// 加锁的 queue，每个元素加锁一次
+inline int locked_queue_run(size_t n) {
+    MySTL::queue<int> q;
+    std::mutex        mtx;
+    long long         sum = 0;
+    auto              start = std::chrono::steady_clock::now();
+    std::thread       consumer([&]() {
+        for (size_t got = 0; got < n;) {
+            std::unique_lock<std::mutex> guard(mtx);
+            if (q.empty()) {
+                guard.unlock();
+                std::this_thread::yield();
+                continue;
+            }
+            sum += q.front();
+            q.pop();
+            ++got;
+        }
+    });
+    for (size_t i = 0; i < n; ++i) {
+        std::lock_guard<std::mutex> guard(mtx);
+        q.push(static_cast<int>(i));
+    }
+    consumer.join();
+    auto end = std::chrono::steady_clock::now();
+    MYSTL_DEBUG(sum == static_cast<long long>(n) * static_cast<long long>(n - 1) / 2);
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+}
+
+// spsc_queue，每次 push / try_pop 一个元素
+inline int spsc_queue_run(size_t n) {
+    MySTL::spsc_queue<int> q(1024);
+    long long              sum = 0;
+    auto                   start = std::chrono::steady_clock::now();
+    std::thread            consumer([&]() {
+        int v;
+        for (size_t got = 0; got < n;) {
+            if (q.try_pop(v)) {
+                sum += v;
+                ++got;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    for (size_t i = 0; i < n; ++i)
+        q.push(static_cast<int>(i));
+    consumer.join();
+    auto end = std::chrono::steady_clock::now();
+    MYSTL_DEBUG(sum == static_cast<long long>(n) * static_cast<long long>(n - 1) / 2);
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+}
+
+// spsc_queue，每次 push_n / pop_n 至多 64 个元素
+inline int spsc_queue_batch_run(size_t n) {
+    MySTL::spsc_queue<int> q(1024);
+    long long              sum = 0;
+    auto                   start = std::chrono::steady_clock::now();
+    std::thread            consumer([&]() {
+        int buf[64];
+        for (size_t got = 0; got < n;) {
+            size_t m = q.pop_n(buf, 64);
+            if (m == 0)
+                std::this_thread::yield();
+            for (size_t i = 0; i < m; ++i)
+                sum += buf[i];
+            got += m;
+        }
+    });
+    int buf[64];
+    for (size_t sent = 0; sent < n;) {
+        size_t want = n - sent < 64 ? n - sent : 64;
+        for (size_t i = 0; i < want; ++i)
+            buf[i] = static_cast<int>(sent + i);
+        size_t m = q.push_n(buf, want);
+        if (m == 0)
+            std::this_thread::yield();
+        sent += m;
+    }
+    consumer.join();
+    auto end = std::chrono::steady_clock::now();
+    MYSTL_DEBUG(sum == static_cast<long long>(n) * static_cast<long long>(n - 1) / 2);
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+}
+
+// 往返延迟：主线程发出 i，另一个线程收到后原样送回，主线程收到后再发下一个，返回每次往返的纳秒数
+inline int locked_queue_ping(size_t n) {
+    MySTL::queue<int> to, back;
+    std::mutex        mto, mback;
+    auto              recv = [](MySTL::queue<int>& q, std::mutex& m) {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> guard(m);
+                if (!q.empty()) {
+                    int v = q.front();
+                    q.pop();
+                    return v;
+                }
+            }
+            std::this_thread::yield();
+        }
+    };
+    std::thread echo([&]() {
+        for (size_t i = 0; i < n; ++i) {
+            int v = recv(to, mto);
+            std::lock_guard<std::mutex> guard(mback);
+            back.push(v);
+        }
+    });
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i) {
+        {
+            std::lock_guard<std::mutex> guard(mto);
+            to.push(static_cast<int>(i));
+        }
+        recv(back, mback);
+    }
+    auto end = std::chrono::steady_clock::now();
+    echo.join();
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / n);
+}
+
+inline int spsc_queue_ping(size_t n) {
+    MySTL::spsc_queue<int> to(64), back(64);
+    auto                   recv = [](MySTL::spsc_queue<int>& q) {
+        int v;
+        while (!q.try_pop(v))
+            std::this_thread::yield();
+        return v;
+    };
+    std::thread echo([&]() {
+        for (size_t i = 0; i < n; ++i)
+            back.push(recv(to));
+    });
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i) {
+        to.push(static_cast<int>(i));
+        recv(back);
+    }
+    auto end = std::chrono::steady_clock::now();
+    echo.join();
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / n);
+}
+
+#define SPSC_DO_TEST(fun, len, unit)                            \
+    do {                                                        \
+        settle_heap();                                          \
+        int         n = fun(static_cast<size_t>(len));          \
+        std::string t = std::to_string(n);                      \
+        t += unit;                                              \
+        std::cout << std::setw(WIDE) << t;                      \
+    } while (0)
+
+#define SPSC_TEST(name, fun, len1, len2, len3, unit) \
+    std::cout << name;                               \
+    SPSC_DO_TEST(fun, len1, unit);                   \
+    SPSC_DO_TEST(fun, len2, unit);                   \
+    SPSC_DO_TEST(fun, len3, unit);                   \
+    std::cout << std::endl;
+
+void spsc_queue_test() {
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[-------------- Run container test : spsc_queue ----------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    int                    a[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    int                    out[10] = {0};
+    MySTL::spsc_queue<int> q1(5);
+    MySTL::spsc_queue<std::string> q2(2);
+    std::cout << std::boolalpha;
+    FUN_VALUE(q1.capacity());
+    FUN_VALUE(q2.capacity());
+    FUN_VALUE(q1.empty());
+    FUN_VALUE(q1.try_push(1));
+    std::cout << std::noboolalpha;
+    q1.push(2);
+    q1.emplace(3);
+    FUN_VALUE(q1.size());
+    FUN_VALUE(q1.front());
+    q1.pop();
+    FUN_VALUE(q1.front());
+    FUN_VALUE(q1.push_n(a, 10));  // 只剩 6 个空位
+    FUN_VALUE(q1.size());
+    std::cout << std::boolalpha;
+    FUN_VALUE(q1.try_push(0));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(q1.pop_n(out, 3));
+    FUN_VALUE(out[0] + out[1] + out[2]);
+    SPSC_DRAIN_COUT(q1);
+    std::cout << std::boolalpha;
+    FUN_VALUE(q1.empty());
+    std::cout << std::noboolalpha;
+
+    // 下标越过容量后继续循环使用缓冲区
+    for (int i = 0; i < 100; ++i) {
+        q1.push(i);
+        q1.pop();
+    }
+    FUN_VALUE(q1.push_n(a, 5));
+    SPSC_DRAIN_COUT(q1);
+    q2.emplace(3, 'a');
+    q2.push("bb");
+    FUN_VALUE(q2.front());
+    SPSC_DRAIN_COUT(q2);
+    q2.push("left in queue");  // 由析构函数销毁
+
+    // 两个线程之间按顺序传递
+    MySTL::spsc_queue<int> q3(16);
+    const int              n = 100000;
+    bool                   ordered = true;
+    std::thread            consumer([&]() {
+        int buf[7];
+        for (int expect = 0; expect < n;) {
+            size_t m = q3.pop_n(buf, 7);
+            if (m == 0)
+                std::this_thread::yield();
+            for (size_t i = 0; i < m; ++i, ++expect)
+                ordered = ordered && buf[i] == expect;
+        }
+    });
+    for (int i = 0; i < n; ++i)
+        q3.push(i);
+    consumer.join();
+    std::cout << std::boolalpha;
+    FUN_VALUE(ordered);
+    FUN_VALUE(q3.empty());
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| two threads         |";
+#if LARGER_TEST_DATA_ON
+    TEST_LEN(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3), WIDE);
+    SPSC_TEST("|  mutex + queue      |", locked_queue_run, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3), "ms    |");
+    SPSC_TEST("|  spsc_queue         |", spsc_queue_run, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3), "ms    |");
+    SPSC_TEST("|  spsc push_n/pop_n  |", spsc_queue_batch_run, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3), "ms    |");
+#else
+    TEST_LEN(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3), WIDE);
+    SPSC_TEST("|  mutex + queue      |", locked_queue_run, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3), "ms    |");
+    SPSC_TEST("|  spsc_queue         |", spsc_queue_run, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3), "ms    |");
+    SPSC_TEST("|  spsc push_n/pop_n  |", spsc_queue_batch_run, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3), "ms    |");
+#endif
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| round trip (avg)    |";
+    TEST_LEN(SCALE_SSS(LEN1), SCALE_SSS(LEN2), SCALE_SSS(LEN3), WIDE);
+    SPSC_TEST("|  mutex + queue      |", locked_queue_ping, SCALE_SSS(LEN1), SCALE_SSS(LEN2), SCALE_SSS(LEN3), "ns    |");
+    SPSC_TEST("|  spsc_queue         |", spsc_queue_ping, SCALE_SSS(LEN1), SCALE_SSS(LEN2), SCALE_SSS(LEN3), "ns    |");
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[-------------- End container test : spsc_queue ----------------]" << std::endl;
+}
+
+} // MySTL::test::spsc_queue_test
+
+} // MySTL::test
+
+} // MySTL
+
+#endif /* MY_SPSC_QUEUE_TEST_H */
@@ -0,0 +1,143 @@
+#ifndef MY_STABLE_VECTOR_TEST_H
+#define MY_STABLE_VECTOR_TEST_H
+
+// 对 stable_vector 容器测试，以及 push_back 的最坏单次延迟
+
+// 标准
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "../../src/algorithm.h"
+#include "../../src/stable_vector.h"
+#include "../../src/vector.h"
+
+#include "../test.h"
+
+namespace MySTL {
+
+namespace test {
+
+namespace stable_vector_test {
+
+// push_back 到 len 个元素，单元格中显示 总耗时/最慢的一次 push_back
+#define WORST_PUSH_DO_TEST(con, len)                                                          \
+    do {                                                                                      \
+        char buf[24];                                                                         \
+        con  c;                                                                               \
+        long long worst = 0;                                                                  \
+        auto start = std::chrono::steady_clock::now();                                        \
+        for (size_t i = 0; i < static_cast<size_t>(len); ++i) {                               \
+            auto t0 = std::chrono::steady_clock::now();                                       \
+            c.push_back(static_cast<int>(i));                                                 \
+            auto t1 = std::chrono::steady_clock::now();                                       \
+            long long us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count(); \
+            if (us > worst) worst = us;                                                       \
+        }                                                                                     \
+        auto end = std::chrono::steady_clock::now();                                          \
+        int  n = static_cast<int>(                                                            \
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());      \
+        std::snprintf(buf, sizeof(buf), "%dms/%dus", n, static_cast<int>(worst));             \
+        std::string t = buf;                                                                  \
+        t += "|";                                                                             \
+        std::cout << std::setw(WIDE) << t;                                                    \
+    } while (0)
+
+#define WORST_PUSH_TEST(name, con, len1, len2, len3) \
+    std::cout << name;                               \
+    WORST_PUSH_DO_TEST(con, len1);                   \
+    WORST_PUSH_DO_TEST(con, len2);                   \
+    WORST_PUSH_DO_TEST(con, len3);                   \
+    std::cout << std::endl;
+
+void stable_vector_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run container test : stable_vector --------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int                          a[] = {1, 2, 3, 4, 5};
+    MySTL::stable_vector<int>    v1;
+    MySTL::stable_vector<int>    v2(10);
+    MySTL::stable_vector<int>    v3(10, 1);
+    MySTL::stable_vector<int>    v4(a, a + 5);
+    MySTL::stable_vector<int>    v5(v2);
+    MySTL::stable_vector<int>    v6(std::move(v2));
+    MySTL::stable_vector<int>    v7{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    MySTL::stable_vector<int>    v8, v9, v10;
+    v8 = v3;
+    v9 = std::move(v3);
+    v10 = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    CON_FUN_AFTER(v1, v1.assign(8, 8));
+    CON_FUN_AFTER(v1, v1.assign(a, a + 5));
+    CON_FUN_AFTER(v1, v1.emplace(v1.begin(), 0));
+    CON_FUN_AFTER(v1, v1.emplace_back(6));
+    CON_FUN_AFTER(v1, v1.push_back(6));
+    CON_FUN_AFTER(v1, v1.insert(v1.end(), 7));
+    CON_FUN_AFTER(v1, v1.insert(v1.begin() + 3, 3));
+    CON_FUN_AFTER(v1, v1.pop_back());
+    CON_FUN_AFTER(v1, v1.erase(v1.begin()));
+    CON_FUN_AFTER(v1, v1.erase(v1.begin(), v1.begin() + 2));
+    CON_FUN_AFTER(v1, v1.swap(v4));
+    FUN_VALUE(v1.front());
+    FUN_VALUE(v1.back());
+    FUN_VALUE(v1.at(1));
+    FUN_VALUE(v1.capacity());
+
+    // 跨越多个块后，已有元素的地址保持不变，迭代器可用于随机访问算法
+    MySTL::stable_vector<int> v11;
+    v11.push_back(-1);
+    int* first_elem = &v11[0];
+    for (int i = 0; i < 1000; ++i)
+        v11.push_back((i * 7919) % 1000);
+    std::cout << std::boolalpha;
+    FUN_VALUE((first_elem == &v11.front()));
+    MySTL::sort(v11.begin(), v11.end());
+    FUN_VALUE(MySTL::is_sorted(v11.begin(), v11.end()));
+    FUN_VALUE((first_elem == &v11.front()));
+    FUN_VALUE(*MySTL::lower_bound(v11.begin(), v11.end(), 500));
+    FUN_VALUE((v11.end() - v11.begin()));
+    FUN_VALUE(v11[777]);
+    FUN_VALUE(*(v11.end() - 224));
+    std::cout << std::noboolalpha;
+    CON_FUN_AFTER(v11, v11.resize(20));
+    FUN_VALUE(v11.capacity());
+    CON_FUN_AFTER(v11, v11.shrink_to_fit());
+    FUN_VALUE(v11.capacity());
+
+    MySTL::stable_vector<std::string> s1;
+    for (int i = 0; i < 40; ++i)
+        s1.emplace_back(static_cast<size_t>(i % 3 + 1), static_cast<char>('a' + i % 26));
+    MySTL::stable_vector<std::string> s2(s1);
+    CON_FUN_AFTER(s2, s2.erase(s2.begin() + 3, s2.end() - 3));
+    CON_FUN_AFTER(s2, s2.insert(s2.begin() + 2, "x"));
+    std::cout << std::boolalpha;
+    FUN_VALUE((s1 < s2));
+    std::cout << std::noboolalpha;
+    PASSED;
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| push_back worst case|";
+#if LARGER_TEST_DATA_ON
+    TEST_LEN(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3), WIDE);
+    WORST_PUSH_TEST("|    MySTL::vector    |", MySTL::vector<int>, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+    WORST_PUSH_TEST("| MySTL::stable_vector|", MySTL::stable_vector<int>, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+    TEST_LEN(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3), WIDE);
+    WORST_PUSH_TEST("|    MySTL::vector    |", MySTL::vector<int>, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    WORST_PUSH_TEST("| MySTL::stable_vector|", MySTL::stable_vector<int>, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[------------- End container test : stable_vector --------------]\n";
+}
+
+} // namespace MySTL::test::stable_vector_test
+
+} // namespace MySTL::test
+
+} // namespace MySTL
+#endif /* MY_STABLE_VECTOR_TEST_H */
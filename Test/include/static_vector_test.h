@@ -0,0 +1,116 @@
+#ifndef MY_STATIC_VECTOR_TEST_H
+#define MY_STATIC_VECTOR_TEST_H
+
+// 对 static_vector 容器测试，以及固定容量短序列的构造性能
+
+// 标准
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "../../src/static_vector.h"
+#include "../../src/small_vector.h"
+#include "../../src/vector.h"
+
+#include "../test.h"
+#include "small_vector_test.h"
+
+namespace MySTL {
+
+namespace test {
+
+namespace static_vector_test {
+
+// 宏参数中不能出现逗号
+typedef MySTL::static_vector<int, 16> static_int_vector;
+
+void static_vector_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run container test : static_vector --------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int                            a[] = {1, 2, 3, 4, 5};
+    MySTL::static_vector<int, 16>  v1;
+    MySTL::static_vector<int, 16>  v2(10);
+    MySTL::static_vector<int, 16>  v3(10, 1);
+    MySTL::static_vector<int, 16>  v4(a, a + 5);
+    MySTL::static_vector<int, 16>  v5(v2);
+    MySTL::static_vector<int, 16>  v6(std::move(v2));
+    MySTL::static_vector<int, 16>  v7{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    MySTL::static_vector<int, 16>  v8, v9, v10;
+    v8 = v3;
+    v9 = std::move(v3);
+    v10 = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    CON_FUN_AFTER(v1, v1.assign(8, 8));
+    CON_FUN_AFTER(v1, v1.assign(a, a + 5));
+    CON_FUN_AFTER(v1, v1.emplace(v1.begin(), 0));
+    CON_FUN_AFTER(v1, v1.emplace_back(6));
+    CON_FUN_AFTER(v1, v1.push_back(6));
+    CON_FUN_AFTER(v1, v1.insert(v1.end(), 7));
+    CON_FUN_AFTER(v1, v1.insert(v1.begin() + 3, 2, 3));
+    CON_FUN_AFTER(v1, v1.insert(v1.begin(), a, a + 5));
+    CON_FUN_AFTER(v1, v1.pop_back());
+    CON_FUN_AFTER(v1, v1.erase(v1.begin()));
+    CON_FUN_AFTER(v1, v1.erase(v1.begin(), v1.begin() + 2));
+    CON_FUN_AFTER(v1, v1.swap(v4));
+    CON_FUN_AFTER(v4, v4.resize(15, 9));
+
+    FUN_VALUE(v1.front());
+    FUN_VALUE(v1.back());
+    FUN_VALUE(v1.at(1));
+    FUN_VALUE(v4.capacity());
+    std::cout << std::boolalpha;
+    FUN_VALUE(std::is_trivially_copyable<static_int_vector>::value);
+    FUN_VALUE(v4.try_push_back(10));
+    FUN_VALUE(v4.full());
+    FUN_VALUE(v4.try_push_back(11));
+    bool thrown = false;
+    try {
+        v4.push_back(11);
+    } catch (const std::length_error&) {
+        thrown = true;
+    }
+    FUN_VALUE(thrown);
+    FUN_VALUE(v4.size());
+    FUN_VALUE((v1 < v4));
+    std::cout << std::noboolalpha;
+
+    // 元素不可平凡复制时，复制、移动、析构逐个进行
+    MySTL::static_vector<std::string, 8> s1;
+    for (int i = 0; i < 6; ++i)
+        s1.emplace_back(static_cast<size_t>(i + 1), static_cast<char>('a' + i));
+    MySTL::static_vector<std::string, 8> s2{"x", "y"};
+    CON_FUN_AFTER(s1, s1.insert(s1.begin() + 1, s2.begin(), s2.end()));
+    CON_FUN_AFTER(s1, s1.swap(s2));
+    CON_FUN_AFTER(s2, s2.erase(s2.begin(), s2.begin() + 5));
+    MySTL::static_vector<std::string, 8> s3(std::move(s2));
+    CON_FUN_AFTER(s3, s3.emplace(s3.begin(), "z"));
+    s2 = s3;
+    std::cout << std::boolalpha;
+    FUN_VALUE((std::is_trivially_copyable<MySTL::static_vector<std::string, 8>>::value));
+    FUN_VALUE((s2 == s3));
+    std::cout << std::noboolalpha;
+    PASSED;
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  build 12 elements  |";
+    TEST_LEN(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3), WIDE);
+    SHORT_SEQ_TEST("|    MySTL::vector    |", MySTL::vector<int>, 12, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    SHORT_SEQ_TEST("| small_vector<int,8> |", small_vector_test::small_int_vector, 12, SCALE_M(LEN1), SCALE_M(LEN2),
+                   SCALE_M(LEN3));
+    SHORT_SEQ_TEST("|static_vector<int,16>|", static_int_vector, 12, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[------------- End container test : static_vector --------------]\n";
+}
+
+} // namespace MySTL::test::static_vector_test
+
+} // namespace MySTL::test
+
+} // namespace MySTL
+#endif /* MY_STATIC_VECTOR_TEST_H */
@@ -1,14 +1,18 @@
 #ifndef MY_STRING_TEST_H
 #define MY_STRING_TEST_H
-// 测试 string 接口
+// 测试 string 接口，以及把整个文件读入 string / vector 的性能
 
 // 标准
 #include <string>
 #include <algorithm>
+#include <cstdio>
 #include <iostream>
 #include <numeric>
+#include <sstream>
+#include <vector>
 
 #include "../../src/astring.h"
+#include "../../src/vector.h"
 
 #include "../test.h"
 
@@ -18,6 +22,67 @@ namespace test {
 
 namespace string_test {
 
+// 从文件开头读取 bytes 字节到 con 中，fill 负责扩展 con 并调用 fread
+template <class Con, class Fill>
+int read_file_ms(std::FILE* fp, size_t bytes, Fill fill) {
+    Con     con;
+    clock_t start, end;
+    std::rewind(fp);
+    start = clock();
+    fill(con, fp, bytes);
+    end = clock();
+    if (con.size() != bytes)
+        std::cout << "short read ";
+    return static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000);
+}
+
+#define READ_FILE_DO_TEST(con, fill, mb)                                     \
+    do {                                                                     \
+        char buf[10];                                                        \
+        int  n = read_file_ms<con>(fp, static_cast<size_t>(mb) << 20, fill); \
+        std::snprintf(buf, sizeof(buf), "%d", n);                            \
+        std::string t = buf;                                                 \
+        t += "ms    |";                                                      \
+        std::cout << std::setw(WIDE) << t;                                   \
+    } while (0)
+
+#define READ_FILE_TEST(name, con, fill, mb1, mb2, mb3) \
+    std::cout << name;                                 \
+    READ_FILE_DO_TEST(con, fill, mb1);                 \
+    READ_FILE_DO_TEST(con, fill, mb2);                 \
+    READ_FILE_DO_TEST(con, fill, mb3);                 \
+    std::cout << std::endl;
+
+// 宏参数中不能出现逗号
+typedef std::vector<char>   std_char_vector;
+typedef MySTL::vector<char> my_char_vector;
+
+// 先 resize 再 fread：std 容器和 resize 都会先把新空间清零
+struct fill_by_resize {
+    template <class Con>
+    void operator()(Con& c, std::FILE* f, size_t n) const {
+        c.resize(n);
+        c.resize(std::fread(&c[0], 1, n, f));
+    }
+};
+
+// resize_and_overwrite 只扩展不清零，fread 直接写入容器的缓冲区
+struct fill_by_overwrite {
+    template <class Con>
+    void operator()(Con& c, std::FILE* f, size_t n) const {
+        c.resize_and_overwrite(n, [f](char* p, size_t len) { return std::fread(p, 1, len, f); });
+    }
+};
+
+#define READ_FILE_TEST_ALL(mb1, mb2, mb3)                                                            \
+    TEST_LEN(mb1, mb2, mb3, WIDE);                                                                   \
+    READ_FILE_TEST("|  std::string resize |", std::string, fill_by_resize(), mb1, mb2, mb3);         \
+    READ_FILE_TEST("|    string resize    |", MySTL::string, fill_by_resize(), mb1, mb2, mb3);       \
+    READ_FILE_TEST("|  string overwrite   |", MySTL::string, fill_by_overwrite(), mb1, mb2, mb3);    \
+    READ_FILE_TEST("|  std::vector resize |", std_char_vector, fill_by_resize(), mb1, mb2, mb3);     \
+    READ_FILE_TEST("|    vector resize    |", my_char_vector, fill_by_resize(), mb1, mb2, mb3);      \
+    READ_FILE_TEST("|  vector overwrite   |", my_char_vector, fill_by_overwrite(), mb1, mb2, mb3);
+
 void string_test() {
     std::cout << "[===============================================================]" << std::endl;
     std::cout << "[----------------- Run container test : string -----------------]" << std::endl;
@@ -84,6 +149,12 @@ void string_test() {
     FUN_VALUE(str.size());
     STR_FUN_AFTER(str, str.resize(20, 'x'));
     FUN_VALUE(str.size());
+    STR_FUN_AFTER(str, str.resize_default_init(5));
+    STR_FUN_AFTER(str, str.resize_and_overwrite(64, [](char* p, size_t n) -> size_t {
+        std::fill_n(p + 5, 3, 'y');
+        return n < 8 ? n : 8;
+    }));
+    FUN_VALUE(str.size());
     STR_FUN_AFTER(str, str.clear());
 
     STR_FUN_AFTER(str, str = "string");
@@ -188,6 +259,14 @@ void string_test() {
     std::cout << " \"My \" + str3 : "
               << "My " + str3 << std::endl;
     std::cout << " str3 + str4 : " << str3 + str4 << std::endl;
+
+    // 整个区间的追加、插入、赋值，输入流迭代器只能单趟读取
+    char               ra[] = {'x', 'y', 'z'};
+    std::istringstream sin("abc");
+    STR_FUN_AFTER(str3, str3.append_range(ra));
+    STR_FUN_AFTER(str3, str3.insert_range(str3.begin() + 1, str4));
+    STR_FUN_AFTER(str3, str3.insert(str3.begin(), MySTL::istream_iterator<char>(sin), MySTL::istream_iterator<char>()));
+    STR_FUN_AFTER(str3, str3.assign_range(ra));
     PASSED;
 #if PERFORMANCE_TEST_ON
     std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
@@ -200,6 +279,25 @@ void string_test() {
 #endif
     std::cout << std::endl;
     std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|   read file (MB)    |";
+    {
+        // 测试文件只写一次，各个容器都从头读取所需的长度
+        std::FILE* fp = std::tmpfile();
+        if (fp != nullptr) {
+            std::vector<char> chunk(1 << 20, 'm');
+#if LARGER_TEST_DATA_ON
+            for (int i = 0; i < 1024; ++i)
+                std::fwrite(chunk.data(), 1, chunk.size(), fp);
+            READ_FILE_TEST_ALL(256, 512, 1024);
+#else
+            for (int i = 0; i < 256; ++i)
+                std::fwrite(chunk.data(), 1, chunk.size(), fp);
+            READ_FILE_TEST_ALL(64, 128, 256);
+#endif
+            std::fclose(fp);
+        }
+    }
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
     PASSED;
 #endif
     std::cout << "[----------------- End container test : string -----------------]" << std::endl;
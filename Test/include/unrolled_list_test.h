@@ -0,0 +1,179 @@
+#ifndef MY_UNROLLED_LIST_TEST_H
+#define MY_UNROLLED_LIST_TEST_H
+// 测试 unrolled_list 接口，以及与 list、deque 在中间插入 + 全量遍历混合负载下的比较
+
+// 标准
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "../../src/deque.h"
+#include "../../src/list.h"
+#include "../../src/numeric.h"
+#include "../../src/unrolled_list.h"
+#include "../../src/vector.h"
+
+#include "../test.h"
+
+namespace MySTL {
+
+namespace test {
+
+namespace unrolled_list_test {
+
+// 双向迭代器向后移动 n 步
+template <class Iter>
+Iter step(Iter it, int n) {
+    MySTL::advance(it, n);
+    return it;
+}
+
+// 先放入 len 个 int，之后 100 轮：走到中间连续插入 100 个元素，再遍历求和一次
+#define MIXED_DO_TEST(con, len)                                                              \
+    do {                                                                                     \
+        settle_heap();                                                                       \
+        con c;                                                                               \
+        for (size_t i = 0; i < static_cast<size_t>(len); ++i)                                \
+            c.push_back(static_cast<int>(i));                                                \
+        long long sum = 0;                                                                   \
+        auto      start = std::chrono::steady_clock::now();                                  \
+        for (int round = 0; round < 100; ++round) {                                          \
+            auto it = c.begin();                                                             \
+            MySTL::advance(it, static_cast<long>(c.size() / 2));                             \
+            for (int k = 0; k < 100; ++k) {                                                  \
+                it = c.insert(it, k);                                                        \
+                ++it;                                                                        \
+            }                                                                                \
+            sum += MySTL::accumulate(c.begin(), c.end(), 0LL);                               \
+        }                                                                                    \
+        auto end = std::chrono::steady_clock::now();                                         \
+        volatile long long sink = sum;                                                       \
+        (void)sink;                                                                          \
+        int         n = static_cast<int>(                                                    \
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());     \
+        std::string t = std::to_string(n);                                                   \
+        t += "ms    |";                                                                      \
+        std::cout << std::setw(WIDE) << t;                                                   \
+    } while (0)
+
+#define MIXED_TEST(name, con, len1, len2, len3) \
+    std::cout << name;                          \
+    MIXED_DO_TEST(con, len1);                   \
+    MIXED_DO_TEST(con, len2);                   \
+    MIXED_DO_TEST(con, len3);                   \
+    std::cout << std::endl;
+
+typedef MySTL::list<int>          list_int;
+typedef MySTL::deque<int>         deque_int;
+typedef MySTL::unrolled_list<int> unrolled_list_int;
+
+void unrolled_list_test() {
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[------------- Run container test : unrolled_list --------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    int                       a[] = {1, 2, 3, 4, 5};
+    MySTL::unrolled_list<int> l1;
+    MySTL::unrolled_list<int> l2(5);
+    MySTL::unrolled_list<int> l3(5, 1);
+    MySTL::unrolled_list<int> l4(a, a + 5);
+    MySTL::unrolled_list<int> l5(l2);
+    MySTL::unrolled_list<int> l6(std::move(l2));
+    MySTL::unrolled_list<int> l7{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    MySTL::unrolled_list<int> l8;
+    l8 = l3;
+    MySTL::unrolled_list<int> l9;
+    l9 = std::move(l3);
+    MySTL::unrolled_list<int> l10;
+    l10 = {1, 2, 2, 3, 5, 6, 7, 8, 9};
+
+    CON_FUN_AFTER(l1, l1.assign(8, 8));
+    CON_FUN_AFTER(l1, l1.assign(a, a + 5));
+    CON_FUN_AFTER(l1, l1.assign({1, 2, 3, 4, 5, 6}));
+    CON_FUN_AFTER(l1, l1.insert(l1.end(), 6));
+    CON_FUN_AFTER(l1, l1.insert(step(l1.begin(), 3), 2, 7));
+    CON_FUN_AFTER(l1, l1.insert(l1.begin(), a, a + 5));
+    CON_FUN_AFTER(l1, l1.insert(step(l1.begin(), 2), {10, 11}));
+    CON_FUN_AFTER(l1, l1.push_back(2));
+    CON_FUN_AFTER(l1, l1.push_front(1));
+    CON_FUN_AFTER(l1, l1.emplace(l1.begin(), 1));
+    CON_FUN_AFTER(l1, l1.emplace_front(0));
+    CON_FUN_AFTER(l1, l1.emplace_back(10));
+    FUN_VALUE(l1.size());
+    CON_FUN_AFTER(l1, l1.pop_front());
+    CON_FUN_AFTER(l1, l1.pop_back());
+    CON_FUN_AFTER(l1, l1.erase(l1.begin()));
+    CON_FUN_AFTER(l1, l1.erase(step(l1.begin(), 2), step(l1.begin(), 6)));
+    CON_FUN_AFTER(l1, l1.resize(10));
+    CON_FUN_AFTER(l1, l1.resize(5, 1));
+    CON_FUN_AFTER(l1, l1.resize(8, 2));
+    CON_FUN_AFTER(l1, l1.splice(step(l1.begin(), 2), l4));
+    CON_FUN_AFTER(l1, l1.splice(l1.begin(), l5, l5.begin()));
+    CON_FUN_AFTER(l1, l1.splice(l1.end(), l7, step(l7.begin(), 2), step(l7.begin(), 5)));
+    CON_COUT(l7);
+    CON_FUN_AFTER(l7, l7.splice(l7.begin(), l7, step(l7.begin(), 3), l7.end()));
+    CON_FUN_AFTER(l1, l1.clear());
+    CON_FUN_AFTER(l1, l1.swap(l9));
+    FUN_VALUE(*l1.begin());
+    FUN_VALUE(*l1.rbegin());
+    FUN_VALUE(l1.front());
+    FUN_VALUE(l1.back());
+    std::cout << std::boolalpha;
+    FUN_VALUE(l1.empty());
+    FUN_VALUE((l1 == l8));
+    FUN_VALUE((l1 < l10));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(l1.max_size());
+    FUN_VALUE(MySTL::unrolled_list<int>::node_capacity);
+    FUN_VALUE(sizeof(MySTL::unrolled_list_node<int>));
+
+    // 大量中间插入、删除后与 vector 逐个比较，结点数随元素数增长而不是每个元素一个结点
+    MySTL::unrolled_list<int> lm;
+    MySTL::vector<int>        vm;
+    for (int i = 0; i < 2000; ++i) {
+        size_t k = (static_cast<size_t>(i) * 7919) % (vm.size() + 1);
+        lm.insert(step(lm.begin(), static_cast<int>(k)), i);
+        vm.insert(vm.begin() + k, i);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        size_t k = (static_cast<size_t>(i) * 104729) % vm.size();
+        lm.erase(step(lm.begin(), static_cast<int>(k)));
+        vm.erase(vm.begin() + k);
+    }
+    size_t nodes = 0;
+    for (auto p = lm.begin().node; p != lm.end().node; p = p->next)
+        ++nodes;
+    std::cout << std::boolalpha;
+    FUN_VALUE(MySTL::equal(lm.begin(), lm.end(), vm.begin()));
+    FUN_VALUE((nodes * MySTL::unrolled_list<int>::node_capacity < 4 * lm.size()));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(MySTL::accumulate(lm.begin(), lm.end(), 0LL));
+    FUN_VALUE(MySTL::distance(lm.begin(), MySTL::find(lm.begin(), lm.end(), 1999)));
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| insert mid + scan   |";
+#if LARGER_TEST_DATA_ON
+    TEST_LEN(SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3), WIDE);
+    MIXED_TEST("|     MySTL::list     |", list_int, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    MIXED_TEST("|    MySTL::deque     |", deque_int, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    MIXED_TEST("|MySTL::unrolled_list |", unrolled_list_int, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#else
+    TEST_LEN(SCALE_SS(LEN1), SCALE_SS(LEN2), SCALE_SS(LEN3), WIDE);
+    MIXED_TEST("|     MySTL::list     |", list_int, SCALE_SS(LEN1), SCALE_SS(LEN2), SCALE_SS(LEN3));
+    MIXED_TEST("|    MySTL::deque     |", deque_int, SCALE_SS(LEN1), SCALE_SS(LEN2), SCALE_SS(LEN3));
+    MIXED_TEST("|MySTL::unrolled_list |", unrolled_list_int, SCALE_SS(LEN1), SCALE_SS(LEN2), SCALE_SS(LEN3));
+#endif
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[------------- End container test : unrolled_list --------------]" << std::endl;
+}
+
+} // MySTL::test::unrolled_list_test
+
+} // MySTL::test
+
+} // MySTL
+
+#endif /* MY_UNROLLED_LIST_TEST_H */
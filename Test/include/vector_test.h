@@ -1,14 +1,23 @@
 #ifndef MY_VECTOR_TEST_H 
 #define MY_VECTOR_TEST_H
 
-// 对 vector 容器测试, 和push_back性能
+// 对 vector 容器测试, 和push_back性能(含可平凡重定位的 string 元素, 以及不同扩容策略)
 
 // 标准
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <iostream>
+#include <iterator>
 #include <numeric>
+#include <sstream>
 #include <functional>
+#include <string>
+#include <vector>
 
+#include "../../src/astring.h"
+#include "../../src/deque.h"
+#include "../../src/growth_policy.h"
 #include "../../src/vector.h"
 
 #include "../test.h"
@@ -18,6 +27,138 @@ namespace MySTL {
 namespace test {
 
 namespace vector_test {
+
+// 累计申请的字节数，用于比较不同扩容策略重新分配的总量
+static size_t grow_alloc_bytes = 0;
+
+template <class T>
+class grow_counting_allocator {
+public:
+    typedef T         value_type;
+    typedef size_t    size_type;
+    typedef ptrdiff_t difference_type;
+
+    grow_counting_allocator() noexcept = default;
+
+    template <class U>
+    grow_counting_allocator(const grow_counting_allocator<U>&) noexcept {}
+
+    T* allocate(size_type n) {
+        grow_alloc_bytes += n * sizeof(T);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_type) { ::operator delete(ptr); }
+};
+
+template <class T, class U>
+bool operator==(const grow_counting_allocator<T>&, const grow_counting_allocator<U>&) noexcept { return true; }
+
+template <class T, class U>
+bool operator!=(const grow_counting_allocator<T>&, const grow_counting_allocator<U>&) noexcept { return false; }
+
+// push_back 到 len 个元素，单元格中显示 墙上时间/累计申请的字节数
+#define GROWTH_DO_TEST(growth, len)                                                      \
+    do {                                                                                 \
+        char buf[16];                                                                    \
+        grow_alloc_bytes = 0;                                                            \
+        auto start = std::chrono::steady_clock::now();                                   \
+        {                                                                                \
+            MySTL::vector<int, grow_counting_allocator<int>, growth> v;                  \
+            for (size_t i = 0; i < static_cast<size_t>(len); ++i)                        \
+                v.push_back(static_cast<int>(i));                                        \
+        }                                                                                \
+        auto end = std::chrono::steady_clock::now();                                     \
+        int  n = static_cast<int>(                                                       \
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()); \
+        int  mb = static_cast<int>(grow_alloc_bytes >> 20);                              \
+        std::snprintf(buf, sizeof(buf), "%dms/%dMB", n, mb);                             \
+        std::string t = buf;                                                             \
+        t += "|";                                                                        \
+        std::cout << std::setw(WIDE) << t;                                               \
+    } while (0)
+
+#define GROWTH_TEST(name, growth, len1, len2, len3) \
+    std::cout << name;                              \
+    GROWTH_DO_TEST(growth, len1);                   \
+    GROWTH_DO_TEST(growth, len2);                   \
+    GROWTH_DO_TEST(growth, len3);                   \
+    std::cout << std::endl;
+
+// 在 len 位的 vector<bool> 上重复 count 和 find 共 BIT_ALGO_ROUNDS 次，单元格中显示耗时
+// 最后一位为 1，find 需要扫描整个区间
+enum { BIT_ALGO_ROUNDS = 20 };
+
+#define BIT_ALGO_DO_TEST(con, ns, len)                                                   \
+    do {                                                                                 \
+        char   buf[16];                                                                  \
+        con    v(static_cast<size_t>(len), false);                                       \
+        size_t sum = 0;                                                                  \
+        v[v.size() - 1] = true;                                                          \
+        auto start = std::chrono::steady_clock::now();                                   \
+        for (int r = 0; r < BIT_ALGO_ROUNDS; ++r) {                                      \
+            v[static_cast<size_t>(r)] = (r & 1) != 0;                                    \
+            sum += static_cast<size_t>(ns::count(v.begin(), v.end(), true));             \
+            sum += static_cast<size_t>(ns::find(v.begin(), v.end(), true) - v.begin());  \
+        }                                                                                \
+        auto end = std::chrono::steady_clock::now();                                     \
+        int  n = static_cast<int>(                                                       \
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()); \
+        std::snprintf(buf, sizeof(buf), "%dms", sum == 0 ? -1 : n);                      \
+        std::string t = buf;                                                             \
+        t += "|";                                                                        \
+        std::cout << std::setw(WIDE) << t;                                               \
+    } while (0)
+
+#define BIT_ALGO_TEST(name, con, ns, len1, len2, len3) \
+    std::cout << name;                                 \
+    BIT_ALGO_DO_TEST(con, ns, len1);                   \
+    BIT_ALGO_DO_TEST(con, ns, len2);                   \
+    BIT_ALGO_DO_TEST(con, ns, len3);                   \
+    std::cout << std::endl;
+
+// 把 len 个整数读入容器，单元格中显示 从输入流读取的耗时/从数组复制的耗时
+// 输入流用 con::insert(end, istream_iterator, istream_iterator)，数组用 append_range 或 insert(end, first, last)
+#define INGEST_DO_TEST(con, ns, len, array_append)                                                    \
+    do {                                                                                              \
+        char               buf[24];                                                                   \
+        std::ostringstream os;                                                                        \
+        MySTL::vector<int> src(static_cast<size_t>(len));                                             \
+        for (size_t i = 0; i < static_cast<size_t>(len); ++i) {                                       \
+            src[i] = static_cast<int>(i);                                                             \
+            os << i << ' ';                                                                           \
+        }                                                                                             \
+        std::istringstream is(os.str());                                                              \
+        auto               t0 = std::chrono::steady_clock::now();                                     \
+        {                                                                                             \
+            con c;                                                                                    \
+            c.insert(c.end(), ns::istream_iterator<int>(is), ns::istream_iterator<int>());            \
+        }                                                                                             \
+        auto t1 = std::chrono::steady_clock::now();                                                   \
+        {                                                                                             \
+            con c;                                                                                    \
+            array_append;                                                                             \
+        }                                                                                             \
+        auto t2 = std::chrono::steady_clock::now();                                                   \
+        int  n1 = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count()); \
+        int  n2 = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count()); \
+        std::snprintf(buf, sizeof(buf), "%dms/%dms", n1, n2);                                         \
+        std::string t = buf;                                                                          \
+        t += "|";                                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                            \
+    } while (0)
+
+#define INGEST_TEST(name, con, ns, array_append, len1, len2, len3) \
+    std::cout << name;                                              \
+    INGEST_DO_TEST(con, ns, len1, array_append);                    \
+    INGEST_DO_TEST(con, ns, len2, array_append);                    \
+    INGEST_DO_TEST(con, ns, len3, array_append);                    \
+    std::cout << std::endl;
+
+// 宏参数中不能出现逗号
+typedef MySTL::page_growth<>     page_growth_default;
+typedef MySTL::additive_growth<> additive_growth_default;
+
 void vector_test() {
     std::cout << "[===============================================================]\n";
     std::cout << "[----------------- Run container test : vector -----------------]\n";
@@ -96,6 +237,83 @@ void vector_test() {
     CON_FUN_AFTER(v1, v1.shrink_to_fit());
     FUN_VALUE(v1.size());
     FUN_VALUE(v1.capacity());
+    CON_FUN_AFTER(v1, v1.resize_and_overwrite(40, [](int* p, size_t n) -> size_t {
+        std::iota(p, p + n / 4, 0);
+        return n / 4;
+    }));
+    CON_FUN_AFTER(v1, v1.resize_default_init(5));
+    FUN_VALUE(v1.size());
+    FUN_VALUE(v1.capacity());
+
+    // 扩容策略决定 push_back 时的新容量
+    MySTL::vector<int, MySTL::allocator<int>, MySTL::exact_growth>  g1;
+    MySTL::vector<int, MySTL::allocator<int>, MySTL::double_growth> g2;
+    MySTL::vector<int, MySTL::allocator<int>, page_growth_default>  g3;
+    for (int i = 0; i < 20; ++i) {
+        g1.push_back(i);
+        g2.push_back(i);
+        g3.push_back(i);
+    }
+    FUN_VALUE(g1.capacity());
+    FUN_VALUE(g2.capacity());
+    FUN_VALUE(g3.capacity());
+    FUN_VALUE((MySTL::golden_growth::next_capacity(800, 801, sizeof(int))));
+    MySTL::basic_string<char, MySTL::char_traits<char>, MySTL::allocator<char>, MySTL::exact_growth> gs("growth");
+    STR_FUN_AFTER(gs, gs.append(" policy"));
+    FUN_VALUE(gs.capacity());
+
+    // 元素可平凡重定位时扩容直接 memcpy，否则逐个移动
+    std::cout << std::boolalpha;
+    FUN_VALUE(MySTL::is_trivially_relocatable<MySTL::string>::value);
+    FUN_VALUE(MySTL::is_trivially_relocatable<MySTL::vector<MySTL::string>>::value);
+    std::cout << std::noboolalpha;
+    MySTL::vector<MySTL::string> vs1;
+    MySTL::vector<std::string>   vs2;
+    for (int i = 0; i < 20; ++i) {
+        vs1.emplace_back(static_cast<size_t>(i % 5 + 1), static_cast<char>('a' + i));
+        vs2.emplace_back(static_cast<size_t>(i % 5 + 1), static_cast<char>('a' + i));
+    }
+    vs1.insert(vs1.begin() + 1, 20, MySTL::string("x"));
+    vs2.insert(vs2.begin() + 1, 20, std::string("x"));
+    CON_FUN_AFTER(vs1, vs1.shrink_to_fit());
+    CON_FUN_AFTER(vs2, vs2.shrink_to_fit());
+
+    // 整个区间的追加、插入、赋值，输入流迭代器只能单趟读取
+    int                ra[] = {1, 2, 3};
+    MySTL::vector<int> r1;
+    std::istringstream vin("7 8 9");
+    CON_FUN_AFTER(r1, r1.append_range(ra));
+    CON_FUN_AFTER(r1, r1.insert_range(r1.begin() + 1, ra));
+    CON_FUN_AFTER(r1, r1.insert(r1.begin() + 2, MySTL::istream_iterator<int>(vin), MySTL::istream_iterator<int>()));
+    CON_FUN_AFTER(r1, r1.assign_range(MySTL::vector<int>(4, 4)));
+    FUN_VALUE(r1.capacity());
+
+    // vector<bool> 按位存储，count / find / fill / copy / equal 按字处理
+    MySTL::vector<bool> b1;
+    MySTL::vector<bool> b2(70, true);
+    MySTL::vector<bool> b3{true, false, true, true};
+    for (int i = 0; i < 100; ++i)
+        b1.push_back(i % 3 == 0);
+    FUN_VALUE(b1.size());
+    FUN_VALUE(b1.capacity());
+    FUN_VALUE(MySTL::count(b1.begin(), b1.end(), true));
+    FUN_VALUE(MySTL::count(b2.cbegin() + 3, b2.cend() - 1, false));
+    FUN_VALUE((MySTL::find(b1.begin() + 1, b1.end(), true) - b1.begin()));
+    FUN_VALUE((MySTL::find(b2.begin(), b2.end(), false) - b2.begin()));
+    CON_FUN_AFTER(b3, b3.insert(b3.begin() + 1, 3, false));
+    CON_FUN_AFTER(b3, b3.insert(b3.end(), b3.begin(), b3.begin() + 4));
+    CON_FUN_AFTER(b3, b3.erase(b3.begin(), b3.begin() + 2));
+    CON_FUN_AFTER(b3, b3.flip());
+    CON_FUN_AFTER(b3, b3[0].flip());
+    CON_FUN_AFTER(b3, MySTL::sort(b3.begin(), b3.end()));
+    CON_FUN_AFTER(b3, b3.resize(12, true));
+    CON_FUN_AFTER(b2, MySTL::fill(b2.begin() + 5, b2.begin() + 67, false));
+    CON_FUN_AFTER(b2, MySTL::copy(b3.begin(), b3.end(), b2.begin() + 60));
+    std::cout << std::boolalpha;
+    FUN_VALUE(MySTL::equal(b3.begin(), b3.end(), b2.cbegin() + 60));
+    FUN_VALUE((b2 == MySTL::vector<bool>(b2)));
+    FUN_VALUE((b3 < b2));
+    std::cout << std::noboolalpha;
     PASSED;
 
 #if PERFORMANCE_TEST_ON
@@ -108,6 +326,44 @@ void vector_test() {
     CON_TEST_P1(vector<int>, push_back, rand(), SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
 #endif
     std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  push_back(string)  |";
+#if LARGER_TEST_DATA_ON
+    CON_TEST_P1(vector<MySTL::string>, push_back, MySTL::string("relocate"), SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    CON_TEST_P1(vector<MySTL::string>, push_back, MySTL::string("relocate"), SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|   growth policy     |";
+    TEST_LEN(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3), WIDE);
+    GROWTH_TEST("|    default 1.5x     |", MySTL::default_growth, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    GROWTH_TEST("|    golden 1.618x    |", MySTL::golden_growth, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    GROWTH_TEST("|      double 2x      |", MySTL::double_growth, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    GROWTH_TEST("|    page rounded     |", page_growth_default, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    GROWTH_TEST("|    additive 1MB     |", additive_growth_default, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  ingest stream/array|";
+    TEST_LEN(SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3), WIDE);
+    INGEST_TEST("|     std::vector     |", std::vector<int>, std, c.insert(c.end(), src.begin(), src.end()),
+                SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    INGEST_TEST("| vector push_back    |", MySTL::vector<int>, MySTL, for (int x : src) c.push_back(x),
+                SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    INGEST_TEST("| vector append_range |", MySTL::vector<int>, MySTL, c.append_range(src),
+                SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    INGEST_TEST("| deque append_range  |", MySTL::deque<int>, MySTL, c.append_range(src),
+                SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| vector<bool> count  |";
+#if LARGER_TEST_DATA_ON
+    TEST_LEN(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3), WIDE);
+    BIT_ALGO_TEST("|         std         |", std::vector<bool>, std, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+    BIT_ALGO_TEST("|        MySTL        |", MySTL::vector<bool>, MySTL, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+    TEST_LEN(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3), WIDE);
+    BIT_ALGO_TEST("|         std         |", std::vector<bool>, std, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    BIT_ALGO_TEST("|        MySTL        |", MySTL::vector<bool>, MySTL, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
     std::cout << "|---------------------|-------------|-------------|-------------|\n";
     PASSED;
 #endif
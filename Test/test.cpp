@@ -2,13 +2,22 @@
 #include "include/algorithm_test.h"
 #include "include/algorithm_performance.h"
 #include "include/vector_test.h"
+#include "include/small_vector_test.h"
+#include "include/static_vector_test.h"
+#include "include/stable_vector_test.h"
 #include "include/deque_test.h"
 #include "include/queue_test.h"
+#include "include/spsc_queue_test.h"
 #include "include/stack_test.h"
 #include "include/list_test.h"
+#include "include/intrusive_test.h"
+#include "include/forward_list_test.h"
+#include "include/unrolled_list_test.h"
 #include "include/string_test.h"
 #include "include/map_test.h"
 #include "include/set_test.h"
+#include "include/allocator_test.h"
+#include "include/memory_test.h"
 
 int main() {
 
@@ -18,14 +27,23 @@ int main() {
     RUN_ALL_TESTS();
     algorithm_performance::algorithm_performance_test();
     vector_test::vector_test();
+    small_vector_test::small_vector_test();
+    static_vector_test::static_vector_test();
+    stable_vector_test::stable_vector_test();
     deque_test::deque_test();
     queue_test::queue_test();
     queue_test::priority_queue_test();
+    spsc_queue_test::spsc_queue_test();
     stack_test::stack_test();
     list_test::list_test();
+    intrusive_test::intrusive_test();
+    forward_list_test::forward_list_test();
+    unrolled_list_test::unrolled_list_test();
     string_test::string_test();
     map_test::map_test();
     map_test::multimap_test();
     set_test::set_test();
     set_test::multiset_test();
+    allocator_test::allocator_test();
+    memory_test::memory_test();
 }
\ No newline at end of file
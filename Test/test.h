@@ -9,6 +9,9 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 
 #include "lib/redbud/io/color.h"
 
@@ -610,6 +613,15 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide)
   std::cout << std::setw(wide) << str3 << "\n";
 }
 
+// 把上一次测试释放的大量小块合并并还给系统
+// 否则之后第一次较大的 malloc 要先为合并这些碎块付出时间(glibc)，算到下一次测试头上
+inline void settle_heap()
+{
+#if defined(__GLIBC__)
+  malloc_trim(0);
+#endif
+}
+
 // 输出测试数量级
 #define TEST_LEN(len1, len2, len3, wide) \
   test_len(len1, len2, len3, wide)
@@ -650,17 +662,21 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide)
         std::cout << std::setw(WIDE) << t;                                                  \
     } while (0)
 
-#define LIST_SORT_DO_TEST(mode, count)                                                      \
+// fun 为 sort 或 inplace_sort(只有 MySTL::list 提供，不使用临时缓冲区)
+#define LIST_SORT_DO_TEST(mode, fun, count)                                                 \
     do {                                                                                    \
         srand((int)time(0));                                                                \
         clock_t         start, end;                                                         \
-        mode::list<int> l;                                                                  \
         char            buf[10];                                                            \
-        for (size_t i = 0; i < count; ++i)                                                  \
-            l.insert(l.end(), rand());                                                      \
-        start = clock();                                                                    \
-        l.sort();                                                                           \
-        end = clock();                                                                      \
+        {                                                                                   \
+            mode::list<int> l;                                                              \
+            for (size_t i = 0; i < count; ++i)                                              \
+                l.insert(l.end(), rand());                                                  \
+            start = clock();                                                                \
+            l.fun();                                                                        \
+            end = clock();                                                                  \
+        }                                                                                   \
+        settle_heap();                                                                      \
         int n = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
         std::snprintf(buf, sizeof(buf), "%d", n);                                           \
         std::string t = buf;                                                                \
@@ -719,16 +735,20 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide)
     MAP_EMPLACE_DO_TEST(MySTL, con, len2);      \
     MAP_EMPLACE_DO_TEST(MySTL, con, len3);
 
-#define LIST_SORT_TEST(len1, len2, len3)      \
-    TEST_LEN(len1, len2, len3, WIDE);         \
-    std::cout << "|         std         |";   \
-    LIST_SORT_DO_TEST(std, len1);             \
-    LIST_SORT_DO_TEST(std, len2);             \
-    LIST_SORT_DO_TEST(std, len3);             \
-    std::cout << "\n|        MySTL        |"; \
-    LIST_SORT_DO_TEST(MySTL, len1);           \
-    LIST_SORT_DO_TEST(MySTL, len2);           \
-    LIST_SORT_DO_TEST(MySTL, len3);
+#define LIST_SORT_TEST(len1, len2, len3)         \
+    TEST_LEN(len1, len2, len3, WIDE);            \
+    std::cout << "|         std         |";      \
+    LIST_SORT_DO_TEST(std, sort, len1);          \
+    LIST_SORT_DO_TEST(std, sort, len2);          \
+    LIST_SORT_DO_TEST(std, sort, len3);          \
+    std::cout << "\n|    MySTL inplace    |";    \
+    LIST_SORT_DO_TEST(MySTL, inplace_sort, len1); \
+    LIST_SORT_DO_TEST(MySTL, inplace_sort, len2); \
+    LIST_SORT_DO_TEST(MySTL, inplace_sort, len3); \
+    std::cout << "\n|    MySTL buffered   |";    \
+    LIST_SORT_DO_TEST(MySTL, sort, len1);        \
+    LIST_SORT_DO_TEST(MySTL, sort, len2);        \
+    LIST_SORT_DO_TEST(MySTL, sort, len3);
 
 // 简单测试的宏定义
 #define TEST(testcase_name) \
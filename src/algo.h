@@ -55,12 +55,31 @@ bool none_of(InputIter first, InputIter last, UnaryPredicate unary_pred) {
  * @note f() 可返回一个值，但该值会被忽略
  */
 template <class InputIter, class Function>
-Function for_each(InputIter first, InputIter last, Function f) {
+Function unchecked_for_each(InputIter first, InputIter last, Function f, m_false_type) {
     for (; first != last; first++)
         f(*first);
     return f;
 }
 
+// 分段迭代器逐段遍历，段内是指针循环
+template <class SegIter, class Function>
+Function unchecked_for_each(SegIter first, SegIter last, Function f, m_true_type) {
+    typedef segmented_iterator_traits<SegIter> traits;
+    auto sfirst = traits::segment(first);
+    auto slast = traits::segment(last);
+    if (sfirst == slast)
+        return unchecked_for_each(traits::local(first), traits::local(last), f, m_false_type());
+    f = unchecked_for_each(traits::local(first), traits::end(sfirst), f, m_false_type());
+    for (++sfirst; sfirst != slast; ++sfirst)
+        f = unchecked_for_each(traits::begin(sfirst), traits::end(sfirst), f, m_false_type());
+    return unchecked_for_each(traits::begin(slast), traits::local(last), f, m_false_type());
+}
+
+template <class InputIter, class Function>
+Function for_each(InputIter first, InputIter last, Function f) {
+    return unchecked_for_each(first, last, f, m_bool_constant<is_segmented_iterator<InputIter>::value>());
+}
+
 /**
  * @brief 对[first, last)区间内的元素与给定值进行比较，缺省使用 operator==
  * @return 返回元素相等的个数
@@ -93,12 +112,40 @@ size_t count_if(InputIter first, InputIter last, UnaryPredicate unary_pred) {
  * @brief 在[first, last)区间内找到等于 value 的元素，返回指向该元素的迭代器
  */
 template <class InputIter, class T>
-InputIter find(InputIter first, InputIter last, const T& value) {
+InputIter unchecked_find(InputIter first, InputIter last, const T& value, m_false_type) {
     while (first != last && *first != value)
         ++first;
     return first;
 }
 
+// 分段迭代器逐段查找，找到后再组合回原迭代器
+template <class SegIter, class T>
+SegIter unchecked_find(SegIter first, SegIter last, const T& value, m_true_type) {
+    typedef segmented_iterator_traits<SegIter> traits;
+    if (first == last)
+        return last;
+    auto sfirst = traits::segment(first);
+    auto slast = traits::segment(last);
+    if (sfirst == slast)
+        return traits::compose(sfirst, unchecked_find(traits::local(first), traits::local(last), value, m_false_type()));
+    auto lend = traits::end(sfirst);
+    auto pos = unchecked_find(traits::local(first), lend, value, m_false_type());
+    if (pos != lend)
+        return traits::compose(sfirst, pos);
+    for (++sfirst; sfirst != slast; ++sfirst) {
+        lend = traits::end(sfirst);
+        pos = unchecked_find(traits::begin(sfirst), lend, value, m_false_type());
+        if (pos != lend)
+            return traits::compose(sfirst, pos);
+    }
+    return traits::compose(slast, unchecked_find(traits::begin(slast), traits::local(last), value, m_false_type()));
+}
+
+template <class InputIter, class T>
+InputIter find(InputIter first, InputIter last, const T& value) {
+    return unchecked_find(first, last, value, m_bool_constant<is_segmented_iterator<InputIter>::value>());
+}
+
 /**
  * @brief 在[first, last)区间内找到第一个令一元操作 unary_pred 为 true 的元素并返回指向该元素的迭代器
  */
@@ -1379,7 +1426,7 @@ rotate_dispatch(RandIter first, RandIter mid, RandIter last, random_access_itera
     }
     auto cycle_times = rgcd(n, l);
     for (auto i = 0; i < cycle_times; i++) {
-        auto tmp = *first;
+        typename iterator_traits<RandIter>::value_type tmp = *first;
         auto p = first;
         if (l < r) {
             for (auto j = 0; j < r / cycle_times; j++) {
@@ -1884,6 +1931,7 @@ void merge_adaptive(BidrectionalIter first, BidrectionalIter middle,
     }
 }
 
+// 缓冲区取自当前线程的 scratch_arena，循环合并时反复复用同一块内存
 template <class BidrectionalIter, class T>
 void inplace_merge_aux(BidrectionalIter first, BidrectionalIter middle, BidrectionalIter last, T*) {
     auto len1 = MySTL::distance(first, middle);
@@ -1930,6 +1978,36 @@ void inplace_merge(BidrectionalIter first, BidrectionalIter middle, Bidrectional
     MySTL::inplace_merge_aux(first, middle, last, value_type(first), cmp);
 }
 
+/**
+ * @brief inplace_merge 的重载版本，使用调用者提供的缓冲区 [buffer, buffer + buffer_size)
+ * @note 缓冲区中的元素必须已经构造(例如一个反复使用的 vector)，合并过程中不再申请内存，
+ * 缓冲区不足时对放不下的部分退化为分治合并
+ */
+template <class BidrectionalIter, class Pointer, class Distance>
+void inplace_merge(BidrectionalIter first, BidrectionalIter middle, BidrectionalIter last,
+                   Pointer buffer, Distance buffer_size) {
+    if (first == middle || middle == last)
+        return;
+    auto len1 = MySTL::distance(first, middle);
+    auto len2 = MySTL::distance(middle, last);
+    MySTL::merge_adaptive(first, middle, last, len1, len2, buffer,
+                          static_cast<decltype(len1)>(buffer_size));
+}
+
+/**
+ * @brief 使用调用者提供的缓冲区的重载版本，使用函数对象 cmp 代替比较操作
+ */
+template <class BidrectionalIter, class Pointer, class Distance, class Compare>
+void inplace_merge(BidrectionalIter first, BidrectionalIter middle, BidrectionalIter last,
+                   Pointer buffer, Distance buffer_size, Compare cmp) {
+    if (first == middle || middle == last)
+        return;
+    auto len1 = MySTL::distance(first, middle);
+    auto len2 = MySTL::distance(middle, last);
+    MySTL::merge_adaptive(first, middle, last, len1, len2, buffer,
+                          static_cast<decltype(len1)>(buffer_size), cmp);
+}
+
 /********************************************* 排序操作 ********************************************/
 
 /*****************************************************************************************/
@@ -2170,30 +2248,30 @@ void intro_sort(RandomIter first, RandomIter last,
     }
 }
 
-// 插入排序的辅助函数
+// 插入排序的辅助函数，value 已从原位置移出，元素逐个向后移动
 template <class RandomIter, class T>
-void unchecked_linear_insert(RandomIter last, const T& value) {
+void unchecked_linear_insert(RandomIter last, T& value) {
     auto next = last;
     --next;
     while (value < *next) {
-        *last = *next;
+        *last = MySTL::move(*next);
         last = next;
         --next;
     }
-    *last = value;
+    *last = MySTL::move(value);
 }
 
 // 插入排序的辅助函数 unchecked_linear_insert 的重载版本
 template <class RandomIter, class T, class Compare>
-void unchecked_linear_insert(RandomIter last, const T& value, Compare cmp) {
+void unchecked_linear_insert(RandomIter last, T& value, Compare cmp) {
     auto next = last;
     --next;
     while (cmp(value, *next)) {
-        *last = *next;
+        *last = MySTL::move(*next);
         last = next;
         --next;
     }
-    *last = value;
+    *last = MySTL::move(value);
 }
 
 // 插入排序
@@ -2202,10 +2280,10 @@ void insertion_sort(RandomIter first, RandomIter last) {
     if (first == last)
         return;
     for (auto i = first + 1; i != last; ++i) {
-        auto value = *i;
+        typename iterator_traits<RandomIter>::value_type value = MySTL::move(*i);
         if (value < *first) {
-            MySTL::copy_backward(first, i, i + 1);
-            *first = value;
+            MySTL::move_backward(first, i, i + 1);
+            *first = MySTL::move(value);
         } else {
             MySTL::unchecked_linear_insert(i, value);
         }
@@ -2218,10 +2296,10 @@ void insertion_sort(RandomIter first, RandomIter last, Compare cmp) {
     if (first == last)
         return;
     for (auto i = first + 1; i != last; ++i) {
-        auto value = *i;
+        typename iterator_traits<RandomIter>::value_type value = MySTL::move(*i);
         if (cmp(value, *first)) {
-            MySTL::copy_backward(first, i, i + 1);
-            *first = value;
+            MySTL::move_backward(first, i, i + 1);
+            *first = MySTL::move(value);
         } else {
             MySTL::unchecked_linear_insert(i, value, cmp);
         }
@@ -2232,7 +2310,8 @@ void insertion_sort(RandomIter first, RandomIter last, Compare cmp) {
 template <class RandomIter>
 void unchecked_insertion_sort(RandomIter first, RandomIter last) {
     for (auto i = first; i != last; i++) {
-        MySTL::unchecked_linear_insert(i, *i);
+        typename iterator_traits<RandomIter>::value_type value = MySTL::move(*i);  // 先移出，*i 的位置会被覆盖
+        MySTL::unchecked_linear_insert(i, value);
     }
 }
 
@@ -2240,7 +2319,8 @@ void unchecked_insertion_sort(RandomIter first, RandomIter last) {
 template <class RandomIter, class Compare>
 void unchecked_insertion_sort(RandomIter first, RandomIter last, Compare cmp) {
     for (auto i = first; i != last; i++) {
-        MySTL::unchecked_linear_insert(i, *i, cmp);
+        typename iterator_traits<RandomIter>::value_type value = MySTL::move(*i);
+        MySTL::unchecked_linear_insert(i, value, cmp);
     }
 }
 
@@ -10,9 +10,11 @@
 // "equal"
 // "fill_n", "fill"
 // "lexicographical_compare" * , "mismatch" *
+// 上述复制、移动、填充算法遇到分段迭代器(见 segmented_iterator_traits)时逐段处理
 // 
 
 #include <cstring>
+#include <type_traits>
 
 #include "iterator.h"
 #include "util.h"
@@ -34,9 +36,142 @@ template <class T, class Compare>
 const T& min(const T& lhs, const T& rhs, Compare cmp) { return cmp(lhs, rhs) ? rhs : lhs; }
 
 // swap the data of two iterator
+// 解引用得到左值引用时直接交换；得到代理对象时(如 bit_vector.h 的 bit_reference)
+// 以不限定的名字调用 swap，由实参相关查找找到代理类型自己的 swap
+template <class Ref1, class Ref2>
+void iter_swap_aux(Ref1&& lhs, Ref2&& rhs, std::true_type) {
+    MySTL::swap(lhs, rhs);
+}
+
+template <class Ref1, class Ref2>
+void iter_swap_aux(Ref1&& lhs, Ref2&& rhs, std::false_type) {
+    swap(MySTL::forward<Ref1>(lhs), MySTL::forward<Ref2>(rhs));
+}
+
 template <class Iter1, class Iter2>
 void iter_swap(Iter1 lhs, Iter2 rhs) {
-    MySTL::swap(*lhs, *rhs);
+    MySTL::iter_swap_aux(*lhs, *rhs,
+                         std::integral_constant<bool, std::is_lvalue_reference<decltype(*lhs)>::value &&
+                                                          std::is_lvalue_reference<decltype(*rhs)>::value>());
+}
+
+/*****************************************************************************************/
+// 分段迭代器上的复制与移动
+// 输入是分段迭代器时逐段处理；输出是分段迭代器且输入可以随机访问时，按输出的段切分
+// 段内都是指针区间，Op::apply 落到 unchecked_copy 等函数的指针版本，可平凡复制的类型直接 memmove
+/*****************************************************************************************/
+template <class Op, class InputIter, class OutputIter>
+OutputIter segmented_forward_out(InputIter first, InputIter last, OutputIter result, m_false_type) {
+    return Op::apply(first, last, result);
+}
+
+template <class Op, class RandIter, class SegIter>
+SegIter segmented_forward_out(RandIter first, RandIter last, SegIter result, m_true_type) {
+    typedef segmented_iterator_traits<SegIter> traits;
+    auto n = last - first;
+    if (n <= 0)
+        return result;
+    auto seg = traits::segment(result);
+    auto cur = traits::local(result);
+    while (true) {
+        const auto room = traits::end(seg) - cur;
+        if (n <= room) {
+            cur = Op::apply(first, first + n, cur);
+            break;
+        }
+        Op::apply(first, first + room, cur);
+        first += room;
+        n -= room;
+        ++seg;
+        cur = traits::begin(seg);
+    }
+    return traits::compose(seg, cur);
+}
+
+template <class Op, class InputIter, class OutputIter>
+OutputIter segmented_forward_in(InputIter first, InputIter last, OutputIter result, m_false_type) {
+    return segmented_forward_out<Op>(first, last, result,
+                                     m_bool_constant<is_segmented_iterator<OutputIter>::value &&
+                                                     is_random_access_iterator<InputIter>::value>());
+}
+
+template <class Op, class SegIter, class OutputIter>
+OutputIter segmented_forward_in(SegIter first, SegIter last, OutputIter result, m_true_type) {
+    typedef segmented_iterator_traits<SegIter>                          traits;
+    typedef m_bool_constant<is_segmented_iterator<OutputIter>::value> out_segmented;
+    auto sfirst = traits::segment(first);
+    auto slast = traits::segment(last);
+    if (sfirst == slast)
+        return segmented_forward_out<Op>(traits::local(first), traits::local(last), result, out_segmented());
+    result = segmented_forward_out<Op>(traits::local(first), traits::end(sfirst), result, out_segmented());
+    for (++sfirst; sfirst != slast; ++sfirst)
+        result = segmented_forward_out<Op>(traits::begin(sfirst), traits::end(sfirst), result, out_segmented());
+    return segmented_forward_out<Op>(traits::begin(slast), traits::local(last), result, out_segmented());
+}
+
+template <class Op, class InputIter, class OutputIter>
+OutputIter segmented_forward(InputIter first, InputIter last, OutputIter result) {
+    return segmented_forward_in<Op>(first, last, result,
+                                    m_bool_constant<is_segmented_iterator<InputIter>::value>());
+}
+
+// 从尾部向前处理，result 为目标区间的尾后位置
+template <class Op, class BidirectionalIter1, class BidirectionalIter2>
+BidirectionalIter2 segmented_backward_out(BidirectionalIter1 first, BidirectionalIter1 last,
+                                          BidirectionalIter2 result, m_false_type) {
+    return Op::apply(first, last, result);
+}
+
+template <class Op, class RandIter, class SegIter>
+SegIter segmented_backward_out(RandIter first, RandIter last, SegIter result, m_true_type) {
+    typedef segmented_iterator_traits<SegIter> traits;
+    auto n = last - first;
+    if (n <= 0)
+        return result;
+    auto seg = traits::segment(result);
+    auto cur = traits::local(result);
+    while (true) {
+        const auto room = cur - traits::begin(seg);
+        if (n <= room) {
+            cur = Op::apply(last - n, last, cur);
+            break;
+        }
+        Op::apply(last - room, last, cur);
+        last -= room;
+        n -= room;
+        --seg;
+        cur = traits::end(seg);
+    }
+    return traits::compose(seg, cur);
+}
+
+template <class Op, class BidirectionalIter1, class BidirectionalIter2>
+BidirectionalIter2 segmented_backward_in(BidirectionalIter1 first, BidirectionalIter1 last,
+                                         BidirectionalIter2 result, m_false_type) {
+    return segmented_backward_out<Op>(first, last, result,
+                                      m_bool_constant<is_segmented_iterator<BidirectionalIter2>::value &&
+                                                      is_random_access_iterator<BidirectionalIter1>::value>());
+}
+
+template <class Op, class SegIter, class BidirectionalIter>
+BidirectionalIter segmented_backward_in(SegIter first, SegIter last, BidirectionalIter result, m_true_type) {
+    typedef segmented_iterator_traits<SegIter>                                 traits;
+    typedef m_bool_constant<is_segmented_iterator<BidirectionalIter>::value> out_segmented;
+    auto sfirst = traits::segment(first);
+    auto slast = traits::segment(last);
+    if (sfirst == slast)
+        return segmented_backward_out<Op>(traits::local(first), traits::local(last), result, out_segmented());
+    result = segmented_backward_out<Op>(traits::begin(slast), traits::local(last), result, out_segmented());
+    for (--slast; slast != sfirst; --slast)
+        result = segmented_backward_out<Op>(traits::begin(slast), traits::end(slast), result, out_segmented());
+    return segmented_backward_out<Op>(traits::local(first), traits::end(sfirst), result, out_segmented());
+}
+
+template <class Op, class BidirectionalIter1, class BidirectionalIter2>
+BidirectionalIter2 segmented_backward(BidirectionalIter1 first, BidirectionalIter1 last,
+                                      BidirectionalIter2 result) {
+    return segmented_backward_in<Op>(first, last, result,
+                                     m_bool_constant<is_segmented_iterator<BidirectionalIter1>::value>());
 }
 
 /*****************************************************************************************/
@@ -67,11 +202,11 @@ OutputIter unchecked_copy(InputIter first, InputIter last,
     return unchecked_copy_cat(first, last, result, iterator_category(first));
 }
 
-// copy() 为 trivially_copy_assignable类型提供的特化版本
+// copy() 为 trivially_copyable 类型提供的特化版本
 template <class Tp, class Up>
 typename std::enable_if<
     std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
-        std::is_trivially_copy_assignable<Up>::value,
+        std::is_trivially_copyable<Up>::value && std::is_trivially_copy_assignable<Up>::value,
     Up*>::type
 unchecked_copy(Tp* first, Tp* last,
                Up* result) {
@@ -81,6 +216,13 @@ unchecked_copy(Tp* first, Tp* last,
     return result + n;
 }
 
+struct copy_op {
+    template <class InputIter, class OutputIter>
+    static OutputIter apply(InputIter first, InputIter last, OutputIter result) {
+        return unchecked_copy(first, last, result);
+    }
+};
+
 /**
  * @brief copy form [first, last) to [result, result + (last - first))
  * @return 返回拷贝结束的尾部(dst 尾部)
@@ -88,7 +230,7 @@ unchecked_copy(Tp* first, Tp* last,
 template <class InputIter, class OutputIter>
 OutputIter copy(InputIter first, InputIter last,
                 OutputIter result) {
-    return unchecked_copy(first, last, result);
+    return segmented_forward<copy_op>(first, last, result);
 }
 
 /*****************************************************************************************/
@@ -99,7 +241,7 @@ OutputIter copy(InputIter first, InputIter last,
 template <class BidirectionalIter1, class BidirectionalIter2>
 BidirectionalIter2 unchecked_copy_backward_cat(BidirectionalIter1 first, BidirectionalIter1 last,
                                                BidirectionalIter2 result, MySTL::bidirectional_iterator_tag) {
-    for (auto n = last - first; n > 0; n--)
+    while (first != last)
         *--result = *--last;
     return result;
 }
@@ -108,8 +250,8 @@ BidirectionalIter2 unchecked_copy_backward_cat(BidirectionalIter1 first, Bidirec
 template <class RandIter, class BidirectionalIter>
 BidirectionalIter unchecked_copy_backward_cat(RandIter first, RandIter last,
                                               BidirectionalIter result, MySTL::random_access_iterator_tag) {
-    for (auto n = last - first; n > 0; --n, --last, --result)
-        *result = *last;
+    for (auto n = last - first; n > 0; --n)
+        *--result = *--last;
     return result;
 }
 
@@ -119,11 +261,11 @@ BidirectionalIter2 unchecked_copy_backward(BidirectionalIter1 first, Bidirection
     return unchecked_copy_backward_cat(first, last, result, iterator_category(first));
 }
 
-// copy_backward() 针对 trivially_copy_assignable 类型提供特化版本
+// copy_backward() 针对 trivially_copyable 类型提供特化版本
 template <class Tp, class Up>
 typename std::enable_if<
     std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
-    std::is_trivially_copy_assignable<Up>::value,
+    std::is_trivially_copyable<Up>::value && std::is_trivially_copy_assignable<Up>::value,
     Up*>::type
 unchecked_copy_backward(Tp* first, Tp* last,
                         Up* result) {
@@ -135,6 +277,13 @@ unchecked_copy_backward(Tp* first, Tp* last,
     return result;
 }
 
+struct copy_backward_op {
+    template <class BidirectionalIter1, class BidirectionalIter2>
+    static BidirectionalIter2 apply(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result) {
+        return unchecked_copy_backward(first, last, result);
+    }
+};
+
 /**
  * @brief copy form [first, last), to [result - (last - first), result)
  * @return result - (last - first) 处的迭代器
@@ -142,7 +291,7 @@ unchecked_copy_backward(Tp* first, Tp* last,
 template <class BidirectionalIter1, class BidirectionalIter2>
 BidirectionalIter2 copy_backward(BidirectionalIter1 first, BidirectionalIter1 last,
                                  BidirectionalIter2 result) {
-    return unchecked_copy_backward(first, last, result);
+    return segmented_backward<copy_backward_op>(first, last, result);
 }
 
 /*****************************************************************************************/
@@ -227,11 +376,11 @@ OutputIter unchecked_move(InputIter first, InputIter last,
     return unchecked_move_cat(first, last, result, iterator_category(first));
 }
 
-// move() 为 trivially_copy_assignable类型提供的特化版本
+// move() 为 trivially_copyable 类型提供的特化版本
 template <class Tp, class Up>
 typename std::enable_if<
     std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
-    std::is_trivially_move_assignable<Up>::value,
+    std::is_trivially_copyable<Up>::value && std::is_trivially_move_assignable<Up>::value,
     Up*>::type
 unchecked_move(Tp* first, Tp* last,
                Up* result) {
@@ -241,6 +390,13 @@ unchecked_move(Tp* first, Tp* last,
     return result + n;
 }
 
+struct move_op {
+    template <class InputIter, class OutputIter>
+    static OutputIter apply(InputIter first, InputIter last, OutputIter result) {
+        return unchecked_move(first, last, result);
+    }
+};
+
 /**
  * @brief move [first, last) to [result, result + (last - first))
  * @return 返回 dst 的尾部
@@ -248,7 +404,7 @@ unchecked_move(Tp* first, Tp* last,
 template <class InputIter, class OutputIter>
 OutputIter move(InputIter first, InputIter last,
                 OutputIter reslut) {
-    return unchecked_move(first, last, reslut);
+    return segmented_forward<move_op>(first, last, reslut);
 }
 
 /*****************************************************************************************/
@@ -259,17 +415,17 @@ OutputIter move(InputIter first, InputIter last,
 template <class BidirectionalIter1, class BidirectionalIter2>
 BidirectionalIter2 unchecked_move_backward_cat(BidirectionalIter1 first, BidirectionalIter1 last,
                                                BidirectionalIter2 result, MySTL::bidirectional_iterator_tag) {
-    for (; first != last; --result, --last)
-        *result = MySTL::move(last);
+    while (first != last)
+        *--result = MySTL::move(*--last);
     return result;
 }
 
 // move_backward() for random_access_iterator_tag
 template <class RandIter1, class RandIter2>
-RandIter2 unchecked_move_backward_cat(RandIter1 first, RandIter2 last,
+RandIter2 unchecked_move_backward_cat(RandIter1 first, RandIter1 last,
                                       RandIter2 result, MySTL::random_access_iterator_tag) {
-    for (auto n = last - first; n > 0; n--, --last, --first)
-        *result = MySTL::move(*last);
+    for (auto n = last - first; n > 0; --n)
+        *--result = MySTL::move(*--last);
     return result;
 }
 
@@ -279,11 +435,11 @@ OutputIter unchecked_move_backward(InputIter first, InputIter last,
     return unchecked_move_backward_cat(first, last, result, iterator_category(first));
 }
 
-// move_backward() 为 trivially_copy_assignable类型提供的特化版本
+// move_backward() 为 trivially_copyable 类型提供的特化版本
 template <class Tp, class Up>
 typename std::enable_if<
     std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
-        std::is_trivially_move_assignable<Up>::value,
+        std::is_trivially_copyable<Up>::value && std::is_trivially_move_assignable<Up>::value,
     Up*>::type
 unchecked_move_backward(Tp* first, Tp* last, Up* result) {
     const size_t n = static_cast<size_t>(last - first);
@@ -294,6 +450,13 @@ unchecked_move_backward(Tp* first, Tp* last, Up* result) {
     return result;
 }
 
+struct move_backward_op {
+    template <class BidirectionalIter1, class BidirectionalIter2>
+    static BidirectionalIter2 apply(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result) {
+        return unchecked_move_backward(first, last, result);
+    }
+};
+
 /**
  * @brief 将[first, last)内的元素移动到[result - (last - first), result)
  * @return 返回 result - (last - first) 处的迭代器
@@ -301,7 +464,7 @@ unchecked_move_backward(Tp* first, Tp* last, Up* result) {
 template <class BidirectionalIter1, class BidirectionalIter2>
 BidirectionalIter2 move_backward(BidirectionalIter1 first, BidirectionalIter1 last,
                                  BidirectionalIter2 result) {
-    return unchecked_move_backward(first, last, result);
+    return segmented_backward<move_backward_op>(first, last, result);
 }
 
 /*****************************************************************************************/
@@ -354,12 +517,40 @@ unchecked_fill_n(Tp* first, Size n, Up value) {
     return first + n;
 }
 
+template <class OutputIter, class Size, class T>
+OutputIter segmented_fill_n(OutputIter first, Size n, const T& value, m_false_type) {
+    return unchecked_fill_n(first, n, value);
+}
+
+// 逐段填充，fill() 对随机访问迭代器转调 fill_n()，也走这里
+template <class SegIter, class Size, class T>
+SegIter segmented_fill_n(SegIter first, Size n, const T& value, m_true_type) {
+    typedef segmented_iterator_traits<SegIter> traits;
+    if (n <= 0)
+        return first;
+    auto left = static_cast<ptrdiff_t>(n);
+    auto seg = traits::segment(first);
+    auto cur = traits::local(first);
+    while (true) {
+        const ptrdiff_t room = traits::end(seg) - cur;
+        if (left <= room) {
+            cur = unchecked_fill_n(cur, left, value);
+            break;
+        }
+        unchecked_fill_n(cur, room, value);
+        left -= room;
+        ++seg;
+        cur = traits::begin(seg);
+    }
+    return traits::compose(seg, cur);
+}
+
 /**
  * @brief 从 first 位置开始填充 n 个值
  */
 template <class OutputIter, class Size, class T>
 OutputIter fill_n(OutputIter first, Size n, const T& value) {
-    return unchecked_fill_n(first, n, value);
+    return segmented_fill_n(first, n, value, m_bool_constant<is_segmented_iterator<OutputIter>::value>());
 }
 
 /*****************************************************************************************/
@@ -376,7 +567,7 @@ void fill_cat(ForwardIter first, ForwardIter last, const T& value, MySTL::forwar
 // fill() for random_access_iterator_tag
 template <class RandIter, class T>
 void fill_cat(RandIter first, RandIter last, const T& value, MySTL::random_access_iterator_tag) {
-    fill_n(first, last - first, value);
+    MySTL::fill_n(first, last - first, value);
 }
 
 /**
@@ -0,0 +1,175 @@
+#ifndef MY_ALIGNED_ALLOCATOR_H
+#define MY_ALIGNED_ALLOCATOR_H
+
+// 按指定边界对齐的分配器，适用于 vector / deque 中需要 SIMD 对齐的大块缓冲区
+// 所有请求至少按 Align(默认一个 cache line) 对齐，可以直接用于 AVX-512 的对齐加载
+// 请求字节数不小于 HugeThreshold 时按 2MB 对齐并向上取整到 2MB 的整数倍，
+// 在 Linux 上再通过 madvise(MADV_HUGEPAGE) 提示内核使用透明大页，减少 TLB miss
+// HugeThreshold 为 0 时不使用大页
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "construct.h"
+#include "util.h"
+
+namespace MySTL {
+
+enum { CACHELINE_ALIGN = 64 };
+enum { HUGEPAGE_BYTES = 2 * 1024 * 1024 };
+
+// 按 align 对齐申请 bytes 字节，失败时抛出 std::bad_alloc
+inline void* aligned_alloc_bytes(size_t bytes, size_t align) {
+    void* p = nullptr;
+#if defined(_WIN32)
+    p = _aligned_malloc(bytes, align);
+    if (p == nullptr) throw std::bad_alloc();
+#else
+    if (posix_memalign(&p, align, bytes) != 0) throw std::bad_alloc();
+#endif
+    return p;
+}
+
+inline void aligned_free_bytes(void* p) noexcept {
+#if defined(_WIN32)
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+// 申请以大页为单位的内存，并提示内核使用透明大页
+inline void* hugepage_alloc_bytes(size_t bytes) {
+    const size_t rounded = (bytes + HUGEPAGE_BYTES - 1) & ~(static_cast<size_t>(HUGEPAGE_BYTES) - 1);
+    void*        p = aligned_alloc_bytes(rounded, HUGEPAGE_BYTES);
+#if defined(MADV_HUGEPAGE)
+    madvise(p, rounded, MADV_HUGEPAGE);  // 只是提示，失败时退化为普通页
+#endif
+    return p;
+}
+
+/*********************************** aligned_allocator ***********************************/
+// 接口与 MySTL::allocator 保持一致，可作为 vector / deque 的 Alloc 参数
+template <class T, size_t Align = CACHELINE_ALIGN, size_t HugeThreshold = HUGEPAGE_BYTES>
+class aligned_allocator {
+    static_assert((Align & (Align - 1)) == 0, "Align of aligned_allocator must be a power of two");
+    static_assert(Align >= alignof(void*), "Align of aligned_allocator must be at least alignof(void*)");
+
+public:
+    typedef T           value_type;
+    typedef T*          pointer;
+    typedef const T*    const_pointer;
+    typedef T&          reference;
+    typedef const T&    const_reference;
+    typedef size_t      size_type;
+    typedef ptrdiff_t   difference_type;
+
+    template <class U>
+    struct rebind {
+        typedef aligned_allocator<U, Align, HugeThreshold> other;
+    };
+
+    static constexpr size_t alignment = Align < alignof(T) ? alignof(T) : Align;
+
+public:
+    aligned_allocator() noexcept = default;
+
+    template <class U>
+    aligned_allocator(const aligned_allocator<U, Align, HugeThreshold>&) noexcept {}
+
+public:
+    static T*   allocate();
+    static T*   allocate(size_type n);
+
+    static void deallocate(T* ptr);
+    static void deallocate(T* ptr, size_type n);
+
+    static void construct(T* ptr);
+    static void construct(T* ptr, const T& value);
+    static void construct(T* ptr, T&& value);
+
+    template <class... Args>
+    static void construct(T* ptr, Args&& ...args);
+
+    static void destroy(T* ptr);
+    static void destroy(T* first, T* last);
+};
+
+template <class T, size_t Align, size_t HugeThreshold>
+constexpr size_t aligned_allocator<T, Align, HugeThreshold>::alignment;
+
+template <class T, size_t Align, size_t HugeThreshold>
+T* aligned_allocator<T, Align, HugeThreshold>::allocate() {
+    return allocate(1);
+}
+
+template <class T, size_t Align, size_t HugeThreshold>
+T* aligned_allocator<T, Align, HugeThreshold>::allocate(size_type n) {
+    if (n == 0) return nullptr;
+    const size_t bytes = sizeof(T) * n;
+    if (HugeThreshold != 0 && bytes >= HugeThreshold) {
+        return static_cast<T*>(hugepage_alloc_bytes(bytes));
+    }
+    return static_cast<T*>(aligned_alloc_bytes(bytes, alignment));
+}
+
+template <class T, size_t Align, size_t HugeThreshold>
+void aligned_allocator<T, Align, HugeThreshold>::deallocate(T* ptr) {
+    deallocate(ptr, 1);
+}
+
+template <class T, size_t Align, size_t HugeThreshold>
+void aligned_allocator<T, Align, HugeThreshold>::deallocate(T* ptr, size_type) {
+    if (ptr == nullptr) return;
+    aligned_free_bytes(ptr);
+}
+
+template <class T, size_t Align, size_t HugeThreshold>
+void aligned_allocator<T, Align, HugeThreshold>::construct(T* ptr) {
+    MySTL::construct(ptr);
+}
+
+template <class T, size_t Align, size_t HugeThreshold>
+void aligned_allocator<T, Align, HugeThreshold>::construct(T* ptr, const T& value) {
+    MySTL::construct(ptr, value);
+}
+
+template <class T, size_t Align, size_t HugeThreshold>
+void aligned_allocator<T, Align, HugeThreshold>::construct(T* ptr, T&& value) {
+    MySTL::construct(ptr, MySTL::move(value));
+}
+
+template <class T, size_t Align, size_t HugeThreshold>
+template <class... Args>
+void aligned_allocator<T, Align, HugeThreshold>::construct(T* ptr, Args&&... args) {
+    MySTL::construct(ptr, MySTL::forward<Args>(args)...);
+}
+
+template <class T, size_t Align, size_t HugeThreshold>
+void aligned_allocator<T, Align, HugeThreshold>::destroy(T* ptr) {
+    MySTL::destroy(ptr);
+}
+
+template <class T, size_t Align, size_t HugeThreshold>
+void aligned_allocator<T, Align, HugeThreshold>::destroy(T* first, T* last) {
+    MySTL::destroy(first, last);
+}
+
+template <class T, class U, size_t Align, size_t HugeThreshold>
+bool operator==(const aligned_allocator<T, Align, HugeThreshold>&,
+                const aligned_allocator<U, Align, HugeThreshold>&) noexcept { return true; }
+
+template <class T, class U, size_t Align, size_t HugeThreshold>
+bool operator!=(const aligned_allocator<T, Align, HugeThreshold>&,
+                const aligned_allocator<U, Align, HugeThreshold>&) noexcept { return false; }
+
+}  // namespace MySTL
+
+#endif /* MY_ALIGNED_ALLOCATOR_H */
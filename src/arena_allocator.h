@@ -0,0 +1,167 @@
+#ifndef MY_ARENA_ALLOCATOR_H
+#define MY_ARENA_ALLOCATOR_H
+
+// 单调增长的内存区(arena)，适用于一次请求内构造大量短生命周期容器、最后统一销毁的场景
+// 分配时只移动指针，当前块用完后向系统申请一块更大的新块并串成链表
+// 可以用一块外部缓冲区(例如栈上数组)作为第一块，小请求可以完全不碰堆
+// arena_allocator 的 deallocate 为空操作，所有内存在 release() 或析构时一次性归还
+// 注意：monotonic_buffer 非线程安全，且必须比使用它的容器活得更久
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace MySTL {
+
+constexpr size_t ARENA_INIT_CHUNK_BYTES = 4 * 1024;
+
+/*********************************** monotonic_buffer ***********************************/
+class monotonic_buffer {
+private:
+    // 每个从堆上申请的块头部记录下一块，便于 release 时依次释放
+    struct chunk {
+        chunk* next;
+    };
+
+    char*  cur_;         // 当前块中未使用部分的起止位置
+    char*  end_;
+    chunk* chunks_;      // 从堆上申请的块组成的链表
+    char*  init_buf_;    // 外部提供的初始缓冲区，不由 arena 释放
+    size_t init_size_;
+    size_t next_size_;   // 下一次申请新块的大小，每次翻倍
+    size_t heap_size_;   // 已向系统申请的总字节数
+
+public:
+    monotonic_buffer() noexcept :
+        cur_(nullptr), end_(nullptr), chunks_(nullptr), init_buf_(nullptr),
+        init_size_(0), next_size_(ARENA_INIT_CHUNK_BYTES), heap_size_(0) {}
+
+    // 第一个块的大小
+    explicit monotonic_buffer(size_t initial_size) noexcept :
+        cur_(nullptr), end_(nullptr), chunks_(nullptr), init_buf_(nullptr), init_size_(0),
+        next_size_(initial_size < sizeof(chunk) ? sizeof(chunk) : initial_size), heap_size_(0) {}
+
+    // 先使用外部缓冲区 [buffer, buffer + size)，用完后再从堆上申请
+    monotonic_buffer(void* buffer, size_t size) noexcept :
+        cur_(static_cast<char*>(buffer)), end_(static_cast<char*>(buffer) + size),
+        chunks_(nullptr), init_buf_(static_cast<char*>(buffer)), init_size_(size),
+        next_size_(size < ARENA_INIT_CHUNK_BYTES ? ARENA_INIT_CHUNK_BYTES : size * 2), heap_size_(0) {}
+
+    monotonic_buffer(const monotonic_buffer&) = delete;
+    monotonic_buffer& operator=(const monotonic_buffer&) = delete;
+
+    ~monotonic_buffer() { release(); }
+
+public:
+    void* allocate(size_t bytes, size_t align = alignof(std::max_align_t));
+
+    // 单调分配器不回收单个对象
+    void  deallocate(void*, size_t, size_t = alignof(std::max_align_t)) noexcept {}
+
+    void  release() noexcept;
+
+    size_t heap_size() const noexcept { return heap_size_; }
+
+private:
+    static size_t padding(const char* p, size_t align) noexcept {
+        return static_cast<size_t>(-reinterpret_cast<uintptr_t>(p)) & (align - 1);
+    }
+
+    void new_chunk(size_t bytes, size_t align);
+};
+
+/**
+ * @brief 从当前块中按对齐要求切出 bytes 字节，不足时申请新块
+ * @param align 必须为 2 的幂
+ */
+inline void* monotonic_buffer::allocate(size_t bytes, size_t align) {
+    size_t pad = padding(cur_, align);
+    if (cur_ == nullptr || static_cast<size_t>(end_ - cur_) < pad + bytes) {
+        new_chunk(bytes, align);
+        pad = padding(cur_, align);
+    }
+    char* result = cur_ + pad;
+    cur_ = result + bytes;
+    return result;
+}
+
+// 申请一个至少能容纳 bytes 字节(含对齐填充)的新块，旧块剩余部分直接丢弃
+inline void monotonic_buffer::new_chunk(size_t bytes, size_t align) {
+    const size_t need = sizeof(chunk) + bytes + align;
+    while (next_size_ < need) {
+        next_size_ <<= 1;
+    }
+    const size_t size = next_size_;
+    chunk*       c = static_cast<chunk*>(::operator new(size));
+    c->next = chunks_;
+    chunks_ = c;
+    cur_ = reinterpret_cast<char*>(c + 1);
+    end_ = reinterpret_cast<char*>(c) + size;
+    heap_size_ += size;
+    next_size_ <<= 1;
+}
+
+// 归还所有从堆上申请的块，并回到只有初始缓冲区的状态
+inline void monotonic_buffer::release() noexcept {
+    while (chunks_ != nullptr) {
+        chunk* next = chunks_->next;
+        ::operator delete(chunks_);
+        chunks_ = next;
+    }
+    cur_ = init_buf_;
+    end_ = init_buf_ == nullptr ? nullptr : init_buf_ + init_size_;
+    heap_size_ = 0;
+}
+
+/*********************************** arena_allocator ***********************************/
+// 有状态分配器，保存所使用的 monotonic_buffer
+// 复制赋值、移动赋值和 swap 都不传播分配器，容器中的元素始终留在构造时指定的 arena 中
+template <class T>
+class arena_allocator {
+public:
+    typedef T           value_type;
+    typedef T*          pointer;
+    typedef const T*    const_pointer;
+    typedef T&          reference;
+    typedef const T&    const_reference;
+    typedef size_t      size_type;
+    typedef ptrdiff_t   difference_type;
+
+    template <class U>
+    struct rebind {
+        typedef arena_allocator<U> other;
+    };
+
+private:
+    monotonic_buffer* buf_;
+
+public:
+    explicit arena_allocator(monotonic_buffer* buf) noexcept : buf_(buf) {}
+
+    template <class U>
+    arena_allocator(const arena_allocator<U>& rhs) noexcept : buf_(rhs.buffer()) {}
+
+public:
+    T* allocate(size_type n) {
+        return static_cast<T*>(buf_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_type) noexcept {}
+
+    monotonic_buffer* buffer() const noexcept { return buf_; }
+};
+
+// 使用同一个 arena 的分配器才相等
+template <class T, class U>
+bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept {
+    return lhs.buffer() == rhs.buffer();
+}
+
+template <class T, class U>
+bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept {
+    return lhs.buffer() != rhs.buffer();
+}
+
+}  // namespace MySTL
+
+#endif /* MY_ARENA_ALLOCATOR_H */
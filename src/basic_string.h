@@ -2,6 +2,7 @@
 #define MY_BASIC_STRING_H_
 
 
+#include "growth_policy.h"
 #include "myallocator.h"
 #include "iterator.h"
 #include "type_traits.h"
@@ -233,29 +234,31 @@ struct char_traits<char32_t> {
     }
 };
 
-template <class CharType, class CharTraits = MySTL::char_traits<CharType>>
-class basic_string {
+// Growth 为扩容策略，见 growth_policy.h，默认 1.5 倍增长且第一次分配不少于 STRING_INIT_SIZE
+template <class CharType, class CharTraits = MySTL::char_traits<CharType>, class Alloc = MySTL::allocator<CharType>,
+          class Growth = MySTL::geometric_growth<3, 2, STRING_INIT_SIZE>>
+class basic_string : private alloc_holder<Alloc> {
 public:  // alias declarations
     typedef CharTraits                              traits_type;
     typedef CharTraits                              char_traits;
 
-    typedef MySTL::allocator<CharType>              allocator_type;
-    typedef MySTL::allocator<CharType>              data_allocator;
+    typedef Alloc                                   allocator_type;
+    typedef MySTL::allocator_traits<Alloc>          alloc_traits;
 
-    typedef typename allocator_type::value_type      value_type;
-    typedef typename allocator_type::pointer         pointer;
-    typedef typename allocator_type::const_pointer   const_pointer;
-    typedef typename allocator_type::reference       reference;
-    typedef typename allocator_type::const_reference const_reference;
-    typedef typename allocator_type::size_type       size_type;
-    typedef typename allocator_type::difference_type difference_type;
+    typedef typename alloc_traits::value_type        value_type;
+    typedef typename alloc_traits::pointer           pointer;
+    typedef typename alloc_traits::const_pointer     const_pointer;
+    typedef value_type&                              reference;
+    typedef const value_type&                        const_reference;
+    typedef typename alloc_traits::size_type         size_type;
+    typedef typename alloc_traits::difference_type   difference_type;
 
     typedef value_type*                             iterator;
     typedef const value_type*                       const_iterator;
     typedef MySTL::reverse_iterator<iterator>       reverse_iterator;
     typedef MySTL::reverse_iterator<const_iterator> const_reverse_iterator;
 
-    allocator_type get_allocator() const noexcept { return allocator_type(); }
+    allocator_type get_allocator() const noexcept { return get_alloc(); }
 
     static_assert(std::is_pod<CharType>::value, "CharType type of basic_string must be POD");
     static_assert(std::is_same<CharType, typename traits_type::char_type>::value, "CharType must be same as traits_type::char_type");
@@ -265,6 +268,9 @@ public:
     static constexpr size_type npos = static_cast<size_type>(-1);
 
 private:
+    typedef alloc_holder<Alloc>                     alloc_base;
+    using alloc_base::get_alloc;
+
     iterator  buffer_;  // 指向存储字符串数据的底层字符数组
     size_type size_;    // 字符串的大小
     size_type cap_;     // 字符串的容量
@@ -276,46 +282,65 @@ public:
         try_init();
     }
 
-    basic_string(size_type n, value_type ch) : buffer_(nullptr), size_(0), cap_(0) {
+    explicit basic_string(const allocator_type& alloc) noexcept : alloc_base(alloc) {
+        try_init();
+    }
+
+    basic_string(size_type n, value_type ch, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc), buffer_(nullptr), size_(0), cap_(0) {
         fill_init(n, ch);
     }
 
     // 拷贝构造函数(复制), 创造新的对象
-    basic_string(const basic_string& other, size_type pos) : buffer_(nullptr), size_(0), cap_(0) {
+    basic_string(const basic_string& other, size_type pos, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc), buffer_(nullptr), size_(0), cap_(0) {
         init_from(other.buffer_, pos, other.size_ - pos);
     }
 
-    basic_string(const basic_string& other, size_type pos, size_type count) : buffer_(nullptr), size_(0), cap_(0) {
+    basic_string(const basic_string& other, size_type pos, size_type count, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc), buffer_(nullptr), size_(0), cap_(0) {
         init_from(other.buffer_, pos, count);
     }
 
-    basic_string(const_pointer str) : buffer_(nullptr), size_(0), cap_(0) {
+    basic_string(const_pointer str, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc), buffer_(nullptr), size_(0), cap_(0) {
         init_from(str, 0, char_traits::length(str));
     }
 
-    basic_string(const_pointer str, size_type count) : buffer_(nullptr), size_(0), cap_(0) {
+    basic_string(const_pointer str, size_type count, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc), buffer_(nullptr), size_(0), cap_(0) {
         init_from(str, 0, count);
     }
 
     template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
-    basic_string(Iter first, Iter last) {
+    basic_string(Iter first, Iter last, const allocator_type& alloc = allocator_type()) : alloc_base(alloc) {
         copy_init(first, last, iterator_category(first));
     }
 
-    basic_string(const basic_string& rhs) : buffer_(nullptr), size_(0), cap_(0) {
+    // 复制，分配器由 select_on_container_copy_construction 决定
+    basic_string(const basic_string& rhs) :
+        alloc_base(alloc_traits::select_on_container_copy_construction(rhs.get_alloc())),
+        buffer_(nullptr), size_(0), cap_(0) {
+        init_from(rhs.buffer_, 0, rhs.size_);
+    }
+
+    basic_string(const basic_string& rhs, const allocator_type& alloc) :
+        alloc_base(alloc), buffer_(nullptr), size_(0), cap_(0) {
         init_from(rhs.buffer_, 0, rhs.size_);
     }
 
     // 移动构造函数, 转移所有权
     basic_string(basic_string&& rhs) noexcept :
-        buffer_(rhs.buffer_), size_(rhs.size_), cap_(rhs.cap_) {
+        alloc_base(MySTL::move(rhs.get_alloc())), buffer_(rhs.buffer_), size_(rhs.size_), cap_(rhs.cap_) {
         rhs.buffer_ = nullptr;
         rhs.size_ = 0;
         rhs.cap_ = 0;
     }
 
     basic_string& operator=(const basic_string& rhs);
-    basic_string& operator=(basic_string&& rhs) noexcept;
+    // 分配器不传播且不相等时要复制到自己的空间，可能抛出异常
+    basic_string& operator=(basic_string&& rhs) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                                         alloc_traits::is_always_equal::value);
     basic_string& operator=(const_pointer str);
     basic_string& operator=(value_type ch);
 
@@ -358,14 +383,19 @@ public:
 
     /*********************************** 元素访问相关操作 ***********************************/
 
+    // 可写的引用不能指向共享的空字符，未分配缓冲区时先分配
     reference operator[](size_type n) {
         MYSTL_DEBUG(n <= size_);
+        if (buffer_ == nullptr)
+            reserve(STRING_INIT_SIZE);
         if (n == size_)
             *(buffer_ + n) = value_type();
         return *(buffer_ + n);
     }
     const_reference operator[](size_type n) const {
         MYSTL_DEBUG(n <= size_);
+        if (buffer_ == nullptr)
+            return empty_char();
         if (n == size_)
             *(buffer_ + n) = value_type();
         return *(buffer_ + n);
@@ -409,8 +439,11 @@ public:
     iterator insert(const_iterator pos, value_type ch);
     iterator insert(const_iterator pos, size_type count, value_type ch);
 
-    template <class Iter>
-    iterator insert(const_iterator pos, Iter first, Iter last);
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    iterator insert(const_iterator pos, Iter first, Iter last) {
+        MYSTL_DEBUG(begin() <= pos && pos <= end());
+        return copy_insert(const_cast<iterator>(pos), first, last, iterator_category(first));
+    }
 
     // push_back & pop_back
     void push_back(value_type ch) {
@@ -433,7 +466,25 @@ public:
 
     template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
     basic_string& append(Iter first, Iter last) {
-        return append_range(first, last);
+        return copy_append(first, last, iterator_category(first));
+    }
+
+    // 追加、插入、赋值整个区间(容器或内置数组)
+    // 能预先得到长度时只分配一次，单趟的输入迭代器按 Growth 成块扩容，块内不再逐个检查容量
+    template <class Range>
+    basic_string& append_range(Range&& rg) {
+        return copy_append(MySTL::range_begin(rg), MySTL::range_end(rg), iterator_category(MySTL::range_begin(rg)));
+    }
+
+    template <class Range>
+    iterator insert_range(const_iterator pos, Range&& rg) {
+        return insert(pos, MySTL::range_begin(rg), MySTL::range_end(rg));
+    }
+
+    template <class Range>
+    basic_string& assign_range(Range&& rg) {
+        clear();
+        return append_range(MySTL::forward<Range>(rg));
     }
 
     // erase & clear
@@ -446,6 +497,13 @@ public:
     }
     void resize(size_type count, value_type ch);
 
+    // 增长时新字符不做初始化，适合随后由 read() 或解码器直接填充
+    void resize_default_init(size_type count);
+
+    // 先扩展到 count 个字符，再由 op(buffer, count) 写入内容，其返回值作为最终长度
+    template <class Operation>
+    void resize_and_overwrite(size_type count, Operation op);
+
     void clear() noexcept { size_ = 0; }
 
 
@@ -618,11 +676,31 @@ private:
     // 返回一个指向存储字符串数据的底层字符数组的指针
     const_pointer to_raw_pointer() const;
 
+    // 未分配缓冲区时 c_str() 和 const operator[](0) 使用的空字符，所有空字符串共享，只读
+    static const value_type& empty_char() noexcept {
+        static const value_type ch = value_type();
+        return ch;
+    }
+
+    // 增长容量，由 Growth 决定，至少为结尾的空字符多留一个位置
+    size_type get_new_cap(size_type add) const {
+        THROW_LENGTH_ERROR_IF(add >= max_size() - cap_, "basic_string<Char, Traits>'s size too big");
+        const size_type need = cap_ + add + 1;
+        return MySTL::max(static_cast<size_type>(Growth::next_capacity(cap_, need, sizeof(CharType))), need);
+    }
+
     // shrink_to_fit
     void reinsert(size_type size);
 
     template <class Iter>
-    basic_string& append_range(Iter first, Iter last);
+    basic_string& copy_append(Iter first, Iter last, MySTL::input_iterator_tag);
+    template <class Iter>
+    basic_string& copy_append(Iter first, Iter last, MySTL::forward_iterator_tag);
+
+    template <class Iter>
+    iterator copy_insert(iterator pos, Iter first, Iter last, MySTL::input_iterator_tag);
+    template <class Iter>
+    iterator copy_insert(iterator pos, Iter first, Iter last, MySTL::forward_iterator_tag);
 
     int compare_cstr(const_pointer s1, size_type n1, const_pointer s2, size_type n2) const;
 
@@ -636,46 +714,65 @@ private:
     // reallocate
     void     reallocate(size_type need);
     iterator reallocate_and_fill(iterator pos, size_type n, value_type ch);
-    iterator reallocate_and_copy(iterator pos, const_iterator first, const_iterator last);
+    template <class Iter>
+    iterator reallocate_and_copy(iterator pos, Iter first, Iter last);
 };
 
 /*********************************** 赋值运算符重载 ***********************************/
 
 // 复制赋值运算符
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>&
+basic_string<CharType, CharTraits, Alloc, Growth>::
 operator=(const basic_string& rhs) {
     if (this != &rhs) {  // effictive c++ item 11
-        basic_string tmp(rhs);
+        if (alloc_traits::propagate_on_container_copy_assignment::value &&
+            !MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+            // 分配器将被替换，旧空间必须先由旧分配器释放
+            destroy_buffer();
+        }
+        MySTL::alloc_on_copy(get_alloc(), rhs.get_alloc());
+        basic_string tmp(rhs, get_alloc());
         swap(tmp);
     }
     return *this;
 }
 
 // 移动赋值运算符
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::
-operator=(basic_string&& rhs) noexcept {
-    destroy_buffer();
-    buffer_ = rhs.buffer_;
-    size_ = rhs.size_;
-    cap_ = rhs.cap_;
-    rhs.buffer_ = nullptr;
-    rhs.size_ = 0;
-    rhs.cap_ = 0;
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>&
+basic_string<CharType, CharTraits, Alloc, Growth>::
+operator=(basic_string&& rhs) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                       alloc_traits::is_always_equal::value) {
+    if (this == &rhs) return *this;
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+        destroy_buffer();
+        MySTL::alloc_on_move(get_alloc(), rhs.get_alloc());
+        buffer_ = rhs.buffer_;
+        size_ = rhs.size_;
+        cap_ = rhs.cap_;
+        rhs.buffer_ = nullptr;
+        rhs.size_ = 0;
+        rhs.cap_ = 0;
+    } else {
+        // 分配器不相等且不传播，只能逐字符复制到自己的空间
+        basic_string tmp(rhs, get_alloc());
+        swap(tmp);
+    }
     return *this;
 }
 
 // 使用字符串进行赋值
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>&
+basic_string<CharType, CharTraits, Alloc, Growth>::
 operator=(const_pointer str) {
     const size_type len = char_traits::length(str);
-    if (cap_ < len) {
-        auto new_buffer = data_allocator::allocate(len + 1);
+    if (cap_ < len + 1) {
+        auto new_buffer = alloc_traits::allocate(get_alloc(), len + 1);
+        if (buffer_ != nullptr)
+            alloc_traits::deallocate(get_alloc(), buffer_, cap_);
         buffer_ = new_buffer;
         cap_ = len + 1;
     }
@@ -685,13 +782,14 @@ operator=(const_pointer str) {
 }
 
 // 使用字符进行赋值
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>&
+basic_string<CharType, CharTraits, Alloc, Growth>::
 operator=(value_type ch) {
-    if (cap_ < 1) {
-        auto new_buffer = data_allocator::allocate(2);
-        data_allocator::deallocate(buffer_);
+    if (cap_ < 2) {
+        auto new_buffer = alloc_traits::allocate(get_alloc(), 2);
+        if (buffer_ != nullptr)
+            alloc_traits::deallocate(get_alloc(), buffer_, cap_);
         buffer_ = new_buffer;
         cap_ = 2;
     }
@@ -703,20 +801,25 @@ operator=(value_type ch) {
 /*********************************** 添加 & 删除 & 容量相关操作 ***********************************/
 
 // 预留储存空间
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+void basic_string<CharType, CharTraits, Alloc, Growth>::
     reserve(size_type n) {
     if (cap_ < n) {
         THROW_LENGTH_ERROR_IF(n > max_size(), "n can not lagger than max_size()"
                                               "int basic_string<CharType, CharTraits>::reserve(n)");
-        auto new_buffer = data_allocator::allocate(n);
-        char_traits::move(new_buffer, buffer_, size_);
+        auto new_buffer = alloc_traits::allocate(get_alloc(), n);
+        if (buffer_ != nullptr) {
+            char_traits::move(new_buffer, buffer_, size_);
+            alloc_traits::deallocate(get_alloc(), buffer_, cap_);
+        }
+        buffer_ = new_buffer;
+        cap_ = n;
     }
 }
 
 // 减少不用空间
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+void basic_string<CharType, CharTraits, Alloc, Growth>::
     shrink_to_fit() {
     if (size_ != cap_) {
         reinsert(size_);
@@ -724,9 +827,9 @@ void basic_string<CharType, CharTraits>::
 }
 
 // 在pos处插入一个元素
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::iterator
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::iterator
+basic_string<CharType, CharTraits, Alloc, Growth>::
 insert(const_iterator pos, value_type ch) {
     iterator r = const_cast<iterator>(pos);
     if (size_ == cap_) {
@@ -739,9 +842,9 @@ insert(const_iterator pos, value_type ch) {
 }
 
 // 在pos处插入n个元素
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::iterator
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::iterator
+basic_string<CharType, CharTraits, Alloc, Growth>::
 insert(const_iterator pos, size_type count, value_type ch) {
     iterator r = const_cast<iterator>(pos);
     if (count == 0) return r;
@@ -760,32 +863,40 @@ insert(const_iterator pos, size_type count, value_type ch) {
 }
 
 // 在pos处插入[first, last)内的元素
-template <class CharType, class CharTraits>
+// 单趟输入迭代器：先追加到末尾，再旋转到 pos 处
+template <class CharType, class CharTraits, class Alloc, class Growth>
 template <class Iter>
-typename basic_string<CharType, CharTraits>::iterator
-basic_string<CharType, CharTraits>::
-insert(const_iterator pos, Iter first, Iter last) {
-    size_type len = MySTL::distance(first, last);
-    iterator  r = const_cast<iterator>(pos);
-    if (len == 0) return r;
+typename basic_string<CharType, CharTraits, Alloc, Growth>::iterator
+basic_string<CharType, CharTraits, Alloc, Growth>::
+copy_insert(iterator pos, Iter first, Iter last, MySTL::input_iterator_tag) {
+    const size_type r = pos - buffer_;
+    const size_type old_size = size_;
+    copy_append(first, last, MySTL::input_iterator_tag());
+    MySTL::rotate(buffer_ + r, buffer_ + old_size, buffer_ + size_);
+    return buffer_ + r;
+}
+
+template <class CharType, class CharTraits, class Alloc, class Growth>
+template <class Iter>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::iterator
+basic_string<CharType, CharTraits, Alloc, Growth>::
+copy_insert(iterator pos, Iter first, Iter last, MySTL::forward_iterator_tag) {
+    const size_type len = MySTL::distance(first, last);
+    if (len == 0) return pos;
+    THROW_LENGTH_ERROR_IF(size_ > max_size() - len, "basic_string<Char, Traits>'s size too big.");
     if (cap_ - size_ < len) {
-        return reallocate_and_copy(r, first, last);
-    }
-    if (pos == end()) {
-        MySTL::uninitialized_copy(first, last, end());
-        size_ += len;
-        return r;
+        return reallocate_and_copy(pos, first, last);
     }
-    char_traits::move(r + len, r, len);
-    MySTL::uninitialized_copy(first, last, r);
+    char_traits::move(pos + len, pos, end() - pos);
+    MySTL::uninitialized_copy(first, last, pos);
     size_ += len;
-    return r;
+    return pos;
 }
 
 // 在末尾添加 count 个 ch
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>&
+basic_string<CharType, CharTraits, Alloc, Growth>::
 append(size_type count, value_type ch) {
     THROW_LENGTH_ERROR_IF(size_ + count > max_size(), "basic_string<CharType, CharTraits>::append() size too big");
     if (cap_ - size_ < count) {
@@ -797,9 +908,9 @@ append(size_type count, value_type ch) {
 }
 
 // 在末尾添加 [str[pos], str[pos + count]) 内的元素
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>&
+basic_string<CharType, CharTraits, Alloc, Growth>::
 append(const basic_string& rhs, size_type pos, size_type count) {
     THROW_LENGTH_ERROR_IF(
         size_ + count > max_size(), "basic_string<CharType, CharTraits>::append() size too big");
@@ -814,9 +925,9 @@ append(const basic_string& rhs, size_type pos, size_type count) {
 }
 
 // 在末尾添加 [s, s + count)
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>&
+basic_string<CharType, CharTraits, Alloc, Growth>::
 append(const_pointer s, size_type count) {
     THROW_LENGTH_ERROR_IF(
         size_ + count > max_size(), "basic_string<CharType, CharTraits>::append() size too big");
@@ -829,9 +940,9 @@ append(const_pointer s, size_type count) {
 }
 
 // 删除pos处元素
-template <class CharType, class CharTratis>
-typename basic_string<CharType, CharTratis>::iterator
-basic_string<CharType, CharTratis>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::iterator
+basic_string<CharType, CharTraits, Alloc, Growth>::
 erase(const_iterator pos) {
     MYSTL_DEBUG(pos != end());
     iterator r = const_cast<iterator>(pos);
@@ -841,9 +952,9 @@ erase(const_iterator pos) {
 }
 
 // 删除[first, last)的元素, 可以看到元素并没有真正的删除, 只是将后面的元素向前移动
-template <class CharType, class CharTratis>
-typename basic_string<CharType, CharTratis>::iterator
-basic_string<CharType, CharTratis>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::iterator
+basic_string<CharType, CharTraits, Alloc, Growth>::
 erase(const_iterator first, const_iterator last) {
     if (first == begin() && last == end()) {
         clear();
@@ -857,8 +968,8 @@ erase(const_iterator first, const_iterator last) {
 }
 
 // 重置容器大小
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+void basic_string<CharType, CharTraits, Alloc, Growth>::
 resize(size_type count, value_type ch) {
     if (count < size_) {
         erase(buffer_ + count, buffer_ + size_);
@@ -867,26 +978,46 @@ resize(size_type count, value_type ch) {
     }
 }
 
+template <class CharType, class CharTraits, class Alloc, class Growth>
+void basic_string<CharType, CharTraits, Alloc, Growth>::
+resize_default_init(size_type count) {
+    if (count > size_ && count >= cap_) {
+        THROW_LENGTH_ERROR_IF(count == max_size(), "basic_string<Char, Traits>'s size too big");
+        reallocate(count - size_);
+    }
+    size_ = count;
+}
+
+template <class CharType, class CharTraits, class Alloc, class Growth>
+template <class Operation>
+void basic_string<CharType, CharTraits, Alloc, Growth>::
+resize_and_overwrite(size_type count, Operation op) {
+    resize_default_init(count);
+    const size_type r = static_cast<size_type>(op(buffer_, count));
+    THROW_OUT_OF_RANGE_IF(r > count, "basic_string<Char, Traits>::resize_and_overwrite: result size out of range");
+    size_ = r;
+}
+
 /*********************************** 比较 ***********************************/
 
 // 比较两个basic_string, 小于返回-1，大于返回1
-template <class CharType, class CharTraits>
-int basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+int basic_string<CharType, CharTraits, Alloc, Growth>::
 compare(const basic_string& other) const {
     return compare_cstr(buffer_, size_, other.buffer_, other.size_);
 }
 
 // 比较从pos1开始的count1个字符和另一个basci_string
-template <class CharType, class CharTraits>
-int basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+int basic_string<CharType, CharTraits, Alloc, Growth>::
 compare(size_type pos1, size_type count1, const basic_string& other) const {
     auto n1 = MySTL::min(count1, size_ - pos1);
     return compare_cstr(buffer_ + pos1, n1, other.buffer_, other.size_);
 }
 
 // 从 pos1 下标开始的 count1 个字符跟另一个 basic_string 下标 pos2 开始的 count2 个字符比较
-template <class CharType, class CharTraits>
-int basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+int basic_string<CharType, CharTraits, Alloc, Growth>::
 compare(size_type pos1, size_type count1, const basic_string& other,
         size_type pos2, size_type count2) const {
     auto n1 = MySTL::min(count1, size_ - pos1);
@@ -895,16 +1026,16 @@ compare(size_type pos1, size_type count1, const basic_string& other,
 }
 
 // compare with a string pointer
-template <class CharType, class CharTraits>
-int basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+int basic_string<CharType, CharTraits, Alloc, Growth>::
 compare(const_pointer s) const {
     auto n2 = char_traits::length(s);
     return compare_cstr(buffer_, size_, s, n2);
 }
 
 // 从 pos1 下标开始的 count1 个字符跟另一个 字面量字符串比较
-template <class CharType, class CharTraits>
-int basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+int basic_string<CharType, CharTraits, Alloc, Growth>::
 compare(size_type pos1, size_type count1, const_pointer s) const {
     auto n1 = MySTL::min(count1, size_ - pos1);
     auto n2 = char_traits::length(s);
@@ -912,8 +1043,8 @@ compare(size_type pos1, size_type count1, const_pointer s) const {
 }
 
 // 从 pos1 下标开始的 count1 个字符跟另一个 字面量字符串的前count2比较
-template <class CharType, class CharTraits>
-int basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+int basic_string<CharType, CharTraits, Alloc, Growth>::
 compare(size_type pos1, size_type count1, const_pointer s, size_type count2) const {
     auto n1 = MySTL::min(count1, size_ - pos1);
     auto n2 = MySTL::min(count2, char_traits::length(s));
@@ -921,8 +1052,8 @@ compare(size_type pos1, size_type count1, const_pointer s, size_type count2) con
 }
 
 // 反转basic_string
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+void basic_string<CharType, CharTraits, Alloc, Growth>::
 reverse() noexcept {
     for (auto i = begin(), j = end(); i < j;) {
         MySTL::iter_swap(i++, --j);
@@ -930,10 +1061,11 @@ reverse() noexcept {
 }
 
 // 交换两个basic_string
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+void basic_string<CharType, CharTraits, Alloc, Growth>::
 swap(basic_string& rhs) noexcept {
     if (this != &rhs) {
+        MySTL::alloc_on_swap(get_alloc(), rhs.get_alloc());
         MySTL::swap(buffer_, rhs.buffer_);
         MySTL::swap(size_, rhs.size_);
         MySTL::swap(cap_, rhs.cap_);
@@ -947,9 +1079,9 @@ swap(basic_string& rhs) noexcept {
 //
 
 // 从下标pos开始查找ch
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find(value_type ch, size_type pos) const noexcept {
     for (auto i = pos; i < size_; i++) {
         if (*(buffer_ + i) == ch)
@@ -959,9 +1091,9 @@ find(value_type ch, size_type pos) const noexcept {
 }
 
 // 从下标pos开始查找字符串str
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find(const_pointer str, size_type pos) const noexcept {
     const auto len = char_traits::length(str);
     if (len == 0)
@@ -984,9 +1116,9 @@ find(const_pointer str, size_type pos) const noexcept {
 }
 
 // 从下标pos开始查找str的前count个字符
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find(const_pointer str, size_type pos, size_type count) const noexcept {
     if (count == 0)
         return pos;
@@ -1008,9 +1140,9 @@ find(const_pointer str, size_type pos, size_type count) const noexcept {
 }
 
 // 从下标pos开始查找str, basic_string
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find(const basic_string& str, size_type pos) const noexcept {
     const size_type count = str.size_;
     if (count == 0)
@@ -1037,9 +1169,9 @@ find(const basic_string& str, size_type pos) const noexcept {
 //
 
 // 从pos反向查找ch
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 rfind(value_type ch, size_type pos) const noexcept {
     if (pos >= size_)
         pos = size_ - 1;
@@ -1052,9 +1184,9 @@ rfind(value_type ch, size_type pos) const noexcept {
 
 // 从pos开始反向查找str, 匹配方式是倒叙匹配字符串
 // "string" 从'g'开始反向查找
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 rfind(const_pointer str, size_type pos) const noexcept {
     if (pos >= size_)
         pos = size_ - 1;
@@ -1088,9 +1220,9 @@ rfind(const_pointer str, size_type pos) const noexcept {
 }
 
 // 从下标pos反向查找str的前count
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 rfind(const_pointer str, size_type pos, size_type count) const noexcept {
     if (count == 0)
         return pos;
@@ -1113,9 +1245,9 @@ rfind(const_pointer str, size_type pos, size_type count) const noexcept {
 }
 
 // 从下标pos反向查找str
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 rfind(const basic_string& str, size_type pos) const noexcept {
     const size_type count = str.size_;
     if (pos >= size_)
@@ -1141,9 +1273,9 @@ rfind(const basic_string& str, size_type pos) const noexcept {
 //
 
 // 从下标pos查找ch出现的第一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find_first_of(value_type ch, size_type pos) const noexcept {
     for (auto i = pos; i < size_; i++)
     {
@@ -1154,9 +1286,9 @@ find_first_of(value_type ch, size_type pos) const noexcept {
 }
 
 // 从下标pos查找str其中的一个字符第一次出现的位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find_first_of(const_pointer str, size_type pos) const noexcept {
     const size_type len = char_traits::length(str);
     if (len == 0)
@@ -1172,9 +1304,9 @@ find_first_of(const_pointer str, size_type pos) const noexcept {
 }
 
 // 从下标pos查找字符串str中的某一个字符
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find_first_of(const_pointer str, size_type pos, size_type count) const noexcept {
     for (auto i = pos; i < size_; i++) {
         value_type ch = *(buffer_ + i);
@@ -1187,9 +1319,9 @@ find_first_of(const_pointer str, size_type pos, size_type count) const noexcept
 }
 
 // 从下标pos查找字符串str中的某一个字符
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find_first_of(const basic_string& str, size_type pos) const noexcept {
     for (auto i = pos; i < size_; i++) {
         value_type ch = *(buffer_ + i);
@@ -1206,9 +1338,9 @@ find_first_of(const basic_string& str, size_type pos) const noexcept {
 //
 
 // 从下标pos找与ch不同的第一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find_first_not_of(value_type ch, size_type pos) const noexcept {
     for (auto i = pos; i < size_; i++) {
         if (*(buffer_ + i) != ch)
@@ -1218,9 +1350,9 @@ find_first_not_of(value_type ch, size_type pos) const noexcept {
 }
 
 // 从下标 pos 开始查找与字符串 s 其中一个字符不相等的第一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find_first_not_of(const_pointer str, size_type pos) const noexcept {
     const size_type len = char_traits::length(str);
     for (auto i = pos; i < size_; i++) {
@@ -1234,9 +1366,9 @@ find_first_not_of(const_pointer str, size_type pos) const noexcept {
 }
 
 // 从下标 pos 开始查找与字符串 s 前 count 个字符中不相等的第一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find_first_not_of(const_pointer str, size_type pos, size_type count) const noexcept {
     for (auto i = pos; i < size_; i++) {
         value_type ch = *(buffer_ + i);
@@ -1249,9 +1381,9 @@ find_first_not_of(const_pointer str, size_type pos, size_type count) const noexc
 }
 
 // 下标pos开始查找与str中不相等的第一个字符位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find_first_not_of(const basic_string& str, size_type pos) const noexcept {
     for (auto i = pos; i < size_; i++) {
         value_type ch = *(buffer_ + i);
@@ -1268,9 +1400,9 @@ find_first_not_of(const basic_string& str, size_type pos) const noexcept {
 //
 
 // 下标pos开始与ch相等的最后一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find_last_of(value_type ch, size_type pos) const noexcept {
     for (auto i = size_ - 1; i >= pos; i--) {  // 从后面查找
         if (*(buffer_ + i) == ch)
@@ -1280,9 +1412,9 @@ find_last_of(value_type ch, size_type pos) const noexcept {
 }
 
 // 从下标 pos 开始查找与字符串 str 的字符中不相等的最后一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find_last_of(const_pointer str, size_type pos) const noexcept {
     size_type len = char_traits::length(str);
     for (auto i = size_ - 1; i >= pos; i--) {
@@ -1296,9 +1428,9 @@ find_last_of(const_pointer str, size_type pos) const noexcept {
 }
 
 // 从下标 pos 开始查找与字符串 s 前 count 个字符中相等的最后一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find_last_of(const_pointer str, size_type pos, size_type count) const noexcept {
     for (auto i = size_ - 1; i >= pos; i--) {
         value_type ch = *(buffer_ + i);
@@ -1311,9 +1443,9 @@ find_last_of(const_pointer str, size_type pos, size_type count) const noexcept {
 }
 
 // 从下标 pos 开始查找与字符串 str 字符中相等的最后一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find_last_of(const basic_string& str, size_type pos) const noexcept {
     for (auto i = size_ - 1; i >= pos; i--) {
         value_type ch = *(buffer_ + i);
@@ -1330,9 +1462,9 @@ find_last_of(const basic_string& str, size_type pos) const noexcept {
 //
 
 // 从下标 pos 开始查找与 ch 字符不相等的最后一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find_last_not_of(value_type ch, size_type pos) const noexcept {
     for (auto i = size_ - 1; i >= pos; --i) {
         if (*(buffer_ + i) != ch)
@@ -1342,9 +1474,9 @@ find_last_not_of(value_type ch, size_type pos) const noexcept {
 }
 
 // 从下标 pos 开始查找与字符串 s 的字符中不相等的最后一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find_last_not_of(const_pointer str, size_type pos) const noexcept {
     const size_type len = char_traits::length(str);
     for (auto i = size_ - 1; i >= pos; --i) {
@@ -1358,9 +1490,9 @@ find_last_not_of(const_pointer str, size_type pos) const noexcept {
 }
 
 // 从下标 pos 开始查找与字符串 s 前 count 个字符中不相等的最后一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find_last_not_of(const_pointer str, size_type pos, size_type count) const noexcept {
     for (auto i = size_ - 1; i >= pos; --i) {
         value_type ch = *(buffer_ + i);
@@ -1373,9 +1505,9 @@ find_last_not_of(const_pointer str, size_type pos, size_type count) const noexce
 }
 
 // 从下标 pos 开始查找与字符串 str 字符中不相等的最后一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 find_last_not_of(const basic_string& str, size_type pos) const noexcept {
     for (auto i = size_ - 1; i >= pos; --i) {
         value_type ch = *(buffer_ + i);
@@ -1388,9 +1520,9 @@ find_last_not_of(const basic_string& str, size_type pos) const noexcept {
 }
 
 // 返回从下标 pos 开始字符为 ch 的元素出现的次数
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::size_type
+basic_string<CharType, CharTraits, Alloc, Growth>::
 count(value_type ch, size_type pos) const noexcept {
     size_type n = 0;
     for (auto i = pos; i < size_; i++) {
@@ -1402,59 +1534,46 @@ count(value_type ch, size_type pos) const noexcept {
 
 /*********************************** helper function ***********************************/
 
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::
+// 空字符串不分配内存，c_str() 返回一个静态的空字符，第一次插入时再分配
+template <class CharType, class CharTraits, class Alloc, class Growth>
+void basic_string<CharType, CharTraits, Alloc, Growth>::
 try_init() noexcept {
-    try {
-        buffer_ = data_allocator::allocate(static_cast<size_type>(STRING_INIT_SIZE));
-        size_ = 0;
-        cap_ = 0;
-    } catch (...) {
-        buffer_ = nullptr;
-        size_ = 0;
-        cap_ = 0;
-    }
+    buffer_ = nullptr;
+    size_ = 0;
+    cap_ = 0;
 }
 
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+void basic_string<CharType, CharTraits, Alloc, Growth>::
 fill_init(size_type n, value_type ch) {
     const auto init_size = MySTL::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
-    buffer_ = data_allocator::allocate(init_size);
+    buffer_ = alloc_traits::allocate(get_alloc(), init_size);
     char_traits::fill(buffer_, ch, n);
     size_ = n;
     cap_ = init_size;
 }
 
-template <class CharType, class CharTraits>
+template <class CharType, class CharTraits, class Alloc, class Growth>
 template <class Iter>
-void basic_string<CharType, CharTraits>::
+void basic_string<CharType, CharTraits, Alloc, Growth>::
 copy_init(Iter first, Iter last, MySTL::input_iterator_tag) {
-    size_type  n = MySTL::distance(first, last);
-    const auto init_size = MySTL::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
+    try_init();
     try {
-        buffer_ = data_allocator::allocate(init_size);
-        size_ = n;
-        cap_ = init_size;
+        copy_append(first, last, MySTL::input_iterator_tag());
     } catch (...) {
-        buffer_ = nullptr;
-        size_ = 0;
-        cap_ = 0;
+        destroy_buffer();
         throw;
     }
-    for (; n > 0; --n, ++first) {
-        append(*first);
-    }
 }
 
-template <class CharType, class CharTraits>
+template <class CharType, class CharTraits, class Alloc, class Growth>
 template <class Iter>
-void basic_string<CharType, CharTraits>::
+void basic_string<CharType, CharTraits, Alloc, Growth>::
 copy_init(Iter first, Iter last, MySTL::forward_iterator_tag) {
     const size_type n = MySTL::distance(first, last);
     const auto      init_size = MySTL::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
     try {
-        buffer_ = data_allocator::allocate(init_size);
+        buffer_ = alloc_traits::allocate(get_alloc(), init_size);
         size_ = n;
         cap_ = init_size;
         MySTL::uninitialized_copy(first, last, buffer_);
@@ -1466,56 +1585,77 @@ copy_init(Iter first, Iter last, MySTL::forward_iterator_tag) {
     }
 }
 
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+void basic_string<CharType, CharTraits, Alloc, Growth>::
 init_from(const_pointer src, size_type pos, size_type count) {
     const auto init_size = MySTL::max(static_cast<size_type>(STRING_INIT_SIZE), count + 1);
-    buffer_ = data_allocator::allocate(init_size);
+    buffer_ = alloc_traits::allocate(get_alloc(), init_size);
     char_traits::copy(buffer_, src + pos, count);
     size_ = count;
     cap_ = init_size;
 }
 
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+void basic_string<CharType, CharTraits, Alloc, Growth>::
 destroy_buffer() {
     if (buffer_ != nullptr){
-        data_allocator::deallocate(buffer_, cap_);
+        alloc_traits::deallocate(get_alloc(), buffer_, cap_);
         buffer_ = nullptr;
         size_ = 0;
         cap_ = 0;
     }
 }
 
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::const_pointer
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::const_pointer
+basic_string<CharType, CharTraits, Alloc, Growth>::
 to_raw_pointer() const {
+    if (buffer_ == nullptr)
+        return &empty_char();
     *(buffer_ + size_) = value_type();
     return buffer_;
 }
 
 // reinsert, 重新分配内存 
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+void basic_string<CharType, CharTraits, Alloc, Growth>::
 reinsert(size_type size) {
-    auto new_buffer = data_allocator::allocate(size);
+    auto new_buffer = alloc_traits::allocate(get_alloc(), size);
     try {
         char_traits::move(new_buffer, buffer_, size);
     } catch (...) {
-        data_allocator::deallocate(new_buffer);
+        alloc_traits::deallocate(get_alloc(), new_buffer, size);
+        throw;
     }
+    if (buffer_ != nullptr)
+        alloc_traits::deallocate(get_alloc(), buffer_, cap_);
     buffer_ = new_buffer;
     size_ = size;
     cap_ = size;
 }
 
-// append_range, 末尾追加[first, last), 内的字符
-template <class CharType, class CharTraits>
+// copy_append, 末尾追加[first, last) 内的字符
+// 单趟输入迭代器：空间用完时按 Growth 扩容，在剩余空间内连续写入，并为结尾的空字符留一个位置
+template <class CharType, class CharTraits, class Alloc, class Growth>
 template <class Iter>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::
-append_range(Iter first, Iter last) {
+basic_string<CharType, CharTraits, Alloc, Growth>&
+basic_string<CharType, CharTraits, Alloc, Growth>::
+copy_append(Iter first, Iter last, MySTL::input_iterator_tag) {
+    while (first != last) {
+        if (size_ + 1 >= cap_)
+            reallocate(1);
+        for (auto p = buffer_ + size_; first != last && size_ + 1 != cap_; ++first, ++p, ++size_)
+            *p = *first;
+    }
+    return *this;
+}
+
+// 长度已知：至多分配一次，从字符指针复制时由 copy 转为 memmove
+template <class CharType, class CharTraits, class Alloc, class Growth>
+template <class Iter>
+basic_string<CharType, CharTraits, Alloc, Growth>&
+basic_string<CharType, CharTraits, Alloc, Growth>::
+copy_append(Iter first, Iter last, MySTL::forward_iterator_tag) {
     const size_type n = MySTL::distance(first, last);
     THROW_LENGTH_ERROR_IF(size_ > max_size() - n,
                           "basic_string<Char, Traits>'s size too big.");
@@ -1527,8 +1667,8 @@ append_range(Iter first, Iter last) {
     return *this;
 }
 
-template <class CharType, class CharTraits>
-int basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+int basic_string<CharType, CharTraits, Alloc, Growth>::
 compare_cstr(const_pointer s1, size_type n1,
              const_pointer s2, size_type n2) const {
     auto rlen = MySTL::min(n1, n2);
@@ -1540,9 +1680,9 @@ compare_cstr(const_pointer s1, size_type n1,
 }
 
 // relplace_cstr， 用str替换[first, first + count1)的字符
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>&
+basic_string<CharType, CharTraits, Alloc, Growth>::
 replace_cstr(const_pointer first, size_type count1,
              const_pointer str, size_type count2) {
     if (static_cast<size_type>(cend() - first) < count1) {
@@ -1569,9 +1709,9 @@ replace_cstr(const_pointer first, size_type count1,
 }
 
 // replace_fill, 用count2个ch替换[first, first + count1)的字符
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>&
+basic_string<CharType, CharTraits, Alloc, Growth>::
 replace_fill(const_pointer first, size_type count1,
              size_type count2, value_type ch) {
     if (static_cast<size_type>(cend() - first) < count1) {
@@ -1598,10 +1738,10 @@ replace_fill(const_pointer first, size_type count1,
 }
 
 // replace_copy, 把[first1, last1)替换为[first2, last2)的字符
-template <class CharType, class CharTraits>
+template <class CharType, class CharTraits, class Alloc, class Growth>
 template <class Iter>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::
+basic_string<CharType, CharTraits, Alloc, Growth>&
+basic_string<CharType, CharTraits, Alloc, Growth>::
 replace_copy(const_pointer first1, const_iterator last1,
              Iter first2, Iter last2) {
     size_type len1 = last1 - first1;
@@ -1627,30 +1767,33 @@ replace_copy(const_pointer first1, const_iterator last1,
 }
 
 // reallocate, 分配更多的内存
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+void basic_string<CharType, CharTraits, Alloc, Growth>::
 reallocate(size_type need) {
-    const auto new_cap = MySTL::max(cap_ + need, cap_ + (cap_ >> 1));
-    auto       new_buffer = data_allocator::allocate(new_cap);
-    char_traits::move(new_buffer, buffer_, size_);
-    data_allocator::deallocate(buffer_);
+    const auto new_cap = get_new_cap(need);
+    auto       new_buffer = alloc_traits::allocate(get_alloc(), new_cap);
+    if (buffer_ != nullptr) {
+        char_traits::move(new_buffer, buffer_, size_);
+        alloc_traits::deallocate(get_alloc(), buffer_, cap_);
+    }
     buffer_ = new_buffer;
     cap_ = new_cap;
 }
 
 // reallocate_and_fill, 在pos处插入n个ch, 后续内容不变
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::iterator
-basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc, class Growth>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::iterator
+basic_string<CharType, CharTraits, Alloc, Growth>::
 reallocate_and_fill(iterator pos, size_type n, value_type ch) {
     const auto r = pos - buffer_;
     const auto old_cap = cap_;
-    const auto new_cap = MySTL::max(old_cap, old_cap + (old_cap >> 1));
-    auto       new_buffer = data_allocator::allocate(new_cap);
+    const auto new_cap = get_new_cap(n);
+    auto       new_buffer = alloc_traits::allocate(get_alloc(), new_cap);
     auto       e1 = char_traits::move(new_buffer, buffer_, r) + r; // 转移所有权后的新的插入所在起始位置
     auto       e2 = char_traits::fill(e1, ch, n) + n;
     char_traits::move(e2, buffer_ + r, size_ - r); // 转移buffer_后面内容的所有权
-    data_allocator::deallocate(buffer_, old_cap);
+    if (buffer_ != nullptr)
+        alloc_traits::deallocate(get_alloc(), buffer_, old_cap);
     buffer_ = new_buffer;
     size_ += n;
     cap_ = new_cap;
@@ -1658,19 +1801,21 @@ reallocate_and_fill(iterator pos, size_type n, value_type ch) {
 }
 
 // reallocate_and_copy, 在pos处插入[first, last)的内容, 后续内容不变
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::iterator
-basic_string<CharType, CharTraits>::
-reallocate_and_copy(iterator pos, const_iterator first, const_iterator last) {
+template <class CharType, class CharTraits, class Alloc, class Growth>
+template <class Iter>
+typename basic_string<CharType, CharTraits, Alloc, Growth>::iterator
+basic_string<CharType, CharTraits, Alloc, Growth>::
+reallocate_and_copy(iterator pos, Iter first, Iter last) {
     const auto      r = pos - buffer_;
     const auto      old_cap = cap_;
     const size_type n = MySTL::distance(first, last);
-    const auto      new_cap = MySTL::max(old_cap + n, old_cap + (old_cap >> 1));
-    auto            new_buffer = data_allocator::allocate(new_cap);
+    const auto      new_cap = get_new_cap(n);
+    auto            new_buffer = alloc_traits::allocate(get_alloc(), new_cap);
     auto            e1 = char_traits::move(new_buffer, buffer_, r) + r;
-    auto            e2 = uninitialized_copy_n(first, n, e1) + n;
+    auto            e2 = uninitialized_copy_n(first, n, e1);
     char_traits::move(e2, buffer_ + r, size_ - r); // 保留pos后面的内容
-    data_allocator::deallocate(buffer_, old_cap);
+    if (buffer_ != nullptr)
+        alloc_traits::deallocate(get_alloc(), buffer_, old_cap);
     buffer_ = new_buffer;
     size_ += n;
     cap_ = new_cap;
@@ -1680,167 +1825,171 @@ reallocate_and_copy(iterator pos, const_iterator first, const_iterator last) {
 /*********************************** 重载全局操作符 ***********************************/
 
 // 重载 operator+
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(const basic_string<CharType, CharTraits>& lhs,
-          const basic_string<CharType, CharTraits>& rhs) {
-    basic_string<CharType, CharTraits> tmp(lhs);
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>
+operator+(const basic_string<CharType, CharTraits, Alloc, Growth>& lhs,
+          const basic_string<CharType, CharTraits, Alloc, Growth>& rhs) {
+    basic_string<CharType, CharTraits, Alloc, Growth> tmp(lhs);
     tmp.append(rhs);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>
 operator+(const CharType*                           lhs,
-          const basic_string<CharType, CharTraits>& rhs) {
-    basic_string<CharType, CharTraits> tmp(lhs);
+          const basic_string<CharType, CharTraits, Alloc, Growth>& rhs) {
+    basic_string<CharType, CharTraits, Alloc, Growth> tmp(lhs);
     tmp.append(rhs);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>
 operator+(CharType                                  ch,
-          const basic_string<CharType, CharTraits>& rhs) {
-    basic_string<CharType, CharTraits> tmp(1, ch);
+          const basic_string<CharType, CharTraits, Alloc, Growth>& rhs) {
+    basic_string<CharType, CharTraits, Alloc, Growth> tmp(1, ch);
     tmp.append(rhs);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(const basic_string<CharType, CharTraits>& lhs,
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>
+operator+(const basic_string<CharType, CharTraits, Alloc, Growth>& lhs,
           const CharType*                           rhs) {
-    basic_string<CharType, CharTraits> tmp(lhs);
+    basic_string<CharType, CharTraits, Alloc, Growth> tmp(lhs);
     tmp.append(rhs);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(const basic_string<CharType, CharTraits>& lhs,
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>
+operator+(const basic_string<CharType, CharTraits, Alloc, Growth>& lhs,
           CharType                                  ch) {
-    basic_string<CharType, CharTraits> tmp(lhs);
+    basic_string<CharType, CharTraits, Alloc, Growth> tmp(lhs);
     tmp.append(1, ch);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(basic_string<CharType, CharTraits>&&      lhs,
-          const basic_string<CharType, CharTraits>& rhs) {
-    basic_string<CharType, CharTraits> tmp(MySTL::move(lhs));
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>
+operator+(basic_string<CharType, CharTraits, Alloc, Growth>&&      lhs,
+          const basic_string<CharType, CharTraits, Alloc, Growth>& rhs) {
+    basic_string<CharType, CharTraits, Alloc, Growth> tmp(MySTL::move(lhs));
     tmp.append(rhs);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(const basic_string<CharType, CharTraits>& lhs,
-          basic_string<CharType, CharTraits>&&      rhs) {
-    basic_string<CharType, CharTraits> tmp(MySTL::move(rhs));
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>
+operator+(const basic_string<CharType, CharTraits, Alloc, Growth>& lhs,
+          basic_string<CharType, CharTraits, Alloc, Growth>&&      rhs) {
+    basic_string<CharType, CharTraits, Alloc, Growth> tmp(MySTL::move(rhs));
     tmp.insert(tmp.begin(), lhs.begin(), lhs.end());
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(basic_string<CharType, CharTraits>&& lhs,
-          basic_string<CharType, CharTraits>&& rhs) {
-    basic_string<CharType, CharTraits> tmp(MySTL::move(lhs));
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>
+operator+(basic_string<CharType, CharTraits, Alloc, Growth>&& lhs,
+          basic_string<CharType, CharTraits, Alloc, Growth>&& rhs) {
+    basic_string<CharType, CharTraits, Alloc, Growth> tmp(MySTL::move(lhs));
     tmp.append(rhs);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>
 operator+(const CharType*                      lhs,
-          basic_string<CharType, CharTraits>&& rhs) {
-    basic_string<CharType, CharTraits> tmp(MySTL::move(rhs));
+          basic_string<CharType, CharTraits, Alloc, Growth>&& rhs) {
+    basic_string<CharType, CharTraits, Alloc, Growth> tmp(MySTL::move(rhs));
     tmp.insert(tmp.begin(), lhs, lhs + char_traits<CharType>::length(lhs));
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>
 operator+(CharType                             ch,
-          basic_string<CharType, CharTraits>&& rhs) {
-    basic_string<CharType, CharTraits> tmp(MySTL::move(rhs));
+          basic_string<CharType, CharTraits, Alloc, Growth>&& rhs) {
+    basic_string<CharType, CharTraits, Alloc, Growth> tmp(MySTL::move(rhs));
     tmp.insert(tmp.begin(), ch);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(basic_string<CharType, CharTraits>&& lhs,
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>
+operator+(basic_string<CharType, CharTraits, Alloc, Growth>&& lhs,
           const CharType*                      rhs) {
-    basic_string<CharType, CharTraits> tmp(MySTL::move(lhs));
+    basic_string<CharType, CharTraits, Alloc, Growth> tmp(MySTL::move(lhs));
     tmp.append(rhs);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(basic_string<CharType, CharTraits>&& lhs,
+template <class CharType, class CharTraits, class Alloc, class Growth>
+basic_string<CharType, CharTraits, Alloc, Growth>
+operator+(basic_string<CharType, CharTraits, Alloc, Growth>&& lhs,
           CharType                             ch) {
-    basic_string<CharType, CharTraits> tmp(MySTL::move(lhs));
+    basic_string<CharType, CharTraits, Alloc, Growth> tmp(MySTL::move(lhs));
     tmp.append(1, ch);
     return tmp;
 }
 
 // 重载 比较操作符
 
-template <class CharType, class CharTraits>
-bool operator==(const basic_string<CharType, CharTraits>& lhs,
-                const basic_string<CharType, CharTraits>& rhs) {
+template <class CharType, class CharTraits, class Alloc, class Growth>
+bool operator==(const basic_string<CharType, CharTraits, Alloc, Growth>& lhs,
+                const basic_string<CharType, CharTraits, Alloc, Growth>& rhs) {
     return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
 }
 
-template <class CharType, class CharTraits>
-bool operator!=(const basic_string<CharType, CharTraits>& lhs,
-                const basic_string<CharType, CharTraits>& rhs) {
+template <class CharType, class CharTraits, class Alloc, class Growth>
+bool operator!=(const basic_string<CharType, CharTraits, Alloc, Growth>& lhs,
+                const basic_string<CharType, CharTraits, Alloc, Growth>& rhs) {
     return lhs.size() != rhs.size() || lhs.compare(rhs) != 0;
 }
 
-template <class CharType, class CharTraits>
-bool operator<(const basic_string<CharType, CharTraits>& lhs,
-               const basic_string<CharType, CharTraits>& rhs) {
+template <class CharType, class CharTraits, class Alloc, class Growth>
+bool operator<(const basic_string<CharType, CharTraits, Alloc, Growth>& lhs,
+               const basic_string<CharType, CharTraits, Alloc, Growth>& rhs) {
     return lhs.compare(rhs) < 0;
 }
 
-template <class CharType, class CharTraits>
-bool operator<=(const basic_string<CharType, CharTraits>& lhs,
-                const basic_string<CharType, CharTraits>& rhs) {
+template <class CharType, class CharTraits, class Alloc, class Growth>
+bool operator<=(const basic_string<CharType, CharTraits, Alloc, Growth>& lhs,
+                const basic_string<CharType, CharTraits, Alloc, Growth>& rhs) {
     return lhs.compare(rhs) <= 0;
 }
 
-template <class CharType, class CharTraits>
-bool operator>(const basic_string<CharType, CharTraits>& lhs,
-               const basic_string<CharType, CharTraits>& rhs) {
+template <class CharType, class CharTraits, class Alloc, class Growth>
+bool operator>(const basic_string<CharType, CharTraits, Alloc, Growth>& lhs,
+               const basic_string<CharType, CharTraits, Alloc, Growth>& rhs) {
     return lhs.compare(rhs) > 0;
 }
 
-template <class CharType, class CharTraits>
-bool operator>=(const basic_string<CharType, CharTraits>& lhs,
-                const basic_string<CharType, CharTraits>& rhs) {
+template <class CharType, class CharTraits, class Alloc, class Growth>
+bool operator>=(const basic_string<CharType, CharTraits, Alloc, Growth>& lhs,
+                const basic_string<CharType, CharTraits, Alloc, Growth>& rhs) {
     return lhs.compare(rhs) >= 0;
 }
 
 // 重载全局 swap
-template <class CharType, class CharTraits>
-void swap(basic_string<CharType, CharTraits>& lhs,
-          basic_string<CharType, CharTraits>& rhs) noexcept {
+template <class CharType, class CharTraits, class Alloc, class Growth>
+void swap(basic_string<CharType, CharTraits, Alloc, Growth>& lhs,
+          basic_string<CharType, CharTraits, Alloc, Growth>& rhs) noexcept {
     lhs.swap(rhs); // effictive c++ item 25, use member swap
 }
 
 // 特化 MySTL::hash
-template <class CharType, class CharTraits>
-struct hash<basic_string<CharType, CharTraits>> {
-    size_t operator()(const basic_string<CharType, CharTraits>& str) const {
+template <class CharType, class CharTraits, class Alloc, class Growth>
+struct hash<basic_string<CharType, CharTraits, Alloc, Growth>> {
+    size_t operator()(const basic_string<CharType, CharTraits, Alloc, Growth>& str) const {
         return bitwise_hash((const unsigned char*)str.c_str(), str.size() * sizeof(CharType));
     }
 };
 
+// basic_string 没有小字符串优化，数据总在堆上，可以按字节搬移
+template <class CharType, class CharTraits, class Alloc, class Growth>
+struct is_trivially_relocatable<basic_string<CharType, CharTraits, Alloc, Growth>> : is_trivially_relocatable<Alloc> {};
+
 }  // namespace MySTL
 
 #endif /* MY_BASIC_STRING_H */
\ No newline at end of file
@@ -0,0 +1,649 @@
+#ifndef MY_BIT_VECTOR_H
+#define MY_BIT_VECTOR_H
+
+// vector<bool> 特化版本
+// 每个 bool 只占一位，按 bit_word 整字保存。operator[] 和迭代器返回代理对象 bit_reference，
+// 因此 vector<bool> 不是真正的容器：不能取元素的地址，auto x = v[i] 得到的是代理而不是 bool
+// 对位迭代器重载了 count / find / fill / copy / copy_backward / equal，一次处理一个字，
+// 计数和查找分别使用 popcount 和 ctz
+// 本文件由 vector.h 末尾包含，也可以单独包含
+
+#include "vector.h"
+
+namespace MySTL {
+
+typedef size_t bit_word;
+
+enum { BIT_WORD_BITS = sizeof(bit_word) * 8 };
+
+/*********************************** 字操作 ***********************************/
+
+inline size_t bit_popcount(bit_word w) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_popcountll(w));
+#else
+    size_t n = 0;
+    for (; w != 0; w &= w - 1)
+        ++n;
+    return n;
+#endif
+}
+
+// w 不为 0
+inline size_t bit_ctz(bit_word w) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctzll(w));
+#else
+    size_t n = 0;
+    for (; (w & 1) == 0; w >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+// 低 n 位为 1 的掩码，n <= BIT_WORD_BITS
+inline bit_word bit_mask(size_t n) noexcept {
+    return n >= BIT_WORD_BITS ? ~bit_word(0) : (bit_word(1) << n) - 1;
+}
+
+// 读取从 p 的第 off 位开始的 n 位，放在返回值的低 n 位，1 <= n <= BIT_WORD_BITS，可以跨越两个字
+inline bit_word bit_get(const bit_word* p, size_t off, size_t n) noexcept {
+    bit_word w = p[0] >> off;
+    if (off + n > BIT_WORD_BITS)
+        w |= p[1] << (BIT_WORD_BITS - off);
+    return w & bit_mask(n);
+}
+
+// 把 v 的低 n 位写到从 p 的第 off 位开始的位置，其余位不变
+inline void bit_set(bit_word* p, size_t off, size_t n, bit_word v) noexcept {
+    const bit_word m = bit_mask(n);
+    v &= m;
+    p[0] = (p[0] & ~(m << off)) | (v << off);
+    if (off + n > BIT_WORD_BITS) {
+        const size_t   shift = BIT_WORD_BITS - off;
+        const bit_word hi = m >> shift;
+        p[1] = (p[1] & ~hi) | (v >> shift);
+    }
+}
+
+/*********************************** bit_reference ***********************************/
+
+// 指向某一位的代理引用
+struct bit_reference {
+    bit_word* p;
+    bit_word  mask;
+
+    bit_reference(bit_word* x, bit_word m) noexcept : p(x), mask(m) {}
+    bit_reference(const bit_reference&) = default;
+
+    operator bool() const noexcept { return (*p & mask) != 0; }
+
+    bit_reference& operator=(bool x) noexcept {
+        if (x)
+            *p |= mask;
+        else
+            *p &= ~mask;
+        return *this;
+    }
+    bit_reference& operator=(const bit_reference& x) noexcept { return *this = static_cast<bool>(x); }
+
+    bool operator==(const bit_reference& x) const noexcept { return static_cast<bool>(*this) == static_cast<bool>(x); }
+    bool operator<(const bit_reference& x) const noexcept { return !static_cast<bool>(*this) && static_cast<bool>(x); }
+
+    void flip() noexcept { *p ^= mask; }
+};
+
+// 代理对象以值传递，交换的是它们指向的位；iter_swap 通过实参相关查找找到它
+inline void swap(bit_reference x, bit_reference y) noexcept {
+    const bool tmp = x;
+    x = y;
+    y = tmp;
+}
+
+/*********************************** bit_iterator ***********************************/
+
+template <bool IsConst>
+struct bit_iterator : public iterator<random_access_iterator_tag, bool> {
+    typedef random_access_iterator_tag                                          iterator_category;
+    typedef bool                                                                value_type;
+    typedef ptrdiff_t                                                           difference_type;
+    typedef typename std::conditional<IsConst, bool, bit_reference>::type       reference;
+    typedef typename std::conditional<IsConst, const bool*, bit_reference*>::type pointer;
+    typedef typename std::conditional<IsConst, const bit_word*, bit_word*>::type  word_pointer;
+    typedef bit_iterator                                                        self;
+
+    word_pointer p;
+    size_t       offset;  // 在 *p 中的位置，0 <= offset < BIT_WORD_BITS
+
+    bit_iterator() noexcept : p(nullptr), offset(0) {}
+    bit_iterator(word_pointer x, size_t off) noexcept : p(x), offset(off) {}
+
+    // iterator 可以转换为 const_iterator
+    template <bool C, typename std::enable_if<IsConst && !C, int>::type = 0>
+    bit_iterator(const bit_iterator<C>& rhs) noexcept : p(rhs.p), offset(rhs.offset) {}
+
+    reference operator*() const { return deref(std::integral_constant<bool, IsConst>()); }
+
+    difference_type operator-(const self& x) const {
+        return static_cast<difference_type>(BIT_WORD_BITS) * (p - x.p) +
+               static_cast<difference_type>(offset) - static_cast<difference_type>(x.offset);
+    }
+
+    self& operator++() {
+        if (++offset == BIT_WORD_BITS) {
+            offset = 0;
+            ++p;
+        }
+        return *this;
+    }
+
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    self& operator--() {
+        if (offset-- == 0) {
+            offset = BIT_WORD_BITS - 1;
+            --p;
+        }
+        return *this;
+    }
+
+    self operator--(int) {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    self& operator+=(difference_type n) {
+        difference_type bits = n + static_cast<difference_type>(offset);
+        difference_type words = bits / static_cast<difference_type>(BIT_WORD_BITS);
+        bits %= static_cast<difference_type>(BIT_WORD_BITS);
+        if (bits < 0) {
+            bits += BIT_WORD_BITS;
+            --words;
+        }
+        p += words;
+        offset = static_cast<size_t>(bits);
+        return *this;
+    }
+
+    self operator+(difference_type n) const {
+        self tmp = *this;
+        return tmp += n;
+    }
+
+    self& operator-=(difference_type n) { return *this += -n; }
+
+    self operator-(difference_type n) const {
+        self tmp = *this;
+        return tmp -= n;
+    }
+
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    bool operator==(const self& rhs) const { return p == rhs.p && offset == rhs.offset; }
+    bool operator<(const self& rhs) const { return p < rhs.p || (p == rhs.p && offset < rhs.offset); }
+    bool operator!=(const self& rhs) const { return !(*this == rhs); }
+    bool operator>(const self& rhs) const { return rhs < *this; }
+    bool operator<=(const self& rhs) const { return !(rhs < *this); }
+    bool operator>=(const self& rhs) const { return !(*this < rhs); }
+
+private:
+    bool deref(std::true_type) const { return ((*p >> offset) & 1) != 0; }
+    bit_reference deref(std::false_type) const {
+        return bit_reference(const_cast<bit_word*>(p), bit_word(1) << offset);
+    }
+};
+
+template <bool IsConst>
+bit_iterator<IsConst> operator+(ptrdiff_t n, const bit_iterator<IsConst>& it) {
+    return it + n;
+}
+
+/*********************************** 按字处理的算法 ***********************************/
+
+/**
+ * @brief count 的位迭代器版本，每次对一个字做 popcount
+ */
+template <bool C, class T>
+size_t count(bit_iterator<C> first, bit_iterator<C> last, const T& value) {
+    const size_t total = static_cast<size_t>(last - first);
+    size_t       ones = 0;
+    for (size_t len = total; len > 0;) {
+        const size_t k = MySTL::min(len, static_cast<size_t>(BIT_WORD_BITS) - first.offset);
+        ones += bit_popcount(bit_get(first.p, first.offset, k));
+        len -= k;
+        ++first.p;
+        first.offset = 0;
+    }
+    return static_cast<bool>(value) ? ones : total - ones;
+}
+
+/**
+ * @brief find 的位迭代器版本，每次检查一个字，命中后用 ctz 定位
+ */
+template <bool C, class T>
+bit_iterator<C> find(bit_iterator<C> first, bit_iterator<C> last, const T& value) {
+    const bit_word flip = static_cast<bool>(value) ? bit_word(0) : ~bit_word(0);
+    for (size_t len = static_cast<size_t>(last - first); len > 0;) {
+        const size_t   k = MySTL::min(len, static_cast<size_t>(BIT_WORD_BITS) - first.offset);
+        const bit_word w = (bit_get(first.p, first.offset, k) ^ flip) & bit_mask(k);
+        if (w != 0)
+            return first + static_cast<ptrdiff_t>(bit_ctz(w));
+        first += static_cast<ptrdiff_t>(k);
+        len -= k;
+    }
+    return first;
+}
+
+/**
+ * @brief fill 的位迭代器版本，除首尾两个字外整字写入
+ */
+template <class T>
+void fill(bit_iterator<false> first, bit_iterator<false> last, const T& value) {
+    const bit_word w = static_cast<bool>(value) ? ~bit_word(0) : bit_word(0);
+    for (size_t len = static_cast<size_t>(last - first); len > 0;) {
+        const size_t k = MySTL::min(len, static_cast<size_t>(BIT_WORD_BITS) - first.offset);
+        bit_set(first.p, first.offset, k, w);
+        len -= k;
+        ++first.p;
+        first.offset = 0;
+    }
+}
+
+/**
+ * @brief copy 的位迭代器版本，按目标的字边界分段，每段最多读两个字、写一个字
+ * @note 与 copy 相同，允许 result 位于 first 之前的重叠区间
+ */
+template <bool C>
+bit_iterator<false> copy(bit_iterator<C> first, bit_iterator<C> last, bit_iterator<false> result) {
+    for (size_t len = static_cast<size_t>(last - first); len > 0;) {
+        const size_t k = MySTL::min(len, static_cast<size_t>(BIT_WORD_BITS) - result.offset);
+        bit_set(result.p, result.offset, k, bit_get(first.p, first.offset, k));
+        first += static_cast<ptrdiff_t>(k);
+        result += static_cast<ptrdiff_t>(k);
+        len -= k;
+    }
+    return result;
+}
+
+/**
+ * @brief copy_backward 的位迭代器版本，从尾部按目标的字边界分段
+ */
+template <bool C>
+bit_iterator<false> copy_backward(bit_iterator<C> first, bit_iterator<C> last, bit_iterator<false> result) {
+    for (size_t len = static_cast<size_t>(last - first); len > 0;) {
+        const size_t k = MySTL::min(len, result.offset == 0 ? static_cast<size_t>(BIT_WORD_BITS) : result.offset);
+        last -= static_cast<ptrdiff_t>(k);
+        result -= static_cast<ptrdiff_t>(k);
+        bit_set(result.p, result.offset, k, bit_get(last.p, last.offset, k));
+        len -= k;
+    }
+    return result;
+}
+
+/**
+ * @brief equal 的位迭代器版本，逐字比较
+ */
+template <bool C1, bool C2>
+bool equal(bit_iterator<C1> first1, bit_iterator<C1> last1, bit_iterator<C2> first2) {
+    for (size_t len = static_cast<size_t>(last1 - first1); len > 0;) {
+        const size_t k = MySTL::min(len, static_cast<size_t>(BIT_WORD_BITS) - first1.offset);
+        if (bit_get(first1.p, first1.offset, k) != bit_get(first2.p, first2.offset, k))
+            return false;
+        first1 += static_cast<ptrdiff_t>(k);
+        first2 += static_cast<ptrdiff_t>(k);
+        len -= k;
+    }
+    return true;
+}
+
+/*********************************** vector<bool> ***********************************/
+
+template <class Alloc, class Growth>
+class vector<bool, Alloc, Growth>
+    : private alloc_holder<typename allocator_traits<Alloc>::template rebind_alloc<bit_word>> {
+public:
+    typedef Alloc                                                       allocator_type;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<bit_word> word_allocator;
+    typedef MySTL::allocator_traits<word_allocator>                     alloc_traits;
+
+    typedef bool                                        value_type;
+    typedef bit_reference                               reference;
+    typedef bool                                        const_reference;
+    typedef bit_reference*                              pointer;
+    typedef const bool*                                 const_pointer;
+    typedef size_t                                      size_type;
+    typedef ptrdiff_t                                   difference_type;
+
+    typedef bit_iterator<false>                         iterator;
+    typedef bit_iterator<true>                          const_iterator;
+    typedef MySTL::reverse_iterator<iterator>           reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator>     const_reverse_iterator;
+
+    allocator_type get_allocator() const { return allocator_type(get_alloc()); }
+
+private:
+    typedef alloc_holder<word_allocator>                alloc_base;
+    using alloc_base::get_alloc;
+
+    bit_word* words_;
+    size_type size_;       // 位数
+    size_type cap_words_;  // 已分配的字数
+
+public:
+    /*********************************** 构造，复制，移动，析构 ***********************************/
+
+    vector() noexcept : words_(nullptr), size_(0), cap_words_(0) {}
+
+    explicit vector(const allocator_type& alloc) noexcept :
+        alloc_base(word_allocator(alloc)), words_(nullptr), size_(0), cap_words_(0) {}
+
+    explicit vector(size_type n, const allocator_type& alloc = allocator_type()) :
+        alloc_base(word_allocator(alloc)), words_(nullptr), size_(0), cap_words_(0) {
+        fill_insert(0, n, false);
+    }
+
+    vector(size_type n, const value_type& value, const allocator_type& alloc = allocator_type()) :
+        alloc_base(word_allocator(alloc)), words_(nullptr), size_(0), cap_words_(0) {
+        fill_insert(0, n, value);
+    }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    vector(Iter first, Iter last, const allocator_type& alloc = allocator_type()) :
+        alloc_base(word_allocator(alloc)), words_(nullptr), size_(0), cap_words_(0) {
+        copy_insert(0, first, last, iterator_category(first));
+    }
+
+    vector(std::initializer_list<bool> ilist, const allocator_type& alloc = allocator_type()) :
+        alloc_base(word_allocator(alloc)), words_(nullptr), size_(0), cap_words_(0) {
+        copy_insert(0, ilist.begin(), ilist.end(), MySTL::forward_iterator_tag());
+    }
+
+    vector(const vector& rhs) :
+        alloc_base(alloc_traits::select_on_container_copy_construction(rhs.get_alloc())),
+        words_(nullptr), size_(0), cap_words_(0) {
+        copy_insert(0, rhs.begin(), rhs.end(), MySTL::forward_iterator_tag());
+    }
+
+    vector(vector&& rhs) noexcept :
+        alloc_base(MySTL::move(rhs.get_alloc())), words_(rhs.words_), size_(rhs.size_), cap_words_(rhs.cap_words_) {
+        rhs.words_ = nullptr;
+        rhs.size_ = 0;
+        rhs.cap_words_ = 0;
+    }
+
+    vector& operator=(const vector& rhs) {
+        if (this != &rhs) {
+            if (alloc_traits::propagate_on_container_copy_assignment::value &&
+                !MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+                release();
+            }
+            MySTL::alloc_on_copy(get_alloc(), rhs.get_alloc());
+            assign(rhs.begin(), rhs.end());
+        }
+        return *this;
+    }
+
+    // 分配器不传播且不相等时要重新分配并逐位复制，可能抛出异常
+    vector& operator=(vector&& rhs) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                             alloc_traits::is_always_equal::value) {
+        if (this == &rhs) return *this;
+        if (alloc_traits::propagate_on_container_move_assignment::value ||
+            MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+            release();
+            MySTL::alloc_on_move(get_alloc(), rhs.get_alloc());
+            words_ = rhs.words_;
+            size_ = rhs.size_;
+            cap_words_ = rhs.cap_words_;
+            rhs.words_ = nullptr;
+            rhs.size_ = 0;
+            rhs.cap_words_ = 0;
+        } else {
+            assign(rhs.begin(), rhs.end());
+            rhs.clear();
+        }
+        return *this;
+    }
+
+    vector& operator=(std::initializer_list<bool> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~vector() { release(); }
+
+public:
+    /*********************************** 迭代器相关操作 ***********************************/
+
+    iterator               begin() noexcept { return iterator(words_, 0); }
+    const_iterator         begin() const noexcept { return const_iterator(words_, 0); }
+    iterator               end() noexcept { return begin() + static_cast<difference_type>(size_); }
+    const_iterator         end() const noexcept { return begin() + static_cast<difference_type>(size_); }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin() const noexcept { return begin(); }
+    const_iterator         cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    /*********************************** 容器相关操作 ***********************************/
+
+    bool      empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1) - (BIT_WORD_BITS - 1); }
+    size_type capacity() const noexcept { return cap_words_ * BIT_WORD_BITS; }
+
+    void reserve(size_type n) {
+        if (capacity() < n) {
+            THROW_LENGTH_ERROR_IF(n > max_size(), "n can not bigger than max_size()"
+                                                  "in vector<bool>::reserve(n)");
+            reallocate_words(word_count(n));
+        }
+    }
+
+    void shrink_to_fit() {
+        if (word_count(size_) < cap_words_)
+            reallocate_words(word_count(size_));
+    }
+
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size());
+        return reference(words_ + n / BIT_WORD_BITS, bit_word(1) << (n % BIT_WORD_BITS));
+    }
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size());
+        return ((words_[n / BIT_WORD_BITS] >> (n % BIT_WORD_BITS)) & 1) != 0;
+    }
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "vector<bool> : out of range");
+        return (*this)[n];
+    }
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "vector<bool> : out of range");
+        return (*this)[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return (*this)[0];
+    }
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return (*this)[0];
+    }
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return (*this)[size_ - 1];
+    }
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return (*this)[size_ - 1];
+    }
+
+    // 底层的字数组，最后一个字中超出 size() 的位没有意义
+    bit_word*       words() noexcept { return words_; }
+    const bit_word* words() const noexcept { return words_; }
+
+    /*********************************** 修改容器相关操作 ***********************************/
+
+    void assign(size_type n, const value_type& value) {
+        clear();
+        fill_insert(0, n, value);
+    }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    void assign(Iter first, Iter last) {
+        clear();
+        copy_insert(0, first, last, iterator_category(first));
+    }
+
+    void assign(std::initializer_list<bool> il) { assign(il.begin(), il.end()); }
+
+    void push_back(bool value) {
+        if (size_ == capacity())
+            grow_for(1);
+        ++size_;
+        (*this)[size_ - 1] = value;
+    }
+
+    void emplace_back(bool value) { push_back(value); }
+
+    void pop_back() {
+        MYSTL_DEBUG(!empty());
+        --size_;
+    }
+
+    iterator insert(const_iterator pos, bool value) { return insert(pos, 1, value); }
+
+    iterator insert(const_iterator pos, size_type n, bool value) {
+        MYSTL_DEBUG(pos >= cbegin() && pos <= cend());
+        const size_type index = static_cast<size_type>(pos - cbegin());
+        fill_insert(index, n, value);
+        return begin() + static_cast<difference_type>(index);
+    }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    iterator insert(const_iterator pos, Iter first, Iter last) {
+        MYSTL_DEBUG(pos >= cbegin() && pos <= cend());
+        const size_type index = static_cast<size_type>(pos - cbegin());
+        copy_insert(index, first, last, iterator_category(first));
+        return begin() + static_cast<difference_type>(index);
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<bool> il) { return insert(pos, il.begin(), il.end()); }
+
+    iterator erase(const_iterator pos) {
+        MYSTL_DEBUG(pos >= cbegin() && pos < cend());
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        MYSTL_DEBUG(first >= cbegin() && last <= cend() && !(last < first));
+        const auto r = begin() + (first - cbegin());
+        MySTL::copy(last, cend(), r);
+        size_ -= static_cast<size_type>(last - first);
+        return r;
+    }
+
+    void clear() noexcept { size_ = 0; }
+
+    void resize(size_type new_size, bool value = false) {
+        if (new_size < size_)
+            size_ = new_size;
+        else
+            fill_insert(size_, new_size - size_, value);
+    }
+
+    // 所有位取反
+    void flip() noexcept {
+        for (size_type i = 0; i < word_count(size_); ++i)
+            words_[i] = ~words_[i];
+    }
+
+    void swap(vector& rhs) noexcept {
+        if (this != &rhs) {
+            MySTL::alloc_on_swap(get_alloc(), rhs.get_alloc());
+            MySTL::swap(words_, rhs.words_);
+            MySTL::swap(size_, rhs.size_);
+            MySTL::swap(cap_words_, rhs.cap_words_);
+        }
+    }
+
+    static void swap(reference x, reference y) noexcept { MySTL::swap(x, y); }
+
+private:
+    /*********************************** helper function ***********************************/
+
+    static size_type word_count(size_type bits) noexcept { return (bits + BIT_WORD_BITS - 1) / BIT_WORD_BITS; }
+
+    void release() noexcept {
+        if (words_ != nullptr)
+            alloc_traits::deallocate(get_alloc(), words_, cap_words_);
+        words_ = nullptr;
+        size_ = 0;
+        cap_words_ = 0;
+    }
+
+    // 把字数组调整为 n 个字，保留已有的位
+    void reallocate_words(size_type n) {
+        bit_word* new_words = n == 0 ? nullptr : alloc_traits::allocate(get_alloc(), n);
+        const size_type used = word_count(size_);
+        if (used != 0)
+            std::memcpy(new_words, words_, used * sizeof(bit_word));
+        if (words_ != nullptr)
+            alloc_traits::deallocate(get_alloc(), words_, cap_words_);
+        words_ = new_words;
+        cap_words_ = n;
+    }
+
+    // 保证至少还能容纳 add 位，新的字数由 Growth 决定
+    void grow_for(size_type add) {
+        THROW_LENGTH_ERROR_IF(add > max_size() - size_, "vector<bool>'s size too big");
+        if (size_ + add <= capacity()) return;
+        const size_type need = word_count(size_ + add);
+        const size_type n = Growth::next_capacity(cap_words_, need, sizeof(bit_word));
+        reallocate_words(MySTL::max(n, need));
+    }
+
+    // 在下标 index 处空出 n 位，之后的位整体后移
+    void open_gap(size_type index, size_type n) {
+        grow_for(n);
+        const iterator old_end = end();
+        size_ += n;
+        if (index != size_ - n)
+            MySTL::copy_backward(begin() + index, old_end, end());
+    }
+
+    void fill_insert(size_type index, size_type n, bool value) {
+        if (n == 0) return;
+        open_gap(index, n);
+        const iterator first = begin() + static_cast<difference_type>(index);
+        MySTL::fill(first, first + static_cast<difference_type>(n), value);
+    }
+
+    template <class Iter>
+    void copy_insert(size_type index, Iter first, Iter last, input_iterator_tag) {
+        for (; first != last; ++first, ++index)
+            fill_insert(index, 1, static_cast<bool>(*first));
+    }
+
+    template <class Iter>
+    void copy_insert(size_type index, Iter first, Iter last, forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(MySTL::distance(first, last));
+        if (n == 0) return;
+        open_gap(index, n);
+        MySTL::copy(first, last, begin() + static_cast<difference_type>(index));
+    }
+};
+
+}  // namespace MySTL
+
+#endif /* MY_BIT_VECTOR_H */
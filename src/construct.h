@@ -40,6 +40,9 @@ void destory_it(T* ptr, std::false_type) {
     if (ptr != nullptr) ptr->~T();
 }
 
+template <class T>
+void destroy(T* pointer);
+
 // SFINAE (substitudion failer is not an error 技术)
 template <class ForwardIter>
 void destory_cat(ForwardIter, ForwardIter, std::true_type) {}
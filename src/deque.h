@@ -2,6 +2,7 @@
 #define MY_DEQUE_H
 
 // 双端队列实现
+#include <cstring>
 #include <initializer_list>
 #include <type_traits>
 
@@ -18,19 +19,28 @@ namespace MySTL {
 #define DEQUE_MAP_INIT_SIZE 8
 #endif
 
-template <class T>
+// 每个 deque 最多缓存的空闲缓冲区个数，为 0 时不缓存
+// 在缓冲区边界附近反复 push / pop 时，缓冲区从缓存中取还，不再反复申请和释放
+#ifndef DEQUE_BLOCK_CACHE_SIZE
+#define DEQUE_BLOCK_CACHE_SIZE 8
+#endif
+
+// 每个缓冲区容纳的元素个数
+// BufSize 不为 0 时就是 BufSize，否则为 4096 字节能放下的元素个数，不小于 256 字节的类型每个缓冲区放 16 个
+// 对某个类型特化 deque_buf_size<T> 可以改变该类型所有 deque 的默认值，包括 queue、stack 的默认底层容器
+template <class T, size_t BufSize = 0>
 struct deque_buf_size {
-    static constexpr size_t value = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+    static constexpr size_t value = BufSize != 0 ? BufSize : sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
 };
 
 // deque 迭代器设计
-template <class t, class ref, class ptr>
+template <class t, class ref, class ptr, size_t BufSize = 0>
 struct deque_iterator : public iterator<random_access_iterator_tag, t> {
-    typedef deque_iterator<t, t&, t*>             iterator;
-    typedef deque_iterator<t, const t&, const t*> const_iterator;
-    typedef deque_iterator                        self;
+    typedef deque_iterator<t, t&, t*, BufSize>             iterator;
+    typedef deque_iterator<t, const t&, const t*, BufSize> const_iterator;
+    typedef deque_iterator                                 self;
 
-    static const size_t buffer_size = deque_buf_size<t>::value;
+    static const size_t buffer_size = deque_buf_size<t, BufSize>::value;
 
     typedef random_access_iterator_tag iterator_category;
     typedef t                          value_type;
@@ -107,7 +117,7 @@ struct deque_iterator : public iterator<random_access_iterator_tag, t> {
         return temp;
     }
 
-    self operator--() {
+    self& operator--() {
         if (cur == first) {
             set_node(node - 1);
             cur = last;
@@ -116,7 +126,7 @@ struct deque_iterator : public iterator<random_access_iterator_tag, t> {
         return *this;
     }
 
-    self& operator--(int) {
+    self operator--(int) {
         self temp = *this;
         --*this;
         return temp;
@@ -141,7 +151,7 @@ struct deque_iterator : public iterator<random_access_iterator_tag, t> {
         return tmp += n;
     }
 
-    self operator-=(difference_type n) {
+    self& operator-=(difference_type n) {
         return *this += -n;
     }
 
@@ -163,89 +173,122 @@ struct deque_iterator : public iterator<random_access_iterator_tag, t> {
     bool operator>=(const self& rhs) const { return !(*this < rhs); }
 };
 
+// deque 的迭代器按缓冲区分段，copy、fill、find、for_each、accumulate 等算法据此逐个缓冲区处理
+// end_ 所在的缓冲区总是已分配，且 cur 不会停在 last 上，所以 compose 可以读取下一个缓冲区
+template <class T, class Ref, class Ptr, size_t BufSize>
+struct segmented_iterator_traits<deque_iterator<T, Ref, Ptr, BufSize>> {
+    typedef m_true_type                                 is_segmented;
+    typedef deque_iterator<T, Ref, Ptr, BufSize>        iterator;
+    typedef typename iterator::map_pointer              segment_iterator;
+    typedef Ptr                                         local_iterator;
+
+    static segment_iterator segment(const iterator& it) noexcept { return it.node; }
+    static local_iterator   local(const iterator& it) noexcept { return it.cur; }
+    static local_iterator   begin(segment_iterator seg) noexcept { return *seg; }
+    static local_iterator   end(segment_iterator seg) noexcept { return *seg + iterator::buffer_size; }
+
+    static iterator compose(segment_iterator seg, local_iterator pos) noexcept {
+        if (pos == end(seg)) {
+            ++seg;
+            pos = begin(seg);
+        }
+        return iterator(const_cast<T*>(pos), seg);
+    }
+};
+
 // 模板类 deque
-template <class T>
-class deque {
+// BufSize 为每个缓冲区的元素个数，0 表示使用 deque_buf_size<T> 的默认值
+template <class T, class Alloc = MySTL::allocator<T>, size_t BufSize = 0>
+class deque : private alloc_holder<Alloc> {
 public:
-    typedef MySTL::allocator<T>                         allocator_type;
-    typedef MySTL::allocator<T>                         data_allocator;
-    typedef MySTL::allocator<T*>                        map_allocator;  // 该分配器负责分配不连续的每一段bufffer, 分段连续的线性空间` 
-
-    typedef typename allocator_type::value_type         value_type;
-    typedef typename allocator_type::pointer            pointer;
-    typedef typename allocator_type::const_pointer      const_pointer;
-    typedef typename allocator_type::reference          reference;
-    typedef typename allocator_type::const_reference    const_reference;
-    typedef typename allocator_type::size_type          size_type;
-    typedef typename allocator_type::difference_type    difference_type;
+    typedef Alloc                                                    allocator_type;
+    typedef MySTL::allocator_traits<Alloc>                           alloc_traits;
+    typedef typename alloc_traits::template rebind_alloc<T*>         map_allocator;  // 该分配器负责分配不连续的每一段bufffer, 分段连续的线性空间` 
+    typedef MySTL::allocator_traits<map_allocator>                   map_alloc_traits;
+
+    typedef T                                           value_type;
+    typedef T*                                          pointer;
+    typedef const T*                                    const_pointer;
+    typedef T&                                          reference;
+    typedef const T&                                    const_reference;
+    typedef size_t                                      size_type;
+    typedef ptrdiff_t                                   difference_type;
     typedef pointer*                                    map_pointer;
     typedef const_pointer*                              const_map_pointer;
 
-    typedef deque_iterator<T, T&, T*>                   iterator;
-    typedef deque_iterator<T, const T&, const T*>       const_iterator;
-    typedef MySTL::reverse_iterator<iterator>           reverse_iterator;
-    typedef MySTL::reverse_iterator<const_iterator>     const_reverse_iterator;
+    typedef deque_iterator<T, T&, T*, BufSize>             iterator;
+    typedef deque_iterator<T, const T&, const T*, BufSize> const_iterator;
+    typedef MySTL::reverse_iterator<iterator>              reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator>        const_reverse_iterator;
 
-    allocator_type get_allocator() {return data_allocator();}
+    allocator_type get_allocator() const { return get_alloc(); }
 
-    static const size_type buffer_size = deque_buf_size<T>::value;
+    static const size_type buffer_size = deque_buf_size<T, BufSize>::value;
 
 // 数据段
 private:
+    typedef alloc_holder<Alloc>                         alloc_base;
+    using alloc_base::get_alloc;
+
     iterator    begin_;
     iterator    end_;
     map_pointer map_;       // 指向map，map是一个指针数组，指向每一个缓冲区的起始位置
     size_type   map_size_;  // map内指针是的数目
+    pointer     spare_ = nullptr;  // 空闲缓冲区组成的单链表，next 指针保存在缓冲区的开头
+    size_type   spare_count_ = 0;
 
 public:
     /*********************************** 构造，复制，移动，析构 ***********************************/
 
     // 构造
-    deque() { fill_init(0, value_type()); }
+    deque() noexcept { empty_init(); }
 
-    explicit deque(size_type n) { fill_init(n, value_type()); }
+    explicit deque(const allocator_type& alloc) noexcept : alloc_base(alloc) { empty_init(); }
 
-    deque(size_type n, const value_type& value) { fill_init(n, value); }
+    explicit deque(size_type n, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc) { fill_init(n, value_type()); }
+
+    deque(size_type n, const value_type& value, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc) { fill_init(n, value); }
 
     template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
-    deque(Iter first, Iter last) {
-        MYSTL_DEBUG(!(last < first));
+    deque(Iter first, Iter last, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc) {
         copy_init(first, last, iterator_category(first));
     }
 
-    deque(std::initializer_list<value_type> ilist) { copy_init(ilist.begin(), ilist.end(), MySTL::forward_iterator_tag()); }
+    deque(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc) { copy_init(ilist.begin(), ilist.end(), MySTL::forward_iterator_tag()); }
 
-    // 复制
-    deque(const deque& rhs) { copy_init(rhs.begin(), rhs.end(), MySTL::forward_iterator_tag()); }
+    // 复制，分配器由 select_on_container_copy_construction 决定
+    deque(const deque& rhs) :
+        alloc_base(alloc_traits::select_on_container_copy_construction(rhs.get_alloc())) {
+        copy_init(rhs.begin(), rhs.end(), MySTL::forward_iterator_tag());
+    }
+
+    deque(const deque& rhs, const allocator_type& alloc) :
+        alloc_base(alloc) { copy_init(rhs.begin(), rhs.end(), MySTL::forward_iterator_tag()); }
 
     // 移动
     deque(deque&& rhs) noexcept :
+        alloc_base(MySTL::move(rhs.get_alloc())),
         begin_(MySTL::move(rhs.begin_)),
         end_(MySTL::move(rhs.end_)),
         map_(rhs.map_),
         map_size_(rhs.map_size_) {
-        rhs.map_ = nullptr;
-        rhs.map_size_ = 0;
+        rhs.empty_init();
     }
 
     deque& operator=(const deque& rhs);
     deque& operator=(deque&& rhs);
 
     deque& operator=(std::initializer_list<value_type> ilist) {
-        deque tmp(ilist);
+        deque tmp(ilist, get_alloc());
         swap(tmp);
         return *this;
     }
 
-    ~deque() {
-        if (map_ != nullptr) {
-            clear();
-            data_allocator::deallocate(*begin_.node, buffer_size);
-            *begin_.node = nullptr;
-            map_allocator::deallocate(map_, map_size_);
-            map_ = nullptr;
-        }
-    }
+    ~deque() { destroy_and_recover(); }
 
 public:
     /*********************************** 迭代器相关操作 ***********************************/
@@ -351,6 +394,25 @@ public:
                               MySTL::is_input_iterator<Iter>::value, int>::type = 0>
     void insert(iterator pos, Iter first, Iter last) { insert_dispatch(pos, first, last, iterator_category(first)); }
 
+    // 追加、插入、赋值整个区间(容器或内置数组)
+    // 能预先得到长度时一次预留全部缓冲区，单趟的输入迭代器逐个缓冲区写入，缓冲区内不再逐个检查容量
+    template <class Range>
+    void append_range(Range&& rg) {
+        insert_dispatch(end_, MySTL::range_begin(rg), MySTL::range_end(rg), iterator_category(MySTL::range_begin(rg)));
+    }
+
+    template <class Range>
+    iterator insert_range(iterator pos, Range&& rg) {
+        const size_type elems_before = pos - begin_;
+        insert_dispatch(pos, MySTL::range_begin(rg), MySTL::range_end(rg), iterator_category(MySTL::range_begin(rg)));
+        return begin_ + elems_before;
+    }
+
+    template <class Range>
+    void assign_range(Range&& rg) {
+        copy_assign(MySTL::range_begin(rg), MySTL::range_end(rg), iterator_category(MySTL::range_begin(rg)));
+    }
+
     // erase && claer, will return the new iter
 
     iterator erase(iterator pos);
@@ -366,10 +428,26 @@ private:
 
     // 创建queue中的buffer缓冲区
     map_pointer create_map(size_type size);
+    void        destroy_map(map_pointer mp, size_type size);
     void        create_buffer(map_pointer nstart, map_pointer nfinish);
     void        destroy_buffer(map_pointer nstart, map_pointer nfinish);
 
+    // 缓冲区缓存：取出时优先复用空闲缓冲区，归还时缓存未满则留下
+    pointer     take_block();
+    void        give_block(pointer block) noexcept;
+    void        release_spare_blocks() noexcept;
+
+    // 把 map 中 [begin_.node, end_.node] 之外仍持有的缓冲区归还并置空
+    void        release_idle_buffers() noexcept;
+
+    // 析构 [first, last) 中的元素，区间可以跨越多个缓冲区
+    void destroy_range(iterator first, iterator last);
+
+    // 释放所有元素、缓冲区以及 map
+    void destroy_and_recover();
+
     // 初始化，构造函数
+    void empty_init() noexcept;
     void map_init(size_type nelem);
     void fill_init(size_type n, const value_type& value);
     template <class Iter>
@@ -392,6 +470,8 @@ private:
     template <class Iter>
     void insert_dispatch(iterator pos, Iter first, Iter last, input_iterator_tag);
     template <class Iter>
+    void append_input(Iter first, Iter last);
+    template <class Iter>
     void insert_dispatch(iterator pos, Iter first, Iter last, forward_iterator_tag);
 
     // reallocate 实现内存重新组织
@@ -401,9 +481,15 @@ private:
 };
 
 // 复制赋值运算符
-template <class T>
-deque<T>& deque<T>::operator=(const deque& rhs) {
+template <class T, class Alloc, size_t BufSize>
+deque<T, Alloc, BufSize>& deque<T, Alloc, BufSize>::operator=(const deque& rhs) {
     if (this != &rhs) {
+        if (alloc_traits::propagate_on_container_copy_assignment::value &&
+            !MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+            // 分配器将被替换，旧的缓冲区和 map 必须先由旧分配器释放
+            destroy_and_recover();
+            MySTL::alloc_on_copy(get_alloc(), rhs.get_alloc());
+        }
         const auto len = size();
         if (len >= rhs.size()) {
             erase(MySTL::copy(rhs.begin_, rhs.end_, begin_), end_);
@@ -417,20 +503,30 @@ deque<T>& deque<T>::operator=(const deque& rhs) {
 }
 
 // 移动赋值运算符
-template <class T>
-deque<T>& deque<T>::operator=(deque&& rhs) {
-    clear();
-    begin_ = MySTL::move(rhs.begin_);
-    end_ = MySTL::move(rhs.end_);
-    map_ = rhs.map_;
-    map_size_ = rhs.map_size_;
-    rhs.map_ = nullptr;
-    rhs.map_size_ = 0;
+template <class T, class Alloc, size_t BufSize>
+deque<T, Alloc, BufSize>& deque<T, Alloc, BufSize>::operator=(deque&& rhs) {
+    if (this == &rhs) return *this;
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+        destroy_and_recover();
+        MySTL::alloc_on_move(get_alloc(), rhs.get_alloc());
+        begin_ = MySTL::move(rhs.begin_);
+        end_ = MySTL::move(rhs.end_);
+        map_ = rhs.map_;
+        map_size_ = rhs.map_size_;
+        rhs.empty_init();
+    } else {
+        // 分配器不相等且不传播，不能接管 rhs 的缓冲区，只能逐个移动元素
+        clear();
+        for (auto it = rhs.begin(); it != rhs.end(); ++it)
+            emplace_back(MySTL::move(*it));
+        rhs.clear();
+    }
     return *this;
 }
 
-template <class T>
-void deque<T>::resize(size_type new_size, const value_type& value) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::resize(size_type new_size, const value_type& value) {
     const auto len = size();
     if (new_size < len) {
         erase(begin_ + new_size, end_);
@@ -439,30 +535,38 @@ void deque<T>::resize(size_type new_size, const value_type& value) {
     }
 }
 
-template <class T>
-void deque<T>::shrink_to_fit() noexcept {
-    for (auto cur = map_; cur < begin_.node; ++cur) {
-        data_allocator::deallocate(*cur, buffer_size);
-        *cur = nullptr;
-    }
-    for (auto cur = end_.node + 1; cur < map_ + map_size_; ++cur) {
-        data_allocator::deallocate(*cur, buffer_size);
-        *cur = nullptr;
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::shrink_to_fit() noexcept {
+    if (map_ != nullptr) {
+        // map 中未使用的位置为空指针，只释放实际分配过的缓冲区
+        for (auto cur = map_; cur < begin_.node; ++cur) {
+            if (*cur != nullptr) {
+                alloc_traits::deallocate(get_alloc(), *cur, buffer_size);
+                *cur = nullptr;
+            }
+        }
+        for (auto cur = end_.node + 1; cur < map_ + map_size_; ++cur) {
+            if (*cur != nullptr) {
+                alloc_traits::deallocate(get_alloc(), *cur, buffer_size);
+                *cur = nullptr;
+            }
+        }
     }
+    release_spare_blocks();
 }
 
 // 头部就地构造元素
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class... Args>
-void deque<T>::emplace_front(Args&&... args) {
+void deque<T, Alloc, BufSize>::emplace_front(Args&&... args) {
     if (begin_.cur != begin_.first) {
-        data_allocator::construct(begin_.cur - 1, MySTL::forward<Args>(args)...);
+        alloc_traits::construct(get_alloc(), begin_.cur - 1, MySTL::forward<Args>(args)...);
         --begin_.cur;
     } else {
         require_capacity(1, true);
         try {
             --begin_;
-            data_allocator::construct(begin_.cur, MySTL::forward<Args>(args)...);
+            alloc_traits::construct(get_alloc(), begin_.cur, MySTL::forward<Args>(args)...);
         } catch (...) {
             ++begin_;
             throw;
@@ -471,22 +575,22 @@ void deque<T>::emplace_front(Args&&... args) {
 }
 
 // 在尾部就地构造元素
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class... Args>
-void deque<T>::emplace_back(Args&&... args) {
-    if (end_.cur != end_.last - 1) {
-        data_allocator::construct(end_.cur, MySTL::forward<Args>(args)...);
+void deque<T, Alloc, BufSize>::emplace_back(Args&&... args) {
+    if (end_.last - end_.cur > 1) {
+        alloc_traits::construct(get_alloc(), end_.cur, MySTL::forward<Args>(args)...);
         ++end_.cur;
     } else {
         require_capacity(1, false);
-        data_allocator::construct(end_.cur, MySTL::forward<Args>(args)...);
+        alloc_traits::construct(get_alloc(), end_.cur, MySTL::forward<Args>(args)...);
         ++end_;
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class... Args>
-typename deque<T>::iterator deque<T>::emplace(iterator pos, Args&&... args) {
+typename deque<T, Alloc, BufSize>::iterator deque<T, Alloc, BufSize>::emplace(iterator pos, Args&&... args) {
     if (pos.cur == begin_.cur) {
         emplace_front(MySTL::forward<Args>(args)...);
         return begin_;
@@ -497,16 +601,16 @@ typename deque<T>::iterator deque<T>::emplace(iterator pos, Args&&... args) {
     return insert_aux(pos, MySTL::forward<Args>(args)...);
 }
 
-template <class T>
-void deque<T>::push_front(const value_type& value) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::push_front(const value_type& value) {
     if (begin_.cur != begin_.first) {
-        data_allocator::construct(begin_.cur - 1, value);
+        alloc_traits::construct(get_alloc(), begin_.cur - 1, value);
         --begin_.cur;
     } else {
         require_capacity(1, true);
         try {
             --begin_;
-            data_allocator::construct(begin_.cur, value);
+            alloc_traits::construct(get_alloc(), begin_.cur, value);
         } catch (...) {
             ++begin_;
             throw;
@@ -514,47 +618,47 @@ void deque<T>::push_front(const value_type& value) {
     }
 }
 
-template <class T>
-void deque<T>::push_back(const value_type& value) {
-    if (end_.cur != end_.last - 1) {
-        data_allocator::construct(end_.cur, value);
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::push_back(const value_type& value) {
+    if (end_.last - end_.cur > 1) {
+        alloc_traits::construct(get_alloc(), end_.cur, value);
         ++end_.cur;
     } else {
         require_capacity(1, false);
-        data_allocator::construct(end_.cur, value);
+        alloc_traits::construct(get_alloc(), end_.cur, value);
         ++end_;
     }
 }
 
-template <class T>
-void deque<T>::pop_front() {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::pop_front() {
     MYSTL_DEBUG(!empty());
     if (begin_.cur != begin_.last - 1) {
-        data_allocator::destroy(begin_.cur);
+        alloc_traits::destroy(get_alloc(), begin_.cur);
         ++begin_.cur;
     } else {
-        data_allocator::destroy(begin_.cur);
+        alloc_traits::destroy(get_alloc(), begin_.cur);
         ++begin_;
         destroy_buffer(begin_.node - 1, begin_.node - 1);
     }
 }
 
-template <class T>
-void deque<T>::pop_back() {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::pop_back() {
     MYSTL_DEBUG(!empty());
     if (end_.cur != end_.first) {
         --end_.cur;
-        data_allocator::destroy(end_.cur);
+        alloc_traits::destroy(get_alloc(), end_.cur);
     } else {
         --end_;
-        data_allocator::destroy(end_.cur);
+        alloc_traits::destroy(get_alloc(), end_.cur);
         destroy_buffer(end_.node + 1, end_.node + 1);
     }
 }
 
-template <class T>
-typename deque<T>::iterator
-deque<T>::insert(iterator pos, const value_type& value) {
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::iterator
+deque<T, Alloc, BufSize>::insert(iterator pos, const value_type& value) {
     if (pos.cur == begin_.cur) {
         push_front(value);
         return begin_;
@@ -568,9 +672,9 @@ deque<T>::insert(iterator pos, const value_type& value) {
     }
 }
 
-template <class T>
-typename deque<T>::iterator
-deque<T>::insert(iterator pos, value_type&& value) {
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::iterator
+deque<T, Alloc, BufSize>::insert(iterator pos, value_type&& value) {
     if (pos.cur == begin_.cur) {
         emplace_front(MySTL::move(value));
         return begin_;
@@ -584,8 +688,8 @@ deque<T>::insert(iterator pos, value_type&& value) {
     }
 }
 
-template <class T>
-void deque<T>::insert(iterator pos, size_type n, const value_type& value) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::insert(iterator pos, size_type n, const value_type& value) {
     if (pos.cur == begin_.cur) {
         require_capacity(n, true);
         auto new_begin = begin_ - n;
@@ -601,9 +705,9 @@ void deque<T>::insert(iterator pos, size_type n, const value_type& value) {
     }
 }
 
-template <class T>
-typename deque<T>::iterator
-deque<T>::erase(iterator pos) {
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::iterator
+deque<T, Alloc, BufSize>::erase(iterator pos) {
     auto next = pos;
     ++next;
     const size_type elems_before = pos - begin_;
@@ -617,9 +721,9 @@ deque<T>::erase(iterator pos) {
     return begin_ + elems_before;
 }
 
-template <class T>
-typename deque<T>::iterator
-deque<T>::erase(iterator first, iterator last) {
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::iterator
+deque<T, Alloc, BufSize>::erase(iterator first, iterator last) {
     if (first == begin_ && last == end_) {
         clear();
         return end_;
@@ -629,89 +733,181 @@ deque<T>::erase(iterator first, iterator last) {
         if (elems_before < ((size() - len) / 2)) {
             MySTL::copy_backward(begin_, first, last);
             auto new_begin = begin_ + len;
-            data_allocator::destroy(begin_.cur, new_begin.cur);
+            destroy_range(begin_, new_begin);
+            if (begin_.node != new_begin.node)
+                destroy_buffer(begin_.node, new_begin.node - 1);
             begin_ = new_begin;
         } else {
             MySTL::copy(last, end_, first);
             auto new_end = end_ - len;
-            data_allocator::destroy(new_end.cur, end_.cur);
+            destroy_range(new_end, end_);
+            if (new_end.node != end_.node)
+                destroy_buffer(new_end.node + 1, end_.node);
             end_ = new_end;
         }
         return begin_ + elems_before;
     }
 }
 
-template <class T>
-void deque<T>::clear() {
-    // clear 保留头部缓冲区
-    for (map_pointer cur = begin_.node + 1; cur < end_.node; ++cur) {
-        data_allocator::destroy(*cur, *cur + buffer_size);
-    }
-    if (begin_.node != end_.node) {
-        MySTL::destroy(begin_.cur, begin_.last);
-        MySTL::destroy(end_.first, end_.cur);
-    } else {
-        MySTL::destroy(begin_.cur, end_.cur);
-    }
-    shrink_to_fit();
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::clear() {
+    // clear 保留头部缓冲区，其余缓冲区在缓存的容量内留作复用
+    destroy_range(begin_, end_);
     end_ = begin_;
+    if (map_ != nullptr)
+        release_idle_buffers();
 }
 
 // swap
-template <class T>
-void deque<T>::swap(deque& rhs) noexcept {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::swap(deque& rhs) noexcept {
     if (this != &rhs) {
+        MySTL::alloc_on_swap(get_alloc(), rhs.get_alloc());
         MySTL::swap(begin_, rhs.begin_);
         MySTL::swap(end_, rhs.end_);
         MySTL::swap(map_, rhs.map_);
         MySTL::swap(map_size_, rhs.map_size_);
+        MySTL::swap(spare_, rhs.spare_);
+        MySTL::swap(spare_count_, rhs.spare_count_);
     }
 }
 
 /*********************************** 辅助函数 ***********************************/
 
-template <class T>
-typename deque<T>::map_pointer
-deque<T>::create_map(size_type size) {
-    map_pointer mp = nullptr;
-    mp = map_allocator::allocate(size);
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::map_pointer
+deque<T, Alloc, BufSize>::create_map(size_type size) {
+    map_allocator alloc(get_alloc());
+    map_pointer   mp = map_alloc_traits::allocate(alloc, size);
     for (size_type i = 0; i < size; i++) {
         *(mp + i) = nullptr;
     }
     return mp;
 }
 
-// 为map所指区域分配内存
-template <class T>
-void deque<T>::create_buffer(map_pointer nstart, map_pointer nfinish) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::destroy_map(map_pointer mp, size_type size) {
+    map_allocator alloc(get_alloc());
+    map_alloc_traits::deallocate(alloc, mp, size);
+}
+
+// 为map所指区域分配内存，已经挂着缓冲区的位置(上一次多申请的)直接复用
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::create_buffer(map_pointer nstart, map_pointer nfinish) {
     map_pointer cur;
     try {
         for (cur = nstart; cur <= nfinish; ++cur) {
-            *cur = data_allocator::allocate(buffer_size);
+            if (*cur == nullptr)
+                *cur = take_block();
         }
     } catch (...) {
         while (cur != nstart) {
             --cur;
-            data_allocator::deallocate(*cur, buffer_size);
+            give_block(*cur);
             *cur = nullptr;
         }
         throw;
     }
 }
 
-template <class T>
-void deque<T>::destroy_buffer(map_pointer nstart, map_pointer nfinish) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::destroy_buffer(map_pointer nstart, map_pointer nfinish) {
     for (map_pointer cur = nstart; cur <= nfinish; ++cur) {
-        data_allocator::deallocate(*cur, buffer_size);
+        give_block(*cur);
         *cur = nullptr;
     }
 }
 
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::pointer
+deque<T, Alloc, BufSize>::take_block() {
+    if (spare_ == nullptr)
+        return alloc_traits::allocate(get_alloc(), buffer_size);
+    pointer block = spare_;
+    std::memcpy(&spare_, static_cast<void*>(block), sizeof(pointer));
+    --spare_count_;
+    return block;
+}
+
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::give_block(pointer block) noexcept {
+    // 放不下一个指针的缓冲区不进入缓存
+    if (spare_count_ >= DEQUE_BLOCK_CACHE_SIZE || buffer_size * sizeof(T) < sizeof(pointer)) {
+        alloc_traits::deallocate(get_alloc(), block, buffer_size);
+        return;
+    }
+    // 缓冲区不一定按指针对齐
+    std::memcpy(static_cast<void*>(block), &spare_, sizeof(pointer));
+    spare_ = block;
+    ++spare_count_;
+}
+
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::release_spare_blocks() noexcept {
+    while (spare_ != nullptr) {
+        pointer block = spare_;
+        std::memcpy(&spare_, static_cast<void*>(block), sizeof(pointer));
+        alloc_traits::deallocate(get_alloc(), block, buffer_size);
+    }
+    spare_count_ = 0;
+}
+
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::release_idle_buffers() noexcept {
+    for (auto cur = map_; cur < begin_.node; ++cur) {
+        if (*cur != nullptr) {
+            give_block(*cur);
+            *cur = nullptr;
+        }
+    }
+    for (auto cur = end_.node + 1; cur < map_ + map_size_; ++cur) {
+        if (*cur != nullptr) {
+            give_block(*cur);
+            *cur = nullptr;
+        }
+    }
+}
+
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::destroy_range(iterator first, iterator last) {
+    if (first.node == last.node) {
+        alloc_traits::destroy(get_alloc(), first.cur, last.cur);
+        return;
+    }
+    alloc_traits::destroy(get_alloc(), first.cur, first.last);
+    for (map_pointer cur = first.node + 1; cur < last.node; ++cur) {
+        alloc_traits::destroy(get_alloc(), *cur, *cur + buffer_size);
+    }
+    alloc_traits::destroy(get_alloc(), last.first, last.cur);
+}
+
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::destroy_and_recover() {
+    if (map_ != nullptr) {
+        clear();
+        alloc_traits::deallocate(get_alloc(), *begin_.node, buffer_size);
+        *begin_.node = nullptr;
+        destroy_map(map_, map_size_);
+        empty_init();
+    }
+    // 被移动后的 deque 没有 map，但仍可能持有缓存的缓冲区
+    release_spare_blocks();
+}
+
+// 空 deque 不持有 map 和缓冲区，第一次插入时由 require_capacity 分配
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::empty_init() noexcept {
+    begin_ = iterator();
+    end_ = iterator();
+    map_ = nullptr;
+    map_size_ = 0;
+}
+
 /// @brief 
 /// @tparam T 
 /// @param nelem deque预计容纳元素数量
-template <class T>
-void deque<T>::map_init(size_type nelem) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::map_init(size_type nelem) {
     const size_type nNode = nelem / buffer_size + 1;// 分配缓冲区的大小
     map_size_ = MySTL::max(static_cast<size_type>(DEQUE_MAP_INIT_SIZE), nNode + 2);
     try {
@@ -727,7 +923,7 @@ void deque<T>::map_init(size_type nelem) {
     try {
         create_buffer(nstart, nfinish);
     } catch (...) {
-        map_allocator::deallocate(map_, map_size_);
+        destroy_map(map_, map_size_);
         map_ = nullptr;
         map_size_ = 0;
         throw;
@@ -738,24 +934,29 @@ void deque<T>::map_init(size_type nelem) {
     end_.cur = end_.first + (nelem % buffer_size);
 }
 
-template <class T>
-void deque<T>::fill_init(size_type n, const value_type& value) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::fill_init(size_type n, const value_type& value) {
+    if (n == 0) {
+        empty_init();
+        return;
+    }
     map_init(n);
-    if (n != 0) {
-        for (auto cur = begin_.node; cur < end_.node; ++cur) {
-            MySTL::uninitialized_fill(*cur, *cur + buffer_size, value);
-        }
-        MySTL::uninitialized_fill(end_.first, end_.cur, value);
+    for (auto cur = begin_.node; cur < end_.node; ++cur) {
+        MySTL::uninitialized_fill(*cur, *cur + buffer_size, value);
     }
+    MySTL::uninitialized_fill(end_.first, end_.cur, value);
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class Iter>
-void deque<T>::copy_init(Iter first, Iter last, input_iterator_tag) {
-    const size_type n = MySTL::distance(first, last);
-    map_init(n);
-    for (; first != last; ++first)
-        emplace_back(*first);
+void deque<T, Alloc, BufSize>::copy_init(Iter first, Iter last, input_iterator_tag) {
+    empty_init();
+    try {
+        append_input(first, last);
+    } catch (...) {
+        destroy_and_recover();
+        throw;
+    }
 }
 
 /// @brief forward_iterator_tag，使用uninitialized_copy
@@ -763,10 +964,14 @@ void deque<T>::copy_init(Iter first, Iter last, input_iterator_tag) {
 /// @param first 
 /// @param last 
 /// @param  
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class Iter>
-void deque<T>::copy_init(Iter first, Iter last, forward_iterator_tag) {
+void deque<T, Alloc, BufSize>::copy_init(Iter first, Iter last, forward_iterator_tag) {
     const size_type n = MySTL::distance(first, last);
+    if (n == 0) {
+        empty_init();
+        return;
+    }
     map_init(n);
     for (auto cur = begin_.node; cur < end_.node; ++cur) {
         auto next = first;
@@ -777,8 +982,8 @@ void deque<T>::copy_init(Iter first, Iter last, forward_iterator_tag) {
     MySTL::uninitialized_copy(first, last, end_.first);
 }
 
-template <class T>
-void deque<T>::fill_assign(size_type n, const value_type& value) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::fill_assign(size_type n, const value_type& value) {
     if (n > size()) {
         MySTL::fill(begin(), end(), value);
         insert(end(), n - size(), value);
@@ -789,9 +994,9 @@ void deque<T>::fill_assign(size_type n, const value_type& value) {
 }
 
 //
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class Iter>
-void deque<T>::copy_assign(Iter first, Iter last, input_iterator_tag) {
+void deque<T, Alloc, BufSize>::copy_assign(Iter first, Iter last, input_iterator_tag) {
     auto first1 = begin();
     auto last1 = end();
     for (; first != last && first1 != last1; ++first, ++first1) {
@@ -804,9 +1009,9 @@ void deque<T>::copy_assign(Iter first, Iter last, input_iterator_tag) {
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class Iter>
-void deque<T>::copy_assign(Iter first, Iter last, forward_iterator_tag) {
+void deque<T, Alloc, BufSize>::copy_assign(Iter first, Iter last, forward_iterator_tag) {
     const size_type len1 = size();
     const size_type len2 = MySTL::distance(first, last);
     if (len1 < len2) {
@@ -819,10 +1024,10 @@ void deque<T>::copy_assign(Iter first, Iter last, forward_iterator_tag) {
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class... Args>
-typename deque<T>::iterator
-deque<T>::insert_aux(iterator pos, Args&&... args) {
+typename deque<T, Alloc, BufSize>::iterator
+deque<T, Alloc, BufSize>::insert_aux(iterator pos, Args&&... args) {
     const size_type elems_before = pos - begin_;
     value_type      value_copy = value_type(MySTL::forward<Args>(args)...);  // 防止改变原数值
     if (elems_before < (size() / 2)) {                                       // 插入到前半段
@@ -849,8 +1054,8 @@ deque<T>::insert_aux(iterator pos, Args&&... args) {
 }
 
 //  fill_insert
-template <class T>
-void deque<T>::fill_insert(iterator pos, size_type n, const value_type& value) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::fill_insert(iterator pos, size_type n, const value_type& value) {
     const size_type elems_before = pos - begin_;
     const size_type len = size();
     auto            value_copy = value;
@@ -906,9 +1111,9 @@ void deque<T>::fill_insert(iterator pos, size_type n, const value_type& value) {
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class Iter>
-void deque<T>::copy_insert(iterator pos, Iter first, Iter last, size_type n) {
+void deque<T, Alloc, BufSize>::copy_insert(iterator pos, Iter first, Iter last, size_type n) {
     const size_type elems_before = pos - begin_;
     auto            len = size();
     if (elems_before < (len / 2)) {
@@ -967,28 +1172,35 @@ void deque<T>::copy_insert(iterator pos, Iter first, Iter last, size_type n) {
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class Iter>
-void deque<T>::insert_dispatch(iterator pos, Iter first, Iter last, input_iterator_tag) {
-    if (last <= first) return;
-    const size_type n = MySTL::distance(first, last);
+void deque<T, Alloc, BufSize>::insert_dispatch(iterator pos, Iter first, Iter last, input_iterator_tag) {
+    // 单趟输入迭代器不能先求长度，先追加到尾部，再旋转到 pos 处
     const size_type elems_before = pos - begin_;
-    if (elems_before < (size() / 2)) {
-        require_capacity(n, true);
-    } else {
-        require_capacity(n, false);
-    }
-    pos = begin_ + elems_before;
-    auto cur = --last;
-    for (size_type i = 0; i < n; i++, --cur) {
-        insert(pos, *cur);
+    const size_type old_size = size();
+    append_input(first, last);
+    if (elems_before != old_size)
+        MySTL::rotate(begin_ + elems_before, begin_ + old_size, end_);
+}
+
+// 在尾部追加 [first, last)，当前缓冲区的空位直接构造，只在跨越缓冲区时由 emplace_back 申请新缓冲区
+template <class T, class Alloc, size_t BufSize>
+template <class Iter>
+void deque<T, Alloc, BufSize>::append_input(Iter first, Iter last) {
+    while (first != last) {
+        for (; first != last && end_.last - end_.cur > 1; ++first, ++end_.cur)
+            alloc_traits::construct(get_alloc(), end_.cur, *first);
+        if (first != last) {
+            emplace_back(*first);
+            ++first;
+        }
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class Iter>
-void deque<T>::insert_dispatch(iterator pos, Iter first, Iter last, forward_iterator_tag) {
-    if (last <= first) return;
+void deque<T, Alloc, BufSize>::insert_dispatch(iterator pos, Iter first, Iter last, forward_iterator_tag) {
+    if (first == last) return;
     const size_type n = MySTL::distance(first, last);
     if (pos.cur == begin_.cur) {
         require_capacity(n, true);
@@ -1018,8 +1230,12 @@ void deque<T>::insert_dispatch(iterator pos, Iter first, Iter last, forward_iter
 }
 
 // bool front表示是否在前面插入
-template <class T>
-void deque<T>::require_capacity(size_type n, bool front) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::require_capacity(size_type n, bool front) {
+    if (map_ == nullptr) {
+        if (n == 0) return;
+        map_init(0);
+    }
     if (front && (static_cast<size_type>(begin_.cur - begin_.first) < n)) {
         const size_type need_buffer = (n - (begin_.cur - begin_.first)) / buffer_size + 1;
         if (need_buffer > static_cast<size_type>(begin_.node - map_)) {
@@ -1037,46 +1253,79 @@ void deque<T>::require_capacity(size_type n, bool front) {
     }
 }
 
-template <class T>
-void deque<T>::reallocate_map_at_front(size_type need_buffer) {
-    const size_type new_map_size = MySTL::max(map_size_ << 1, map_size_ + need_buffer + DEQUE_MAP_INIT_SIZE);
-    map_pointer     new_map = create_map(new_map_size);
+// map 前端空位不足：另一端空位足够时把缓冲区指针移到 map 中间，否则分配更大的 map
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::reallocate_map_at_front(size_type need_buffer) {
     const size_type old_buffer = end_.node - begin_.node + 1;
     const size_type new_buffer = old_buffer + need_buffer;
+    // 多出的缓冲区先进入缓存，搬移后 map 中只有 [begin_.node, end_.node] 非空
+    release_idle_buffers();
+
+    if (map_size_ > 2 * new_buffer) {
+        auto begin = map_ + (map_size_ - new_buffer) / 2;
+        auto mid = begin + need_buffer;
+        auto end = mid + old_buffer;
+        // 空位都在后端，缓冲区指针整体后移，原位置中不再使用的部分置空
+        MySTL::copy_backward(begin_.node, end_.node + 1, end);
+        for (auto cur = begin_.node; cur < mid; ++cur)
+            *cur = nullptr;
+        begin_.node = mid;
+        end_.node = end - 1;
+        create_buffer(begin, mid - 1);
+        return;
+    }
+
+    const size_type new_map_size = MySTL::max(map_size_ << 1, map_size_ + need_buffer + DEQUE_MAP_INIT_SIZE);
+    map_pointer     new_map = create_map(new_map_size);
 
     // map中的指针指向原来的buffer，并开辟新的buffer
     auto begin = new_map + (new_map_size - new_buffer) / 2;
     auto mid = begin + need_buffer;
     auto end = mid + old_buffer;
     create_buffer(begin, mid - 1);
-    for (auto begin1 = mid, begin2 = begin_.node; begin1 != end; ++begin1, ++begin2) {
-        *begin1 = *begin2;
-    }
+    // 只搬移指向缓冲区的指针，元素本身不动
+    MySTL::uninitialized_relocate(begin_.node, end_.node + 1, mid);
     // 更新数据
-    map_allocator::deallocate(map_, map_size_);
+    destroy_map(map_, map_size_);
     map_ = new_map;
     map_size_ = new_map_size;
     begin_ = iterator(*mid + (begin_.cur - begin_.first), mid);
     end_ = iterator(*(end - 1) + (end_.cur - end_.first), end - 1);
 }
 
-template <class T>
-void deque<T>::reallocate_map_at_back(size_type need_buffer) {
-    const size_type new_map_size = MySTL::max(map_size_ << 1, map_size_ + need_buffer + DEQUE_MAP_INIT_SIZE);
-    map_pointer     new_map = create_map(new_map_size);
+// map 后端空位不足：另一端空位足够时把缓冲区指针移到 map 中间，否则分配更大的 map
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::reallocate_map_at_back(size_type need_buffer) {
     const size_type old_buffer = end_.node - begin_.node + 1;
     const size_type new_buffer = old_buffer + need_buffer;
+    release_idle_buffers();
+
+    if (map_size_ > 2 * new_buffer) {
+        auto begin = map_ + (map_size_ - new_buffer) / 2;
+        auto mid = begin + old_buffer;
+        auto end = mid + need_buffer;
+        // 空位都在前端，缓冲区指针整体前移，原位置中不再使用的部分置空
+        auto old_end = end_.node + 1;
+        MySTL::copy(begin_.node, old_end, begin);
+        for (auto cur = mid; cur < old_end; ++cur)
+            *cur = nullptr;
+        begin_.node = begin;
+        end_.node = mid - 1;
+        create_buffer(mid, end - 1);
+        return;
+    }
+
+    const size_type new_map_size = MySTL::max(map_size_ << 1, map_size_ + need_buffer + DEQUE_MAP_INIT_SIZE);
+    map_pointer     new_map = create_map(new_map_size);
 
     // 新的map中的指针指向原来的buffer，并开辟新的buffer
     auto begin = new_map + (new_map_size - new_buffer) / 2;
     auto mid = begin + old_buffer;
     auto end = mid + need_buffer;
-    for (auto begin1 = begin, begin2 = begin_.node; begin1 != mid; ++begin1, ++begin2) {
-        *begin1 = *begin2;
-    }
+    MySTL::uninitialized_relocate(begin_.node, end_.node + 1, begin);
     create_buffer(mid, end - 1);
     // 更新数据
-    map_allocator::deallocate(map_, map_size_);
+    destroy_map(map_, map_size_);
     map_ = new_map;
     map_size_ = new_map_size;
     begin_ = iterator(*begin + (begin_.cur - begin_.first), begin);
@@ -1084,44 +1333,48 @@ void deque<T>::reallocate_map_at_back(size_type need_buffer) {
 }
 
 // 重载比较操作符
-template <class T>
-bool operator==(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSize>
+bool operator==(const deque<T, Alloc, BufSize>& lhs, const deque<T, Alloc, BufSize>& rhs) {
     return lhs.size() == rhs.size() &&
            MySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T>
-bool operator<(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSize>
+bool operator<(const deque<T, Alloc, BufSize>& lhs, const deque<T, Alloc, BufSize>& rhs) {
     return MySTL::lexicographical_compare(
         lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class T>
-bool operator!=(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSize>
+bool operator!=(const deque<T, Alloc, BufSize>& lhs, const deque<T, Alloc, BufSize>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class T>
-bool operator>(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSize>
+bool operator>(const deque<T, Alloc, BufSize>& lhs, const deque<T, Alloc, BufSize>& rhs) {
     return rhs < lhs;
 }
 
-template <class T>
-bool operator<=(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSize>
+bool operator<=(const deque<T, Alloc, BufSize>& lhs, const deque<T, Alloc, BufSize>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class T>
-bool operator>=(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSize>
+bool operator>=(const deque<T, Alloc, BufSize>& lhs, const deque<T, Alloc, BufSize>& rhs) {
     return !(lhs < rhs);
 }
 
 // 重载全局 swap
-template <class T>
-void swap(MySTL::deque<T>& lhs, MySTL::deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSize>
+void swap(MySTL::deque<T, Alloc, BufSize>& lhs, MySTL::deque<T, Alloc, BufSize>& rhs) {
     lhs.swap(rhs);
 }
 
+// deque 的迭代器和 map 都指向堆空间，不指向对象自身，可以按字节搬移
+template <class T, class Alloc, size_t BufSize>
+struct is_trivially_relocatable<deque<T, Alloc, BufSize>> : is_trivially_relocatable<Alloc> {};
+
 };  // namespace MySTL
 
 
@@ -0,0 +1,731 @@
+#ifndef MYSTL_FORWARD_LIST_H
+#define MYSTL_FORWARD_LIST_H
+
+// 单向链表 forward_list 的实现
+// 每个结点只保存一个 next 指针，对象本身只有一个嵌入的哨兵结点(before_begin)，不记录元素个数
+// 所有插入、删除都作用于给定位置之后的结点：insert_after / erase_after / splice_after
+// sort 为自底向上的链表归并排序，只重新链接结点，不申请额外内存
+// 结点的申请与销毁复用 list.h 中的 create_value_node / destroy_value_node
+
+#include <initializer_list>
+#include <type_traits>
+
+#include "exceptdef.h"
+#include "functional.h"
+#include "iterator.h"
+#include "list.h"
+#include "memory.h"
+#include "myallocator.h"
+#include "util.h"
+
+namespace MySTL {
+
+// forward_list 结点结构，链接部分只有一个指针
+struct forward_list_node_base {
+    forward_list_node_base* next;
+};
+
+template <class T>
+struct forward_list_node : public forward_list_node_base {
+    T value;  // 结点数据
+};
+
+// forward_list 迭代器设计
+template <class T>
+struct forward_list_iterator : public MySTL::iterator<MySTL::forward_iterator_tag, T> {
+    typedef T                        value_type;
+    typedef T*                       pointer;
+    typedef T&                       reference;
+    typedef forward_list_node_base*  base_ptr;
+    typedef forward_list_node<T>*    node_ptr;
+    typedef forward_list_iterator<T> self;
+
+    base_ptr node_;  // 指向当前结点，end() 为空指针
+
+    forward_list_iterator() noexcept : node_(nullptr) {}
+
+    explicit forward_list_iterator(base_ptr x) noexcept : node_(x) {}
+
+    reference operator*() const { return static_cast<node_ptr>(node_)->value; }
+    pointer   operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        MYSTL_DEBUG(node_ != nullptr);
+        node_ = node_->next;
+        return *this;
+    }
+
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+    bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+template <class T>
+struct forward_list_const_iterator : public MySTL::iterator<MySTL::forward_iterator_tag, T> {
+    typedef T                              value_type;
+    typedef const T*                       pointer;
+    typedef const T&                       reference;
+    typedef forward_list_node_base*        base_ptr;
+    typedef forward_list_node<T>*          node_ptr;
+    typedef forward_list_const_iterator<T> self;
+
+    base_ptr node_;
+
+    forward_list_const_iterator() noexcept : node_(nullptr) {}
+
+    explicit forward_list_const_iterator(base_ptr x) noexcept : node_(x) {}
+
+    forward_list_const_iterator(const forward_list_iterator<T>& rhs) noexcept : node_(rhs.node_) {}
+
+    reference operator*() const { return static_cast<node_ptr>(node_)->value; }
+    pointer   operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        MYSTL_DEBUG(node_ != nullptr);
+        node_ = node_->next;
+        return *this;
+    }
+
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+    bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+// 模板类 forward_list
+// 模板参数 T 代表数据类型，Alloc 代表分配器类型
+template <class T, class Alloc = MySTL::allocator<T>>
+class forward_list
+    : private alloc_holder<typename allocator_traits<Alloc>::template rebind_alloc<forward_list_node<T>>> {
+public:
+    typedef Alloc                                                                       allocator_type;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<forward_list_node<T>> node_allocator;
+    typedef MySTL::allocator_traits<node_allocator>                                     node_alloc_traits;
+
+    typedef T         value_type;
+    typedef T*        pointer;
+    typedef const T*  const_pointer;
+    typedef T&        reference;
+    typedef const T&  const_reference;
+    typedef size_t    size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef forward_list_iterator<T>       iterator;
+    typedef forward_list_const_iterator<T> const_iterator;
+
+    typedef forward_list_node_base* base_ptr;
+    typedef forward_list_node<T>*   node_ptr;
+
+    allocator_type get_allocator() const { return allocator_type(get_alloc()); }
+
+private:
+    typedef alloc_holder<node_allocator> alloc_base;
+    using alloc_base::get_alloc;
+
+    forward_list_node_base head_;  // 哨兵结点，即 before_begin()，空 forward_list 不需要分配内存
+
+public:
+    /*********************************** 构造，复制，移动，析构 ***********************************/
+
+    forward_list() noexcept { head_.next = nullptr; }
+
+    explicit forward_list(const allocator_type& alloc) noexcept : alloc_base(node_allocator(alloc)) {
+        head_.next = nullptr;
+    }
+
+    explicit forward_list(size_type n, const allocator_type& alloc = allocator_type()) :
+        alloc_base(node_allocator(alloc)) {
+        head_.next = nullptr;
+        fill_insert_after(before_begin(), n, value_type());
+    }
+
+    forward_list(size_type n, const T& value, const allocator_type& alloc = allocator_type()) :
+        alloc_base(node_allocator(alloc)) {
+        head_.next = nullptr;
+        fill_insert_after(before_begin(), n, value);
+    }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    forward_list(Iter first, Iter last, const allocator_type& alloc = allocator_type()) :
+        alloc_base(node_allocator(alloc)) {
+        head_.next = nullptr;
+        copy_insert_after(before_begin(), first, last);
+    }
+
+    forward_list(std::initializer_list<T> ilist, const allocator_type& alloc = allocator_type()) :
+        alloc_base(node_allocator(alloc)) {
+        head_.next = nullptr;
+        copy_insert_after(before_begin(), ilist.begin(), ilist.end());
+    }
+
+    // 复制，分配器由 select_on_container_copy_construction 决定
+    forward_list(const forward_list& rhs) :
+        alloc_base(node_alloc_traits::select_on_container_copy_construction(rhs.get_alloc())) {
+        head_.next = nullptr;
+        copy_insert_after(before_begin(), rhs.begin(), rhs.end());
+    }
+
+    forward_list(const forward_list& rhs, const allocator_type& alloc) : alloc_base(node_allocator(alloc)) {
+        head_.next = nullptr;
+        copy_insert_after(before_begin(), rhs.begin(), rhs.end());
+    }
+
+    // 移动，链表以空指针结尾，只需接管首结点
+    forward_list(forward_list&& rhs) noexcept : alloc_base(MySTL::move(rhs.get_alloc())) {
+        head_.next = rhs.head_.next;
+        rhs.head_.next = nullptr;
+    }
+
+    forward_list& operator=(const forward_list& rhs) {
+        if (this != &rhs) {
+            if (node_alloc_traits::propagate_on_container_copy_assignment::value &&
+                !MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+                // 分配器将被替换，已有结点必须先由旧分配器释放
+                clear();
+            }
+            MySTL::alloc_on_copy(get_alloc(), rhs.get_alloc());
+            copy_assign(rhs.begin(), rhs.end());
+        }
+        return *this;
+    }
+
+    forward_list& operator=(forward_list&& rhs) {
+        if (this == &rhs) return *this;
+        clear();
+        MySTL::alloc_on_move(get_alloc(), rhs.get_alloc());
+        if (MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+            head_.next = rhs.head_.next;
+            rhs.head_.next = nullptr;
+        } else {
+            // 分配器不相等且不传播，不能接管 rhs 的结点，只能逐个移动元素
+            auto tail = before_begin();
+            for (auto it = rhs.begin(); it != rhs.end(); ++it)
+                tail = emplace_after(tail, MySTL::move(*it));
+            rhs.clear();
+        }
+        return *this;
+    }
+
+    forward_list& operator=(std::initializer_list<T> ilist) {
+        copy_assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~forward_list() { clear(); }
+
+public:
+    /*********************************** 迭代器相关操作 ***********************************/
+
+    // before_begin 指向哨兵结点，可作为 insert_after / erase_after 的位置，但不能解引用
+    iterator       before_begin() noexcept { return iterator(&head_); }
+    const_iterator before_begin() const noexcept { return const_iterator(head()); }
+    const_iterator cbefore_begin() const noexcept { return before_begin(); }
+
+    iterator       begin() noexcept { return iterator(head_.next); }
+    const_iterator begin() const noexcept { return const_iterator(head_.next); }
+    iterator       end() noexcept { return iterator(); }
+    const_iterator end() const noexcept { return const_iterator(); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    /*********************************** 容量相关操作 ***********************************/
+
+    bool      empty() const noexcept { return head_.next == nullptr; }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(forward_list_node<T>); }
+
+    /*********************************** 访问元素相关操作 ***********************************/
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+
+    /*********************************** 修改容器相关操作 ***********************************/
+
+    // assign
+
+    void assign(size_type n, const value_type& value) { fill_assign(n, value); }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    void assign(Iter first, Iter last) {
+        copy_assign(first, last);
+    }
+
+    void assign(std::initializer_list<T> ilist) { copy_assign(ilist.begin(), ilist.end()); }
+
+    // 头部插入、删除
+
+    template <class... Args>
+    reference emplace_front(Args&&... args) {
+        return *emplace_after(cbefore_begin(), MySTL::forward<Args>(args)...);
+    }
+
+    void push_front(const value_type& value) { emplace_after(cbefore_begin(), value); }
+    void push_front(value_type&& value) { emplace_after(cbefore_begin(), MySTL::move(value)); }
+
+    void pop_front() {
+        MYSTL_DEBUG(!empty());
+        erase_after(cbefore_begin());
+    }
+
+    // 在 pos 之后插入，返回最后一个插入的元素；没有插入元素时返回 pos
+
+    template <class... Args>
+    iterator emplace_after(const_iterator pos, Args&&... args) {
+        auto node = create_node(MySTL::forward<Args>(args)...);
+        node->next = pos.node_->next;
+        pos.node_->next = node;
+        return iterator(node);
+    }
+
+    iterator insert_after(const_iterator pos, const value_type& value) { return emplace_after(pos, value); }
+
+    iterator insert_after(const_iterator pos, value_type&& value) {
+        return emplace_after(pos, MySTL::move(value));
+    }
+
+    iterator insert_after(const_iterator pos, size_type n, const value_type& value) {
+        return fill_insert_after(pos, n, value);
+    }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    iterator insert_after(const_iterator pos, Iter first, Iter last) {
+        return copy_insert_after(pos, first, last);
+    }
+
+    iterator insert_after(const_iterator pos, std::initializer_list<T> ilist) {
+        return copy_insert_after(pos, ilist.begin(), ilist.end());
+    }
+
+    // 插入、前置、赋值整个区间(容器或内置数组)，新结点先连成一串再一次接入链表
+    template <class Range>
+    iterator insert_range_after(const_iterator pos, Range&& rg) {
+        return copy_insert_after(pos, MySTL::range_begin(rg), MySTL::range_end(rg));
+    }
+
+    template <class Range>
+    void prepend_range(Range&& rg) { copy_insert_after(cbefore_begin(), MySTL::range_begin(rg), MySTL::range_end(rg)); }
+
+    template <class Range>
+    void assign_range(Range&& rg) { copy_assign(MySTL::range_begin(rg), MySTL::range_end(rg)); }
+
+    // 删除 pos 之后的一个元素 / (first, last) 内的元素，返回被删除元素之后的位置
+    iterator erase_after(const_iterator pos);
+    iterator erase_after(const_iterator first, const_iterator last);
+
+    void resize(size_type new_size) { resize(new_size, value_type()); }
+    void resize(size_type new_size, const value_type& value);
+
+    void clear() noexcept { erase_chain(head_.next); head_.next = nullptr; }
+
+    void swap(forward_list& rhs) noexcept {
+        MySTL::alloc_on_swap(get_alloc(), rhs.get_alloc());
+        MySTL::swap(head_.next, rhs.head_.next);
+    }
+
+    /*********************************** 链表相关操作 ***********************************/
+
+    // 把 x 的元素接到 pos 之后，x 与 *this 的分配器必须相等
+    void splice_after(const_iterator pos, forward_list& x);
+    void splice_after(const_iterator pos, forward_list&& x) { splice_after(pos, x); }
+    // 把 x 中 it 之后的一个元素接到 pos 之后
+    void splice_after(const_iterator pos, forward_list& x, const_iterator it);
+    void splice_after(const_iterator pos, forward_list&& x, const_iterator it) { splice_after(pos, x, it); }
+    // 把 x 中 (first, last) 内的元素接到 pos 之后
+    void splice_after(const_iterator pos, forward_list& x, const_iterator first, const_iterator last);
+    void splice_after(const_iterator pos, forward_list&& x, const_iterator first, const_iterator last) {
+        splice_after(pos, x, first, last);
+    }
+
+    void remove(const value_type& value) {
+        remove_if([&](const value_type& v) { return v == value; });
+    }
+    template <class UnaryPredicate>
+    void remove_if(UnaryPredicate pred);
+
+    void unique() { unique(MySTL::equal_to<T>()); }
+    template <class BinaryPredicate>
+    void unique(BinaryPredicate pred);
+
+    void merge(forward_list& x) { merge(x, MySTL::less<T>()); }
+    void merge(forward_list&& x) { merge(x, MySTL::less<T>()); }
+    template <class Compare>
+    void merge(forward_list& x, Compare comp);
+    template <class Compare>
+    void merge(forward_list&& x, Compare comp) { merge(x, comp); }
+
+    // 稳定排序，自底向上两两归并相邻的有序段，只修改 next 指针
+    void sort() { sort(MySTL::less<T>()); }
+    template <class Compare>
+    void sort(Compare comp);
+
+    void reverse() noexcept;
+
+private:
+    /*********************************** helper functions ***********************************/
+
+    template <class... Args>
+    node_ptr create_node(Args&&... args) {
+        node_ptr p = create_value_node(get_alloc(), MySTL::forward<Args>(args)...);
+        p->next = nullptr;
+        return p;
+    }
+
+    void destroy_node(base_ptr p) { destroy_value_node(get_alloc(), static_cast<node_ptr>(p)); }
+
+    base_ptr head() const noexcept { return const_cast<base_ptr>(&head_); }
+
+    static reference value_of(base_ptr p) { return static_cast<node_ptr>(p)->value; }
+
+    // 销毁从 first 开始直到链表末尾的所有结点
+    void erase_chain(base_ptr first);
+
+    // 把 (before_first, last] 从原链表中取下，接到 pos 之后
+    static void splice_chain_after(base_ptr pos, base_ptr before_first, base_ptr last) noexcept;
+
+    // 把以 first 开头、以空指针结尾的整串结点接到 pos 之后，返回最后一个结点
+    static base_ptr link_chain_after(base_ptr pos, base_ptr first) noexcept;
+
+    iterator fill_insert_after(const_iterator pos, size_type n, const value_type& value);
+    template <class Iter>
+    iterator copy_insert_after(const_iterator pos, Iter first, Iter last);
+
+    void fill_assign(size_type n, const value_type& value);
+    template <class Iter>
+    void copy_assign(Iter first, Iter last);
+};
+
+/*********************************** helper functions ***********************************/
+
+template <class T, class Alloc>
+void forward_list<T, Alloc>::erase_chain(base_ptr first) {
+    while (first != nullptr) {
+        base_ptr next = first->next;
+        destroy_node(first);
+        first = next;
+    }
+}
+
+template <class T, class Alloc>
+void forward_list<T, Alloc>::splice_chain_after(base_ptr pos, base_ptr before_first, base_ptr last) noexcept {
+    base_ptr first = before_first->next;
+    before_first->next = last->next;
+    last->next = pos->next;
+    pos->next = first;
+}
+
+template <class T, class Alloc>
+typename forward_list<T, Alloc>::base_ptr
+forward_list<T, Alloc>::link_chain_after(base_ptr pos, base_ptr first) noexcept {
+    if (first == nullptr)
+        return pos;
+    base_ptr last = first;
+    while (last->next != nullptr)
+        last = last->next;
+    last->next = pos->next;
+    pos->next = first;
+    return last;
+}
+
+// 先在链表外把 n 个新结点连成一串，全部构造成功后再接入，异常时原链表不变
+template <class T, class Alloc>
+typename forward_list<T, Alloc>::iterator
+forward_list<T, Alloc>::fill_insert_after(const_iterator pos, size_type n, const value_type& value) {
+    forward_list_node_base chain;
+    base_ptr               tail = &chain;
+    chain.next = nullptr;
+    try {
+        for (; n > 0; --n) {
+            tail->next = create_node(value);
+            tail = tail->next;
+        }
+    } catch (...) {
+        erase_chain(chain.next);
+        throw;
+    }
+    return iterator(link_chain_after(pos.node_, chain.next));
+}
+
+template <class T, class Alloc>
+template <class Iter>
+typename forward_list<T, Alloc>::iterator
+forward_list<T, Alloc>::copy_insert_after(const_iterator pos, Iter first, Iter last) {
+    forward_list_node_base chain;
+    base_ptr               tail = &chain;
+    chain.next = nullptr;
+    try {
+        for (; first != last; ++first) {
+            tail->next = create_node(*first);
+            tail = tail->next;
+        }
+    } catch (...) {
+        erase_chain(chain.next);
+        throw;
+    }
+    return iterator(link_chain_after(pos.node_, chain.next));
+}
+
+// 已有结点直接赋值，多余的删除，不足的再插入
+template <class T, class Alloc>
+void forward_list<T, Alloc>::fill_assign(size_type n, const value_type& value) {
+    base_ptr prev = &head_;
+    for (; prev->next != nullptr && n > 0; --n) {
+        value_of(prev->next) = value;
+        prev = prev->next;
+    }
+    if (n > 0)
+        fill_insert_after(const_iterator(prev), n, value);
+    else
+        erase_after(const_iterator(prev), cend());
+}
+
+template <class T, class Alloc>
+template <class Iter>
+void forward_list<T, Alloc>::copy_assign(Iter first, Iter last) {
+    base_ptr prev = &head_;
+    for (; prev->next != nullptr && first != last; ++first) {
+        value_of(prev->next) = *first;
+        prev = prev->next;
+    }
+    if (first != last)
+        copy_insert_after(const_iterator(prev), first, last);
+    else
+        erase_after(const_iterator(prev), cend());
+}
+
+/*********************************** 容器操作 ***********************************/
+
+template <class T, class Alloc>
+typename forward_list<T, Alloc>::iterator
+forward_list<T, Alloc>::erase_after(const_iterator pos) {
+    MYSTL_DEBUG(pos.node_ != nullptr && pos.node_->next != nullptr);
+    base_ptr node = pos.node_->next;
+    pos.node_->next = node->next;
+    destroy_node(node);
+    return iterator(pos.node_->next);
+}
+
+template <class T, class Alloc>
+typename forward_list<T, Alloc>::iterator
+forward_list<T, Alloc>::erase_after(const_iterator first, const_iterator last) {
+    base_ptr cur = first.node_->next;
+    while (cur != last.node_) {
+        base_ptr next = cur->next;
+        destroy_node(cur);
+        cur = next;
+    }
+    first.node_->next = last.node_;
+    return iterator(last.node_);
+}
+
+template <class T, class Alloc>
+void forward_list<T, Alloc>::resize(size_type new_size, const value_type& value) {
+    base_ptr prev = &head_;
+    for (; prev->next != nullptr && new_size > 0; --new_size)
+        prev = prev->next;
+    if (new_size > 0)
+        fill_insert_after(const_iterator(prev), new_size, value);
+    else
+        erase_after(const_iterator(prev), cend());
+}
+
+template <class T, class Alloc>
+void forward_list<T, Alloc>::splice_after(const_iterator pos, forward_list& x) {
+    MYSTL_DEBUG(this != &x);
+    link_chain_after(pos.node_, x.head_.next);
+    x.head_.next = nullptr;
+}
+
+template <class T, class Alloc>
+void forward_list<T, Alloc>::splice_after(const_iterator pos, forward_list&, const_iterator it) {
+    base_ptr node = it.node_->next;
+    if (pos.node_ != it.node_ && pos.node_ != node)
+        splice_chain_after(pos.node_, it.node_, node);
+}
+
+template <class T, class Alloc>
+void forward_list<T, Alloc>::splice_after(const_iterator pos, forward_list&, const_iterator first,
+                                          const_iterator last) {
+    base_ptr tail = first.node_;
+    while (tail->next != last.node_)
+        tail = tail->next;
+    if (tail != first.node_)
+        splice_chain_after(pos.node_, first.node_, tail);
+}
+
+// 把被删除的结点先摘到一条临时链上，最后统一销毁，value 可以引用本链表中的元素
+template <class T, class Alloc>
+template <class UnaryPredicate>
+void forward_list<T, Alloc>::remove_if(UnaryPredicate pred) {
+    forward_list_node_base removed;
+    base_ptr               removed_tail = &removed;
+    base_ptr               prev = &head_;
+    while (prev->next != nullptr) {
+        if (pred(value_of(prev->next))) {
+            base_ptr node = prev->next;
+            prev->next = node->next;
+            removed_tail->next = node;
+            removed_tail = node;
+        } else {
+            prev = prev->next;
+        }
+    }
+    removed_tail->next = nullptr;
+    erase_chain(removed.next);
+}
+
+template <class T, class Alloc>
+template <class BinaryPredicate>
+void forward_list<T, Alloc>::unique(BinaryPredicate pred) {
+    base_ptr cur = head_.next;
+    if (cur == nullptr)
+        return;
+    while (cur->next != nullptr) {
+        if (pred(value_of(cur), value_of(cur->next)))
+            erase_after(const_iterator(cur));
+        else
+            cur = cur->next;
+    }
+}
+
+// 与有序链表 x 合并，相等元素中 *this 的在前
+template <class T, class Alloc>
+template <class Compare>
+void forward_list<T, Alloc>::merge(forward_list& x, Compare comp) {
+    if (this == &x)
+        return;
+    base_ptr prev = &head_;
+    while (prev->next != nullptr && x.head_.next != nullptr) {
+        if (comp(value_of(x.head_.next), value_of(prev->next)))
+            splice_chain_after(prev, &x.head_, x.head_.next);
+        prev = prev->next;
+    }
+    if (x.head_.next != nullptr) {
+        prev->next = x.head_.next;
+        x.head_.next = nullptr;
+    }
+}
+
+/**
+ * 自底向上归并：第 k 趟把相邻的两段长度为 2^k 的有序段合并，直到某一趟只发生一次合并
+ * 每趟从头到尾扫一遍链表，只用几个指针记录两段的起点和剩余长度，不需要额外内存
+ */
+template <class T, class Alloc>
+template <class Compare>
+void forward_list<T, Alloc>::sort(Compare comp) {
+    if (head_.next == nullptr || head_.next->next == nullptr)
+        return;
+    for (size_type width = 1;; width *= 2) {
+        base_ptr  p = head_.next;
+        base_ptr  tail = &head_;
+        size_type merges = 0;
+        while (p != nullptr) {
+            ++merges;
+            base_ptr  q = p;
+            size_type psize = 0;
+            for (; psize < width && q != nullptr; ++psize)
+                q = q->next;
+            size_type qsize = width;
+            // 合并 [p, p + psize) 与 [q, q + qsize)，q 段先到链表末尾时提前结束
+            while (psize > 0 || (qsize > 0 && q != nullptr)) {
+                base_ptr e;
+                if (psize == 0) {
+                    e = q;
+                    q = q->next;
+                    --qsize;
+                } else if (qsize == 0 || q == nullptr || !comp(value_of(q), value_of(p))) {
+                    e = p;
+                    p = p->next;
+                    --psize;
+                } else {
+                    e = q;
+                    q = q->next;
+                    --qsize;
+                }
+                tail->next = e;
+                tail = e;
+            }
+            p = q;
+        }
+        tail->next = nullptr;
+        if (merges <= 1)
+            return;
+    }
+}
+
+template <class T, class Alloc>
+void forward_list<T, Alloc>::reverse() noexcept {
+    base_ptr prev = nullptr;
+    base_ptr cur = head_.next;
+    while (cur != nullptr) {
+        base_ptr next = cur->next;
+        cur->next = prev;
+        prev = cur;
+        cur = next;
+    }
+    head_.next = prev;
+}
+
+/*********************************** 重载比较操作符 ***********************************/
+
+template <class T, class Alloc>
+bool operator==(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs) {
+    auto first1 = lhs.cbegin();
+    auto last1 = lhs.cend();
+    auto first2 = rhs.cbegin();
+    auto last2 = rhs.cend();
+
+    for (; first1 != last1 && first2 != last2 && *first1 == *first2; ++first1, ++first2) {
+    }
+    return first1 == last1 && first2 == last2;
+}
+
+template <class T, class Alloc>
+bool operator!=(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, class Alloc>
+bool operator<(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs) {
+    return MySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, class Alloc>
+bool operator>(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, class Alloc>
+bool operator<=(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, class Alloc>
+bool operator>=(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+// 重载swap
+template <class T, class Alloc>
+void swap(forward_list<T, Alloc>& lhs, forward_list<T, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // namespace MySTL
+
+#endif /* MYSTL_FORWARD_LIST_H */
@@ -0,0 +1,71 @@
+#ifndef MY_GROWTH_POLICY_H
+#define MY_GROWTH_POLICY_H
+
+// 这个头文件包含 vector 和 basic_string 的扩容策略
+// 策略是一个提供如下静态函数的类型，作为容器的模板参数：
+//   static size_t next_capacity(size_t old_cap, size_t need, size_t elem_size) noexcept;
+// old_cap 为当前容量，need 为至少需要的容量(均以元素个数计)，elem_size 为元素的字节数
+// 返回值小于 need 时容器按 need 处理，超过 max_size() 时按 max_size() 处理，策略本身不需要考虑溢出之外的边界
+//
+// geometric_growth<Num, Den, Min> : 按 Num / Den 倍增长，第一次分配不少于 Min 个元素
+//   default_growth                : 1.5 倍，vector 的默认策略
+//   golden_growth                 : 约 1.618 倍，释放的旧空间之和有机会被后续分配复用
+//   double_growth                 : 2 倍
+// exact_growth                    : 只分配需要的大小，适合元素很少且大小固定的容器
+// additive_growth<Bytes>          : 每次固定增长 Bytes 字节，配合 mmap_allocator 用于巨大的缓冲区
+// page_growth<Base, PageSize>     : 在 Base 的基础上把字节数向上取整到页
+
+#include <cstddef>
+
+namespace MySTL {
+
+enum { GROWTH_PAGE_SIZE = 4096 };
+
+template <size_t Num, size_t Den, size_t Min = 16>
+struct geometric_growth {
+    static_assert(Den != 0 && Num > Den, "geometric_growth requires Num / Den > 1");
+
+    static size_t next_capacity(size_t old_cap, size_t need, size_t) noexcept {
+        if (old_cap == 0)
+            return need < Min ? Min : need;
+        const size_t extra = old_cap / Den * (Num - Den) + old_cap % Den * (Num - Den) / Den;
+        if (old_cap > static_cast<size_t>(-1) - extra)
+            return need;
+        return old_cap + extra < need ? need : old_cap + extra;
+    }
+};
+
+typedef geometric_growth<3, 2>  default_growth;
+typedef geometric_growth<13, 8> golden_growth;
+typedef geometric_growth<2, 1>  double_growth;
+
+struct exact_growth {
+    static size_t next_capacity(size_t, size_t need, size_t) noexcept { return need; }
+};
+
+template <size_t Bytes = 1024 * 1024>
+struct additive_growth {
+    static size_t next_capacity(size_t old_cap, size_t need, size_t elem_size) noexcept {
+        const size_t step = Bytes / elem_size == 0 ? 1 : Bytes / elem_size;
+        if (old_cap > static_cast<size_t>(-1) - step)
+            return need;
+        return old_cap + step < need ? need : old_cap + step;
+    }
+};
+
+template <class Base = default_growth, size_t PageSize = GROWTH_PAGE_SIZE>
+struct page_growth {
+    static_assert((PageSize & (PageSize - 1)) == 0, "page size must be a power of 2");
+
+    static size_t next_capacity(size_t old_cap, size_t need, size_t elem_size) noexcept {
+        const size_t n = Base::next_capacity(old_cap, need, elem_size);
+        if (n > (static_cast<size_t>(-1) - PageSize) / elem_size)
+            return n;
+        const size_t bytes = (n * elem_size + PageSize - 1) & ~(PageSize - 1);
+        return bytes / elem_size;
+    }
+};
+
+} // namespace MySTL
+
+#endif /* MY_GROWTH_POLICY_H */
@@ -29,7 +29,7 @@ void push_heap_aux(RandIter first, Distance holeIndex, Distance topIndex, T valu
 
 template <class RandIter, class Distance>
 void push_heap_d(RandIter first, RandIter last, Distance*) {
-    push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), *(last - 1));
+    push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), typename iterator_traits<RandIter>::value_type(*(last - 1)));
 }
 
 /**
@@ -56,7 +56,7 @@ void push_heap_aux(RandIter first, Distance holeIndex, Distance topIndex, T valu
 // push_heap_d() 使用Compare的重载版本
 template <class RandIter, class Distance, class Compare>
 void push_heap_d(RandIter first, RandIter last, Distance*, Compare cmp) {
-    push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), *(last - 1), cmp);
+    push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), typename iterator_traits<RandIter>::value_type(*(last - 1)), cmp);
 }
 
 /**
@@ -90,13 +90,13 @@ void pop_heap_aux(RandIter first, RandIter last, RandIter result, Distance*, T v
  */
 template <class RandIter>
 void pop_heap(RandIter first, RandIter last) {
-    pop_heap_aux(first, last - 1, last - 1, MySTL::distance_type(first), *(last - 1));
+    pop_heap_aux(first, last - 1, last - 1, MySTL::distance_type(first), typename iterator_traits<RandIter>::value_type(*(last - 1)));
 }
 
 // pop_heap() 使用Compare的重载版本
 template <class RandIter, class Compare>
 void pop_heap(RandIter first, RandIter last, Compare cmp) {
-    pop_heap_aux(first, last - 1, last - 1, MySTL::distance_type(first), *(last - 1), cmp);
+    pop_heap_aux(first, last - 1, last - 1, MySTL::distance_type(first), typename iterator_traits<RandIter>::value_type(*(last - 1)), cmp);
 }
 
 /*****************************************************************************************/
@@ -178,7 +178,7 @@ void make_heap_aux(RandIter first, RandIter last, Distance*) {
     auto len = last - first;
     auto holeIndex = (len - 2) / 2; // 找到最后一个节点的父节点的索引，len处为最后一个右子节点的索引
     while (1) {
-        MySTL::adjust_heap(first, holeIndex, len, *(first + holeIndex));
+        MySTL::adjust_heap(first, holeIndex, len, typename iterator_traits<RandIter>::value_type(*(first + holeIndex)));
         if (holeIndex == 0)
             return;
         holeIndex--;
@@ -200,7 +200,7 @@ void make_heap_aux(RandIter first, RandIter last, Distance*, Compare cmp) {
     auto len = last - first;
     auto holeIndex = (len - 2) / 2;
     while (1) {
-        MySTL::adjust_heap(first, holeIndex, len, *(first + holeIndex), cmp);
+        MySTL::adjust_heap(first, holeIndex, len, typename iterator_traits<RandIter>::value_type(*(first + holeIndex)), cmp);
         if (holeIndex == 0)
             return;
         holeIndex--;
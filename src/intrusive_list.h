@@ -0,0 +1,323 @@
+#ifndef MYSTL_INTRUSIVE_LIST_H
+#define MYSTL_INTRUSIVE_LIST_H
+
+// 侵入式双向链表 intrusive_list 的实现
+// 元素类型 T 公有继承 list_base_hook<Tag>，链表直接串起对象内部的钩子，插入、删除都不申请内存
+// 容器不拥有元素：元素的生命周期由使用者管理，元素析构前必须先从所有链表中移除
+// 同一个对象可以通过不同的 Tag 继承多个钩子，同时挂在多条链表上
+// 链接与断开复用 list.h 中的 list_link_nodes / list_unlink_nodes
+
+#include <cstddef>
+#include <type_traits>
+
+#include "exceptdef.h"
+#include "iterator.h"
+#include "list.h"
+#include "util.h"
+
+namespace MySTL {
+
+// 链表钩子，Tag 用来区分同一个对象上的多个钩子
+// 复制对象时不复制链接关系，新对象的钩子处于未链接状态
+template <class Tag = void>
+struct list_base_hook : public list_node_base<list_base_hook<Tag>> {
+    typedef list_node_base<list_base_hook<Tag>> node_base;
+
+    list_base_hook() noexcept { this->prev = this->next = nullptr; }
+
+    list_base_hook(const list_base_hook&) noexcept { this->prev = this->next = nullptr; }
+
+    list_base_hook& operator=(const list_base_hook&) noexcept { return *this; }
+
+    // 钩子是否挂在某条链表上
+    bool is_linked() const noexcept { return this->next != nullptr; }
+};
+
+// intrusive_list 迭代器设计
+template <class T, class Tag, class Ref, class Ptr>
+struct intrusive_list_iterator : public MySTL::iterator<MySTL::bidirectional_iterator_tag, T> {
+    typedef list_base_hook<Tag>                                      hook_type;
+    typedef typename hook_type::node_base*                           base_ptr;
+    typedef intrusive_list_iterator<T, Tag, T&, T*>                  iterator;
+    typedef intrusive_list_iterator<T, Tag, const T&, const T*>      const_iterator;
+    typedef intrusive_list_iterator                                  self;
+
+    typedef T   value_type;
+    typedef Ptr pointer;
+    typedef Ref reference;
+
+    base_ptr node_;  // 指向当前钩子
+
+    intrusive_list_iterator() noexcept : node_(nullptr) {}
+
+    explicit intrusive_list_iterator(base_ptr x) noexcept : node_(x) {}
+
+    intrusive_list_iterator(const iterator& rhs) noexcept : node_(rhs.node_) {}
+
+    reference operator*() const { return static_cast<reference>(static_cast<hook_type&>(*node_)); }
+    pointer   operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        MYSTL_DEBUG(node_ != nullptr);
+        node_ = node_->next;
+        return *this;
+    }
+
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    self& operator--() {
+        MYSTL_DEBUG(node_ != nullptr);
+        node_ = node_->prev;
+        return *this;
+    }
+
+    self operator--(int) {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+    bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+// 模板类 intrusive_list
+// 模板参数 T 代表元素类型，必须继承 list_base_hook<Tag>，Tag 选择使用哪一个钩子
+template <class T, class Tag = void>
+class intrusive_list {
+public:
+    typedef list_base_hook<Tag> hook_type;
+
+    typedef T         value_type;
+    typedef T*        pointer;
+    typedef const T*  const_pointer;
+    typedef T&        reference;
+    typedef const T&  const_reference;
+    typedef size_t    size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef intrusive_list_iterator<T, Tag, T&, T*>             iterator;
+    typedef intrusive_list_iterator<T, Tag, const T&, const T*> const_iterator;
+    typedef MySTL::reverse_iterator<iterator>                   reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator>             const_reverse_iterator;
+
+private:
+    typedef typename hook_type::node_base node_base;
+    typedef node_base*                    base_ptr;
+
+    node_base head_;  // 哑结点，与 list 一样首尾相连成环
+    size_type size_;
+
+public:
+    /*********************************** 构造、析构 ***********************************/
+    intrusive_list() noexcept : size_(0) { head_.unlink(); }
+
+    // 把 [first, last) 内的对象依次挂到链表尾部
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    intrusive_list(Iter first, Iter last) : size_(0) {
+        head_.unlink();
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    // 元素不属于容器，不能被复制
+    intrusive_list(const intrusive_list&) = delete;
+    intrusive_list& operator=(const intrusive_list&) = delete;
+
+    intrusive_list(intrusive_list&& rhs) noexcept : size_(0) {
+        head_.unlink();
+        swap(rhs);
+    }
+
+    intrusive_list& operator=(intrusive_list&& rhs) noexcept {
+        if (this != &rhs) {
+            clear();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    // 析构时只断开链接，不销毁元素
+    ~intrusive_list() { clear(); }
+
+public:
+    /*********************************** 迭代器相关操作 ***********************************/
+    iterator       begin() noexcept { return iterator(head_.next); }
+    const_iterator begin() const noexcept { return const_iterator(head_.next); }
+    iterator       end() noexcept { return iterator(head()); }
+    const_iterator end() const noexcept { return const_iterator(head()); }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin() const noexcept { return begin(); }
+    const_iterator         cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 由元素得到指向它的迭代器，元素必须已经挂在本链表上，O(1)
+    iterator       iterator_to(reference value) noexcept { return iterator(node_of(value)); }
+    const_iterator iterator_to(const_reference value) const noexcept {
+        return const_iterator(node_of(const_cast<reference>(value)));
+    }
+
+    /*********************************** 容量相关操作 ***********************************/
+    bool      empty() const noexcept { return head_.next == head(); }
+    size_type size() const noexcept { return size_; }
+
+    /*********************************** 访问元素相关操作 ***********************************/
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return *(--end());
+    }
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return *(--end());
+    }
+
+    /*********************************** 修改容器相关操作 ***********************************/
+    void push_front(reference value) noexcept { insert(begin(), value); }
+    void push_back(reference value) noexcept { insert(end(), value); }
+
+    void pop_front() noexcept {
+        MYSTL_DEBUG(!empty());
+        erase(begin());
+    }
+    void pop_back() noexcept {
+        MYSTL_DEBUG(!empty());
+        erase(--end());
+    }
+
+    iterator insert(const_iterator pos, reference value) noexcept;
+    iterator erase(const_iterator pos) noexcept;
+    iterator erase(const_iterator first, const_iterator last) noexcept;
+
+    // 把 value 从本链表中移除，value 必须已经挂在本链表上
+    void remove(reference value) noexcept { erase(iterator_to(value)); }
+
+    void clear() noexcept;
+
+    void splice(const_iterator pos, intrusive_list& x) noexcept;
+    void splice(const_iterator pos, intrusive_list& x, const_iterator it) noexcept;
+
+    void swap(intrusive_list& rhs) noexcept {
+        node_base tmp;
+        list_take_head(tmp.self(), head());
+        list_take_head(head(), rhs.head());
+        list_take_head(rhs.head(), tmp.self());
+        MySTL::swap(size_, rhs.size_);
+    }
+
+private:
+    base_ptr head() const noexcept { return const_cast<base_ptr>(static_cast<const node_base*>(&head_)); }
+
+    static base_ptr node_of(reference value) noexcept { return static_cast<hook_type&>(value).self(); }
+
+    // 断开后把钩子恢复为未链接状态
+    static void reset_node(base_ptr p) noexcept { p->prev = p->next = nullptr; }
+};
+
+/*****************************************************************************************/
+
+// 在 pos 之前挂上 value，value 的钩子必须处于未链接状态
+template <class T, class Tag>
+typename intrusive_list<T, Tag>::iterator
+intrusive_list<T, Tag>::insert(const_iterator pos, reference value) noexcept {
+    auto p = node_of(value);
+    MYSTL_DEBUG(!static_cast<hook_type&>(value).is_linked());
+    list_link_nodes(pos.node_, p, p);
+    ++size_;
+    return iterator(p);
+}
+
+// 移除 pos 处的元素，返回其后继
+template <class T, class Tag>
+typename intrusive_list<T, Tag>::iterator
+intrusive_list<T, Tag>::erase(const_iterator pos) noexcept {
+    MYSTL_DEBUG(pos != cend());
+    auto p = pos.node_;
+    auto next = p->next;
+    list_unlink_nodes(p, p);
+    reset_node(p);
+    --size_;
+    return iterator(next);
+}
+
+// 移除 [first, last) 内的元素
+template <class T, class Tag>
+typename intrusive_list<T, Tag>::iterator
+intrusive_list<T, Tag>::erase(const_iterator first, const_iterator last) noexcept {
+    if (first != last) {
+        list_unlink_nodes(first.node_, last.node_->prev);
+        while (first != last) {
+            auto p = first.node_;
+            ++first;
+            reset_node(p);
+            --size_;
+        }
+    }
+    return iterator(last.node_);
+}
+
+// 断开所有元素，每个钩子都恢复为未链接状态
+template <class T, class Tag>
+void intrusive_list<T, Tag>::clear() noexcept {
+    base_ptr cur = head_.next;
+    while (cur != head()) {
+        base_ptr next = cur->next;
+        reset_node(cur);
+        cur = next;
+    }
+    head_.unlink();
+    size_ = 0;
+}
+
+// 把链表 x 的全部元素移到 pos 之前
+template <class T, class Tag>
+void intrusive_list<T, Tag>::splice(const_iterator pos, intrusive_list& x) noexcept {
+    MYSTL_DEBUG(this != &x);
+    if (!x.empty()) {
+        auto f = x.head_.next;
+        auto l = x.head_.prev;
+        list_unlink_nodes(f, l);
+        list_link_nodes(pos.node_, f, l);
+        size_ += x.size_;
+        x.size_ = 0;
+    }
+}
+
+// 把 x 中 it 所指的元素移到 pos 之前
+template <class T, class Tag>
+void intrusive_list<T, Tag>::splice(const_iterator pos, intrusive_list& x, const_iterator it) noexcept {
+    if (pos.node_ != it.node_ && pos.node_ != it.node_->next) {
+        auto f = it.node_;
+        list_unlink_nodes(f, f);
+        list_link_nodes(pos.node_, f, f);
+        ++size_;
+        --x.size_;
+    }
+}
+
+// 重载 MySTL 的 swap
+template <class T, class Tag>
+void swap(intrusive_list<T, Tag>& lhs, intrusive_list<T, Tag>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // namespace MySTL
+
+#endif /* MYSTL_INTRUSIVE_LIST_H */
@@ -0,0 +1,514 @@
+#ifndef MY_INTRUSIVE_RBTREE_H
+#define MY_INTRUSIVE_RBTREE_H
+
+// 侵入式红黑树 intrusive_rb_tree 的实现
+// 元素类型 T 公有继承 rb_tree_base_hook<Tag>，树直接串起对象内部的钩子，插入、删除都不申请内存
+// 容器不拥有元素：元素的生命周期由使用者管理，元素析构前必须先从所有树中移除，
+// 挂在树上时也不能修改参与比较的键
+// 同一个对象可以通过不同的 Tag 继承多个钩子，同时按不同的键挂在多棵树上
+// 插入、删除后的重新平衡以及迭代器的前进后退复用 rb_tree.h 中的算法
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "exceptdef.h"
+#include "functional.h"
+#include "iterator.h"
+#include "rb_tree.h"
+#include "util.h"
+
+namespace MySTL {
+
+// 红黑树钩子，Tag 用来区分同一个对象上的多个钩子
+// 复制对象时不复制链接关系，新对象的钩子处于未链接状态
+template <class Tag = void>
+struct rb_tree_base_hook : public rb_tree_node_base<rb_tree_base_hook<Tag>> {
+    typedef rb_tree_node_base<rb_tree_base_hook<Tag>> node_base;
+
+    rb_tree_base_hook() noexcept { reset(); }
+
+    rb_tree_base_hook(const rb_tree_base_hook&) noexcept { reset(); }
+
+    rb_tree_base_hook& operator=(const rb_tree_base_hook&) noexcept { return *this; }
+
+    // 钩子是否挂在某棵树上，根节点的父节点是 header，所以已链接的钩子 parent 一定非空
+    bool is_linked() const noexcept { return this->parent != nullptr; }
+
+    void reset() noexcept {
+        this->parent = this->left = this->right = nullptr;
+        this->color = rb_tree_red;
+    }
+};
+
+// 由 KeyOfValue 推导出键的类型，result 为 KeyOfValue 的返回类型(可能是引用也可能是值)
+template <class T, class KeyOfValue>
+struct intrusive_key_of {
+    typedef decltype(std::declval<const KeyOfValue&>()(std::declval<const T&>())) result;
+    typedef typename std::decay<result>::type                                     type;
+};
+
+/*********************************** 侵入式红黑树迭代器设计 ***********************************/
+// inc / dec 直接使用 rb_tree_iterator_base
+template <class T, class Tag, class Ref, class Ptr>
+struct intrusive_rb_tree_iterator : public rb_tree_iterator_base<rb_tree_base_hook<Tag>> {
+    typedef rb_tree_base_hook<Tag>                                 hook_type;
+    typedef rb_tree_iterator_base<hook_type>                       iterator_base;
+    typedef typename iterator_base::base_ptr                       base_ptr;
+    typedef intrusive_rb_tree_iterator<T, Tag, T&, T*>             iterator;
+    typedef intrusive_rb_tree_iterator<T, Tag, const T&, const T*> const_iterator;
+    typedef intrusive_rb_tree_iterator                             self;
+
+    typedef MySTL::bidirectional_iterator_tag iterator_category;
+    typedef T                                 value_type;
+    typedef Ptr                               pointer;
+    typedef Ref                               reference;
+    typedef ptrdiff_t                         difference_type;
+
+    using iterator_base::node;
+
+    // 构造函数
+    intrusive_rb_tree_iterator() {}
+    explicit intrusive_rb_tree_iterator(base_ptr x) { node = x; }
+    intrusive_rb_tree_iterator(const iterator& rhs) { node = rhs.node; }
+
+    // 重载操作符
+    reference operator*() const { return static_cast<reference>(static_cast<hook_type&>(*node)); }
+    pointer   operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        this->inc();
+        return *this;
+    }
+    self operator++(int) {
+        self tmp(*this);
+        this->inc();
+        return tmp;
+    }
+    self& operator--() {
+        this->dec();
+        return *this;
+    }
+    self operator--(int) {
+        self tmp(*this);
+        this->dec();
+        return tmp;
+    }
+};
+
+/*********************************** 侵入式红黑树模板类 ***********************************/
+// 模板参数一为元素类型，必须继承 rb_tree_base_hook<Tag>
+// 参数二为从元素取出键的函数对象，参数三为键值比较类型，参数四选择使用哪一个钩子
+template <class T,
+          class KeyOfValue = MySTL::identity<T>,
+          class Compare = MySTL::less<typename intrusive_key_of<T, KeyOfValue>::type>,
+          class Tag = void>
+class intrusive_rb_tree {
+public:
+    typedef rb_tree_base_hook<Tag>                          hook_type;
+    typedef typename intrusive_key_of<T, KeyOfValue>::type key_type;
+    typedef KeyOfValue                                      key_of_value;
+    typedef Compare                                         key_compare;
+
+    typedef T         value_type;
+    typedef T*        pointer;
+    typedef const T*  const_pointer;
+    typedef T&        reference;
+    typedef const T&  const_reference;
+    typedef size_t    size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef intrusive_rb_tree_iterator<T, Tag, T&, T*>             iterator;
+    typedef intrusive_rb_tree_iterator<T, Tag, const T&, const T*> const_iterator;
+    typedef MySTL::reverse_iterator<iterator>                      reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator>                const_reverse_iterator;
+
+private:
+    typedef typename hook_type::node_base node_base;
+    typedef node_base*                    base_ptr;
+
+    // header_ 的 parent 指向根节点，left / right 分别指向最小、最大节点，与 rb_tree 相同
+    // 只是直接放在容器对象内部，不需要申请
+    mutable node_base header_;
+    size_type         node_count_;
+    key_compare       key_comp_;
+    key_of_value      key_of_;
+
+    base_ptr  header() const noexcept { return &header_; }
+    base_ptr& root() const noexcept { return header_.parent; }
+    base_ptr& leftmost() const noexcept { return header_.left; }
+    base_ptr& rightmost() const noexcept { return header_.right; }
+
+public:
+    /*********************************** 构造、析构 ***********************************/
+    intrusive_rb_tree() : node_count_(0), key_comp_(), key_of_() { header_init(); }
+
+    explicit intrusive_rb_tree(const key_compare& comp, const key_of_value& key_of = key_of_value())
+        : node_count_(0), key_comp_(comp), key_of_(key_of) {
+        header_init();
+    }
+
+    // 元素不属于容器，不能被复制
+    intrusive_rb_tree(const intrusive_rb_tree&) = delete;
+    intrusive_rb_tree& operator=(const intrusive_rb_tree&) = delete;
+
+    intrusive_rb_tree(intrusive_rb_tree&& rhs) noexcept
+        : node_count_(0), key_comp_(rhs.key_comp_), key_of_(rhs.key_of_) {
+        header_init();
+        swap(rhs);
+    }
+
+    intrusive_rb_tree& operator=(intrusive_rb_tree&& rhs) noexcept {
+        if (this != &rhs) {
+            clear();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    // 析构时只断开链接，不销毁元素
+    ~intrusive_rb_tree() { clear(); }
+
+public:
+    /*********************************** 迭代器相关操作 ***********************************/
+    iterator       begin() noexcept { return iterator(leftmost()); }
+    const_iterator begin() const noexcept { return const_iterator(leftmost()); }
+    iterator       end() noexcept { return iterator(header()); }
+    const_iterator end() const noexcept { return const_iterator(header()); }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin() const noexcept { return begin(); }
+    const_iterator         cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 由元素得到指向它的迭代器，元素必须已经挂在本树上，O(1)
+    iterator       iterator_to(reference value) noexcept { return iterator(node_of(value)); }
+    const_iterator iterator_to(const_reference value) const noexcept {
+        return const_iterator(node_of(const_cast<reference>(value)));
+    }
+
+    /*********************************** 容量相关操作 ***********************************/
+    bool      empty() const noexcept { return node_count_ == 0; }
+    size_type size() const noexcept { return node_count_; }
+
+    key_compare  key_comp() const { return key_comp_; }
+    key_of_value key_of() const { return key_of_; }
+
+    /*********************************** 修改容器相关操作 ***********************************/
+    // 允许键重复，value 的钩子必须处于未链接状态
+    // 查找插入位置要调用 key_comp_，比较器可能抛出异常，因此不标 noexcept
+    iterator insert_equal(reference value);
+    // 键已存在时不插入，返回已存在的元素
+    MySTL::pair<iterator, bool> insert_unique(reference value);
+
+    iterator  erase(const_iterator pos) noexcept;
+    void      erase(const_iterator first, const_iterator last) noexcept;
+    size_type erase_multi(const key_type& key);
+    size_type erase_unique(const key_type& key);
+
+    // 把 value 从本树中移除，value 必须已经挂在本树上
+    void remove(reference value) noexcept { erase(iterator_to(value)); }
+
+    void clear() noexcept;
+
+    void swap(intrusive_rb_tree& rhs) noexcept;
+
+    /*********************************** 查找相关操作 ***********************************/
+    iterator       find(const key_type& key);
+    const_iterator find(const key_type& key) const;
+
+    size_type count_multi(const key_type& key) const {
+        auto p = equal_range(key);
+        return static_cast<size_type>(MySTL::distance(p.first, p.second));
+    }
+    size_type count_unique(const key_type& key) const { return find(key) != end() ? 1 : 0; }
+
+    iterator       lower_bound(const key_type& key) { return iterator(lower_bound_node(key)); }
+    const_iterator lower_bound(const key_type& key) const { return const_iterator(lower_bound_node(key)); }
+    iterator       upper_bound(const key_type& key) { return iterator(upper_bound_node(key)); }
+    const_iterator upper_bound(const key_type& key) const { return const_iterator(upper_bound_node(key)); }
+
+    MySTL::pair<iterator, iterator> equal_range(const key_type& key) {
+        return MySTL::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+    }
+    MySTL::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return MySTL::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+    }
+
+private:
+    static base_ptr node_of(reference value) noexcept {
+        return static_cast<node_base*>(&static_cast<hook_type&>(value));
+    }
+
+    typename intrusive_key_of<T, KeyOfValue>::result key_of_node(base_ptr p) const {
+        return key_of_(static_cast<const_reference>(static_cast<hook_type&>(*p)));
+    }
+
+    void header_init() noexcept {
+        header_.color = rb_tree_red;  // header_与root_互为父节点，颜色区分
+        header_.parent = nullptr;
+        header_.left = header();
+        header_.right = header();
+    }
+
+    base_ptr lower_bound_node(const key_type& key) const;
+    base_ptr upper_bound_node(const key_type& key) const;
+
+    MySTL::pair<base_ptr, bool> get_insert_multi_pos(const key_type& key) const;
+    MySTL::pair<MySTL::pair<base_ptr, bool>, bool> get_insert_unique_pos(const key_type& key) const;
+    iterator insert_node_at(base_ptr x, base_ptr node, bool add_to_left) noexcept;
+
+    static void reset_since(base_ptr x) noexcept;
+};
+
+/*****************************************************************************************/
+
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::iterator
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::insert_equal(reference value) {
+    MYSTL_DEBUG(!static_cast<hook_type&>(value).is_linked());
+    auto res = get_insert_multi_pos(key_of_(value));
+    return insert_node_at(res.first, node_of(value), res.second);
+}
+
+template <class T, class KeyOfValue, class Compare, class Tag>
+MySTL::pair<typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::iterator, bool>
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::insert_unique(reference value) {
+    MYSTL_DEBUG(!static_cast<hook_type&>(value).is_linked());
+    auto res = get_insert_unique_pos(key_of_(value));
+    if (res.second)
+        return MySTL::make_pair(insert_node_at(res.first.first, node_of(value), res.first.second), true);
+    return MySTL::make_pair(iterator(res.first.first), false);
+}
+
+/**
+ * @brief 移除 pos 处的元素
+ * @return iterator 指向被移除元素的下一个元素
+ */
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::iterator
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::erase(const_iterator pos) noexcept {
+    MYSTL_DEBUG(pos != cend());
+    base_ptr z = pos.node;
+    iterator next(z);
+    ++next;
+    rb_tree_erase_reblance(z, root(), leftmost(), rightmost());
+    static_cast<hook_type*>(z)->reset();
+    --node_count_;
+    return next;
+}
+
+// 移除 [first, last) 内的元素
+template <class T, class KeyOfValue, class Compare, class Tag>
+void intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::erase(const_iterator first, const_iterator last) noexcept {
+    if (first == cbegin() && last == cend()) {
+        clear();
+    } else {
+        while (first != last)
+            first = erase(first);
+    }
+}
+
+// 移除所有键为 key 的元素，返回移除的个数
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::size_type
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::erase_multi(const key_type& key) {
+    auto      p = equal_range(key);
+    size_type n = static_cast<size_type>(MySTL::distance(p.first, p.second));
+    erase(p.first, p.second);
+    return n;
+}
+
+// 移除键为 key 的元素，返回移除的个数
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::size_type
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::erase_unique(const key_type& key) {
+    auto it = find(key);
+    if (it != end()) {
+        erase(it);
+        return 1;
+    }
+    return 0;
+}
+
+// 断开所有元素，每个钩子都恢复为未链接状态
+template <class T, class KeyOfValue, class Compare, class Tag>
+void intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::clear() noexcept {
+    if (node_count_ != 0) {
+        reset_since(root());
+        header_init();
+        node_count_ = 0;
+    }
+}
+
+// header_ 在对象内部，交换后要把根节点的 parent 指回各自的 header_
+template <class T, class KeyOfValue, class Compare, class Tag>
+void intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::swap(intrusive_rb_tree& rhs) noexcept {
+    if (this == &rhs)
+        return;
+    MySTL::swap(root(), rhs.root());
+    MySTL::swap(leftmost(), rhs.leftmost());
+    MySTL::swap(rightmost(), rhs.rightmost());
+    MySTL::swap(node_count_, rhs.node_count_);
+    MySTL::swap(key_comp_, rhs.key_comp_);
+    MySTL::swap(key_of_, rhs.key_of_);
+    if (root() == nullptr)
+        header_init();
+    else
+        root()->parent = header();
+    if (rhs.root() == nullptr)
+        rhs.header_init();
+    else
+        rhs.root()->parent = rhs.header();
+}
+
+// 查找键为 key 的元素，没有找到时返回 end()
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::iterator
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::find(const key_type& key) {
+    auto j = lower_bound_node(key);
+    return (j == header() || key_comp_(key, key_of_node(j))) ? end() : iterator(j);
+}
+
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::const_iterator
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::find(const key_type& key) const {
+    auto j = lower_bound_node(key);
+    return (j == header() || key_comp_(key, key_of_node(j))) ? end() : const_iterator(j);
+}
+
+// 第一个不小于 key 的节点
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::base_ptr
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::lower_bound_node(const key_type& key) const {
+    auto y = header();
+    auto x = root();
+    while (x != nullptr) {
+        if (!key_comp_(key_of_node(x), key)) {
+            y = x;
+            x = x->left;
+        } else {
+            x = x->right;
+        }
+    }
+    return y;
+}
+
+// 第一个大于 key 的节点
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::base_ptr
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::upper_bound_node(const key_type& key) const {
+    auto y = header();
+    auto x = root();
+    while (x != nullptr) {
+        if (key_comp_(key, key_of_node(x))) {
+            y = x;
+            x = x->left;
+        } else {
+            x = x->right;
+        }
+    }
+    return y;
+}
+
+/**
+ * @brief 寻找合适插入节点的位置，允许插入具有相同键的节点
+ * @return pair<指向应该插入位置的父节点，插入在找到的位置的左边还是右边>
+ */
+template <class T, class KeyOfValue, class Compare, class Tag>
+MySTL::pair<typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::base_ptr, bool>
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::get_insert_multi_pos(const key_type& key) const {
+    auto x = root();
+    auto y = header();
+    bool add_to_left = true;
+    while (x != nullptr) {
+        y = x;
+        add_to_left = key_comp_(key, key_of_node(x));
+        x = add_to_left ? x->left : x->right;
+    }
+    return MySTL::make_pair(y, add_to_left);
+}
+
+/**
+ * @brief 寻找合适插入节点的位置，不允许插入具有相同键的节点
+ * @return pair<pair<插入点的父节点，是否在左边插入>，是否可以插入>
+ *         不能插入时，插入点的前驱就是键相同的节点
+ */
+template <class T, class KeyOfValue, class Compare, class Tag>
+MySTL::pair<MySTL::pair<typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::base_ptr, bool>, bool>
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::get_insert_unique_pos(const key_type& key) const {
+    auto x = root();
+    auto y = header();
+    bool add_to_left = true;
+    while (x != nullptr) {
+        y = x;
+        add_to_left = key_comp_(key, key_of_node(x));
+        x = add_to_left ? x->left : x->right;
+    }
+    const_iterator j(y);
+    if (add_to_left) {
+        if (y == header() || j == begin()) {  // 树为空 / 插入点在最左节点处
+            return MySTL::make_pair(MySTL::make_pair(y, add_to_left), true);
+        }
+        --j;
+    }
+    if (key_comp_(key_of_node(j.node), key))
+        return MySTL::make_pair(MySTL::make_pair(y, add_to_left), true);
+    return MySTL::make_pair(MySTL::make_pair(j.node, add_to_left), false);
+}
+
+/**
+ * @brief 在 x 节点处挂上 node
+ * @param x 插入点的父节点
+ * @param node 要挂上的钩子
+ * @param add_to_left 是否在左边插入
+ */
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::iterator
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::insert_node_at(base_ptr x, base_ptr node, bool add_to_left) noexcept {
+    node->parent = x;
+    node->left = node->right = nullptr;
+    if (x == header()) {  // 空树
+        root() = node;
+        leftmost() = node;
+        rightmost() = node;
+    } else if (add_to_left) {
+        x->left = node;
+        if (leftmost() == x)
+            leftmost() = node;
+    } else {
+        x->right = node;
+        if (rightmost() == x)
+            rightmost() = node;
+    }
+    rb_tree_insert_rebalance(node, root());
+    ++node_count_;
+    return iterator(node);
+}
+
+// 把以 x 为根的子树上的钩子全部恢复为未链接状态
+template <class T, class KeyOfValue, class Compare, class Tag>
+void intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::reset_since(base_ptr x) noexcept {
+    while (x != nullptr) {
+        reset_since(x->right);
+        auto y = x->left;
+        static_cast<hook_type*>(x)->reset();
+        x = y;
+    }
+}
+
+// 重载 MySTL 的 swap
+template <class T, class KeyOfValue, class Compare, class Tag>
+void swap(intrusive_rb_tree<T, KeyOfValue, Compare, Tag>& lhs,
+          intrusive_rb_tree<T, KeyOfValue, Compare, Tag>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} /* namespace MySTL  */
+
+#endif // MY_INTRUSIVE_RBTREE_H
@@ -2,10 +2,12 @@
 #define MY_ITERATOR_H
 
 //
-// 迭代器标签, 迭代器模板, 迭代器萃取, 迭代器距离, 迭代器前进, 反向迭代器
+// 迭代器标签, 迭代器模板, 迭代器萃取, 迭代器距离, 迭代器前进, 反向迭代器, 输入流迭代器, 区间首尾
 //
 
 #include <cstddef>
+#include <istream>
+#include <string>
 
 #include "type_traits.h"
 
@@ -134,6 +136,22 @@ template <class Iter>
 struct is_iterator : public m_bool_constant<is_input_iterator<Iter>::value ||
                                             is_output_iterator<Iter>::value> {};
 
+// 分段迭代器萃取
+// 由若干段连续内存组成的序列(如 deque)的迭代器特化该模板，算法据此逐段处理，段内只用指针循环或 memmove
+// 特化需提供：
+//   is_segmented      : m_true_type
+//   segment_iterator  : 段迭代器，local_iterator : 段内迭代器(指针)
+//   segment(it), local(it)   : 拆出 it 所在的段与段内位置
+//   begin(seg), end(seg)     : 段的首尾
+//   compose(seg, local)      : 组合回原迭代器，local 等于 end(seg) 时落到下一段的开头
+template <class Iter>
+struct segmented_iterator_traits {
+    typedef m_false_type is_segmented;
+};
+
+template <class Iter>
+struct is_segmented_iterator : public segmented_iterator_traits<Iter>::is_segmented {};
+
 // 萃取category
 template <class Iterator>
 typename iterator_traits<Iterator>::iterator_category
@@ -334,6 +352,67 @@ bool operator<=(const reverse_iterator<Iterator>& lhs, const reverse_iterator<It
     return !(lhs > rhs);
 }
 
+/**
+ * @brief 输入流迭代器，每次递增用 operator>> 读取一个 T，读取失败后等于默认构造的尾迭代器
+ * @note  单趟迭代器，不能预先求出区间长度
+ */
+template <class T, class CharT = char, class Traits = std::char_traits<CharT>, class Distance = ptrdiff_t>
+class istream_iterator : public iterator<input_iterator_tag, T, Distance, const T*, const T&> {
+public:
+    typedef input_iterator_tag                iterator_category;
+    typedef T                                 value_type;
+    typedef Distance                          difference_type;
+    typedef const T*                          pointer;
+    typedef const T&                          reference;
+    typedef std::basic_istream<CharT, Traits> istream_type;
+    typedef istream_iterator                  self;
+
+private:
+    istream_type* stream_;
+    T             value_;
+
+    void read() {
+        if (stream_ != nullptr && !(*stream_ >> value_))
+            stream_ = nullptr;
+    }
+
+public:
+    istream_iterator() : stream_(nullptr), value_() {}
+    istream_iterator(istream_type& is) : stream_(&is), value_() { read(); }
+
+    const T& operator*() const { return value_; }
+    const T* operator->() const { return &value_; }
+
+    self& operator++() {
+        read();
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        read();
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return stream_ == rhs.stream_; }
+    bool operator!=(const self& rhs) const { return stream_ != rhs.stream_; }
+};
+
+/**
+ * @brief 区间的首尾迭代器，供容器的 append_range / insert_range / assign_range 使用
+ * @note  接受提供 begin() / end() 的容器和内置数组
+ */
+template <class Range>
+auto range_begin(Range& rg) -> decltype(rg.begin()) { return rg.begin(); }
+
+template <class Range>
+auto range_end(Range& rg) -> decltype(rg.end()) { return rg.end(); }
+
+template <class T, size_t N>
+T* range_begin(T (&arr)[N]) noexcept { return arr; }
+
+template <class T, size_t N>
+T* range_end(T (&arr)[N]) noexcept { return arr + N; }
+
 } // namespace MySTL
 
 #endif /* MY_ITERATOR_H */
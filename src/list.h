@@ -17,6 +17,11 @@
 
 namespace MySTL {
 
+// list::sort 中先用插入排序整理的每段长度，之后再两两归并
+#ifndef LIST_SORT_RUN
+#define LIST_SORT_RUN 16
+#endif
+
 template <class T> struct list_node_base;
 template <class T> struct list_node;
 
@@ -72,6 +77,66 @@ struct list_node : public list_node_base<T> {
     }
 };
 
+/**
+ * 链接算法，只依赖结点的 prev/next 指针，list 与 intrusive_list 共用
+ */
+
+// 在 pos 之前连接 [first, last]
+template <class BasePtr>
+void list_link_nodes(BasePtr pos, BasePtr first, BasePtr last) noexcept {
+    pos->prev->next = first;
+    first->prev = pos->prev;
+    pos->prev = last;
+    last->next = pos;
+}
+
+// 断开 [first, last] 与前后结点的连接，[first, last] 内部的指针保持不变
+template <class BasePtr>
+void list_unlink_nodes(BasePtr first, BasePtr last) noexcept {
+    first->prev->next = last->next;
+    last->next->prev = first->prev;
+}
+
+// 把 src 哑结点上挂着的整条环形链表转移到 dst 哑结点上，src 变为空链表
+template <class BasePtr>
+void list_take_head(BasePtr dst, BasePtr src) noexcept {
+    if (src->next == src) {
+        dst->unlink();
+        return;
+    }
+    dst->next = src->next;
+    dst->prev = src->prev;
+    dst->next->prev = dst;
+    dst->prev->next = dst;
+    src->unlink();
+}
+
+/**
+ * 结点的申请与销毁，只要求结点类型有名为 value 的成员，list 与 forward_list 共用
+ */
+
+// 申请一个结点并在其 value 上构造元素，构造抛出异常时释放结点；链接指针由调用者设置
+template <class NodeAlloc, class... Args>
+typename allocator_traits<NodeAlloc>::pointer create_value_node(NodeAlloc& alloc, Args&&... args) {
+    typedef allocator_traits<NodeAlloc> node_alloc_traits;
+    auto p = node_alloc_traits::allocate(alloc, 1);
+    try {
+        node_alloc_traits::construct(alloc, MySTL::address_of(p->value), MySTL::forward<Args>(args)...);
+    } catch (...) {
+        node_alloc_traits::deallocate(alloc, p, 1);
+        throw;
+    }
+    return p;
+}
+
+// 析构结点中的元素并释放结点
+template <class NodeAlloc>
+void destroy_value_node(NodeAlloc& alloc, typename allocator_traits<NodeAlloc>::pointer p) {
+    typedef allocator_traits<NodeAlloc> node_alloc_traits;
+    node_alloc_traits::destroy(alloc, MySTL::address_of(p->value));
+    node_alloc_traits::deallocate(alloc, p, 1);
+}
+
 // list迭代器设计
 template <class T>
 struct list_iterator : public MySTL::iterator<MySTL::bidirectional_iterator_tag, T> {
@@ -180,22 +245,21 @@ struct list_const_iterator : public MySTL::iterator<bidirectional_iterator_tag,
 
 };
 
-template <class T>
-class list {
+template <class T, class Alloc = MySTL::allocator<T>>
+class list : private alloc_holder<typename allocator_traits<Alloc>::template rebind_alloc<list_node<T>>> {
 
 public:
-    typedef MySTL::allocator<T>                         allocator_type;
-    typedef MySTL::allocator<T>                         data_allocator;
-    typedef MySTL::allocator<list_node_base<T>>         base_allocator;
-    typedef MySTL::allocator<list_node<T>>              node_allocator;
-
-    typedef typename allocator_type::value_type         value_type;
-    typedef typename allocator_type::pointer            pointer;
-    typedef typename allocator_type::const_pointer      const_pointer;
-    typedef typename allocator_type::reference          reference;
-    typedef typename allocator_type::const_reference    const_reference;
-    typedef typename allocator_type::size_type          size_type;
-    typedef typename allocator_type::difference_type    difference_type;
+    typedef Alloc                                                                       allocator_type;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<list_node<T>>      node_allocator;
+    typedef MySTL::allocator_traits<node_allocator>                                     node_alloc_traits;
+
+    typedef T                                           value_type;
+    typedef T*                                          pointer;
+    typedef const T*                                    const_pointer;
+    typedef T&                                          reference;
+    typedef const T&                                    const_reference;
+    typedef size_t                                      size_type;
+    typedef ptrdiff_t                                   difference_type;
 
     typedef list_iterator<T>                            iterator;
     typedef list_const_iterator<T>                      const_iterator;
@@ -205,36 +269,51 @@ public:
     typedef typename node_traits<T>::base_ptr           base_ptr;
     typedef typename node_traits<T>::node_ptr           node_ptr;
 
-    allocator_type get_allocator() {return node_allocator();}
+    allocator_type get_allocator() const { return allocator_type(get_alloc()); }
 
 
 private:
-    base_ptr  node_; // node是一个dummy 结点
-    size_type size_;
+    typedef alloc_holder<node_allocator>                alloc_base;
+    using alloc_base::get_alloc;
+
+    list_node_base<T> head_; // 哨兵结点直接嵌在 list 对象中，空 list 不需要分配内存
+    size_type         size_;
 
 public:
     /*********************************** 构造，复制，移动，析构 ***********************************/
 
     // 构造
 
-    list() { fill_init(0, value_type()); }
+    list() noexcept : size_(0) { head_.unlink(); }
+
+    explicit list(const allocator_type& alloc) noexcept : alloc_base(node_allocator(alloc)), size_(0) { head_.unlink(); }
 
-    explicit list(size_type n) { fill_init(n, value_type()); }
+    explicit list(size_type n, const allocator_type& alloc = allocator_type()) :
+        alloc_base(node_allocator(alloc)) { fill_init(n, value_type()); }
 
-    list(size_type n, const T& value) { fill_init(n, value); }
+    list(size_type n, const T& value, const allocator_type& alloc = allocator_type()) :
+        alloc_base(node_allocator(alloc)) { fill_init(n, value); }
 
     template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
-    list(Iter first, Iter last) { copy_init(first, last); }
+    list(Iter first, Iter last, const allocator_type& alloc = allocator_type()) :
+        alloc_base(node_allocator(alloc)) { copy_init(first, last); }
 
-    list(std::initializer_list<T> ilist) { copy_init(ilist.begin(), ilist.end()); }
+    list(std::initializer_list<T> ilist, const allocator_type& alloc = allocator_type()) :
+        alloc_base(node_allocator(alloc)) { copy_init(ilist.begin(), ilist.end()); }
 
-    // 复制
-    list(const list& rhs) { copy_init(rhs.begin(), rhs.end()); }
+    // 复制，分配器由 select_on_container_copy_construction 决定
+    list(const list& rhs) :
+        alloc_base(node_alloc_traits::select_on_container_copy_construction(rhs.get_alloc())) {
+        copy_init(rhs.begin(), rhs.end());
+    }
+
+    list(const list& rhs, const allocator_type& alloc) :
+        alloc_base(node_allocator(alloc)) { copy_init(rhs.begin(), rhs.end()); }
 
-    // 移动
+    // 移动，哨兵结点不能随之转移，只把首尾结点重新接到自己的哨兵上
     list(list&& rhs) noexcept :
-        node_(rhs.node_), size_(rhs.size_) {
-        rhs.node_ = nullptr;
+        alloc_base(MySTL::move(rhs.get_alloc())), size_(rhs.size_) {
+        take_head(head(), rhs.head());
         rhs.size_ = 0;
     }
 
@@ -242,41 +321,49 @@ public:
 
     list& operator=(const list& rhs) {
         if (this != &rhs) {
+            if (node_alloc_traits::propagate_on_container_copy_assignment::value &&
+                !MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+                // 分配器将被替换，已有结点必须先由旧分配器释放
+                clear();
+            }
+            MySTL::alloc_on_copy(get_alloc(), rhs.get_alloc());
             assign(rhs.begin(), rhs.end());
         }
         return *this;
     }
 
     list& operator=(list &&rhs) {
+        if (this == &rhs) return *this;
         clear();
-        splice(end(), rhs);
+        MySTL::alloc_on_move(get_alloc(), rhs.get_alloc());
+        if (MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+            splice(end(), rhs);
+        } else {
+            // 分配器不相等且不传播，不能接管 rhs 的结点，只能逐个移动元素
+            for (auto it = rhs.begin(); it != rhs.end(); ++it)
+                emplace_back(MySTL::move(*it));
+            rhs.clear();
+        }
         return *this;
     }
 
     list& operator=(std::initializer_list<T> ilist) {
-        list tmp(ilist.begin(), ilist.end());
+        list tmp(ilist.begin(), ilist.end(), get_allocator());
         swap(tmp);
         return *this;
     }
 
     // 析构
-    ~list() {
-        if (node_) {
-            clear();
-            base_allocator::deallocate(node_);
-            node_ = nullptr;
-            size_ = 0;
-        }
-    }
+    ~list() { clear(); }
 
 public:
 
     /***********************************  迭代器相关操作 ***********************************/
 
-    iterator       begin() noexcept { return node_->next; }
-    const_iterator begin() const noexcept { return node_->next; }
-    iterator       end() noexcept { return node_; }
-    const_iterator end() const noexcept { return node_; }
+    iterator       begin() noexcept { return head()->next; }
+    const_iterator begin() const noexcept { return head()->next; }
+    iterator       end() noexcept { return head(); }
+    const_iterator end() const noexcept { return head(); }
 
     reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
     const_reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
@@ -290,7 +377,7 @@ public:
 
     /***********************************  容器相关操作 ***********************************/
 
-    bool empty() const noexcept { return node_->next == node_; }
+    bool empty() const noexcept { return head()->next == head(); }
 
     size_type size() const noexcept { return size_; }
 
@@ -375,11 +462,21 @@ public:
 
     template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
     iterator insert(const_iterator pos, Iter first, Iter last) {
-        size_type len = MySTL::distance(first, last);
-        THROW_LENGTH_ERROR_IF(size_ + len > max_size(), "list<T>'s size too big");
-        return copy_insert(pos, len, first);
+        return copy_insert(pos, first, last);
+    }
+
+    // 追加、插入、赋值整个区间(容器或内置数组)，新节点先连成一串再一次接入链表
+    template <class Range>
+    void append_range(Range&& rg) { copy_insert(cend(), MySTL::range_begin(rg), MySTL::range_end(rg)); }
+
+    template <class Range>
+    iterator insert_range(const_iterator pos, Range&& rg) {
+        return copy_insert(pos, MySTL::range_begin(rg), MySTL::range_end(rg));
     }
 
+    template <class Range>
+    void assign_range(Range&& rg) { copy_assign(MySTL::range_begin(rg), MySTL::range_end(rg)); }
+
     // push_front & push_back
 
     void push_front(const value_type& value) {
@@ -408,7 +505,7 @@ public:
 
     void pop_front() {
         MYSTL_DEBUG(!empty());
-        auto n = node_ -> next;
+        auto n = head() -> next;
         unlink_nodes(n, n);
         destory_node(n->as_node());
         --size_;
@@ -416,7 +513,7 @@ public:
 
     void pop_back() {
         MYSTL_DEBUG(!empty());
-        auto n = node_ -> prev;
+        auto n = head() -> prev;
         unlink_nodes(n, n);
         destory_node(n->as_node());
         --size_;
@@ -434,7 +531,11 @@ public:
     void resize(size_type new_size, const value_type& value);
 
     void swap(list& rhs) noexcept {
-        MySTL::swap(node_, rhs.node_);
+        MySTL::alloc_on_swap(get_alloc(), rhs.get_alloc());
+        list_node_base<T> tmp;
+        take_head(tmp.self(), head());
+        take_head(head(), rhs.head());
+        take_head(rhs.head(), tmp.self());
         MySTL::swap(size_, rhs.size_);
     }
 
@@ -462,9 +563,18 @@ public:
     void merge(list& x, Compare comp);
 
     // sort
-    void sort() { list_sort(begin(), end(), size(), MySTL::less<T>()); }
+    // 先把结点指针收集到临时缓冲区中稳定排序，再一次性重新链接；缓冲区申请不到时退回到原地归并
+    void sort() { sort(MySTL::less<T>()); }
     template <class Compare>
-    void sort(Compare cmp) { list_sort(begin(), end(), size(), cmp); }
+    void sort(Compare cmp) {
+        if (!buffer_sort(cmp))
+            list_sort(begin(), end(), size(), cmp);
+    }
+
+    // 不申请额外内存的原地归并排序
+    void inplace_sort() { list_sort(begin(), end(), size(), MySTL::less<T>()); }
+    template <class Compare>
+    void inplace_sort(Compare cmp) { list_sort(begin(), end(), size(), cmp); }
 
     void reverse();
 
@@ -478,6 +588,11 @@ private:
 
     void destory_node(node_ptr p);
 
+    base_ptr head() const noexcept { return const_cast<list_node_base<T>&>(head_).self(); }
+
+    // 把 src 哨兵上的结点整体改挂到 dst 哨兵上，src 变为空
+    static void take_head(base_ptr dst, base_ptr src) noexcept;
+
     // 初始化
     void fill_init(size_type n, const value_type& value);
     template <class Iter>
@@ -498,10 +613,15 @@ private:
     // 实现insert
     iterator fill_insert(const_iterator pos, size_type n, const value_type& value);
     template <class Iter>
-    iterator copy_insert(const_iterator pos, size_type n, Iter first);
+    iterator copy_insert(const_iterator pos, Iter first, Iter last);
 
     template <class Compare>
     iterator list_sort(iterator first, iterator last, size_type n, Compare comp);
+    template <class Compare>
+    bool buffer_sort(Compare cmp);
+    template <class Compare>
+    static void merge_pointer_runs(base_ptr* first, base_ptr* middle, base_ptr* last,
+                                   base_ptr* result, Compare& cmp);
 };
 
 /*********************************** 容器操作 ***********************************/
@@ -511,9 +631,9 @@ private:
 */
 
 // 删除pos
-template <class T>
-typename list<T>::iterator
-list<T>::erase(const_iterator pos) {
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator
+list<T, Alloc>::erase(const_iterator pos) {
     MYSTL_DEBUG(pos != cend());
     auto n = pos.node_;
     auto next = n->next;
@@ -524,9 +644,9 @@ list<T>::erase(const_iterator pos) {
 }
 
 // 删除 [first, last), 返回last
-template <class T>
-typename list<T>::iterator
-list<T>::erase(const_iterator first, const_iterator last) {
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator
+list<T, Alloc>::erase(const_iterator first, const_iterator last) {
     if (first != last) {
         unlink_nodes(first.node_, last.node_->prev);
         while (first != last) {
@@ -540,21 +660,21 @@ list<T>::erase(const_iterator first, const_iterator last) {
 }
 
 // 清空list
-template <class T>
-void list<T>::clear() {
+template <class T, class Alloc>
+void list<T, Alloc>::clear() {
     if (size_ != 0) {
-        auto cur = node_->next;
-        for (base_ptr next = cur->next; cur != node_; cur = next, next = cur->next) {
+        auto cur = head()->next;
+        for (base_ptr next = cur->next; cur != head(); cur = next, next = cur->next) {
             destory_node(cur->as_node());
         }
-        node_->unlink();
+        head()->unlink();
         size_ = 0;
     }
 }
 
 // resize
-template <class T>
-void list<T>::resize(size_type new_size, const value_type& value) {
+template <class T, class Alloc>
+void list<T, Alloc>::resize(size_type new_size, const value_type& value) {
     auto      i = begin();
     size_type len = 0;
     while (i != end() && len < new_size) {
@@ -562,20 +682,20 @@ void list<T>::resize(size_type new_size, const value_type& value) {
         ++len;
     }
     if (len == new_size) {
-        erase(i, node_);
+        erase(i, head());
     } else {
-        insert(node_, new_size - len, value);
+        insert(head(), new_size - len, value);
     }
 }
 
 // 将list x 接合于pos之前
-template <class T>
-void list<T>::splice(const_iterator pos, list& x) {
+template <class T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list& x) {
     MYSTL_DEBUG(this != &x);
     if (!x.empty()) {
         THROW_LENGTH_ERROR_IF(size_ + x.size_ > max_size(), "list<T>'s size too big");
-        auto first = x.node_->next;
-        auto last = x.node_->prev;
+        auto first = x.head()->next;
+        auto last = x.head()->prev;
         x.unlink_nodes(first, last);
         link_nodes(pos.node_, first, last);
         size_ += x.size_;
@@ -584,8 +704,8 @@ void list<T>::splice(const_iterator pos, list& x) {
 }
 
 // 将list x 中的it 所指节点 接合于pos之前
-template <class T>
-void list<T>::splice(const_iterator pos, list& x, const_iterator it) {
+template <class T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list& x, const_iterator it) {
     if (pos.node_ != it.node_ && pos.node_ != it.node_ -> next) {
         THROW_LENGTH_ERROR_IF(size_ + 1 > max_size(), "list<T>'s size too big");
 
@@ -599,8 +719,8 @@ void list<T>::splice(const_iterator pos, list& x, const_iterator it) {
 }
 
 // 将list x 的[first, last) 接合于pos之前
-template <class T>
-void list<T>::splice(const_iterator pos, list& x, const_iterator first, const_iterator last) {
+template <class T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list& x, const_iterator first, const_iterator last) {
     if (first != last && this != &x) {
         size_type len = MySTL::distance(first, last);
         THROW_LENGTH_ERROR_IF(size_ + len > max_size(), "list<T>'s size too big");
@@ -614,9 +734,9 @@ void list<T>::splice(const_iterator pos, list& x, const_iterator first, const_it
 }
 
 // 一元操作pred作为true的元素进行移除
-template <class T>
+template <class T, class Alloc>
 template <class UnaryPredicate>
-void list<T>::remove_if(UnaryPredicate pred) {
+void list<T, Alloc>::remove_if(UnaryPredicate pred) {
     auto f = begin();
     auto l = end();
     for (auto next = f; f != l; f = next) {
@@ -628,9 +748,9 @@ void list<T>::remove_if(UnaryPredicate pred) {
 }
 
 // 移除list 中满足pred为true的重复元素
-template <class T>
+template <class T, class Alloc>
 template <class BinaryPredicate>
-void list<T>::unique(BinaryPredicate pred) {
+void list<T, Alloc>::unique(BinaryPredicate pred) {
     auto i = begin();
     auto e = end();
     auto j = i;
@@ -647,9 +767,9 @@ void list<T>::unique(BinaryPredicate pred) {
 }
 
 // 与另一个list合并
-template <class T>
+template <class T, class Alloc>
 template <class Compare>
-void list<T>::merge(list& x, Compare cmp) {
+void list<T, Alloc>::merge(list& x, Compare cmp) {
     if (this != &x) {
         THROW_LENGTH_ERROR_IF(size_ + x.size_ > max_size(), "list<T>'s size too big");
 
@@ -691,8 +811,8 @@ void list<T>::merge(list& x, Compare cmp) {
 }
 
 // 反转list
-template <class T>
-void list<T>::reverse() {
+template <class T, class Alloc>
+void list<T, Alloc>::reverse() {
     if (size_ <= 1) {
         return;
     }
@@ -708,34 +828,31 @@ void list<T>::reverse() {
 /*********************************** helper functions ***********************************/
 
 // 创建结点
-template <class T>
+template <class T, class Alloc>
 template <class... Args>
-typename list<T>::node_ptr
-list<T>::create_node(Args&&... args) {
-    node_ptr p = node_allocator::allocate(1);
-    try {
-        data_allocator::construct(MySTL::address_of(p->value), MySTL::forward<Args>(args)...);
-        p->prev = nullptr;
-        p->next = nullptr;
-    } catch (...) {
-        node_allocator::deallocate(p);
-        throw;
-    }
+typename list<T, Alloc>::node_ptr
+list<T, Alloc>::create_node(Args&&... args) {
+    node_ptr p = create_value_node(get_alloc(), MySTL::forward<Args>(args)...);
+    p->prev = nullptr;
+    p->next = nullptr;
     return p;
 }
 
 // 销毁节点
-template <class T>
-void list<T>::destory_node(node_ptr p) {
-    data_allocator::destroy(MySTL::address_of(p->value));
-    node_allocator::deallocate(p);
+template <class T, class Alloc>
+void list<T, Alloc>::destory_node(node_ptr p) {
+    destroy_value_node(get_alloc(), p);
+}
+
+template <class T, class Alloc>
+void list<T, Alloc>::take_head(base_ptr dst, base_ptr src) noexcept {
+    list_take_head(dst, src);
 }
 
 // 使用 n 个 value 初始化容器
-template <class T>
-void list<T>::fill_init(size_type n, const value_type& value) {
-    node_ = base_allocator::allocate(1);
-    node_->unlink();
+template <class T, class Alloc>
+void list<T, Alloc>::fill_init(size_type n, const value_type& value) {
+    head_.unlink();
     size_ = n;
     try {
         for (; n > 0; --n) {
@@ -744,29 +861,25 @@ void list<T>::fill_init(size_type n, const value_type& value) {
         }
     } catch (...) {
         clear();
-        base_allocator::deallocate(node_);
-        node_ = nullptr;
         throw;
     }
 }
 
 // 使用 [first, last) 初始化容器
-template <class T>
+template <class T, class Alloc>
 template <class Iter>
-void list<T>::copy_init(Iter first, Iter last) {
-    node_ = base_allocator::allocate(1);
-    node_->unlink();
-    size_type n = MySTL::distance(first, last);
-    size_ = n;
+void list<T, Alloc>::copy_init(Iter first, Iter last) {
+    head_.unlink();
+    size_ = 0;
     try {
-        for (; n > 0; --n, ++first) {
+        for (; first != last; ++first) {
+            THROW_LENGTH_ERROR_IF(size_ == max_size(), "list<T>'s size too big");
             auto node = create_node(*first);
             link_nodes_at_back(node->as_base(), node->as_base());
+            ++size_;
         }
     } catch (...) {
         clear();
-        base_allocator::deallocate(node_);
-        node_ = nullptr;
         throw;
     }
 }
@@ -776,12 +889,12 @@ void list<T>::copy_init(Iter first, Iter last) {
 */
 
 // 在pos处连接节点
-template <class T>
-typename list<T>::iterator
-list<T>::link_iter_node(const_iterator pos, base_ptr link_node) {
-    if (pos == node_->next) {
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator
+list<T, Alloc>::link_iter_node(const_iterator pos, base_ptr link_node) {
+    if (pos == head()->next) {
         link_nodes_at_front(link_node, link_node);
-    } else if (pos == node_) {
+    } else if (pos == head()) {
         link_nodes_at_back(link_node, link_node);
     } else {
         link_nodes(pos.node_, link_node, link_node);
@@ -790,37 +903,27 @@ list<T>::link_iter_node(const_iterator pos, base_ptr link_node) {
 }
 
 // 在 pos 处连接 [first, last]
-template <class T>
-void list<T>::link_nodes(base_ptr pos, base_ptr first, base_ptr last) {
-    pos->prev->next = first;
-    first->prev = pos->prev;
-    pos->prev = last;
-    last->next = pos;
+template <class T, class Alloc>
+void list<T, Alloc>::link_nodes(base_ptr pos, base_ptr first, base_ptr last) {
+    list_link_nodes(pos, first, last);
 }
 
 // 在头部连接 [first, last]
-template <class T>
-void list<T>::link_nodes_at_front(base_ptr first, base_ptr last) {
-    first->prev = node_;
-    last->next = node_->next;
-    last->next->prev = last;
-    node_->next = first; // 在哑结点处形成环形
+template <class T, class Alloc>
+void list<T, Alloc>::link_nodes_at_front(base_ptr first, base_ptr last) {
+    list_link_nodes(head()->next, first, last); // 在哑结点处形成环形
 }
 
 // 在尾部连接 [first, last]
-template <class T>
-void list<T>::link_nodes_at_back(base_ptr first, base_ptr last) {
-    last->next = node_;
-    first->prev = node_->prev;
-    first->prev->next = first;
-    node_->prev = last;
+template <class T, class Alloc>
+void list<T, Alloc>::link_nodes_at_back(base_ptr first, base_ptr last) {
+    list_link_nodes(head(), first, last);
 }
 
 // 容器断开与 [first, last] 的连接
-template <class T>
-void list<T>::unlink_nodes(base_ptr first, base_ptr last) {
-    first->prev->next = last->next;
-    last->next->prev = first->prev;
+template <class T, class Alloc>
+void list<T, Alloc>::unlink_nodes(base_ptr first, base_ptr last) {
+    list_unlink_nodes(first, last);
 }
 
 /**
@@ -828,8 +931,8 @@ void list<T>::unlink_nodes(base_ptr first, base_ptr last) {
 */
 
 // 用n个元素为容器赋值
-template <class T>
-void list<T>::fill_assign(size_type n, const value_type& value) {
+template <class T, class Alloc>
+void list<T, Alloc>::fill_assign(size_type n, const value_type& value) {
     auto i = begin();
     auto e = end();
     for (; n > 0 && i != e; --n, ++i)
@@ -842,9 +945,9 @@ void list<T>::fill_assign(size_type n, const value_type& value) {
 }
 
 // 复制 [first, last) 为容器赋值
-template <class T>
+template <class T, class Alloc>
 template <class Iter>
-void list<T>::copy_assign(Iter first2, Iter last2) {
+void list<T, Alloc>::copy_assign(Iter first2, Iter last2) {
     auto first1 = begin();
     auto last1 = end();
     for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
@@ -861,9 +964,9 @@ void list<T>::copy_assign(Iter first2, Iter last2) {
 */
 
 // 在pos处插入n个元素
-template <class T>
-typename list<T>::iterator
-list<T>::fill_insert(const_iterator pos, size_type n, const value_type& value) {
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator
+list<T, Alloc>::fill_insert(const_iterator pos, size_type n, const value_type& value) {
     iterator r(pos.node_);
     if (n != 0) {
         const auto add_size = n;
@@ -895,19 +998,21 @@ list<T>::fill_insert(const_iterator pos, size_type n, const value_type& value) {
 }
 
 // 在 pos 处插入 [first, last) 的元素
-template <class T>
+template <class T, class Alloc>
 template <class Iter>
-typename list<T>::iterator
-list<T>::copy_insert(const_iterator pos, size_type n, Iter first) {
+typename list<T, Alloc>::iterator
+list<T, Alloc>::copy_insert(const_iterator pos, Iter first, Iter last) {
     iterator r(pos.node_);
-    if (n != 0) {
-        const auto add_size = n;
-        auto       node = create_node(*first);
+    if (first != last) {
+        size_type add_size = 1;
+        auto      node = create_node(*first);
         node->prev = nullptr;
         r = iterator(node);
         iterator end = r;
         try {
-            for (--n, ++first; n > 0; --n, ++end) {  // 还需要n - 1个
+            // 边读边建节点，单趟的输入迭代器也只遍历一次
+            for (++first; first != last; ++first, ++end, ++add_size) {
+                THROW_LENGTH_ERROR_IF(add_size > max_size() - size_, "list<T>'s size too big");
                 auto next = create_node(*first);
                 end.node_->next = next->as_base();
                 next->prev = end.node_;
@@ -931,10 +1036,10 @@ list<T>::copy_insert(const_iterator pos, size_type n, Iter first) {
 
 // FIGUREOUT: 归并排序的实现
 // list归并排序
-template <class T>
+template <class T, class Alloc>
 template <class Compare>
-typename list<T>::iterator
-list<T>::list_sort(iterator first1, iterator last2, size_type n, Compare cmp) { // last2和first1属于同一个链表不同前后段的表示方法
+typename list<T, Alloc>::iterator
+list<T, Alloc>::list_sort(iterator first1, iterator last2, size_type n, Compare cmp) { // last2和first1属于同一个链表不同前后段的表示方法
     if (n < 2)
         return first1;
     if (n == 2) {
@@ -994,10 +1099,85 @@ list<T>::list_sort(iterator first1, iterator last2, size_type n, Compare cmp) {
     return result;
 }
 
+// 把 [first, middle) 和 [middle, last) 两段有序的结点指针归并到 result，相等时前一段优先
+template <class T, class Alloc>
+template <class Compare>
+void list<T, Alloc>::merge_pointer_runs(base_ptr* first, base_ptr* middle, base_ptr* last,
+                                        base_ptr* result, Compare& cmp) {
+    auto first2 = middle;
+    while (first != middle && first2 != last) {
+        if (cmp(first2[0]->as_node()->value, first[0]->as_node()->value))
+            *result++ = *first2++;
+        else
+            *result++ = *first++;
+    }
+    while (first != middle)
+        *result++ = *first++;
+    while (first2 != last)
+        *result++ = *first2++;
+}
+
+// 结点指针放在连续的缓冲区中：先对每 LIST_SORT_RUN 个指针做插入排序，再在两块缓冲区之间自底向上归并
+// 排序过程中不修改链表，比较函数抛出异常时链表保持原样；缓冲区申请不到时返回 false
+template <class T, class Alloc>
+template <class Compare>
+bool list<T, Alloc>::buffer_sort(Compare cmp) {
+    const auto n = static_cast<ptrdiff_t>(size_);
+    if (n < 2)
+        return true;
+    auto buf = MySTL::get_temporary_buffer_helper<base_ptr>(2 * n);
+    if (buf.second < 2 * n) {
+        MySTL::release_temporary_buffer(buf.first);
+        return false;
+    }
+    base_ptr* from = buf.first;
+    base_ptr* to = buf.first + n;
+    base_ptr  p = head_.next;
+    for (ptrdiff_t i = 0; i < n; ++i, p = p->next)
+        from[i] = p;
+
+    try {
+        const ptrdiff_t run = LIST_SORT_RUN;
+        for (ptrdiff_t lo = 0; lo < n; lo += run) {
+            const ptrdiff_t hi = MySTL::min(lo + run, n);
+            for (ptrdiff_t i = lo + 1; i < hi; ++i) {
+                base_ptr  x = from[i];
+                ptrdiff_t j = i;
+                for (; j > lo && cmp(x->as_node()->value, from[j - 1]->as_node()->value); --j)
+                    from[j] = from[j - 1];
+                from[j] = x;
+            }
+        }
+        for (ptrdiff_t width = run; width < n; width *= 2) {
+            for (ptrdiff_t lo = 0; lo < n; lo += 2 * width) {
+                const ptrdiff_t mid = MySTL::min(lo + width, n);
+                const ptrdiff_t hi = MySTL::min(lo + 2 * width, n);
+                merge_pointer_runs(from + lo, from + mid, from + hi, to + lo, cmp);
+            }
+            MySTL::swap(from, to);
+        }
+    } catch (...) {
+        MySTL::release_temporary_buffer(buf.first);
+        throw;
+    }
+
+    // 按排好的顺序重新链接
+    base_ptr prev = head();
+    for (ptrdiff_t i = 0; i < n; ++i) {
+        prev->next = from[i];
+        from[i]->prev = prev;
+        prev = from[i];
+    }
+    prev->next = head();
+    head_.prev = prev;
+    MySTL::release_temporary_buffer(buf.first);
+    return true;
+}
+
 /*********************************** 重载比较操作符 ***********************************/
 
-template <class T>
-bool operator==(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator==(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     auto first1 = lhs.cbegin();
     auto last1 = lhs.cend();
     auto first2 = rhs.cbegin();
@@ -1008,34 +1188,34 @@ bool operator==(const list<T>& lhs, const list<T>& rhs) {
     return first1 == last1 && first2 == last2;
 }
 
-template <class T>
-bool operator!=(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator!=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class T>
-bool operator<(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator<(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return MySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class T>
-bool operator>(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator>(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return rhs < lhs;
 }
 
-template <class T>
-bool operator<=(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator<=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class T>
-bool operator>=(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator>=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
 // 重载swap
-template <class T>
-void swap(list<T>&lhs, list<T>&rhs) noexcept {
+template <class T, class Alloc>
+void swap(list<T, Alloc>&lhs, list<T, Alloc>&rhs) noexcept {
     lhs.swap(rhs);
 }
 
@@ -13,7 +13,8 @@ namespace MySTL {
 /// @tparam Key     键值型别
 /// @tparam T   实值型别
 /// @tparam Compare     比较函数型别
-template <class Key, class T, class Compare = MySTL::less<T>>
+/// @tparam Alloc   分配器型别
+template <class Key, class T, class Compare = MySTL::less<Key>, class Alloc = MySTL::allocator<MySTL::pair<const Key, T>>>
 class map {
 public:
     typedef Key                       key_type;
@@ -22,7 +23,7 @@ public:
     typedef Compare                   key_compare;
 
     class value_compare : public binary_function<value_type, value_type, bool> {
-        friend class map<Key, T, Compare>;  // 友元类，使得 map 可以访问 value_compare 的两个成员函数
+        friend class map<Key, T, Compare, Alloc>;  // 友元类，使得 map 可以访问 value_compare 的两个成员函数
     private:
         Compare comp;
         value_compare(Compare cmp) :
@@ -33,7 +34,7 @@ public:
     };
 
 private:
-    typedef MySTL::rb_tree<value_type, key_compare> base_type;
+    typedef MySTL::rb_tree<value_type, key_compare, Alloc> base_type;
     base_type tree_;  // 设计模式：组合
 
 public:
@@ -56,6 +57,8 @@ public:
     // 构造
     map() = default;
 
+    explicit map(const allocator_type& alloc) : tree_(key_compare(), alloc) {}
+
     template <class InputIterator>
     map(InputIterator first, InputIterator last) : tree_() { tree_.insert_unique(first, last); }
 
@@ -74,7 +77,7 @@ public:
     }
 
     // 移动赋值
-    map& operator=(map&& rhs) noexcept {
+    map& operator=(map&& rhs) noexcept(std::is_nothrow_move_assignable<base_type>::value) {
         tree_ = MySTL::move(rhs.tree_);
         return *this;
     }
@@ -203,30 +206,31 @@ public:
 };
 
 // 重载比较操作符
-template <class Key, class T, class Compare>
-bool operator==(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) { return lhs == rhs; }
+template <class Key, class T, class Compare, class Alloc>
+bool operator==(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) { return lhs == rhs; }
 
-template <class Key, class T, class Compare>
-bool operator<(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) { return lhs < rhs; }
+template <class Key, class T, class Compare, class Alloc>
+bool operator<(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) { return lhs < rhs; }
 
-template <class Key, class T, class Compare>
-bool operator!=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) { return !(lhs == rhs); }
+template <class Key, class T, class Compare, class Alloc>
+bool operator!=(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) { return !(lhs == rhs); }
 
-template <class Key, class T, class Compare>
-bool operator>(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) { return rhs < lhs; }
+template <class Key, class T, class Compare, class Alloc>
+bool operator>(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) { return rhs < lhs; }
 
-template <class Key, class T, class Compare>
-bool operator<=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) { return !(rhs < lhs); }
+template <class Key, class T, class Compare, class Alloc>
+bool operator<=(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) { return !(rhs < lhs); }
 
-template <class Key, class T, class Compare>
-bool operator>=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) { return !(lhs < rhs); }
+template <class Key, class T, class Compare, class Alloc>
+bool operator>=(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) { return !(lhs < rhs); }
 
 
 /// @brief multimap 的模板类，键值允许重复
 /// @tparam Key 
 /// @tparam T 
 /// @tparam Compare 
-template <class Key, class T, class Compare = MySTL::less<T>>
+/// @tparam Alloc 
+template <class Key, class T, class Compare = MySTL::less<Key>, class Alloc = MySTL::allocator<MySTL::pair<const Key, T>>>
 class multimap {
 public:
     typedef Key                       key_type;
@@ -235,7 +239,7 @@ public:
     typedef Compare                   key_compare;
 
     class value_compare : public binary_function<value_type, value_type, bool> {
-        friend class multimap<Key, T, Compare>;  // 友元类，使得 multimap 可以访问 value_compare 的两个成员函数
+        friend class multimap<Key, T, Compare, Alloc>;  // 友元类，使得 multimap 可以访问 value_compare 的两个成员函数
     private:
         Compare comp;
         value_compare(Compare cmp) :
@@ -246,7 +250,7 @@ public:
     };
 
 private:
-    typedef MySTL::rb_tree<value_type, key_compare> base_type;
+    typedef MySTL::rb_tree<value_type, key_compare, Alloc> base_type;
     base_type tree_;  // 设计模式：组合
 
 public:
@@ -269,6 +273,8 @@ public:
     // 构造
     multimap() = default;
 
+    explicit multimap(const allocator_type& alloc) : tree_(key_compare(), alloc) {}
+
     template <class InputIterator>
     multimap(InputIterator first, InputIterator last) : tree_() { tree_.insert_multi(first, last); }
 
@@ -287,7 +293,7 @@ public:
     }
 
     // 移动赋值
-    multimap& operator=(multimap&& rhs) noexcept {
+    multimap& operator=(multimap&& rhs) noexcept(std::is_nothrow_move_assignable<base_type>::value) {
         tree_ = MySTL::move(rhs.tree_);
         return *this;
     }
@@ -416,23 +422,34 @@ public:
 };
 
 // 重载比较操作符
-template <class Key, class T, class Compare>
-bool operator==(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) { return lhs == rhs; }
+template <class Key, class T, class Compare, class Alloc>
+bool operator==(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs) { return lhs == rhs; }
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator<(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs) { return lhs < rhs; }
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator!=(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs) { return !(lhs == rhs); }
 
-template <class Key, class T, class Compare>
-bool operator<(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) { return lhs < rhs; }
+template <class Key, class T, class Compare, class Alloc>
+bool operator>(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs) { return rhs < lhs; }
 
-template <class Key, class T, class Compare>
-bool operator!=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) { return !(lhs == rhs); }
+template <class Key, class T, class Compare, class Alloc>
+bool operator<=(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs) { return !(rhs < lhs); }
 
-template <class Key, class T, class Compare>
-bool operator>(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) { return rhs < lhs; }
+template <class Key, class T, class Compare, class Alloc>
+bool operator>=(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs) { return !(lhs < rhs); }
 
-template <class Key, class T, class Compare>
-bool operator<=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) { return !(rhs < lhs); }
+// map / multimap 只包含一棵 rb_tree
+template <class Key, class T, class Compare, class Alloc>
+struct is_trivially_relocatable<map<Key, T, Compare, Alloc>>
+    : std::integral_constant<bool, is_trivially_relocatable<Compare>::value &&
+                                   is_trivially_relocatable<Alloc>::value> {};
 
-template <class Key, class T, class Compare>
-bool operator>=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) { return !(lhs < rhs); }
+template <class Key, class T, class Compare, class Alloc>
+struct is_trivially_relocatable<multimap<Key, T, Compare, Alloc>>
+    : std::integral_constant<bool, is_trivially_relocatable<Compare>::value &&
+                                   is_trivially_relocatable<Alloc>::value> {};
 } /* namespace MySTL */
 
 #endif
@@ -1,10 +1,14 @@
 #ifndef MY_MEMORY_H
 #define MY_MEMORY_H
 // 智能指针和内存空间管理
+// unique_ptr 使用空基类优化保存删除器，shared_ptr 由 make_shared 创建时对象与控制块一次分配
 
+#include <atomic>
 #include <cstddef>
 #include <cstdlib>
 #include <climits>
+#include <new>
+#include <type_traits>
 
 #include "myallocator.h"
 #include "util.h"
@@ -19,17 +23,101 @@ constexpr Tp* address_of(Tp& value) noexcept {
     return &value;
 }
 
+/*********************************** scratch_arena ***********************************/
+// 线程私有的临时缓冲区，供 temporary_buffer 以及 algo.h 中需要缓冲区的算法使用
+// 同一线程反复调用 inplace_merge 等算法时复用同一块内存，不再每次 malloc/free
+// 请求超过当前容量时申请更大的新块，成功后才释放旧块，归还时超过 SCRATCH_KEEP_BYTES 的块直接还给系统
+// 同一时刻只有一个使用者，嵌套申请(如比较函数中再次调用算法)退回到直接 malloc
+
+constexpr size_t SCRATCH_MIN_BYTES = 4096;
+constexpr size_t SCRATCH_KEEP_BYTES = 4 * 1024 * 1024;
+
+class scratch_arena {
+private:
+    void*  buffer_;
+    size_t bytes_;
+    bool   in_use_;
+
+public:
+    scratch_arena() noexcept : buffer_(nullptr), bytes_(0), in_use_(false) {}
+    ~scratch_arena() { free(buffer_); }
+
+    scratch_arena(const scratch_arena&) = delete;
+    scratch_arena& operator=(const scratch_arena&) = delete;
+
+    // 当前线程的缓冲区
+    static scratch_arena& local() {
+        static thread_local scratch_arena arena;
+        return arena;
+    }
+
+    size_t capacity() const noexcept { return bytes_; }
+
+    // 申请 bytes 字节，内存不足时减半重试，直到不足 min_bytes 为止
+    // got 返回实际得到的字节数，一个字节都没有得到时返回 nullptr
+    void* acquire(size_t bytes, size_t min_bytes, size_t& got) noexcept {
+        got = 0;
+        if (in_use_)
+            return malloc_halving(bytes, min_bytes, got);
+        if (bytes > bytes_) {
+            // 先申请新块，比现有的大才替换；申请失败或减半后反而更小时保留原来的缓冲区
+            size_t new_bytes = 0;
+            void*  p = malloc_halving(bytes < SCRATCH_MIN_BYTES ? SCRATCH_MIN_BYTES : bytes, min_bytes, new_bytes);
+            if (new_bytes > bytes_) {
+                free(buffer_);
+                buffer_ = p;
+                bytes_ = new_bytes;
+            } else {
+                free(p);
+            }
+            if (bytes_ == 0 || bytes_ < min_bytes)
+                return nullptr;
+        }
+        in_use_ = true;
+        got = bytes < bytes_ ? bytes : bytes_;
+        return buffer_;
+    }
+
+    void release(void* ptr) noexcept {
+        if (ptr == nullptr)
+            return;
+        if (ptr != buffer_) {
+            free(ptr);
+            return;
+        }
+        in_use_ = false;
+        if (bytes_ > SCRATCH_KEEP_BYTES) {
+            free(buffer_);
+            buffer_ = nullptr;
+            bytes_ = 0;
+        }
+    }
+
+private:
+    static void* malloc_halving(size_t bytes, size_t min_bytes, size_t& got) noexcept {
+        while (bytes >= min_bytes && bytes > 0) {
+            void* p = malloc(bytes);
+            if (p) {
+                got = bytes;
+                return p;
+            }
+            bytes /= 2;
+        }
+        got = 0;
+        return nullptr;
+    }
+};
+
 // 获取临时缓冲区
 template <class T>
 pair<T*, ptrdiff_t> get_buffer_helper(ptrdiff_t len, T*) {
     if (len > static_cast<ptrdiff_t>(INT_MAX / sizeof(T)))
         len = INT_MAX / sizeof(T);
-    while (len > 0) {
-        T* tmp = static_cast<T*>(malloc(static_cast<size_t>(len) * sizeof(T)));
-        if (tmp) return pair<T*, ptrdiff_t>(tmp, len);
-        len /= 2;
-    }
-    return pair<T*, ptrdiff_t>(nullptr, 0);
+    if (len <= 0)
+        return pair<T*, ptrdiff_t>(nullptr, 0);
+    size_t got = 0;
+    void*  p = scratch_arena::local().acquire(static_cast<size_t>(len) * sizeof(T), sizeof(T), got);
+    return pair<T*, ptrdiff_t>(static_cast<T*>(p), static_cast<ptrdiff_t>(got / sizeof(T)));
 }
 
 template <class T>
@@ -44,7 +132,7 @@ pair<T*, ptrdiff_t> get_temporary_buffer_helper(ptrdiff_t len, T*) {
 
 template <class T>
 void release_temporary_buffer(T* ptr){
-        free(ptr);
+    scratch_arena::local().release(ptr);
 }
 
 template <class ForwardIter, class T>
@@ -59,7 +147,7 @@ public:
     temporary_buffer(ForwardIter first, ForwardIter last);
     ~temporary_buffer() {
         MySTL::destroy(buffer, buffer + len);
-        free(buffer);
+        MySTL::release_temporary_buffer(buffer);
     }
 
 public:
@@ -83,28 +171,27 @@ private:
 
 // temporaray_buffer类构造函数
 template <class ForwardIter, class T>
-temporary_buffer<ForwardIter, T>::temporary_buffer(ForwardIter first, ForwardIter last) {
+temporary_buffer<ForwardIter, T>::temporary_buffer(ForwardIter first, ForwardIter last) :
+    original_len(0), len(0), buffer(nullptr) {
     try {
         len = MySTL::distance(first, last);
         allocate_buffer();
         if (len > 0)
             initialize_buffer(*first, std::is_trivially_default_constructible<T>());
     } catch (...) {
-        free(buffer);
+        MySTL::release_temporary_buffer(buffer);
         buffer = nullptr;
         len = 0;
     }
 }
 
+// 从当前线程的 scratch_arena 中取得缓冲区
 template <class ForwardIter, class T>
 void temporary_buffer<ForwardIter, T>::allocate_buffer() {
     original_len = len;
-    if (len > static_cast<ptrdiff_t>(INT_MAX / sizeof(T))) len = INT_MAX / sizeof(T);
-    while (len > 0) {
-        buffer = static_cast<T*>(malloc(len * sizeof(T)));
-        if (buffer) break;
-        len /= 2;
-    }
+    const auto result = MySTL::get_temporary_buffer_helper<T>(len);
+    buffer = result.first;
+    len = result.second;
 }
 
 template <class T>
@@ -150,6 +237,801 @@ public:
     }
 };
 
+/*********************************** unique_ptr ***********************************/
+
+template <class T>
+struct default_delete {
+    constexpr default_delete() noexcept = default;
+
+    template <class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    default_delete(const default_delete<U>&) noexcept {}
+
+    void operator()(T* ptr) const {
+        static_assert(sizeof(T) > 0, "can't delete an incomplete type");
+        delete ptr;
+    }
+};
+
+template <class T>
+struct default_delete<T[]> {
+    constexpr default_delete() noexcept = default;
+
+    void operator()(T* ptr) const {
+        static_assert(sizeof(T) > 0, "can't delete an incomplete type");
+        delete[] ptr;
+    }
+};
+
+// 与 alloc_holder 相同，空删除器借助空基类优化不占用空间，unique_ptr 与裸指针一样大
+template <class D, bool = std::is_empty<D>::value>
+class deleter_holder : private D {
+public:
+    deleter_holder() = default;
+    template <class E>
+    explicit deleter_holder(E&& d) : D(MySTL::forward<E>(d)) {}
+
+    D&       get_deleter() noexcept { return *this; }
+    const D& get_deleter() const noexcept { return *this; }
+};
+
+template <class D>
+class deleter_holder<D, false> {
+private:
+    D deleter_;
+
+public:
+    deleter_holder() = default;
+    template <class E>
+    explicit deleter_holder(E&& d) : deleter_(MySTL::forward<E>(d)) {}
+
+    D&       get_deleter() noexcept { return deleter_; }
+    const D& get_deleter() const noexcept { return deleter_; }
+};
+
+template <class T, class D = default_delete<T>>
+class unique_ptr : private deleter_holder<D> {
+    template <class U, class E>
+    friend class unique_ptr;
+
+public:
+    typedef T* pointer;
+    typedef T  element_type;
+    typedef D  deleter_type;
+
+private:
+    typedef deleter_holder<D> deleter_base;
+
+    pointer ptr_;
+
+public:
+    /*********************************** 构造，复制，移动，析构 ***********************************/
+
+    constexpr unique_ptr() noexcept : deleter_base(), ptr_(nullptr) {}
+    constexpr unique_ptr(std::nullptr_t) noexcept : deleter_base(), ptr_(nullptr) {}
+    explicit unique_ptr(pointer p) noexcept : deleter_base(), ptr_(p) {}
+
+    unique_ptr(pointer p, const D& d) noexcept : deleter_base(d), ptr_(p) {}
+    unique_ptr(pointer p, typename std::remove_reference<D>::type&& d) noexcept :
+        deleter_base(MySTL::move(d)), ptr_(p) {}
+
+    unique_ptr(unique_ptr&& rhs) noexcept :
+        deleter_base(MySTL::forward<D>(rhs.get_deleter())), ptr_(rhs.release()) {}
+
+    template <class U, class E,
+              class = typename std::enable_if<!std::is_array<U>::value &&
+                                              std::is_convertible<U*, T*>::value &&
+                                              std::is_convertible<E, D>::value>::type>
+    unique_ptr(unique_ptr<U, E>&& rhs) noexcept :
+        deleter_base(MySTL::forward<E>(rhs.get_deleter())), ptr_(rhs.release()) {}
+
+    unique_ptr(const unique_ptr&) = delete;
+    unique_ptr& operator=(const unique_ptr&) = delete;
+
+    unique_ptr& operator=(unique_ptr&& rhs) noexcept {
+        reset(rhs.release());
+        get_deleter() = MySTL::forward<D>(rhs.get_deleter());
+        return *this;
+    }
+
+    template <class U, class E,
+              class = typename std::enable_if<!std::is_array<U>::value &&
+                                              std::is_convertible<U*, T*>::value &&
+                                              std::is_assignable<D&, E&&>::value>::type>
+    unique_ptr& operator=(unique_ptr<U, E>&& rhs) noexcept {
+        reset(rhs.release());
+        get_deleter() = MySTL::forward<E>(rhs.get_deleter());
+        return *this;
+    }
+
+    unique_ptr& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    ~unique_ptr() {
+        if (ptr_ != nullptr)
+            get_deleter()(ptr_);
+    }
+
+public:
+    using deleter_base::get_deleter;
+
+    typename std::add_lvalue_reference<T>::type operator*() const { return *ptr_; }
+    pointer operator->() const noexcept { return ptr_; }
+
+    pointer  get() const noexcept { return ptr_; }
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    pointer release() noexcept {
+        pointer tmp = ptr_;
+        ptr_ = nullptr;
+        return tmp;
+    }
+
+    void reset(pointer p = pointer()) noexcept {
+        pointer old = ptr_;
+        ptr_ = p;
+        if (old != nullptr)
+            get_deleter()(old);
+    }
+
+    void swap(unique_ptr& rhs) noexcept {
+        MySTL::swap(ptr_, rhs.ptr_);
+        MySTL::swap(get_deleter(), rhs.get_deleter());
+    }
+};
+
+// 数组版本只提供下标访问，不支持派生类指针的转换
+template <class T, class D>
+class unique_ptr<T[], D> : private deleter_holder<D> {
+public:
+    typedef T* pointer;
+    typedef T  element_type;
+    typedef D  deleter_type;
+
+private:
+    typedef deleter_holder<D> deleter_base;
+
+    pointer ptr_;
+
+public:
+    constexpr unique_ptr() noexcept : deleter_base(), ptr_(nullptr) {}
+    constexpr unique_ptr(std::nullptr_t) noexcept : deleter_base(), ptr_(nullptr) {}
+    explicit unique_ptr(pointer p) noexcept : deleter_base(), ptr_(p) {}
+    unique_ptr(pointer p, const D& d) noexcept : deleter_base(d), ptr_(p) {}
+
+    unique_ptr(unique_ptr&& rhs) noexcept :
+        deleter_base(MySTL::forward<D>(rhs.get_deleter())), ptr_(rhs.release()) {}
+
+    unique_ptr(const unique_ptr&) = delete;
+    unique_ptr& operator=(const unique_ptr&) = delete;
+
+    unique_ptr& operator=(unique_ptr&& rhs) noexcept {
+        reset(rhs.release());
+        get_deleter() = MySTL::forward<D>(rhs.get_deleter());
+        return *this;
+    }
+
+    unique_ptr& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    ~unique_ptr() {
+        if (ptr_ != nullptr)
+            get_deleter()(ptr_);
+    }
+
+public:
+    using deleter_base::get_deleter;
+
+    T& operator[](size_t i) const { return ptr_[i]; }
+
+    pointer  get() const noexcept { return ptr_; }
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    pointer release() noexcept {
+        pointer tmp = ptr_;
+        ptr_ = nullptr;
+        return tmp;
+    }
+
+    void reset(pointer p = pointer()) noexcept {
+        pointer old = ptr_;
+        ptr_ = p;
+        if (old != nullptr)
+            get_deleter()(old);
+    }
+
+    void swap(unique_ptr& rhs) noexcept {
+        MySTL::swap(ptr_, rhs.ptr_);
+        MySTL::swap(get_deleter(), rhs.get_deleter());
+    }
+};
+
+template <class T, class... Args>
+typename std::enable_if<!std::is_array<T>::value, unique_ptr<T>>::type
+make_unique(Args&&... args) {
+    return unique_ptr<T>(new T(MySTL::forward<Args>(args)...));
+}
+
+template <class T>
+typename std::enable_if<std::is_array<T>::value && std::extent<T>::value == 0, unique_ptr<T>>::type
+make_unique(size_t n) {
+    return unique_ptr<T>(new typename std::remove_extent<T>::type[n]());
+}
+
+template <class T1, class D1, class T2, class D2>
+bool operator==(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs) noexcept {
+    return lhs.get() == rhs.get();
+}
+
+template <class T1, class D1, class T2, class D2>
+bool operator!=(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs) noexcept {
+    return lhs.get() != rhs.get();
+}
+
+template <class T, class D>
+bool operator==(const unique_ptr<T, D>& lhs, std::nullptr_t) noexcept {
+    return !lhs;
+}
+
+template <class T, class D>
+bool operator!=(const unique_ptr<T, D>& lhs, std::nullptr_t) noexcept {
+    return static_cast<bool>(lhs);
+}
+
+template <class T, class D>
+void swap(unique_ptr<T, D>& lhs, unique_ptr<T, D>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// unique_ptr 只保存一个指针(和删除器)，搬移时不需要调用移动构造
+template <class T, class D>
+struct is_trivially_relocatable<unique_ptr<T, D>> : is_trivially_relocatable<D> {};
+
+/*********************************** shared_ptr ***********************************/
+
+// 不内联的函数，用于释放控制块等冷路径
+#if defined(__GNUC__)
+#define MYSTL_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define MYSTL_NOINLINE __declspec(noinline)
+#else
+#define MYSTL_NOINLINE
+#endif
+
+// 引用计数策略
+// sp_atomic_count 为默认策略，可以在多个线程间共享所有权
+// sp_plain_count 不使用原子操作，只能用于声明了单线程所有权的 local_shared_ptr
+class sp_atomic_count {
+private:
+    std::atomic<long> n_;
+
+public:
+    explicit sp_atomic_count(long n) noexcept : n_(n) {}
+
+    long get() const noexcept { return n_.load(std::memory_order_relaxed); }
+
+    void increment() noexcept { n_.fetch_add(1, std::memory_order_relaxed); }
+
+    // 返回减一后的值，acq_rel 保证最后一个释放者能看到其他线程对对象的全部写入
+    long decrement() noexcept { return n_.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+
+    // weak_ptr::lock 使用，计数已经为 0 时不能再增加
+    bool increment_if_not_zero() noexcept {
+        long n = n_.load(std::memory_order_relaxed);
+        while (n != 0) {
+            if (n_.compare_exchange_weak(n, n + 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+};
+
+class sp_plain_count {
+private:
+    long n_;
+
+public:
+    explicit sp_plain_count(long n) noexcept : n_(n) {}
+
+    long get() const noexcept { return n_; }
+    void increment() noexcept { ++n_; }
+    long decrement() noexcept { return --n_; }
+
+    bool increment_if_not_zero() noexcept {
+        if (n_ == 0) return false;
+        ++n_;
+        return true;
+    }
+};
+
+// 控制块
+// use_ 为 shared_ptr 个数，weak_ 为 weak_ptr 个数加一(所有 shared_ptr 共同持有一个)
+// use_ 归零时析构对象，weak_ 归零时释放控制块
+template <class Count>
+class sp_counted_base {
+private:
+    Count use_;
+    Count weak_;
+
+public:
+    sp_counted_base() noexcept : use_(1), weak_(1) {}
+    virtual ~sp_counted_base() = default;
+
+    sp_counted_base(const sp_counted_base&) = delete;
+    sp_counted_base& operator=(const sp_counted_base&) = delete;
+
+    // 析构被管理的对象
+    virtual void dispose() noexcept = 0;
+    // 释放控制块本身
+    virtual void destroy() noexcept = 0;
+
+    long use_count() const noexcept { return use_.get(); }
+
+    void add_ref() noexcept { use_.increment(); }
+    bool add_ref_lock() noexcept { return use_.increment_if_not_zero(); }
+
+    void release() noexcept {
+        if (use_.decrement() == 0)
+            release_last();
+    }
+
+    void weak_add_ref() noexcept { weak_.increment(); }
+
+    void weak_release() noexcept {
+        if (weak_.decrement() == 0)
+            destroy_block();
+    }
+
+private:
+    // 以下两个函数会释放控制块，不内联：调用方看不到其中的 delete，
+    // 同一函数中先后释放共享同一控制块的多个指针时，编译器不会误报 -Wuse-after-free
+
+    // 最后一个 shared_ptr 释放：先析构对象，再放掉所有 shared_ptr 共同持有的那一份 weak_
+    // weak_ 的新值在释放控制块之前读出，destroy 之后不再访问控制块
+    MYSTL_NOINLINE void release_last() noexcept {
+        dispose();
+        const long weak = weak_.decrement();
+        if (weak == 0)
+            destroy();
+    }
+
+    MYSTL_NOINLINE void destroy_block() noexcept { destroy(); }
+};
+
+// 由 shared_ptr(p) 或 shared_ptr(p, d) 创建，对象和控制块分别分配
+template <class P, class D, class Count>
+class sp_counted_deleter : public sp_counted_base<Count>, private deleter_holder<D> {
+private:
+    P ptr_;
+
+public:
+    sp_counted_deleter(P p, D d) noexcept : deleter_holder<D>(MySTL::move(d)), ptr_(p) {}
+
+    void dispose() noexcept override { this->get_deleter()(ptr_); }
+    void destroy() noexcept override { delete this; }
+};
+
+// 由 make_shared / allocate_shared 创建，对象就地构造在控制块之后，只需要一次分配
+template <class T, class Alloc, class Count>
+class sp_counted_inplace : public sp_counted_base<Count>, private alloc_holder<Alloc> {
+private:
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<sp_counted_inplace> block_allocator;
+    typedef allocator_traits<block_allocator>                                         block_traits;
+
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_;
+
+public:
+    explicit sp_counted_inplace(const Alloc& a) noexcept : alloc_holder<Alloc>(a) {}
+
+    using alloc_holder<Alloc>::get_alloc;
+
+    T* get_ptr() noexcept { return reinterpret_cast<T*>(&storage_); }
+
+    void dispose() noexcept override {
+        allocator_traits<Alloc>::destroy(this->get_alloc(), get_ptr());
+    }
+
+    // 先把分配器复制出来，控制块析构之后再用它归还内存
+    void destroy() noexcept override {
+        block_allocator a(this->get_alloc());
+        this->~sp_counted_inplace();
+        block_traits::deallocate(a, this, 1);
+    }
+};
+
+template <class T, class Count>
+class shared_ptr;
+
+template <class T, class Count>
+class weak_ptr;
+
+template <class T, class Count>
+class enable_shared_from_this;
+
+// 对象继承了 enable_shared_from_this 时，创建第一个 shared_ptr 的同时初始化其中的 weak_ptr
+template <class Count, class T, class U>
+void sp_enable_shared_from_this(const shared_ptr<T, Count>& sp,
+                                const enable_shared_from_this<U, Count>* p) noexcept {
+    if (p != nullptr && p->weak_this_.expired())
+        p->weak_this_ = shared_ptr<U, Count>(sp, const_cast<U*>(static_cast<const U*>(p)));
+}
+
+template <class Count, class T>
+void sp_enable_shared_from_this(const shared_ptr<T, Count>&, ...) noexcept {}
+
+template <class T, class Count = sp_atomic_count>
+class shared_ptr {
+    template <class U, class C>
+    friend class shared_ptr;
+    template <class U, class C>
+    friend class weak_ptr;
+    template <class U, class C, class Alloc, class... Args>
+    friend shared_ptr<U, C> allocate_shared_with(const Alloc& alloc, Args&&... args);
+
+public:
+    typedef T element_type;
+    typedef weak_ptr<T, Count> weak_type;
+
+private:
+    typedef sp_counted_base<Count> counted_base;
+
+    T*            ptr_;
+    counted_base* cb_;
+
+public:
+    /*********************************** 构造，复制，移动，析构 ***********************************/
+
+    constexpr shared_ptr() noexcept : ptr_(nullptr), cb_(nullptr) {}
+    constexpr shared_ptr(std::nullptr_t) noexcept : ptr_(nullptr), cb_(nullptr) {}
+
+    // 控制块单独分配，分配失败时删除 p 后重新抛出
+    template <class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    explicit shared_ptr(U* p) : shared_ptr(p, default_delete<U>()) {}
+
+    template <class U, class D, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    shared_ptr(U* p, D d) : ptr_(p), cb_(nullptr) {
+        try {
+            cb_ = new sp_counted_deleter<U*, D, Count>(p, d);
+        } catch (...) {
+            d(p);
+            throw;
+        }
+        sp_enable_shared_from_this<Count>(*this, p);
+    }
+
+    // 别名构造：与 rhs 共享所有权，但指向 p
+    template <class U>
+    shared_ptr(const shared_ptr<U, Count>& rhs, T* p) noexcept : ptr_(p), cb_(rhs.cb_) {
+        if (cb_ != nullptr) cb_->add_ref();
+    }
+
+    shared_ptr(const shared_ptr& rhs) noexcept : ptr_(rhs.ptr_), cb_(rhs.cb_) {
+        if (cb_ != nullptr) cb_->add_ref();
+    }
+
+    template <class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    shared_ptr(const shared_ptr<U, Count>& rhs) noexcept : ptr_(rhs.ptr_), cb_(rhs.cb_) {
+        if (cb_ != nullptr) cb_->add_ref();
+    }
+
+    shared_ptr(shared_ptr&& rhs) noexcept : ptr_(rhs.ptr_), cb_(rhs.cb_) {
+        rhs.ptr_ = nullptr;
+        rhs.cb_ = nullptr;
+    }
+
+    template <class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    shared_ptr(shared_ptr<U, Count>&& rhs) noexcept : ptr_(rhs.ptr_), cb_(rhs.cb_) {
+        rhs.ptr_ = nullptr;
+        rhs.cb_ = nullptr;
+    }
+
+    // 从 weak_ptr 构造，对象已经销毁时抛出异常
+    template <class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    explicit shared_ptr(const weak_ptr<U, Count>& rhs) : ptr_(nullptr), cb_(nullptr) {
+        THROW_RUNTIME_ERROR_IF(!construct_from_weak(rhs), "shared_ptr<T> from expired weak_ptr");
+    }
+
+    template <class U, class D, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    shared_ptr(unique_ptr<U, D>&& rhs) : shared_ptr() {
+        if (rhs.get() != nullptr) {
+            shared_ptr tmp(rhs.get(), rhs.get_deleter());
+            rhs.release();
+            swap(tmp);
+        }
+    }
+
+    shared_ptr& operator=(const shared_ptr& rhs) noexcept {
+        shared_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    template <class U>
+    shared_ptr& operator=(const shared_ptr<U, Count>& rhs) noexcept {
+        shared_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    shared_ptr& operator=(shared_ptr&& rhs) noexcept {
+        shared_ptr(MySTL::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    template <class U>
+    shared_ptr& operator=(shared_ptr<U, Count>&& rhs) noexcept {
+        shared_ptr(MySTL::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    template <class U, class D>
+    shared_ptr& operator=(unique_ptr<U, D>&& rhs) {
+        shared_ptr(MySTL::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    ~shared_ptr() {
+        if (cb_ != nullptr) cb_->release();
+    }
+
+public:
+    T& operator*() const noexcept { return *ptr_; }
+    T* operator->() const noexcept { return ptr_; }
+
+    T*       get() const noexcept { return ptr_; }
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    long use_count() const noexcept { return cb_ != nullptr ? cb_->use_count() : 0; }
+    bool unique() const noexcept { return use_count() == 1; }
+
+    void reset() noexcept { shared_ptr().swap(*this); }
+
+    template <class U>
+    void reset(U* p) { shared_ptr(p).swap(*this); }
+
+    template <class U, class D>
+    void reset(U* p, D d) { shared_ptr(p, d).swap(*this); }
+
+    void swap(shared_ptr& rhs) noexcept {
+        MySTL::swap(ptr_, rhs.ptr_);
+        MySTL::swap(cb_, rhs.cb_);
+    }
+
+    // 按控制块排序，用于以 shared_ptr/weak_ptr 作为关联容器的键
+    template <class U, class C>
+    bool owner_before(const shared_ptr<U, C>& rhs) const noexcept { return cb_ < rhs.cb_; }
+    template <class U, class C>
+    bool owner_before(const weak_ptr<U, C>& rhs) const noexcept { return cb_ < rhs.cb_; }
+
+private:
+    template <class U>
+    bool construct_from_weak(const weak_ptr<U, Count>& rhs) noexcept {
+        if (rhs.cb_ != nullptr && rhs.cb_->add_ref_lock()) {
+            ptr_ = rhs.ptr_;
+            cb_ = rhs.cb_;
+            return true;
+        }
+        return false;
+    }
+};
+
+template <class T, class Count = sp_atomic_count>
+class weak_ptr {
+    template <class U, class C>
+    friend class shared_ptr;
+    template <class U, class C>
+    friend class weak_ptr;
+
+public:
+    typedef T element_type;
+
+private:
+    typedef sp_counted_base<Count> counted_base;
+
+    T*            ptr_;
+    counted_base* cb_;
+
+public:
+    constexpr weak_ptr() noexcept : ptr_(nullptr), cb_(nullptr) {}
+
+    template <class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    weak_ptr(const shared_ptr<U, Count>& rhs) noexcept : ptr_(rhs.ptr_), cb_(rhs.cb_) {
+        if (cb_ != nullptr) cb_->weak_add_ref();
+    }
+
+    weak_ptr(const weak_ptr& rhs) noexcept : ptr_(rhs.ptr_), cb_(rhs.cb_) {
+        if (cb_ != nullptr) cb_->weak_add_ref();
+    }
+
+    // 对象可能已经销毁，ptr_ 不能用于派生类到基类的转换，通过 lock 获取
+    template <class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    weak_ptr(const weak_ptr<U, Count>& rhs) noexcept : ptr_(rhs.lock().get()), cb_(rhs.cb_) {
+        if (cb_ != nullptr) cb_->weak_add_ref();
+    }
+
+    weak_ptr(weak_ptr&& rhs) noexcept : ptr_(rhs.ptr_), cb_(rhs.cb_) {
+        rhs.ptr_ = nullptr;
+        rhs.cb_ = nullptr;
+    }
+
+    weak_ptr& operator=(const weak_ptr& rhs) noexcept {
+        weak_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    template <class U>
+    weak_ptr& operator=(const shared_ptr<U, Count>& rhs) noexcept {
+        weak_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    weak_ptr& operator=(weak_ptr&& rhs) noexcept {
+        weak_ptr(MySTL::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    ~weak_ptr() {
+        if (cb_ != nullptr) cb_->weak_release();
+    }
+
+public:
+    long use_count() const noexcept { return cb_ != nullptr ? cb_->use_count() : 0; }
+    bool expired() const noexcept { return use_count() == 0; }
+
+    shared_ptr<T, Count> lock() const noexcept {
+        shared_ptr<T, Count> sp;
+        sp.construct_from_weak(*this);
+        return sp;
+    }
+
+    void reset() noexcept { weak_ptr().swap(*this); }
+
+    void swap(weak_ptr& rhs) noexcept {
+        MySTL::swap(ptr_, rhs.ptr_);
+        MySTL::swap(cb_, rhs.cb_);
+    }
+
+    template <class U, class C>
+    bool owner_before(const shared_ptr<U, C>& rhs) const noexcept { return cb_ < rhs.cb_; }
+    template <class U, class C>
+    bool owner_before(const weak_ptr<U, C>& rhs) const noexcept { return cb_ < rhs.cb_; }
+};
+
+// 继承该类的对象可以在成员函数中通过 shared_from_this 取得管理自己的 shared_ptr
+template <class T, class Count = sp_atomic_count>
+class enable_shared_from_this {
+    template <class C, class U, class V>
+    friend void sp_enable_shared_from_this(const shared_ptr<U, C>&, const enable_shared_from_this<V, C>*) noexcept;
+
+private:
+    mutable weak_ptr<T, Count> weak_this_;
+
+protected:
+    constexpr enable_shared_from_this() noexcept {}
+    enable_shared_from_this(const enable_shared_from_this&) noexcept {}
+    enable_shared_from_this& operator=(const enable_shared_from_this&) noexcept { return *this; }
+    ~enable_shared_from_this() = default;
+
+public:
+    shared_ptr<T, Count>       shared_from_this() { return shared_ptr<T, Count>(weak_this_); }
+    shared_ptr<const T, Count> shared_from_this() const { return shared_ptr<const T, Count>(weak_this_); }
+
+    weak_ptr<T, Count>       weak_from_this() noexcept { return weak_this_; }
+    weak_ptr<const T, Count> weak_from_this() const noexcept { return weak_this_; }
+};
+
+// 只在单个线程内共享所有权，引用计数不使用原子操作
+template <class T>
+using local_shared_ptr = shared_ptr<T, sp_plain_count>;
+
+template <class T>
+using local_weak_ptr = weak_ptr<T, sp_plain_count>;
+
+template <class T>
+using enable_local_shared_from_this = enable_shared_from_this<T, sp_plain_count>;
+
+// 控制块与对象一次分配，对象构造失败时归还整块内存
+template <class T, class Count, class Alloc, class... Args>
+shared_ptr<T, Count> allocate_shared_with(const Alloc& alloc, Args&&... args) {
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<T> value_allocator;
+    typedef sp_counted_inplace<T, value_allocator, Count>             block_type;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<block_type> block_allocator;
+    typedef allocator_traits<block_allocator>                                   block_traits;
+
+    block_allocator ba(alloc);
+    block_type*     cb = block_traits::allocate(ba, 1);
+    ::new (static_cast<void*>(cb)) block_type(value_allocator(alloc));
+    try {
+        allocator_traits<value_allocator>::construct(cb->get_alloc(), cb->get_ptr(),
+                                                     MySTL::forward<Args>(args)...);
+    } catch (...) {
+        cb->~block_type();
+        block_traits::deallocate(ba, cb, 1);
+        throw;
+    }
+    shared_ptr<T, Count> sp;
+    sp.ptr_ = cb->get_ptr();
+    sp.cb_ = cb;
+    sp_enable_shared_from_this<Count>(sp, sp.ptr_);
+    return sp;
+}
+
+template <class T, class Alloc, class... Args>
+shared_ptr<T> allocate_shared(const Alloc& alloc, Args&&... args) {
+    return allocate_shared_with<T, sp_atomic_count>(alloc, MySTL::forward<Args>(args)...);
+}
+
+template <class T, class... Args>
+shared_ptr<T> make_shared(Args&&... args) {
+    return allocate_shared_with<T, sp_atomic_count>(MySTL::allocator<T>(), MySTL::forward<Args>(args)...);
+}
+
+template <class T, class Alloc, class... Args>
+local_shared_ptr<T> allocate_local_shared(const Alloc& alloc, Args&&... args) {
+    return allocate_shared_with<T, sp_plain_count>(alloc, MySTL::forward<Args>(args)...);
+}
+
+template <class T, class... Args>
+local_shared_ptr<T> make_local_shared(Args&&... args) {
+    return allocate_shared_with<T, sp_plain_count>(MySTL::allocator<T>(), MySTL::forward<Args>(args)...);
+}
+
+template <class T, class U, class Count>
+shared_ptr<T, Count> static_pointer_cast(const shared_ptr<U, Count>& sp) noexcept {
+    return shared_ptr<T, Count>(sp, static_cast<T*>(sp.get()));
+}
+
+template <class T, class U, class Count>
+shared_ptr<T, Count> dynamic_pointer_cast(const shared_ptr<U, Count>& sp) noexcept {
+    T* p = dynamic_cast<T*>(sp.get());
+    return p != nullptr ? shared_ptr<T, Count>(sp, p) : shared_ptr<T, Count>();
+}
+
+template <class T, class U, class Count>
+shared_ptr<T, Count> const_pointer_cast(const shared_ptr<U, Count>& sp) noexcept {
+    return shared_ptr<T, Count>(sp, const_cast<T*>(sp.get()));
+}
+
+template <class T1, class T2, class Count>
+bool operator==(const shared_ptr<T1, Count>& lhs, const shared_ptr<T2, Count>& rhs) noexcept {
+    return lhs.get() == rhs.get();
+}
+
+template <class T1, class T2, class Count>
+bool operator!=(const shared_ptr<T1, Count>& lhs, const shared_ptr<T2, Count>& rhs) noexcept {
+    return lhs.get() != rhs.get();
+}
+
+template <class T, class Count>
+bool operator==(const shared_ptr<T, Count>& lhs, std::nullptr_t) noexcept {
+    return !lhs;
+}
+
+template <class T, class Count>
+bool operator!=(const shared_ptr<T, Count>& lhs, std::nullptr_t) noexcept {
+    return static_cast<bool>(lhs);
+}
+
+template <class T, class Count>
+void swap(shared_ptr<T, Count>& lhs, shared_ptr<T, Count>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <class T, class Count>
+void swap(weak_ptr<T, Count>& lhs, weak_ptr<T, Count>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// 只保存对象指针和控制块指针，搬移后控制块中的计数不变
+template <class T, class Count>
+struct is_trivially_relocatable<shared_ptr<T, Count>> : m_true_type {};
+
+template <class T, class Count>
+struct is_trivially_relocatable<weak_ptr<T, Count>> : m_true_type {};
+
 }  // namespace MySTL
 
+#undef MYSTL_NOINLINE
+
 #endif /* MY_MEMORY_H */
@@ -0,0 +1,227 @@
+#ifndef MY_MMAP_ALLOCATOR_H
+#define MY_MMAP_ALLOCATOR_H
+
+// 大块缓冲区直接向内核申请匿名映射的分配器，适用于几百 MB 的 vector<int> / vector<double>
+// 请求字节数不小于 Threshold 时使用 mmap，并提供 reallocate：
+// 新旧大小都不小于 Threshold 时通过 mremap 由内核重新映射页表，不复制数据，
+// 扩容期间也不会同时持有新旧两块内存，峰值 RSS 约为原来的一半
+// 小于 Threshold 的请求与 MySTL::allocator 相同，走 ::operator new
+// vector 在元素可平凡重定位时自动使用 reallocate 扩容，见 vector::resize_storage
+// 没有 mremap 的平台上 reallocate 退化为 申请 + memcpy + 释放
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "construct.h"
+#include "util.h"
+
+namespace MySTL {
+
+enum { MMAP_THRESHOLD = 1024 * 1024 };
+
+#if !defined(_WIN32)
+
+inline size_t mmap_page_size() noexcept {
+    static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return page;
+}
+
+inline size_t mmap_round_up(size_t bytes) noexcept {
+    const size_t page = mmap_page_size();
+    return (bytes + page - 1) & ~(page - 1);
+}
+
+// 申请 bytes 字节(向上取整到页)的匿名映射，失败时抛出 std::bad_alloc
+inline void* mmap_alloc_bytes(size_t bytes) {
+    void* p = mmap(nullptr, mmap_round_up(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) throw std::bad_alloc();
+    return p;
+}
+
+inline void mmap_free_bytes(void* p, size_t bytes) noexcept {
+    munmap(p, mmap_round_up(bytes));
+}
+
+/**
+ * @brief 把 p 处 old_bytes 字节的映射调整为 new_bytes 字节，必要时由内核移动到新的地址
+ * @return 调整后的地址，失败时抛出 std::bad_alloc，原映射保持不变
+ */
+inline void* mmap_realloc_bytes(void* p, size_t old_bytes, size_t new_bytes) {
+    const size_t old_len = mmap_round_up(old_bytes);
+    const size_t new_len = mmap_round_up(new_bytes);
+    if (old_len == new_len) return p;
+#if defined(MREMAP_MAYMOVE)
+    void* q = mremap(p, old_len, new_len, MREMAP_MAYMOVE);
+    if (q == MAP_FAILED) throw std::bad_alloc();
+    return q;
+#else
+    void* q = mmap_alloc_bytes(new_bytes);
+    std::memcpy(q, p, old_len < new_len ? old_len : new_len);
+    munmap(p, old_len);
+    return q;
+#endif
+}
+
+#else
+
+// Windows 上没有 mmap / mremap，大块请求同样走 ::operator new
+inline void* mmap_alloc_bytes(size_t bytes) { return ::operator new(bytes); }
+
+inline void mmap_free_bytes(void* p, size_t) noexcept { ::operator delete(p); }
+
+inline void* mmap_realloc_bytes(void* p, size_t old_bytes, size_t new_bytes) {
+    void* q = ::operator new(new_bytes);
+    std::memcpy(q, p, old_bytes < new_bytes ? old_bytes : new_bytes);
+    ::operator delete(p);
+    return q;
+}
+
+#endif
+
+/*********************************** mmap_allocator ***********************************/
+// 接口与 MySTL::allocator 保持一致，可作为 vector 的 Alloc 参数
+// 释放时根据字节数判断内存来自 mmap 还是 ::operator new，因此 deallocate 的 n 必须与分配时相同
+template <class T, size_t Threshold = MMAP_THRESHOLD>
+class mmap_allocator {
+public:
+    typedef T           value_type;
+    typedef T*          pointer;
+    typedef const T*    const_pointer;
+    typedef T&          reference;
+    typedef const T&    const_reference;
+    typedef size_t      size_type;
+    typedef ptrdiff_t   difference_type;
+
+    template <class U>
+    struct rebind {
+        typedef mmap_allocator<U, Threshold> other;
+    };
+
+public:
+    mmap_allocator() noexcept = default;
+
+    template <class U>
+    mmap_allocator(const mmap_allocator<U, Threshold>&) noexcept {}
+
+public:
+    static T*   allocate();
+    static T*   allocate(size_type n);
+
+    static void deallocate(T* ptr);
+    static void deallocate(T* ptr, size_type n);
+
+    // 调整 ptr 处 old_n 个对象的空间为 new_n 个，保留前 min(old_n, new_n) 个对象的字节
+    // 只能用于可平凡重定位的对象
+    static T*   reallocate(T* ptr, size_type old_n, size_type new_n);
+
+    static void construct(T* ptr);
+    static void construct(T* ptr, const T& value);
+    static void construct(T* ptr, T&& value);
+
+    template <class... Args>
+    static void construct(T* ptr, Args&& ...args);
+
+    static void destroy(T* ptr);
+    static void destroy(T* first, T* last);
+
+private:
+    static bool is_mapped(size_type n) { return sizeof(T) * n >= Threshold; }
+};
+
+template <class T, size_t Threshold>
+T* mmap_allocator<T, Threshold>::allocate() {
+    return allocate(1);
+}
+
+template <class T, size_t Threshold>
+T* mmap_allocator<T, Threshold>::allocate(size_type n) {
+    if (n == 0) return nullptr;
+    if (is_mapped(n)) {
+        return static_cast<T*>(mmap_alloc_bytes(sizeof(T) * n));
+    }
+    return static_cast<T*>(::operator new(sizeof(T) * n));
+}
+
+template <class T, size_t Threshold>
+void mmap_allocator<T, Threshold>::deallocate(T* ptr) {
+    deallocate(ptr, 1);
+}
+
+template <class T, size_t Threshold>
+void mmap_allocator<T, Threshold>::deallocate(T* ptr, size_type n) {
+    if (ptr == nullptr) return;
+    if (is_mapped(n)) {
+        mmap_free_bytes(ptr, sizeof(T) * n);
+    }
+    else {
+        ::operator delete(ptr);
+    }
+}
+
+template <class T, size_t Threshold>
+T* mmap_allocator<T, Threshold>::reallocate(T* ptr, size_type old_n, size_type new_n) {
+    if (ptr == nullptr || old_n == 0) {
+        deallocate(ptr, old_n);
+        return allocate(new_n);
+    }
+    if (new_n == 0) {
+        deallocate(ptr, old_n);
+        return nullptr;
+    }
+    if (is_mapped(old_n) && is_mapped(new_n)) {
+        return static_cast<T*>(mmap_realloc_bytes(ptr, sizeof(T) * old_n, sizeof(T) * new_n));
+    }
+    // 跨越阈值时来源不同，只能复制
+    T* result = allocate(new_n);
+    std::memcpy(static_cast<void*>(result), static_cast<const void*>(ptr),
+                sizeof(T) * (old_n < new_n ? old_n : new_n));
+    deallocate(ptr, old_n);
+    return result;
+}
+
+template <class T, size_t Threshold>
+void mmap_allocator<T, Threshold>::construct(T* ptr) {
+    MySTL::construct(ptr);
+}
+
+template <class T, size_t Threshold>
+void mmap_allocator<T, Threshold>::construct(T* ptr, const T& value) {
+    MySTL::construct(ptr, value);
+}
+
+template <class T, size_t Threshold>
+void mmap_allocator<T, Threshold>::construct(T* ptr, T&& value) {
+    MySTL::construct(ptr, MySTL::move(value));
+}
+
+template <class T, size_t Threshold>
+template <class... Args>
+void mmap_allocator<T, Threshold>::construct(T* ptr, Args&&... args) {
+    MySTL::construct(ptr, MySTL::forward<Args>(args)...);
+}
+
+template <class T, size_t Threshold>
+void mmap_allocator<T, Threshold>::destroy(T* ptr) {
+    MySTL::destroy(ptr);
+}
+
+template <class T, size_t Threshold>
+void mmap_allocator<T, Threshold>::destroy(T* first, T* last) {
+    MySTL::destroy(first, last);
+}
+
+template <class T, class U, size_t Threshold>
+bool operator==(const mmap_allocator<T, Threshold>&, const mmap_allocator<U, Threshold>&) noexcept { return true; }
+
+template <class T, class U, size_t Threshold>
+bool operator!=(const mmap_allocator<T, Threshold>&, const mmap_allocator<U, Threshold>&) noexcept { return false; }
+
+}  // namespace MySTL
+
+#endif /* MY_MMAP_ALLOCATOR_H */
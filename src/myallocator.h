@@ -2,8 +2,10 @@
 #define MY_ALLOCATOR_H
 
 #include <memory>
+#include <type_traits>
 
 #include "construct.h"
+#include "exceptdef.h"
 #include "type_traits.h"
 #include "util.h"
 
@@ -20,6 +22,17 @@ public:
     typedef size_t      size_type;
     typedef ptrdiff_t   difference_type;
 
+    template <class U>
+    struct rebind {
+        typedef allocator<U> other;
+    };
+
+public:
+    allocator() noexcept = default;
+
+    template <class U>
+    allocator(const allocator<U>&) noexcept {}
+
 public:
     static T*   allocate();
     static T*   allocate(size_type n);
@@ -96,6 +109,235 @@ void allocator<T>::destroy(T* first, T* last) {
     MySTL::destroy(first, last);
 }
 
+// 无状态分配器，任意两个实例都可以互相释放对方分配的内存
+template <class T, class U>
+bool operator==(const allocator<T>&, const allocator<U>&) noexcept { return true; }
+
+template <class T, class U>
+bool operator!=(const allocator<T>&, const allocator<U>&) noexcept { return false; }
+
+/*********************************** allocator_traits ***********************************/
+// 容器统一通过 allocator_traits 访问分配器实例，分配器缺省的成员按标准规定的默认值补齐
+
+template <class...>
+struct alloc_void {
+    typedef void type;
+};
+
+template <class Alloc, class = void>
+struct alloc_pocca : public std::false_type {};
+
+template <class Alloc>
+struct alloc_pocca<Alloc, typename alloc_void<typename Alloc::propagate_on_container_copy_assignment>::type>
+    : public std::integral_constant<bool, Alloc::propagate_on_container_copy_assignment::value> {};
+
+template <class Alloc, class = void>
+struct alloc_pocma : public std::false_type {};
+
+template <class Alloc>
+struct alloc_pocma<Alloc, typename alloc_void<typename Alloc::propagate_on_container_move_assignment>::type>
+    : public std::integral_constant<bool, Alloc::propagate_on_container_move_assignment::value> {};
+
+template <class Alloc, class = void>
+struct alloc_pocs : public std::false_type {};
+
+template <class Alloc>
+struct alloc_pocs<Alloc, typename alloc_void<typename Alloc::propagate_on_container_swap>::type>
+    : public std::integral_constant<bool, Alloc::propagate_on_container_swap::value> {};
+
+// 未声明 is_always_equal 时，空类型的分配器视为总是相等
+template <class Alloc, class = void>
+struct alloc_always_equal : public std::integral_constant<bool, std::is_empty<Alloc>::value> {};
+
+template <class Alloc>
+struct alloc_always_equal<Alloc, typename alloc_void<typename Alloc::is_always_equal>::type>
+    : public std::integral_constant<bool, Alloc::is_always_equal::value> {};
+
+// rebind：优先使用 Alloc::rebind<U>::other，否则替换 Alloc<T, Args...> 的第一个模板参数
+template <class Alloc, class U>
+struct alloc_rebind_first;
+
+template <template <class, class...> class Alloc, class T, class... Args, class U>
+struct alloc_rebind_first<Alloc<T, Args...>, U> {
+    typedef Alloc<U, Args...> type;
+};
+
+template <class Alloc, class U, class = void>
+struct alloc_rebind : public alloc_rebind_first<Alloc, U> {};
+
+template <class Alloc, class U>
+struct alloc_rebind<Alloc, U, typename alloc_void<typename Alloc::template rebind<U>::other>::type> {
+    typedef typename Alloc::template rebind<U>::other type;
+};
+
+// 分配器是否提供 reallocate(p, old_n, new_n)，提供时容器可以把整块可平凡重定位的元素交给分配器调整大小
+template <class Alloc, class = void>
+struct alloc_has_reallocate : public std::false_type {};
+
+template <class Alloc>
+struct alloc_has_reallocate<Alloc, typename alloc_void<decltype(std::declval<Alloc&>().reallocate(
+    std::declval<typename Alloc::value_type*>(), size_t(), size_t()))>::type> : public std::true_type {};
+
+template <class Alloc>
+struct allocator_traits {
+    typedef Alloc                             allocator_type;
+    typedef typename Alloc::value_type        value_type;
+    typedef value_type*                       pointer;
+    typedef const value_type*                 const_pointer;
+    typedef size_t                            size_type;
+    typedef ptrdiff_t                         difference_type;
+
+    typedef alloc_pocca<Alloc>                propagate_on_container_copy_assignment;
+    typedef alloc_pocma<Alloc>                propagate_on_container_move_assignment;
+    typedef alloc_pocs<Alloc>                 propagate_on_container_swap;
+    typedef alloc_always_equal<Alloc>         is_always_equal;
+    typedef alloc_has_reallocate<Alloc>       has_reallocate;
+
+    template <class U>
+    using rebind_alloc = typename alloc_rebind<Alloc, U>::type;
+
+    template <class U>
+    using rebind_traits = allocator_traits<rebind_alloc<U>>;
+
+    static pointer allocate(Alloc& a, size_type n) { return a.allocate(n); }
+
+    static void deallocate(Alloc& a, pointer p, size_type n) { a.deallocate(p, n); }
+
+    // 仅当 has_reallocate 为真时可用
+    static pointer reallocate(Alloc& a, pointer p, size_type old_n, size_type new_n) {
+        return a.reallocate(p, old_n, new_n);
+    }
+
+    template <class U, class... Args>
+    static void construct(Alloc& a, U* p, Args&&... args) {
+        construct_aux(0, a, p, MySTL::forward<Args>(args)...);
+    }
+
+    template <class U>
+    static void destroy(Alloc& a, U* p) { destroy_aux(0, a, p); }
+
+    // 区间析构，分配器未提供 destroy 时直接走 MySTL::destroy 的平凡析构快速路径
+    template <class U>
+    static void destroy(Alloc& a, U* first, U* last) { destroy_range_aux(0, a, first, last); }
+
+    static Alloc select_on_container_copy_construction(const Alloc& a) { return select_aux(0, a); }
+
+private:
+    // 分配器类型作为模板参数推导，使 decltype 中的表达式参与 SFINAE
+    template <class A, class U, class... Args>
+    static auto construct_aux(int, A& a, U* p, Args&&... args)
+        -> decltype(a.construct(p, MySTL::forward<Args>(args)...), void()) {
+        a.construct(p, MySTL::forward<Args>(args)...);
+    }
+
+    template <class A, class U, class... Args>
+    static void construct_aux(long, A&, U* p, Args&&... args) {
+        MySTL::construct(p, MySTL::forward<Args>(args)...);
+    }
+
+    template <class A, class U>
+    static auto destroy_aux(int, A& a, U* p) -> decltype(a.destroy(p), void()) {
+        a.destroy(p);
+    }
+
+    template <class A, class U>
+    static void destroy_aux(long, A&, U* p) {
+        MySTL::destroy(p);
+    }
+
+    template <class A, class U>
+    static auto destroy_range_aux(int, A& a, U* first, U* last) -> decltype(a.destroy(first), void()) {
+        for (; first != last; ++first)
+            a.destroy(first);
+    }
+
+    template <class A, class U>
+    static void destroy_range_aux(long, A&, U* first, U* last) {
+        MySTL::destroy(first, last);
+    }
+
+    template <class A>
+    static auto select_aux(int, const A& a) -> decltype(a.select_on_container_copy_construction()) {
+        return a.select_on_container_copy_construction();
+    }
+
+    template <class A>
+    static Alloc select_aux(long, const A& a) { return a; }
+};
+
+// 容器复制赋值时，按 propagate_on_container_copy_assignment 决定是否复制分配器
+template <class Alloc>
+void alloc_on_copy(Alloc& lhs, const Alloc& rhs, std::true_type) { lhs = rhs; }
+
+template <class Alloc>
+void alloc_on_copy(Alloc&, const Alloc&, std::false_type) {}
+
+template <class Alloc>
+void alloc_on_copy(Alloc& lhs, const Alloc& rhs) {
+    alloc_on_copy(lhs, rhs, typename allocator_traits<Alloc>::propagate_on_container_copy_assignment{});
+}
+
+// 容器移动赋值时，按 propagate_on_container_move_assignment 决定是否移动分配器
+template <class Alloc>
+void alloc_on_move(Alloc& lhs, Alloc& rhs, std::true_type) { lhs = MySTL::move(rhs); }
+
+template <class Alloc>
+void alloc_on_move(Alloc&, Alloc&, std::false_type) {}
+
+template <class Alloc>
+void alloc_on_move(Alloc& lhs, Alloc& rhs) {
+    alloc_on_move(lhs, rhs, typename allocator_traits<Alloc>::propagate_on_container_move_assignment{});
+}
+
+// 容器交换时，按 propagate_on_container_swap 决定是否交换分配器，不传播时两者必须相等
+template <class Alloc>
+void alloc_on_swap(Alloc& lhs, Alloc& rhs, std::true_type) { MySTL::swap(lhs, rhs); }
+
+template <class Alloc>
+void alloc_on_swap(Alloc& lhs, Alloc& rhs, std::false_type) {
+    (void)lhs;
+    (void)rhs;
+    MYSTL_DEBUG(lhs == rhs);
+}
+
+template <class Alloc>
+void alloc_on_swap(Alloc& lhs, Alloc& rhs) {
+    alloc_on_swap(lhs, rhs, typename allocator_traits<Alloc>::propagate_on_container_swap{});
+}
+
+// 两个分配器能否互相释放对方分配的内存
+template <class Alloc>
+bool alloc_equal(const Alloc& lhs, const Alloc& rhs) {
+    return allocator_traits<Alloc>::is_always_equal::value || lhs == rhs;
+}
+
+/*********************************** alloc_holder ***********************************/
+// 容器通过私有继承 alloc_holder 保存分配器实例，空分配器借助空基类优化不占用空间
+template <class Alloc, bool = std::is_empty<Alloc>::value>
+class alloc_holder : private Alloc {
+public:
+    alloc_holder() = default;
+    explicit alloc_holder(const Alloc& a) : Alloc(a) {}
+    explicit alloc_holder(Alloc&& a) : Alloc(MySTL::move(a)) {}
+
+    Alloc&       get_alloc() noexcept { return *this; }
+    const Alloc& get_alloc() const noexcept { return *this; }
+};
+
+template <class Alloc>
+class alloc_holder<Alloc, false> {
+private:
+    Alloc alloc_;
+
+public:
+    alloc_holder() = default;
+    explicit alloc_holder(const Alloc& a) : alloc_(a) {}
+    explicit alloc_holder(Alloc&& a) : alloc_(MySTL::move(a)) {}
+
+    Alloc&       get_alloc() noexcept { return alloc_; }
+    const Alloc& get_alloc() const noexcept { return alloc_; }
+};
+
 }  // namespace MySTL
 
 #endif /* MY_ALLOCATOR_H */
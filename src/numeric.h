@@ -21,13 +21,33 @@ namespace MySTL{
  * @note 函数声明为 constexpr 用于C++11, 表示该函数在编译期就能计算出结果
  */
 template <class InputIter, class T>
-constexpr
-T accumulate(InputIter first, InputIter last, T init) {
+T unchecked_accumulate(InputIter first, InputIter last, T init, m_false_type) {
     for (; first != last; first++)
         init = MySTL::move(init) + *first;
     return init;
 }
 
+// 分段迭代器逐段累加，段内是指针循环，编译器可以向量化
+template <class SegIter, class T>
+T unchecked_accumulate(SegIter first, SegIter last, T init, m_true_type) {
+    typedef segmented_iterator_traits<SegIter> traits;
+    auto sfirst = traits::segment(first);
+    auto slast = traits::segment(last);
+    if (sfirst == slast)
+        return unchecked_accumulate(traits::local(first), traits::local(last), MySTL::move(init), m_false_type());
+    init = unchecked_accumulate(traits::local(first), traits::end(sfirst), MySTL::move(init), m_false_type());
+    for (++sfirst; sfirst != slast; ++sfirst)
+        init = unchecked_accumulate(traits::begin(sfirst), traits::end(sfirst), MySTL::move(init), m_false_type());
+    return unchecked_accumulate(traits::begin(slast), traits::local(last), MySTL::move(init), m_false_type());
+}
+
+template <class InputIter, class T>
+constexpr
+T accumulate(InputIter first, InputIter last, T init) {
+    return unchecked_accumulate(first, last, MySTL::move(init),
+                                m_bool_constant<is_segmented_iterator<InputIter>::value>());
+}
+
 /**
  * @brief accumulate()针对BinaryOperation op重载版本,使用op代替+
  * @tparam BinaryOperation 二元操作函数
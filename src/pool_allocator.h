@@ -0,0 +1,273 @@
+#ifndef MY_POOL_ALLOCATOR_H
+#define MY_POOL_ALLOCATOR_H
+
+// 按 size class 划分的结点内存池，适用于 list / rb_tree 这类频繁分配小结点的容器
+// 小于等于 POOL_MAX_BYTES 的请求按 POOL_ALIGN 向上取整后落入对应的自由链表，
+// 自由链表为空时一次性从大块 slab 中切出 POOL_REFILL_OBJS 个对象
+// 超过上限或对齐要求更高的请求直接交给 ::operator new
+// 注意：内存池非线程安全，且 slab 在程序结束前不会归还给系统
+
+#include <cstddef>
+#include <new>
+
+#include "construct.h"
+#include "util.h"
+
+namespace MySTL {
+
+enum { POOL_ALIGN = 8 };
+enum { POOL_MAX_BYTES = 256 };
+enum { POOL_NFREELISTS = POOL_MAX_BYTES / POOL_ALIGN };
+enum { POOL_REFILL_OBJS = 32 };
+constexpr size_t POOL_SLAB_BYTES = 64 * 1024;
+
+/*********************************** node_pool ***********************************/
+// 模板参数仅用于让静态成员可以定义在头文件中
+template <int Inst>
+class node_pool_template {
+private:
+    union obj {
+        union obj* next;
+        char       data[1];
+    };
+
+    static obj*   free_list_[POOL_NFREELISTS];
+    static char*  start_free_;  // 当前 slab 中未切分部分的起止位置
+    static char*  end_free_;
+    static size_t heap_size_;   // 已向系统申请的总字节数
+
+public:
+    static void* allocate(size_t bytes);
+    static void  deallocate(void* ptr, size_t bytes);
+
+    // 请求是否由内存池负责
+    static bool  is_pooled(size_t bytes, size_t align) {
+        return bytes <= POOL_MAX_BYTES && align <= POOL_ALIGN;
+    }
+
+    static size_t heap_size() { return heap_size_; }
+
+private:
+    static size_t round_up(size_t bytes) {
+        return (bytes + POOL_ALIGN - 1) & ~(static_cast<size_t>(POOL_ALIGN) - 1);
+    }
+
+    static size_t free_list_index(size_t bytes) {
+        return (bytes + POOL_ALIGN - 1) / POOL_ALIGN - 1;
+    }
+
+    static void* refill(size_t bytes);
+    static char* chunk_alloc(size_t bytes, size_t& nobjs);
+};
+
+template <int Inst>
+typename node_pool_template<Inst>::obj* node_pool_template<Inst>::free_list_[POOL_NFREELISTS] = {};
+
+template <int Inst>
+char* node_pool_template<Inst>::start_free_ = nullptr;
+
+template <int Inst>
+char* node_pool_template<Inst>::end_free_ = nullptr;
+
+template <int Inst>
+size_t node_pool_template<Inst>::heap_size_ = 0;
+
+/**
+ * @brief 从对应 size class 的自由链表取出一块内存，链表为空时从 slab 补充
+ * @param bytes 请求字节数，调用者保证 0 < bytes <= POOL_MAX_BYTES
+ */
+template <int Inst>
+void* node_pool_template<Inst>::allocate(size_t bytes) {
+    obj*& head   = free_list_[free_list_index(bytes)];
+    obj*  result = head;
+    if (result == nullptr) {
+        return refill(round_up(bytes));
+    }
+    head = result->next;
+    return result;
+}
+
+/**
+ * @brief 将内存块挂回对应 size class 的自由链表
+ * @param bytes 必须与 allocate 时的请求字节数落在同一 size class
+ */
+template <int Inst>
+void node_pool_template<Inst>::deallocate(void* ptr, size_t bytes) {
+    obj*& head = free_list_[free_list_index(bytes)];
+    obj*  q    = static_cast<obj*>(ptr);
+    q->next    = head;
+    head       = q;
+}
+
+// 从 slab 中切出若干个大小为 bytes 的对象，返回第一个，其余挂入自由链表
+template <int Inst>
+void* node_pool_template<Inst>::refill(size_t bytes) {
+    size_t nobjs = POOL_REFILL_OBJS;
+    char*  chunk = chunk_alloc(bytes, nobjs);
+    if (nobjs == 1) return chunk;
+
+    obj*& head = free_list_[free_list_index(bytes)];
+    obj*  cur  = reinterpret_cast<obj*>(chunk + bytes);
+    head       = cur;
+    for (size_t i = 2; i < nobjs; ++i) {
+        obj* next = reinterpret_cast<obj*>(reinterpret_cast<char*>(cur) + bytes);
+        cur->next = next;
+        cur       = next;
+    }
+    cur->next = nullptr;
+    return chunk;
+}
+
+/**
+ * @brief 从当前 slab 中取出 nobjs 个对象的空间，不足时申请新的 slab
+ * @param nobjs 传入期望数量，传出实际取得的数量(至少为 1)
+ */
+template <int Inst>
+char* node_pool_template<Inst>::chunk_alloc(size_t bytes, size_t& nobjs) {
+    size_t total = bytes * nobjs;
+    size_t left  = static_cast<size_t>(end_free_ - start_free_);
+
+    if (left >= total) {
+        char* result = start_free_;
+        start_free_ += total;
+        return result;
+    }
+    if (left >= bytes) {
+        nobjs        = left / bytes;
+        char* result = start_free_;
+        start_free_ += bytes * nobjs;
+        return result;
+    }
+
+    // 当前 slab 的零头挂到对应的自由链表上，避免浪费
+    if (left > 0) {
+        obj*& head = free_list_[free_list_index(left)];
+        obj*  q    = reinterpret_cast<obj*>(start_free_);
+        q->next    = head;
+        head       = q;
+    }
+
+    size_t bytes_to_get = 2 * total > POOL_SLAB_BYTES ? 2 * total : POOL_SLAB_BYTES;
+    start_free_         = static_cast<char*>(::operator new(bytes_to_get));
+    end_free_           = start_free_ + bytes_to_get;
+    heap_size_ += bytes_to_get;
+    return chunk_alloc(bytes, nobjs);
+}
+
+typedef node_pool_template<0> node_pool;
+
+/*********************************** pool_allocator ***********************************/
+// 接口与 MySTL::allocator 保持一致，可作为 list / rb_tree / map / set 的 Alloc 参数
+template <class T>
+class pool_allocator {
+public:
+    typedef T           value_type;
+    typedef T*          pointer;
+    typedef const T*    const_pointer;
+    typedef T&          reference;
+    typedef const T&    const_reference;
+    typedef size_t      size_type;
+    typedef ptrdiff_t   difference_type;
+
+    template <class U>
+    struct rebind {
+        typedef pool_allocator<U> other;
+    };
+
+public:
+    pool_allocator() noexcept = default;
+
+    template <class U>
+    pool_allocator(const pool_allocator<U>&) noexcept {}
+
+public:
+    static T*   allocate();
+    static T*   allocate(size_type n);
+
+    static void deallocate(T* ptr);
+    static void deallocate(T* ptr, size_type n);
+
+    static void construct(T* ptr);
+    static void construct(T* ptr, const T& value);
+    static void construct(T* ptr, T&& value);
+
+    template <class... Args>
+    static void construct(T* ptr, Args&& ...args);
+
+    static void destroy(T* ptr);
+    static void destroy(T* first, T* last);
+};
+
+template <class T>
+T* pool_allocator<T>::allocate() {
+    return allocate(1);
+}
+
+template <class T>
+T* pool_allocator<T>::allocate(size_type n) {
+    if (n == 0) return nullptr;
+    const size_t bytes = sizeof(T) * n;
+    if (node_pool::is_pooled(bytes, alignof(T))) {
+        return static_cast<T*>(node_pool::allocate(bytes));
+    }
+    return static_cast<T*>(::operator new(bytes));
+}
+
+template <class T>
+void pool_allocator<T>::deallocate(T* ptr) {
+    deallocate(ptr, 1);
+}
+
+template <class T>
+void pool_allocator<T>::deallocate(T* ptr, size_type n) {
+    if (ptr == nullptr) return;
+    const size_t bytes = sizeof(T) * n;
+    if (node_pool::is_pooled(bytes, alignof(T))) {
+        node_pool::deallocate(ptr, bytes);
+    }
+    else {
+        ::operator delete(ptr);
+    }
+}
+
+template <class T>
+void pool_allocator<T>::construct(T* ptr) {
+    MySTL::construct(ptr);
+}
+
+template <class T>
+void pool_allocator<T>::construct(T* ptr, const T& value) {
+    MySTL::construct(ptr, value);
+}
+
+template <class T>
+void pool_allocator<T>::construct(T* ptr, T&& value) {
+    MySTL::construct(ptr, MySTL::move(value));
+}
+
+template <class T>
+template <class... Args>
+void pool_allocator<T>::construct(T* ptr, Args&&... args) {
+    MySTL::construct(ptr, MySTL::forward<Args>(args)...);
+}
+
+template <class T>
+void pool_allocator<T>::destroy(T* ptr) {
+    MySTL::destroy(ptr);
+}
+
+template <class T>
+void pool_allocator<T>::destroy(T* first, T* last) {
+    MySTL::destroy(first, last);
+}
+
+// 所有实例共享同一个内存池
+template <class T, class U>
+bool operator==(const pool_allocator<T>&, const pool_allocator<U>&) noexcept { return true; }
+
+template <class T, class U>
+bool operator!=(const pool_allocator<T>&, const pool_allocator<U>&) noexcept { return false; }
+
+}  // namespace MySTL
+
+#endif /* MY_POOL_ALLOCATOR_H */
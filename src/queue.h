@@ -11,6 +11,7 @@
 namespace MySTL {
 
 // 模板类 queue
+// 底层 deque 的缓冲区大小通过 Container 指定，如 queue<int, deque<int, allocator<int>, 1024>>
 template <class T, class Container = MySTL::deque<T>>
 class queue {
 public:
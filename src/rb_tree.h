@@ -562,9 +562,9 @@ Nodeptr rb_tree_erase_reblance(Nodeptr z, Nodeptr& root, Nodeptr& leftmost, Node
 
 /*********************************** 红黑树模板类 ***********************************/
 // 模板类红黑树，
-// 模板参数一为数据类型，参数二为键值比较类型
-template <class T, class Compare>
-class rb_tree {
+// 模板参数一为数据类型，参数二为键值比较类型，参数三为分配器类型
+template <class T, class Compare, class Alloc = MySTL::allocator<T>>
+class rb_tree : private alloc_holder<typename allocator_traits<Alloc>::template rebind_alloc<rb_tree_node<T>>> {
 public:
     // 简化
     typedef rb_tree_traits<T>                        tree_traits;
@@ -580,27 +580,31 @@ public:
 
     typedef Compare                                  key_compare;
 
-    typedef MySTL::allocator<T>                      allocator_type;
-    typedef MySTL::allocator<T>                      data_allocator;
-    typedef MySTL::allocator<base_type>              base_allocator;
-    typedef MySTL::allocator<node_type>              node_allocator;
-    // 分配器萃取
-    typedef typename allocator_type::size_type       size_type;
-    typedef typename allocator_type::difference_type difference_type;
-    typedef typename allocator_type::pointer         pointer;
-    typedef typename allocator_type::const_pointer   const_pointer;
-    typedef typename allocator_type::reference       reference;
-    typedef typename allocator_type::const_reference const_reference;
+    typedef Alloc                                                               allocator_type;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<base_type> base_allocator;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<node_type> node_allocator;
+    typedef MySTL::allocator_traits<base_allocator>                             base_alloc_traits;
+    typedef MySTL::allocator_traits<node_allocator>                             node_alloc_traits;
+
+    typedef size_t                                   size_type;
+    typedef ptrdiff_t                                difference_type;
+    typedef value_type*                              pointer;
+    typedef const value_type*                        const_pointer;
+    typedef value_type&                              reference;
+    typedef const value_type&                        const_reference;
     // 迭代器类型
     typedef rb_tree_iterator<T>                      iterator;
     typedef rb_tree_const_iterator<T>                const_iterator;
     typedef MySTL::reverse_iterator<iterator>        reverse_iterator;
     typedef MySTL::reverse_iterator<const_iterator>  const_reverse_iterator;
 
-    allocator_type get_allocator()  const { return node_allocator(); }
+    allocator_type get_allocator()  const { return allocator_type(get_alloc()); }
     key_compare    key_comp()       const { return key_comp_; }
 
 private:
+    typedef alloc_holder<node_allocator>             alloc_base;
+    using alloc_base::get_alloc;
+
     base_ptr    header_;
     size_type   node_count_;
     key_compare key_comp_;
@@ -616,20 +620,22 @@ public:
 
     rb_tree() { rb_tree_init(); }
 
-    // 拷贝
-    rb_tree(const rb_tree& rhs) noexcept {
+    explicit rb_tree(const key_compare& comp, const allocator_type& alloc = allocator_type()) :
+        alloc_base(node_allocator(alloc)) {
         rb_tree_init();
-        if (rhs.node_count_ != 0) {
-            root() = copy_from(rhs.root(), header_);
-            leftmost() = rb_tree_min(root());
-            rightmost() = rb_tree_max(root());
-        }
-        node_count_ = rhs.node_count_;
-        key_comp_ = rhs.key_comp_;
+        key_comp_ = comp;
+    }
+
+    // 拷贝，分配器由 select_on_container_copy_construction 决定
+    rb_tree(const rb_tree& rhs) :
+        alloc_base(node_alloc_traits::select_on_container_copy_construction(rhs.get_alloc())) {
+        rb_tree_init();
+        copy_tree(rhs);
     }
 
     // 移动，
     rb_tree(rb_tree&& rhs) :
+        alloc_base(MySTL::move(rhs.get_alloc())),
         header_(MySTL::move(rhs.header_)), node_count_(rhs.node_count_), key_comp_(rhs.key_comp_) {
         rhs.reset();
     }
@@ -638,28 +644,47 @@ public:
         if (this == &rhs) return *this;
 
         clear();
-        if (rhs.node_count_ != 0) {
-            root() = copy_from(rhs.root(), header_);
-            leftmost() = rb_tree_min(root());
-            rightmost() = rb_tree_max(root());
+        if (header_ != nullptr && node_alloc_traits::propagate_on_container_copy_assignment::value &&
+            !MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+            // 分配器将被替换，header 必须先由旧分配器释放
+            destroy_base_node(header_);
+            header_ = nullptr;
         }
-        node_count_ = rhs.node_count_;
-        key_comp_ = rhs.key_comp_;
+        MySTL::alloc_on_copy(get_alloc(), rhs.get_alloc());
+        if (header_ == nullptr) rb_tree_init();
+        copy_tree(rhs);
         return *this;
     };
 
-    rb_tree& operator=(rb_tree&& rhs) noexcept {
+    // 分配器不传播且不相等时要逐个申请结点，可能抛出异常
+    rb_tree& operator=(rb_tree&& rhs) noexcept(node_alloc_traits::propagate_on_container_move_assignment::value ||
+                                               node_alloc_traits::is_always_equal::value) {
         if (this == &rhs) return *this;
 
         clear();
-        header_ = MySTL::move(rhs.header_);
-        node_count_ = rhs.node_count_;
-        key_comp_ = rhs.key_comp_;
-        rhs.reset();
+        if (node_alloc_traits::propagate_on_container_move_assignment::value ||
+            MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+            if (header_ != nullptr) destroy_base_node(header_);
+            MySTL::alloc_on_move(get_alloc(), rhs.get_alloc());
+            header_ = MySTL::move(rhs.header_);
+            node_count_ = rhs.node_count_;
+            key_comp_ = rhs.key_comp_;
+            rhs.reset();
+        } else {
+            // 分配器不相等且不传播，不能接管 rhs 的结点，只能逐个移动元素
+            if (header_ == nullptr) rb_tree_init();
+            key_comp_ = rhs.key_comp_;
+            for (auto it = rhs.begin(); it != rhs.end(); ++it)
+                emplace_multi_use_hint(end(), MySTL::move(*it));
+            rhs.clear();
+        }
         return *this;
     };
 
-    ~rb_tree() { clear(); }
+    ~rb_tree() {
+        clear();
+        if (header_ != nullptr) destroy_base_node(header_);
+    }
 
 public:
     /*********************************** 迭代器操作 ***********************************/
@@ -782,10 +807,13 @@ private:
     node_ptr create_node(Args&&... args);
     node_ptr clone_node(base_ptr x);
     void     destory_node(node_ptr p);
+    base_ptr create_base_node();
+    void     destroy_base_node(base_ptr p);
 
     // init
     void rb_tree_init();
     void reset();
+    void copy_tree(const rb_tree& rhs);
 
     // get insert pos
     MySTL::pair<base_ptr, bool>
@@ -814,10 +842,10 @@ private:
  * @param args 
  * @return iterator 插入的位置
  */
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class... Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::emplace_multi(Args&&... args) {
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::emplace_multi(Args&&... args) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Compare>'s size too big");
     node_ptr np = create_node(MySTL::forward<Args>(args)...);
     auto res = get_insert_multi_pos(value_traits::get_key(np->value));
@@ -829,10 +857,10 @@ rb_tree<T, Compare>::emplace_multi(Args&&... args) {
  * @param args 变参模板参数
  * @return pair<iterator, bool> 插入的位置，是否插入成功
  */
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class... Args>
-MySTL::pair<typename rb_tree<T, Compare>::iterator, bool>
-rb_tree<T, Compare>::emplace_unique(Args&&... args) {
+MySTL::pair<typename rb_tree<T, Compare, Alloc>::iterator, bool>
+rb_tree<T, Compare, Alloc>::emplace_unique(Args&&... args) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Compare>'s size too big");
     node_ptr np = create_node(MySTL::forward<Args>(args)...);
     auto    res = get_insert_unique_pos(value_traits::get_key(np->value));
@@ -848,10 +876,10 @@ rb_tree<T, Compare>::emplace_unique(Args&&... args) {
  * @brief hint位置与插入位置重复时，采用更优算法  
  * @param hint 插入位置的提示
  */
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class... Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::emplace_multi_use_hint(typename rb_tree<T, Compare>::iterator hint, Args&&... args) {
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::emplace_multi_use_hint(typename rb_tree<T, Compare, Alloc>::iterator hint, Args&&... args) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
     node_ptr np = create_node(MySTL::forward<Args>(args)...);
 
@@ -882,10 +910,10 @@ rb_tree<T, Compare>::emplace_multi_use_hint(typename rb_tree<T, Compare>::iterat
  * @param hint 插入位置的提示
  * @return iterator 插入的位置
  */
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class... Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::emplace_unique_use_hint(iterator hint, Args&&... args) {
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::emplace_unique_use_hint(iterator hint, Args&&... args) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
 
     node_ptr np = create_node(MySTL::forward<Args>(args)...);
@@ -920,9 +948,9 @@ rb_tree<T, Compare>::emplace_unique_use_hint(iterator hint, Args&&... args) {
     return insert_unique_use_hint(hint, key, np);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::insert_multi(const value_type& value) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::insert_multi(const value_type& value) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
     auto pos = get_insert_multi_pos(value_traits::get_key(value));
     return insert_value_at(pos.first, value, pos.second);
@@ -932,9 +960,9 @@ rb_tree<T, Compare>::insert_multi(const value_type& value) {
  * @brief 插入节点，不允许插入具有相同键的节点
  * @return pair<iterator, bool> 插入的位置，是否插入成功 
  */
-template <class T, class Compare>
-MySTL::pair<typename rb_tree<T, Compare>::iterator, bool>
-rb_tree<T, Compare>::insert_unique(const value_type& value) {
+template <class T, class Compare, class Alloc>
+MySTL::pair<typename rb_tree<T, Compare, Alloc>::iterator, bool>
+rb_tree<T, Compare, Alloc>::insert_unique(const value_type& value) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
     auto pos = get_insert_unique_pos(value_traits::get_key(value));
     if (pos.second) {
@@ -949,9 +977,9 @@ rb_tree<T, Compare>::insert_unique(const value_type& value) {
  * @brief 删除 hint 处节点
  * @return iterator 指向被删除节点的下一个节点
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::erase(iterator hint) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::erase(iterator hint) {
     auto     pnode = hint.node->get_node_ptr();
     iterator next(pnode);
     ++next;
@@ -965,9 +993,9 @@ rb_tree<T, Compare>::erase(iterator hint) {
  * @brief 所有键为 key 的元素，返回删除的个数
  * @return 删除的个数
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::size_type
-rb_tree<T, Compare>::erase_multi(const key_type & key) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::size_type
+rb_tree<T, Compare, Alloc>::erase_multi(const key_type & key) {
     auto      p = equal_range_multi(key);
     size_type n = MySTL::distance(p.first, p.second);
     erase(p.first, p.second);
@@ -978,9 +1006,9 @@ rb_tree<T, Compare>::erase_multi(const key_type & key) {
  * @brief 删除键为 key 的元素，返回删除的个数
  * @return 删除的个数
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::size_type
-rb_tree<T, Compare>::erase_unique(const key_type& key) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::size_type
+rb_tree<T, Compare, Alloc>::erase_unique(const key_type& key) {
     auto it = find(key);
     if (it != end()) {
         erase(it);
@@ -992,8 +1020,8 @@ rb_tree<T, Compare>::erase_unique(const key_type& key) {
 /**
  * @brief 删除 [first, last) 内的元素]
  */
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
 erase(iterator first, iterator last) {
     if (first == begin() && last == end()) {
         clear();
@@ -1006,8 +1034,8 @@ erase(iterator first, iterator last) {
 /**
  * @brief 删除 [first, last) 内的元素]
  */
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
 clear() {
     if (node_count_ != 0) {
         erase_since(root());
@@ -1024,9 +1052,9 @@ clear() {
 /**
  * @brief 查找键为 key 的元素，返回其迭代器(二叉查找树)
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::find(const key_type& key) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::find(const key_type& key) {
     auto y = header_; // y 表示最后一个不小于 key 的节点
     auto x = root(); 
     while(x != nullptr) {
@@ -1047,9 +1075,9 @@ rb_tree<T, Compare>::find(const key_type& key) {
 /**
  * @brief 查找键为 key 的元素，返回其迭代器(二叉查找树)
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::find(const key_type& key) const {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::const_iterator
+rb_tree<T, Compare, Alloc>::find(const key_type& key) const {
     auto y = header_;
     auto x = root(); 
     while(x != nullptr) {
@@ -1068,9 +1096,9 @@ rb_tree<T, Compare>::find(const key_type& key) const {
 /**
  * @brief 键不小于key的第一个位置，算法同find()方法
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::lower_bound(const key_type& key) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::lower_bound(const key_type& key) {
     auto y = header_;
     auto x = root();
     while (x != nullptr) {
@@ -1088,9 +1116,9 @@ rb_tree<T, Compare>::lower_bound(const key_type& key) {
 /**
  * @brief 键不小于key的第一个位置，算法同find()方法
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::lower_bound(const key_type& key) const {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::const_iterator
+rb_tree<T, Compare, Alloc>::lower_bound(const key_type& key) const {
     auto y = header_;
     auto x = root();
     while (x != nullptr) {
@@ -1108,9 +1136,9 @@ rb_tree<T, Compare>::lower_bound(const key_type& key) const {
 /**
  * @brief 键不小于key的最后一个位置
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::upper_bound(const key_type& key) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::upper_bound(const key_type& key) {
     auto y = header_;
     auto x = root();
     while (x != nullptr) {
@@ -1129,9 +1157,9 @@ rb_tree<T, Compare>::upper_bound(const key_type& key) {
 /**
  * @brief 键不小于key的最后一个位置
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::upper_bound(const key_type& key) const {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::const_iterator
+rb_tree<T, Compare, Alloc>::upper_bound(const key_type& key) const {
     auto y = header_;
     auto x = root();
     while (x != nullptr) {
@@ -1147,9 +1175,10 @@ rb_tree<T, Compare>::upper_bound(const key_type& key) const {
     return const_iterator(y);
 }
 
-template <class T, class Compare>
-void rb_tree<T, Compare>::swap(rb_tree& rhs) noexcept {
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::swap(rb_tree& rhs) noexcept {
     if (this != &rhs) {
+        MySTL::alloc_on_swap(get_alloc(), rhs.get_alloc());
         MySTL::swap(header_, rhs.header_);
         MySTL::swap(node_count_, rhs.node_count_);
         MySTL::swap(key_comp_, rhs.key_comp_);
@@ -1159,27 +1188,27 @@ void rb_tree<T, Compare>::swap(rb_tree& rhs) noexcept {
 /*********************************** helper function ***********************************/
 
 // 创造节点
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class... Args>
-typename rb_tree<T, Compare>::node_ptr
-rb_tree<T, Compare>::create_node(Args&&... args) {
-    auto node = node_allocator::allocate(1);
+typename rb_tree<T, Compare, Alloc>::node_ptr
+rb_tree<T, Compare, Alloc>::create_node(Args&&... args) {
+    auto node = node_alloc_traits::allocate(get_alloc(), 1);
     try {
-        data_allocator::construct(MySTL::address_of(node->value), MySTL::forward<Args>(args)...);
+        node_alloc_traits::construct(get_alloc(), MySTL::address_of(node->value), MySTL::forward<Args>(args)...);
         node->left = nullptr;
         node->right = nullptr;
         node->parent = nullptr;
     } catch (...) {
-        node_allocator::deallocate(node);
+        node_alloc_traits::deallocate(get_alloc(), node, 1);
         throw;
     }
     return node;
 }
 
 // 复制节点
-template <class T, class Compare>
-typename rb_tree<T, Compare>::node_ptr
-rb_tree<T, Compare>::clone_node(base_ptr x) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::node_ptr
+rb_tree<T, Compare, Alloc>::clone_node(base_ptr x) {
     node_ptr tmp = create_node(x->get_node_ptr()->value);
     tmp->color = x->color;
     tmp->left = nullptr;
@@ -1188,16 +1217,30 @@ rb_tree<T, Compare>::clone_node(base_ptr x) {
 }
 
 // 销毁节点
-template <class T, class Compare>
-void rb_tree<T, Compare>::destory_node(node_ptr p) {
-    data_allocator::destroy(&p->value);
-    node_allocator::deallocate(p);
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::destory_node(node_ptr p) {
+    node_alloc_traits::destroy(get_alloc(), &p->value);
+    node_alloc_traits::deallocate(get_alloc(), p, 1);
+}
+
+// header 只有 rb_tree_node_base 大小，使用重新绑定的分配器申请和释放
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::base_ptr
+rb_tree<T, Compare, Alloc>::create_base_node() {
+    base_allocator alloc(get_alloc());
+    return base_alloc_traits::allocate(alloc, 1);
+}
+
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::destroy_base_node(base_ptr p) {
+    base_allocator alloc(get_alloc());
+    base_alloc_traits::deallocate(alloc, p, 1);
 }
 
 // 初始化容器
-template <class T, class Compare>
-void rb_tree<T, Compare>::rb_tree_init() {
-    header_ = base_allocator::allocate(1);
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::rb_tree_init() {
+    header_ = create_base_node();
     header_->color = rb_tree_red; // header_与root_互为父节点，颜色区分
     root() = nullptr;
     leftmost() = header_;
@@ -1208,21 +1251,33 @@ void rb_tree<T, Compare>::rb_tree_init() {
 /**
  * @brief 重置rb_tree状态
  */
-template <class T, class Compare>
-void rb_tree<T, Compare>::reset() {
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::reset() {
     header_ = nullptr;
     node_count_ = 0;
     key_comp_ = key_compare();
 }
 
+// 复制 rhs 的所有节点，调用前当前树必须为空
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::copy_tree(const rb_tree& rhs) {
+    if (rhs.node_count_ != 0) {
+        root() = copy_from(rhs.root(), header_);
+        leftmost() = rb_tree_min(root());
+        rightmost() = rb_tree_max(root());
+    }
+    node_count_ = rhs.node_count_;
+    key_comp_ = rhs.key_comp_;
+}
+
 /**
  * @brief 寻找合适插入节点的位置，允许插入具有相同键的节点
  * @param key 新节点的键
  * @return pair<指向应该插入位置的父节点，插入在找到的位置的左边还是右边>
  */
-template <class T, class Compare>
-MySTL::pair<typename rb_tree<T, Compare>::base_ptr, bool>
-rb_tree<T, Compare>::get_insert_multi_pos(const key_type& key) {
+template <class T, class Compare, class Alloc>
+MySTL::pair<typename rb_tree<T, Compare, Alloc>::base_ptr, bool>
+rb_tree<T, Compare, Alloc>::get_insert_multi_pos(const key_type& key) {
     auto x = root();
     auto y = header_;
     bool add_to_left = true;
@@ -1239,9 +1294,9 @@ rb_tree<T, Compare>::get_insert_multi_pos(const key_type& key) {
  * @param key 要插入节点的键值
  * @return 返回一个 pair，第一个元素 pair<插入点的父节点，一个bool表示是否在左边插入>，第二个元素为是否插入成功
  */
-template <class T, class Compare>
-MySTL::pair<MySTL::pair<typename rb_tree<T, Compare>::base_ptr, bool>, bool>
-rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key) {
+template <class T, class Compare, class Alloc>
+MySTL::pair<MySTL::pair<typename rb_tree<T, Compare, Alloc>::base_ptr, bool>, bool>
+rb_tree<T, Compare, Alloc>::get_insert_unique_pos(const key_type& key) {
     auto x = root();
     auto y = header_;
     bool add_to_left = true;
@@ -1271,9 +1326,9 @@ rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key) {
  * @param add_to_left 是否在左边插入
  * @return iterator 插入的位置
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::insert_value_at(base_ptr x, const value_type& value, bool add_to_left) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::insert_value_at(base_ptr x, const value_type& value, bool add_to_left) {
     node_ptr node = create_node(value);
     node->parent = x;
     auto base_node = node->get_base_ptr();
@@ -1302,9 +1357,9 @@ rb_tree<T, Compare>::insert_value_at(base_ptr x, const value_type& value, bool a
  * @param node 要插入的节点
  * @param add_to_left 是否在左边插入
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::insert_node_at(base_ptr x, node_ptr node, bool add_to_left) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::insert_node_at(base_ptr x, node_ptr node, bool add_to_left) {
     node->parent = x;
     auto base_node = node->get_base_ptr();
     if (x == header_) { // 空树
@@ -1331,9 +1386,9 @@ rb_tree<T, Compare>::insert_node_at(base_ptr x, node_ptr node, bool add_to_left)
  * @param key 键值
  * @param node 要插入的节点
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::insert_multi_use_hint(iterator hint, key_type key, node_ptr node) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::insert_multi_use_hint(iterator hint, key_type key, node_ptr node) {
     // hint 附近寻找可插入位置
     auto np = hint.node;
     auto before = hint;
@@ -1357,9 +1412,9 @@ rb_tree<T, Compare>::insert_multi_use_hint(iterator hint, key_type key, node_ptr
  * @param key 键值
  * @param node 要插入的节点
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::insert_unique_use_hint(iterator hint, key_type key, node_ptr node) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::insert_unique_use_hint(iterator hint, key_type key, node_ptr node) {
     // hint 附近寻找可插入位置
     auto np = hint.node;
     auto before = hint;
@@ -1386,9 +1441,9 @@ rb_tree<T, Compare>::insert_unique_use_hint(iterator hint, key_type key, node_pt
  * @param x 要复制的节点
  * @param p 复制节点的父节点
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::base_ptr
-rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::base_ptr
+rb_tree<T, Compare, Alloc>::copy_from(base_ptr x, base_ptr p) {
     // init
     auto top = clone_node(x);
     top->parent = p;
@@ -1417,8 +1472,8 @@ rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p) {
  * @brief 递归删除整棵树，从节点 x 开始
  * @param x 要删除的节点(开始)
  */
-template <class T, class Compare>
-void rb_tree<T, Compare>::erase_since(base_ptr x) {
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::erase_since(base_ptr x) {
     while(x != nullptr) {
         erase_since(x->right);
         auto y = x->left;
@@ -1428,42 +1483,48 @@ void rb_tree<T, Compare>::erase_since(base_ptr x) {
 }
 
 // 比较操作符重载
-template <class T, class Compare>
-bool operator==(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator==(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs) {
     return lhs.size() == rhs.size() && MySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T, class Compare>
-bool operator!=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator!=(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class T, class Compare>
-bool operator<(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator<(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs) {
     return MySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class T, class Compare>
-bool operator>(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator>(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs) {
     return rhs < lhs;
 }
 
-template <class T, class Compare>
-bool operator<=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator<=(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class T, class Compare>
-bool operator>=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator>=(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
 // swap
-template <class T, class Compare>
-void swap(rb_tree<T, Compare>& lhs, rb_tree<T, Compare>& rhs) noexcept {
+template <class T, class Compare, class Alloc>
+void swap(rb_tree<T, Compare, Alloc>& lhs, rb_tree<T, Compare, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
+// rb_tree 的 header 结点在堆上分配，比较器和分配器可以按字节搬移时整体也可以
+template <class T, class Compare, class Alloc>
+struct is_trivially_relocatable<rb_tree<T, Compare, Alloc>>
+    : std::integral_constant<bool, is_trivially_relocatable<Compare>::value &&
+                                   is_trivially_relocatable<Alloc>::value> {};
+
 } /* namespace MySTL  */
 
 #endif // MY_RBTREE_H
\ No newline at end of file
@@ -9,7 +9,7 @@
 
 namespace MySTL {
 
-template <class Key, class Compare = MySTL::less<Key>>
+template <class Key, class Compare = MySTL::less<Key>, class Alloc = MySTL::allocator<Key>>
 class set {
 public:
     typedef Key     key_type;
@@ -19,7 +19,7 @@ public:
 
 private:
     // 简写
-    typedef MySTL::rb_tree<value_type, key_compare> base_type;
+    typedef MySTL::rb_tree<value_type, key_compare, Alloc> base_type;
 
     base_type tree_;
 
@@ -44,6 +44,8 @@ public:
     // 构造
     set() = default;
 
+    explicit set(const allocator_type& alloc) : tree_(key_compare(), alloc) {}
+
     template <class InputIterator>
     set(InputIterator first, InputIterator last) : tree_() { tree_.insert_unique(first, last); }
     set(std::initializer_list<value_type> ilist) : tree_() { tree_.insert_unique(ilist.begin(), ilist.end()); }
@@ -164,27 +166,27 @@ public:
 };
 
 // 重载比较操作符
-template <class Key, class Compare>
-bool operator==(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) { return lhs == rhs; }
+template <class Key, class Compare, class Alloc>
+bool operator==(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) { return lhs == rhs; }
 
-template <class Key, class Compare>
-bool operator<(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) { return lhs < rhs; }
+template <class Key, class Compare, class Alloc>
+bool operator<(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) { return lhs < rhs; }
 
-template <class Key, class Compare>
-bool operator!=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) { return !(lhs == rhs); }
+template <class Key, class Compare, class Alloc>
+bool operator!=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) { return !(lhs == rhs); }
 
-template <class Key, class Compare>
-bool operator>(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) { return rhs < lhs; }
+template <class Key, class Compare, class Alloc>
+bool operator>(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) { return rhs < lhs; }
 
-template <class Key, class Compare>
-bool operator<=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) { return !(rhs < lhs); }
+template <class Key, class Compare, class Alloc>
+bool operator<=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) { return !(rhs < lhs); }
 
-template <class Key, class Compare>
-bool operator>=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) { return !(lhs < rhs); }
+template <class Key, class Compare, class Alloc>
+bool operator>=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) { return !(lhs < rhs); }
 
 // 模板类 multiset
 // Compare 指定权重比较方式，默认使用less
-template <class Key, class Compare = MySTL::less<Key>>
+template <class Key, class Compare = MySTL::less<Key>, class Alloc = MySTL::allocator<Key>>
 class multiset {
 public:
     typedef Key     key_type;
@@ -194,7 +196,7 @@ public:
 
 private:
     // 简写
-    typedef MySTL::rb_tree<value_type, key_compare> base_type;
+    typedef MySTL::rb_tree<value_type, key_compare, Alloc> base_type;
 
     base_type tree_;
 
@@ -219,6 +221,8 @@ public:
     // 构造
     multiset() = default;
 
+    explicit multiset(const allocator_type& alloc) : tree_(key_compare(), alloc) {}
+
     template <class InputIterator>
     multiset(InputIterator first, InputIterator last) : tree_() { tree_.insert_multi(first, last); }
     multiset(std::initializer_list<value_type> ilist) : tree_() { tree_.insert_multi(ilist.begin(), ilist.end()); }
@@ -338,23 +342,34 @@ public:
 };
 
 // 重载比较操作符
-template <class Key, class Compare>
-bool operator==(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) { return lhs == rhs; }
+template <class Key, class Compare, class Alloc>
+bool operator==(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs) { return lhs == rhs; }
+
+template <class Key, class Compare, class Alloc>
+bool operator<(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs) { return lhs < rhs; }
+
+template <class Key, class Compare, class Alloc>
+bool operator!=(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs) { return !(lhs == rhs); }
 
-template <class Key, class Compare>
-bool operator<(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) { return lhs < rhs; }
+template <class Key, class Compare, class Alloc>
+bool operator>(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs) { return rhs < lhs; }
 
-template <class Key, class Compare>
-bool operator!=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) { return !(lhs == rhs); }
+template <class Key, class Compare, class Alloc>
+bool operator<=(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs) { return !(rhs < lhs); }
 
-template <class Key, class Compare>
-bool operator>(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) { return rhs < lhs; }
+template <class Key, class Compare, class Alloc>
+bool operator>=(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs) { return !(lhs < rhs); }
 
-template <class Key, class Compare>
-bool operator<=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) { return !(rhs < lhs); }
+// set / multiset 只包含一棵 rb_tree
+template <class Key, class Compare, class Alloc>
+struct is_trivially_relocatable<set<Key, Compare, Alloc>>
+    : std::integral_constant<bool, is_trivially_relocatable<Compare>::value &&
+                                   is_trivially_relocatable<Alloc>::value> {};
 
-template <class Key, class Compare>
-bool operator>=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) { return !(lhs < rhs); }
+template <class Key, class Compare, class Alloc>
+struct is_trivially_relocatable<multiset<Key, Compare, Alloc>>
+    : std::integral_constant<bool, is_trivially_relocatable<Compare>::value &&
+                                   is_trivially_relocatable<Alloc>::value> {};
 
 }  // namespace MySTL
 
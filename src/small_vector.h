@@ -0,0 +1,613 @@
+#ifndef MY_SMALL_VECTOR_H
+#define MY_SMALL_VECTOR_H
+
+// small_vector 容器实现
+// 对象内部预留 N 个元素的空间，元素不超过 N 个时不申请堆内存，超过后整体搬到堆上，
+// 接口与 vector 一致。适合保存大量通常只有几个元素的短序列
+// 注意：内联状态下 begin_ 指向对象自身，因此 small_vector 不可平凡重定位
+
+#include <initializer_list>
+#include <type_traits>
+
+#include "memory.h"
+#include "iterator.h"
+#include "uninitialize.h"
+#include "util.h"
+#include "exceptdef.h"
+#include "algo.h"
+
+namespace MySTL {
+
+template <class T, size_t N, class Alloc = MySTL::allocator<T>>
+class small_vector : private alloc_holder<Alloc> {
+    static_assert(N > 0, "small_vector<T, N> requires N > 0");
+
+public:
+    typedef Alloc                                       allocator_type;
+    typedef MySTL::allocator_traits<Alloc>              alloc_traits;
+
+    typedef typename alloc_traits::value_type           value_type;
+    typedef typename alloc_traits::pointer              pointer;
+    typedef typename alloc_traits::const_pointer        const_pointer;
+    typedef value_type&                                 reference;
+    typedef const value_type&                           const_reference;
+    typedef typename alloc_traits::size_type            size_type;
+    typedef typename alloc_traits::difference_type      difference_type;
+
+    typedef value_type*                                 iterator;
+    typedef const value_type*                           const_iterator;
+    typedef MySTL::reverse_iterator<iterator>           reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator>     const_reverse_iterator;
+
+    static constexpr size_type inline_capacity = N;
+
+    allocator_type get_allocator() const { return get_alloc(); }
+
+private:
+    typedef alloc_holder<Alloc>                         alloc_base;
+    using alloc_base::get_alloc;
+
+    iterator begin_;
+    iterator end_;
+    iterator cap_;
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type inline_;
+
+public:
+    /*********************************** 构造，复制，移动，析构 ***********************************/
+
+    small_vector() noexcept { init_inline(); }
+
+    explicit small_vector(const allocator_type& alloc) noexcept : alloc_base(alloc) { init_inline(); }
+
+    explicit small_vector(size_type n, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc) {
+        init_inline();
+        fill_insert(end_, n, value_type());
+    }
+
+    small_vector(size_type n, const value_type& value, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc) {
+        init_inline();
+        fill_insert(end_, n, value);
+    }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    small_vector(Iter first, Iter last, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc) {
+        init_inline();
+        copy_insert(end_, first, last, iterator_category(first));
+    }
+
+    small_vector(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc) {
+        init_inline();
+        copy_insert(end_, ilist.begin(), ilist.end(), MySTL::forward_iterator_tag{});
+    }
+
+    small_vector(const small_vector& rhs) :
+        alloc_base(alloc_traits::select_on_container_copy_construction(rhs.get_alloc())) {
+        init_inline();
+        copy_insert(end_, rhs.begin_, rhs.end_, MySTL::forward_iterator_tag{});
+    }
+
+    // 移动：rhs 在堆上时直接接管其空间，在内联空间时只能逐个移动元素
+    small_vector(small_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value) :
+        alloc_base(MySTL::move(rhs.get_alloc())) {
+        init_inline();
+        take(rhs, !rhs.is_inline());
+    }
+
+    small_vector& operator=(const small_vector& rhs) {
+        if (this != &rhs) {
+            if (alloc_traits::propagate_on_container_copy_assignment::value &&
+                !MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+                // 分配器将被替换，旧的堆空间必须先由旧分配器释放
+                clear();
+                release_heap();
+                MySTL::alloc_on_copy(get_alloc(), rhs.get_alloc());
+            }
+            assign(rhs.begin_, rhs.end_);
+        }
+        return *this;
+    }
+
+    // rhs 在堆上且分配器相等(或随移动传播)时接管其空间，否则逐个移动元素
+    // 分配器既不传播也不总是相等时，逐个移动可能要申请堆空间
+    small_vector& operator=(small_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value &&
+                                                         (alloc_traits::propagate_on_container_move_assignment::value ||
+                                                          alloc_traits::is_always_equal::value)) {
+        if (this == &rhs) return *this;
+        clear();
+        if (alloc_traits::propagate_on_container_move_assignment::value) {
+            release_heap();
+            MySTL::alloc_on_move(get_alloc(), rhs.get_alloc());
+        }
+        const bool steal = !rhs.is_inline() && MySTL::alloc_equal(get_alloc(), rhs.get_alloc());
+        if (steal)
+            release_heap();
+        take(rhs, steal);
+        return *this;
+    }
+
+    small_vector& operator=(std::initializer_list<value_type> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~small_vector() {
+        alloc_traits::destroy(get_alloc(), begin_, end_);
+        release_heap();
+    }
+
+public:
+    /*********************************** 迭代器相关操作 ***********************************/
+
+    iterator               begin() noexcept { return begin_; }
+    const_iterator         begin() const noexcept { return begin_; }
+    iterator               end() noexcept { return end_; }
+    const_iterator         end() const noexcept { return end_; }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin() const noexcept { return begin(); }
+    const_iterator         cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    /*********************************** 容器相关操作 ***********************************/
+
+    bool      empty() const noexcept { return begin_ == end_; }
+    size_type size() const noexcept { return static_cast<size_type>(end_ - begin_); }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(T); }
+    size_type capacity() const noexcept { return static_cast<size_type>(cap_ - begin_); }
+
+    // 元素是否保存在对象内部
+    bool is_inline() const noexcept { return begin_ == inline_data(); }
+
+    void reserve(size_type n) {
+        if (capacity() < n) {
+            THROW_LENGTH_ERROR_IF(n > max_size(), "n can not bigger than max_size()"
+                                                  "in small_vector<T, N>::reserve(n)");
+            grow_to(n);
+        }
+    }
+
+    // 元素个数不超过 N 时搬回内联空间
+    void shrink_to_fit();
+
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size());
+        return *(begin_ + n);
+    }
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size());
+        return *(begin_ + n);
+    }
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "small_vector<T, N> : out of range");
+        return (*this)[n];
+    }
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "small_vector<T, N> : out of range");
+        return (*this)[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return *begin_;
+    }
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return *begin_;
+    }
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return *(end_ - 1);
+    }
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return *(end_ - 1);
+    }
+
+    pointer       data() noexcept { return begin_; }
+    const_pointer data() const noexcept { return begin_; }
+
+    /*********************************** 修改容器相关操作 ***********************************/
+
+    void assign(size_type n, const value_type& value) {
+        clear();
+        fill_insert(end_, n, value);
+    }
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    void assign(Iter first, Iter last) {
+        clear();
+        copy_insert(end_, first, last, iterator_category(first));
+    }
+    void assign(std::initializer_list<value_type> il) { assign(il.begin(), il.end()); }
+
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+
+    template <class... Args>
+    void emplace_back(Args&&... args) {
+        if (end_ < cap_) {
+            alloc_traits::construct(get_alloc(), end_, MySTL::forward<Args>(args)...);
+            ++end_;
+        } else {
+            reallocate_emplace(end_, MySTL::forward<Args>(args)...);
+        }
+    }
+
+    void push_back(const value_type& value) { emplace_back(value); }
+    void push_back(value_type&& value) { emplace_back(MySTL::move(value)); }
+
+    void pop_back() {
+        MYSTL_DEBUG(!empty());
+        --end_;
+        alloc_traits::destroy(get_alloc(), end_);
+    }
+
+    iterator insert(const_iterator pos, const value_type& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, value_type&& value) { return emplace(pos, MySTL::move(value)); }
+
+    iterator insert(const_iterator pos, size_type n, const value_type& value) {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        return fill_insert(const_cast<iterator>(pos), n, value);
+    }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    iterator insert(const_iterator pos, Iter first, Iter last) {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        return copy_insert(const_cast<iterator>(pos), first, last, iterator_category(first));
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<value_type> il) {
+        return insert(pos, il.begin(), il.end());
+    }
+
+    iterator erase(const_iterator pos) {
+        MYSTL_DEBUG(pos < end() && pos >= begin());
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+        iterator r = begin_ + (first - begin_);
+        iterator new_end = MySTL::move(r + (last - first), end_, r);
+        alloc_traits::destroy(get_alloc(), new_end, end_);
+        end_ = new_end;
+        return r;
+    }
+
+    void clear() noexcept {
+        alloc_traits::destroy(get_alloc(), begin_, end_);
+        end_ = begin_;
+    }
+
+    void resize(size_type new_size) { resize(new_size, value_type()); }
+    void resize(size_type new_size, const value_type& value) {
+        if (new_size < size())
+            erase(begin_ + new_size, end_);
+        else
+            fill_insert(end_, new_size - size(), value);
+    }
+
+    void swap(small_vector& rhs);
+
+private:
+    /*********************************** helper function ***********************************/
+
+    pointer       inline_data() noexcept { return reinterpret_cast<pointer>(&inline_); }
+    const_pointer inline_data() const noexcept { return reinterpret_cast<const_pointer>(&inline_); }
+
+    void init_inline() noexcept {
+        begin_ = end_ = inline_data();
+        cap_ = begin_ + N;
+    }
+
+    // 释放堆空间(元素已经析构或搬走)，回到空的内联状态
+    void release_heap() noexcept {
+        if (!is_inline())
+            alloc_traits::deallocate(get_alloc(), begin_, capacity());
+        init_inline();
+    }
+
+    // 接管 rhs 的元素，调用前 *this 必须为空
+    // steal 为 true 时直接接管 rhs 的堆空间(此时 *this 必须处于内联状态)，否则逐个移动元素
+    void take(small_vector& rhs, bool steal);
+
+    size_type get_new_cap(size_type add_size) const {
+        const size_type old_cap = capacity();
+        THROW_LENGTH_ERROR_IF(size() + add_size > max_size(), "small_vector<T, N>'s size too big");
+        return MySTL::max(old_cap + old_cap / 2, size() + add_size);
+    }
+
+    // 把元素搬到容量为 new_cap 的新堆空间，[begin_, end_) 保持原有偏移
+    void grow_to(size_type new_cap);
+
+    // 把 [begin_, pos) 搬到 new_begin 处，[pos, end_) 搬到 new_after 处，返回新的尾后位置
+    // 失败时旧元素保持不变，已搬到新空间的元素被析构
+    iterator relocate_around(iterator pos, iterator new_begin, iterator new_after);
+    iterator relocate_around(iterator pos, iterator new_begin, iterator new_after, std::true_type);
+    iterator relocate_around(iterator pos, iterator new_begin, iterator new_after, std::false_type);
+
+    // 申请新空间，先由 fill(new_pos) 构造中间的 n 个新元素，再把旧元素搬到两侧
+    template <class Fill>
+    iterator reallocate_with(iterator pos, size_type n, Fill fill);
+
+    template <class... Args>
+    void reallocate_emplace(iterator pos, Args&&... args);
+
+    iterator fill_insert(iterator pos, size_type n, const value_type& value);
+
+    template <class Iter>
+    iterator copy_insert(iterator pos, Iter first, Iter last, input_iterator_tag);
+    template <class Iter>
+    iterator copy_insert(iterator pos, Iter first, Iter last, forward_iterator_tag);
+};
+
+template <class T, size_t N, class Alloc>
+constexpr typename small_vector<T, N, Alloc>::size_type small_vector<T, N, Alloc>::inline_capacity;
+
+/*********************************** 容器操作 ***********************************/
+
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::shrink_to_fit() {
+    if (is_inline() || end_ == cap_) return;
+    if (size() <= N) {
+        const auto old_begin = begin_;
+        const auto old_end = end_;
+        const auto old_cap = capacity();
+        end_ = MySTL::uninitialized_relocate(old_begin, old_end, inline_data());
+        begin_ = inline_data();
+        cap_ = begin_ + N;
+        alloc_traits::deallocate(get_alloc(), old_begin, old_cap);
+    } else {
+        grow_to(size());
+    }
+}
+
+template <class T, size_t N, class Alloc>
+template <class... Args>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::emplace(const_iterator pos, Args&&... args) {
+    MYSTL_DEBUG(pos >= begin() && pos <= end());
+    iterator        xpos = const_cast<iterator>(pos);
+    const size_type n = xpos - begin_;
+    if (end_ == cap_) {
+        reallocate_emplace(xpos, MySTL::forward<Args>(args)...);
+    } else if (xpos == end_) {
+        alloc_traits::construct(get_alloc(), end_, MySTL::forward<Args>(args)...);
+        ++end_;
+    } else {
+        // args 可能引用容器中的元素，先构造好再移动元素
+        value_type tmp(MySTL::forward<Args>(args)...);
+        alloc_traits::construct(get_alloc(), end_, MySTL::move(*(end_ - 1)));
+        ++end_;
+        MySTL::move_backward(xpos, end_ - 2, end_ - 1);
+        *xpos = MySTL::move(tmp);
+    }
+    return begin_ + n;
+}
+
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::swap(small_vector& rhs) {
+    if (this == &rhs) return;
+    if (!is_inline() && !rhs.is_inline()) {
+        MySTL::alloc_on_swap(get_alloc(), rhs.get_alloc());
+        MySTL::swap(begin_, rhs.begin_);
+        MySTL::swap(end_, rhs.end_);
+        MySTL::swap(cap_, rhs.cap_);
+        return;
+    }
+    // 至少一方在内联空间，借助临时对象逐个移动
+    small_vector tmp(MySTL::move(rhs));
+    rhs = MySTL::move(*this);
+    *this = MySTL::move(tmp);
+}
+
+/*********************************** helper function ***********************************/
+
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::take(small_vector& rhs, bool steal) {
+    if (steal) {
+        begin_ = rhs.begin_;
+        end_ = rhs.end_;
+        cap_ = rhs.cap_;
+        rhs.init_inline();
+        return;
+    }
+    reserve(rhs.size());
+    end_ = MySTL::uninitialized_move(rhs.begin_, rhs.end_, begin_);
+    rhs.clear();
+}
+
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::relocate_around(iterator pos, iterator new_begin, iterator new_after) {
+    return relocate_around(pos, new_begin, new_after,
+                           std::integral_constant<bool, MySTL::is_trivially_relocatable<T>::value>{});
+}
+
+// 可平凡重定位：按字节复制，不会失败
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::relocate_around(iterator pos, iterator new_begin, iterator new_after, std::true_type) {
+    MySTL::uninitialized_relocate(begin_, pos, new_begin);
+    return MySTL::uninitialized_relocate(pos, end_, new_after);
+}
+
+// 逐个移动构造，全部成功后才析构旧元素
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::relocate_around(iterator pos, iterator new_begin, iterator new_after, std::false_type) {
+    auto new_pos = MySTL::uninitialized_move(begin_, pos, new_begin);
+    iterator new_end;
+    try {
+        new_end = MySTL::uninitialized_move(pos, end_, new_after);
+    } catch (...) {
+        alloc_traits::destroy(get_alloc(), new_begin, new_pos);
+        throw;
+    }
+    alloc_traits::destroy(get_alloc(), begin_, end_);
+    return new_end;
+}
+
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::grow_to(size_type new_cap) {
+    auto new_begin = alloc_traits::allocate(get_alloc(), new_cap);
+    iterator new_end;
+    try {
+        new_end = relocate_around(end_, new_begin, new_begin + size());
+    } catch (...) {
+        alloc_traits::deallocate(get_alloc(), new_begin, new_cap);
+        throw;
+    }
+    release_heap();
+    begin_ = new_begin;
+    end_ = new_end;
+    cap_ = new_begin + new_cap;
+}
+
+template <class T, size_t N, class Alloc>
+template <class Fill>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::reallocate_with(iterator pos, size_type n, Fill fill) {
+    const auto new_cap = get_new_cap(n);
+    auto       new_begin = alloc_traits::allocate(get_alloc(), new_cap);
+    auto       new_pos = new_begin + (pos - begin_);
+    try {
+        fill(new_pos);
+    } catch (...) {
+        alloc_traits::deallocate(get_alloc(), new_begin, new_cap);
+        throw;
+    }
+    iterator new_end;
+    try {
+        new_end = relocate_around(pos, new_begin, new_pos + n);
+    } catch (...) {
+        alloc_traits::destroy(get_alloc(), new_pos, new_pos + n);
+        alloc_traits::deallocate(get_alloc(), new_begin, new_cap);
+        throw;
+    }
+    release_heap();
+    begin_ = new_begin;
+    end_ = new_end;
+    cap_ = new_begin + new_cap;
+    return new_pos;
+}
+
+template <class T, size_t N, class Alloc>
+template <class... Args>
+void small_vector<T, N, Alloc>::reallocate_emplace(iterator pos, Args&&... args) {
+    // 先在新空间构造新元素：args 可能引用旧空间中的元素
+    reallocate_with(pos, 1, [&](iterator p) {
+        alloc_traits::construct(get_alloc(), p, MySTL::forward<Args>(args)...);
+    });
+}
+
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::fill_insert(iterator pos, size_type n, const value_type& value) {
+    if (n == 0)
+        return pos;
+    if (static_cast<size_type>(cap_ - end_) < n) {
+        return reallocate_with(pos, n, [&](iterator p) { MySTL::uninitialized_fill_n(p, n, value); });
+    }
+    const value_type value_copy = value;
+    const size_type  after_elems = end_ - pos;
+    auto             old_end = end_;
+    if (after_elems > n) {
+        end_ = MySTL::uninitialized_move(end_ - n, end_, end_);
+        MySTL::move_backward(pos, old_end - n, old_end);
+        MySTL::fill_n(pos, n, value_copy);
+    } else {
+        end_ = MySTL::uninitialized_fill_n(end_, n - after_elems, value_copy);
+        end_ = MySTL::uninitialized_move(pos, old_end, end_);
+        MySTL::fill(pos, old_end, value_copy);
+    }
+    return pos;
+}
+
+// 单趟输入迭代器：先追加到尾部，再旋转到 pos 处
+template <class T, size_t N, class Alloc>
+template <class Iter>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::copy_insert(iterator pos, Iter first, Iter last, input_iterator_tag) {
+    const size_type n = pos - begin_;
+    const size_type old_size = size();
+    for (; first != last; ++first)
+        emplace_back(*first);
+    MySTL::rotate(begin_ + n, begin_ + old_size, end_);
+    return begin_ + n;
+}
+
+template <class T, size_t N, class Alloc>
+template <class Iter>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::copy_insert(iterator pos, Iter first, Iter last, forward_iterator_tag) {
+    const size_type n = MySTL::distance(first, last);
+    if (n == 0)
+        return pos;
+    if (static_cast<size_type>(cap_ - end_) < n) {
+        return reallocate_with(pos, n, [&](iterator p) { MySTL::uninitialized_copy(first, last, p); });
+    }
+    const size_type after_elems = end_ - pos;
+    auto            old_end = end_;
+    if (after_elems > n) {
+        end_ = MySTL::uninitialized_move(end_ - n, end_, end_);
+        MySTL::move_backward(pos, old_end - n, old_end);
+        MySTL::copy(first, last, pos);
+    } else {
+        auto mid = first;
+        MySTL::advance(mid, after_elems);
+        end_ = MySTL::uninitialized_copy(mid, last, end_);
+        end_ = MySTL::uninitialized_move(pos, old_end, end_);
+        MySTL::copy(first, mid, pos);
+    }
+    return pos;
+}
+
+/*********************************** 重载比较运算 ***********************************/
+
+template <class T, size_t N, class Alloc>
+bool operator==(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return lhs.size() == rhs.size() && MySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, size_t N, class Alloc>
+bool operator!=(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, size_t N, class Alloc>
+bool operator<(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return MySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, size_t N, class Alloc>
+bool operator>(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, size_t N, class Alloc>
+bool operator<=(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, size_t N, class Alloc>
+bool operator>=(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+template <class T, size_t N, class Alloc>
+void swap(small_vector<T, N, Alloc>& lhs, small_vector<T, N, Alloc>& rhs) {
+    lhs.swap(rhs);
+}
+
+}  // namespace MySTL
+
+#endif /* MY_SMALL_VECTOR_H */
@@ -0,0 +1,257 @@
+#ifndef MYSTL_SPSC_QUEUE_H
+#define MYSTL_SPSC_QUEUE_H
+
+// 有界的单生产者单消费者无锁环形队列 spsc_queue
+// 恰好一个线程调用生产者一侧的接口(push / emplace / try_push / push_n)，
+// 恰好一个线程调用消费者一侧的接口(front / pop / try_pop / pop_n / clear)，两侧之间不需要加锁
+// 容量向上取整为 2 的幂，head / tail 单调递增，下标用 & mask 取得，满与空不需要额外的标志位
+// 生产者独占 tail 与对 head 的本地缓存，消费者独占 head 与对 tail 的本地缓存，两组之间用一个 cache line 的填充隔开；
+// 缓存的值足够判断有空位 / 有元素时不读取对方的原子变量，对方的 cache line 不会在两个核之间来回传递
+// 接口与 queue 相似，另有 try_ 系列的非阻塞版本与批量的 push_n / pop_n，批量操作只发布一次下标
+
+#include <atomic>
+#include <thread>
+#include <type_traits>
+
+#include "algobase.h"
+#include "aligned_allocator.h"
+#include "exceptdef.h"
+#include "memory.h"
+#include "myallocator.h"
+#include "util.h"
+
+namespace MySTL {
+
+// 模板类 spsc_queue
+// 模板参数 T 代表数据类型，Alloc 代表分配器类型
+template <class T, class Alloc = MySTL::allocator<T>>
+class spsc_queue : private alloc_holder<Alloc> {
+public:
+    typedef Alloc                          allocator_type;
+    typedef MySTL::allocator_traits<Alloc> alloc_traits;
+
+    typedef T         value_type;
+    typedef T*        pointer;
+    typedef T&        reference;
+    typedef const T&  const_reference;
+    typedef size_t    size_type;
+
+    allocator_type get_allocator() const { return get_alloc(); }
+
+private:
+    typedef alloc_holder<Alloc> alloc_base;
+    using alloc_base::get_alloc;
+
+    typedef std::atomic<size_type> index_type;
+
+    // C++11 的 new 不保证超过 16 字节的对齐，不用 alignas；
+    // 每组成员之后空出整整一个 cache line，无论对象放在什么地址，一个 cache line 都不会同时含有两组成员
+
+    // 构造后只读，两侧共享
+    pointer   buf_;
+    size_type mask_;
+    char      pad0_[CACHELINE_ALIGN];
+
+    // 生产者一侧
+    index_type tail_;        // 下一个写入位置
+    size_type  head_cache_;  // 上一次读到的 head_
+    char       pad1_[CACHELINE_ALIGN];
+
+    // 消费者一侧，之后的填充使紧随其后的其他数据也不会与它共用 cache line
+    index_type head_;        // 下一个读取位置
+    size_type  tail_cache_;  // 上一次读到的 tail_
+    char       pad2_[CACHELINE_ALIGN];
+
+public:
+    /*********************************** 构造，析构 ***********************************/
+
+    // 容量至少为 2，向上取整为 2 的幂
+    explicit spsc_queue(size_type n, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc), buf_(nullptr), mask_(0), tail_(0), head_cache_(0), head_(0), tail_cache_(0) {
+        THROW_LENGTH_ERROR_IF(n > (static_cast<size_type>(-1) / sizeof(T) >> 1) + 1, "spsc_queue<T>'s size too big");
+        size_type cap = 2;
+        while (cap < n)
+            cap <<= 1;
+        buf_ = alloc_traits::allocate(get_alloc(), cap);
+        mask_ = cap - 1;
+    }
+
+    // 原子下标与两侧的缓存不能被复制或移动
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    ~spsc_queue() {
+        clear();
+        alloc_traits::deallocate(get_alloc(), buf_, mask_ + 1);
+    }
+
+    /*********************************** 容量相关操作 ***********************************/
+
+    // 两侧并发修改时 empty / size 只是某一时刻的近似值
+    bool empty() const noexcept {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    // 先读 head_ 再读 tail_，tail_ 单调递增，差值不会为负
+    size_type size() const noexcept {
+        const size_type h = head_.load(std::memory_order_acquire);
+        const size_type t = tail_.load(std::memory_order_acquire);
+        return t - h < capacity() ? t - h : capacity();
+    }
+
+    size_type capacity() const noexcept { return mask_ + 1; }
+
+    /*********************************** 生产者一侧 ***********************************/
+
+    // 队列已满时返回 false，不构造元素
+    template <class... Args>
+    bool try_emplace(Args&&... args) {
+        const size_type t = tail_.load(std::memory_order_relaxed);
+        if (!has_room(t, 1))
+            return false;
+        alloc_traits::construct(get_alloc(), buf_ + (t & mask_), MySTL::forward<Args>(args)...);
+        tail_.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const value_type& value) { return try_emplace(value); }
+    bool try_push(value_type&& value) { return try_emplace(MySTL::move(value)); }
+
+    // 队列已满时让出时间片等待消费者
+    template <class... Args>
+    void emplace(Args&&... args) {
+        const size_type t = tail_.load(std::memory_order_relaxed);
+        while (!has_room(t, 1))
+            std::this_thread::yield();
+        alloc_traits::construct(get_alloc(), buf_ + (t & mask_), MySTL::forward<Args>(args)...);
+        tail_.store(t + 1, std::memory_order_release);
+    }
+
+    void push(const value_type& value) { emplace(value); }
+    void push(value_type&& value) { emplace(MySTL::move(value)); }
+
+    // 从 first 开始复制至多 n 个元素入队，返回实际入队的个数；全部写完后才发布一次 tail_
+    template <class InputIter>
+    size_type push_n(InputIter first, size_type n);
+
+    /*********************************** 消费者一侧 ***********************************/
+
+    // 队首元素，队列不能为空
+    reference front() {
+        const size_type h = head_.load(std::memory_order_relaxed);
+        MYSTL_DEBUG(has_item(h, 1));
+        return buf_[h & mask_];
+    }
+
+    // 弹出队首元素，队列不能为空
+    void pop() {
+        const size_type h = head_.load(std::memory_order_relaxed);
+        MYSTL_DEBUG(has_item(h, 1));
+        alloc_traits::destroy(get_alloc(), buf_ + (h & mask_));
+        head_.store(h + 1, std::memory_order_release);
+    }
+
+    // 队列为空时返回 false；否则把队首元素移动到 value 中并弹出
+    bool try_pop(value_type& value) {
+        const size_type h = head_.load(std::memory_order_relaxed);
+        if (!has_item(h, 1))
+            return false;
+        pointer p = buf_ + (h & mask_);
+        value = MySTL::move(*p);
+        alloc_traits::destroy(get_alloc(), p);
+        head_.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 把至多 n 个元素依次移动到 result 开始的位置，返回实际出队的个数；全部取完后才发布一次 head_
+    template <class OutputIter>
+    size_type pop_n(OutputIter result, size_type n);
+
+    // 弹出当前所有元素
+    void clear() noexcept;
+
+private:
+    /*********************************** helper functions ***********************************/
+
+    // 生产者在 tail 处是否还有 n 个空位，本地缓存不够时才重新读取 head_
+    bool has_room(size_type t, size_type n) {
+        if (capacity() - (t - head_cache_) >= n)
+            return true;
+        head_cache_ = head_.load(std::memory_order_acquire);
+        return capacity() - (t - head_cache_) >= n;
+    }
+
+    // 消费者在 head 处是否已有 n 个元素，本地缓存不够时才重新读取 tail_
+    bool has_item(size_type h, size_type n) {
+        if (tail_cache_ - h >= n)
+            return true;
+        tail_cache_ = tail_.load(std::memory_order_acquire);
+        return tail_cache_ - h >= n;
+    }
+
+    // 生产者可用的空位数 / 消费者可取的元素数，已缓存的数量不足 want 时刷新一次缓存
+    size_type room(size_type t, size_type want) {
+        has_room(t, want);
+        return capacity() - (t - head_cache_);
+    }
+
+    size_type items(size_type h, size_type want) {
+        has_item(h, want);
+        return tail_cache_ - h;
+    }
+};
+
+/*****************************************************************************************/
+
+// 构造中途抛出异常时，已构造的元素照常发布
+template <class T, class Alloc>
+template <class InputIter>
+typename spsc_queue<T, Alloc>::size_type spsc_queue<T, Alloc>::push_n(InputIter first, size_type n) {
+    const size_type t = tail_.load(std::memory_order_relaxed);
+    const size_type m = MySTL::min(n, room(t, n));
+    size_type       i = 0;
+    try {
+        for (; i < m; ++i, ++first)
+            alloc_traits::construct(get_alloc(), buf_ + ((t + i) & mask_), *first);
+    } catch (...) {
+        tail_.store(t + i, std::memory_order_release);
+        throw;
+    }
+    tail_.store(t + m, std::memory_order_release);
+    return m;
+}
+
+// 赋值中途抛出异常时，已取出的元素照常出队，其余元素留在队列中
+template <class T, class Alloc>
+template <class OutputIter>
+typename spsc_queue<T, Alloc>::size_type spsc_queue<T, Alloc>::pop_n(OutputIter result, size_type n) {
+    const size_type h = head_.load(std::memory_order_relaxed);
+    const size_type m = MySTL::min(n, items(h, n));
+    size_type       i = 0;
+    try {
+        for (; i < m; ++i, ++result) {
+            pointer p = buf_ + ((h + i) & mask_);
+            *result = MySTL::move(*p);
+            alloc_traits::destroy(get_alloc(), p);
+        }
+    } catch (...) {
+        head_.store(h + i, std::memory_order_release);
+        throw;
+    }
+    head_.store(h + m, std::memory_order_release);
+    return m;
+}
+
+template <class T, class Alloc>
+void spsc_queue<T, Alloc>::clear() noexcept {
+    const size_type h = head_.load(std::memory_order_relaxed);
+    const size_type t = tail_.load(std::memory_order_acquire);
+    for (size_type i = h; i != t; ++i)
+        alloc_traits::destroy(get_alloc(), buf_ + (i & mask_));
+    tail_cache_ = t;
+    head_.store(t, std::memory_order_release);
+}
+
+} // namespace MySTL
+
+#endif /* MYSTL_SPSC_QUEUE_H */
@@ -0,0 +1,610 @@
+#ifndef MY_STABLE_VECTOR_H
+#define MY_STABLE_VECTOR_H
+
+// stable_vector 容器实现
+// 元素分段保存在按几何级数增长的块中：第 0 块 B 个元素，第 k 块 B << k 个元素(B 为 2 的幂)，
+// 下标为 i 的元素位于第 floor(log2(i + B)) - log2(B) 块，块号和块内偏移都由位运算得到，随机访问为 O(1)
+// 扩容时只申请新块，已有元素从不移动，因此 push_back 没有整体搬移带来的延迟尖峰，元素的引用和指针也始终有效
+// 块指针保存在对象内部的定长数组中，迭代器引用该数组，因此移动或交换容器后迭代器失效，元素的引用仍然有效
+
+#include <initializer_list>
+#include <type_traits>
+
+#include "memory.h"
+#include "iterator.h"
+#include "uninitialize.h"
+#include "util.h"
+#include "exceptdef.h"
+#include "algo.h"
+
+namespace MySTL {
+
+#ifndef STABLE_VECTOR_FIRST_LOG2
+#define STABLE_VECTOR_FIRST_LOG2 4
+#endif
+
+// 分块规则，B = 1 << STABLE_VECTOR_FIRST_LOG2
+struct stable_vector_layout {
+    enum { FIRST_LOG2 = STABLE_VECTOR_FIRST_LOG2, MAX_BLOCKS = sizeof(size_t) * 8 - STABLE_VECTOR_FIRST_LOG2 };
+
+    // floor(log2(n))，n > 0
+    static size_t log2(size_t n) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return sizeof(unsigned long long) * 8 - 1 - static_cast<size_t>(__builtin_clzll(n));
+#else
+        size_t r = 0;
+        while (n >>= 1)
+            ++r;
+        return r;
+#endif
+    }
+
+    // 下标 i 所在的块
+    static size_t block_of(size_t i) noexcept { return log2(i + (size_t(1) << FIRST_LOG2)) - FIRST_LOG2; }
+
+    // 第 k 块第一个元素的下标，也是前 k 块的总容量
+    static size_t block_start(size_t k) noexcept { return ((size_t(1) << k) - 1) << FIRST_LOG2; }
+
+    static size_t block_size(size_t k) noexcept { return size_t(1) << (k + FIRST_LOG2); }
+};
+
+// stable_vector 迭代器，index 为元素下标，[first, last) 为当前块
+template <class T, class Ref, class Ptr>
+struct stable_vector_iterator : public iterator<random_access_iterator_tag, T> {
+    typedef stable_vector_iterator<T, T&, T*>             iterator;
+    typedef stable_vector_iterator<T, const T&, const T*> const_iterator;
+    typedef stable_vector_iterator                        self;
+
+    typedef random_access_iterator_tag iterator_category;
+    typedef T                          value_type;
+    typedef Ptr                        pointer;
+    typedef Ref                        reference;
+    typedef size_t                     size_type;
+    typedef ptrdiff_t                  difference_type;
+    typedef T*                         value_pointer;
+    typedef T* const*                  block_pointer;
+
+    block_pointer blocks;
+    size_type     index;
+    value_pointer cur;
+    value_pointer first;
+    value_pointer last;
+
+    /*********************************** 构造，复制，移动，析构 ***********************************/
+
+    stable_vector_iterator() noexcept : blocks(nullptr), index(0), cur(nullptr), first(nullptr), last(nullptr) {}
+    stable_vector_iterator(block_pointer b, size_type i) : blocks(b) { set_index(i); }
+
+    stable_vector_iterator(const stable_vector_iterator&) = default;
+    stable_vector_iterator& operator=(const stable_vector_iterator&) = default;
+
+    // iterator 可以隐式转换为 const_iterator
+    template <class It, typename std::enable_if<std::is_same<It, iterator>::value &&
+                                                    std::is_same<self, const_iterator>::value, int>::type = 0>
+    stable_vector_iterator(const It& rhs) :
+        blocks(rhs.blocks), index(rhs.index), cur(rhs.cur), first(rhs.first), last(rhs.last) {}
+
+    /*********************************** auxiliary function ***********************************/
+
+    // 定位到下标 i，i 所在的块尚未分配时(只可能是 end())，cur 为空
+    void set_index(size_type i) {
+        const size_type k = stable_vector_layout::block_of(i);
+        index = i;
+        first = blocks[k];
+        if (first != nullptr) {
+            cur = first + (i - stable_vector_layout::block_start(k));
+            last = first + stable_vector_layout::block_size(k);
+        } else {
+            cur = nullptr;
+            last = nullptr;
+        }
+    }
+
+    /*********************************** 运算符重载 ***********************************/
+
+    reference operator*() const { return *cur; }
+    pointer   operator->() const { return cur; }
+
+    difference_type operator-(const self& x) const {
+        return static_cast<difference_type>(index) - static_cast<difference_type>(x.index);
+    }
+
+    self& operator++() {
+        ++index;
+        if (++cur == last)
+            set_index(index);
+        return *this;
+    }
+
+    self operator++(int) {
+        self temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    self& operator--() {
+        if (cur == first) {
+            set_index(index - 1);
+        } else {
+            --cur;
+            --index;
+        }
+        return *this;
+    }
+
+    self operator--(int) {
+        self temp = *this;
+        --*this;
+        return temp;
+    }
+
+    self& operator+=(difference_type n) {
+        const difference_type offset = n + (cur - first);
+        if (cur != nullptr && offset >= 0 && offset < last - first) {  // 仍在当前块
+            cur += n;
+            index += n;
+        } else {
+            set_index(index + n);
+        }
+        return *this;
+    }
+
+    self operator+(difference_type n) const {
+        self tmp = *this;
+        return tmp += n;
+    }
+
+    self& operator-=(difference_type n) { return *this += -n; }
+
+    self operator-(difference_type n) const {
+        self tmp = *this;
+        return tmp -= n;
+    }
+
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    // 比较运算符
+    bool operator==(const self& rhs) const { return index == rhs.index; }
+    bool operator<(const self& rhs) const { return index < rhs.index; }
+    bool operator!=(const self& rhs) const { return !(*this == rhs); }
+    bool operator>(const self& rhs) const { return rhs < *this; }
+    bool operator<=(const self& rhs) const { return !(rhs < *this); }
+    bool operator>=(const self& rhs) const { return !(*this < rhs); }
+};
+
+template <class T, class Ref, class Ptr>
+stable_vector_iterator<T, Ref, Ptr>
+operator+(ptrdiff_t n, const stable_vector_iterator<T, Ref, Ptr>& it) {
+    return it + n;
+}
+
+template <class T, class Alloc = MySTL::allocator<T>>
+class stable_vector : private alloc_holder<Alloc> {
+public:
+    typedef Alloc                                       allocator_type;
+    typedef MySTL::allocator_traits<Alloc>              alloc_traits;
+
+    typedef typename alloc_traits::value_type           value_type;
+    typedef T*                                          pointer;
+    typedef const T*                                    const_pointer;
+    typedef value_type&                                 reference;
+    typedef const value_type&                           const_reference;
+    typedef size_t                                      size_type;
+    typedef ptrdiff_t                                   difference_type;
+
+    typedef stable_vector_iterator<T, T&, T*>             iterator;
+    typedef stable_vector_iterator<T, const T&, const T*> const_iterator;
+    typedef MySTL::reverse_iterator<iterator>             reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator>       const_reverse_iterator;
+
+    allocator_type get_allocator() const { return get_alloc(); }
+
+private:
+    typedef alloc_holder<Alloc>                         alloc_base;
+    using alloc_base::get_alloc;
+
+    typedef stable_vector_layout                        layout;
+
+    T*        blocks_[layout::MAX_BLOCKS];  // 已分配的块总在前 nblocks_ 项，其余为空
+    size_type nblocks_;
+    size_type size_;
+    T*        tail_;      // 下一个 push_back 的位置
+    T*        tail_end_;  // tail_ 所在块的结尾，两者相等时需要切换到下一块
+
+public:
+    /*********************************** 构造，复制，移动，析构 ***********************************/
+
+    stable_vector() noexcept { empty_init(); }
+
+    explicit stable_vector(const allocator_type& alloc) noexcept : alloc_base(alloc) { empty_init(); }
+
+    explicit stable_vector(size_type n, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc) {
+        empty_init();
+        guarded([&] { resize(n); });
+    }
+
+    stable_vector(size_type n, const value_type& value, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc) {
+        empty_init();
+        guarded([&] { resize(n, value); });
+    }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    stable_vector(Iter first, Iter last, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc) {
+        empty_init();
+        guarded([&] { append_range(first, last); });
+    }
+
+    stable_vector(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc) {
+        empty_init();
+        guarded([&] { append_range(ilist.begin(), ilist.end()); });
+    }
+
+    stable_vector(const stable_vector& rhs) :
+        alloc_base(alloc_traits::select_on_container_copy_construction(rhs.get_alloc())) {
+        empty_init();
+        guarded([&] {
+            reserve(rhs.size_);
+            append_range(rhs.begin(), rhs.end());
+        });
+    }
+
+    // 移动：接管所有块
+    stable_vector(stable_vector&& rhs) noexcept :
+        alloc_base(MySTL::move(rhs.get_alloc())) {
+        take(rhs);
+    }
+
+    stable_vector& operator=(const stable_vector& rhs) {
+        if (this != &rhs) {
+            if (alloc_traits::propagate_on_container_copy_assignment::value &&
+                !MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+                // 分配器将被替换，旧的块必须先由旧分配器释放
+                destroy_and_recover();
+                MySTL::alloc_on_copy(get_alloc(), rhs.get_alloc());
+            }
+            assign(rhs.begin(), rhs.end());
+        }
+        return *this;
+    }
+
+    stable_vector& operator=(stable_vector&& rhs) {
+        if (this == &rhs) return *this;
+        if (alloc_traits::propagate_on_container_move_assignment::value ||
+            MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+            destroy_and_recover();
+            MySTL::alloc_on_move(get_alloc(), rhs.get_alloc());
+            take(rhs);
+        } else {
+            // 分配器不同，只能逐个移动元素
+            clear();
+            reserve(rhs.size_);
+            for (auto it = rhs.begin(); it != rhs.end(); ++it)
+                emplace_back(MySTL::move(*it));
+        }
+        return *this;
+    }
+
+    stable_vector& operator=(std::initializer_list<value_type> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~stable_vector() { destroy_and_recover(); }
+
+public:
+    /*********************************** 迭代器相关操作 ***********************************/
+
+    iterator               begin() noexcept { return iterator(blocks_, 0); }
+    const_iterator         begin() const noexcept { return const_iterator(blocks_, 0); }
+    iterator               end() noexcept { return iterator(blocks_, size_); }
+    const_iterator         end() const noexcept { return const_iterator(blocks_, size_); }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin() const noexcept { return begin(); }
+    const_iterator         cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    /*********************************** 容器相关操作 ***********************************/
+
+    bool      empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type max_size() const noexcept { return layout::block_start(layout::MAX_BLOCKS - 1); }
+    size_type capacity() const noexcept { return layout::block_start(nblocks_); }
+
+    // 申请新块直到容量不小于 n，已有元素不受影响
+    void reserve(size_type n) {
+        THROW_LENGTH_ERROR_IF(n > max_size(), "n can not bigger than max_size()"
+                                              "in stable_vector<T>::reserve(n)");
+        while (capacity() < n)
+            allocate_block();
+        set_tail();
+    }
+
+    // 释放不含元素的块
+    void shrink_to_fit();
+
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size());
+        return *locate(n);
+    }
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size());
+        return *locate(n);
+    }
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "stable_vector<T> : out of range");
+        return (*this)[n];
+    }
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "stable_vector<T> : out of range");
+        return (*this)[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return *blocks_[0];
+    }
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return *blocks_[0];
+    }
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return *locate(size_ - 1);
+    }
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return *locate(size_ - 1);
+    }
+
+    /*********************************** 修改容器相关操作 ***********************************/
+
+    void assign(size_type n, const value_type& value) {
+        clear();
+        resize(n, value);
+    }
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    void assign(Iter first, Iter last) {
+        clear();
+        append_range(first, last);
+    }
+    void assign(std::initializer_list<value_type> il) { assign(il.begin(), il.end()); }
+
+    template <class... Args>
+    void emplace_back(Args&&... args) {
+        if (tail_ == tail_end_) {
+            if (size_ == capacity())
+                allocate_block();
+            set_tail();
+        }
+        alloc_traits::construct(get_alloc(), tail_, MySTL::forward<Args>(args)...);
+        ++tail_;
+        ++size_;
+    }
+
+    void push_back(const value_type& value) { emplace_back(value); }
+    void push_back(value_type&& value) { emplace_back(MySTL::move(value)); }
+
+    void pop_back() {
+        MYSTL_DEBUG(!empty());
+        --size_;
+        set_tail();
+        alloc_traits::destroy(get_alloc(), tail_);
+    }
+
+    // 中间插入先在尾部构造，再旋转到 pos 处，pos 之后的元素后移一位
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        MYSTL_DEBUG(pos.index <= size_);
+        const size_type n = pos.index;
+        emplace_back(MySTL::forward<Args>(args)...);
+        MySTL::rotate(begin() + n, end() - 1, end());
+        return begin() + n;
+    }
+
+    iterator insert(const_iterator pos, const value_type& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, value_type&& value) { return emplace(pos, MySTL::move(value)); }
+
+    iterator erase(const_iterator pos) {
+        MYSTL_DEBUG(pos.index < size_);
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last);
+
+    void clear() noexcept { destroy_from(0); }
+
+    void resize(size_type new_size) { resize(new_size, value_type()); }
+    void resize(size_type new_size, const value_type& value);
+
+    void swap(stable_vector& rhs) noexcept;
+
+private:
+    /*********************************** helper function ***********************************/
+
+    void empty_init() noexcept {
+        for (size_type k = 0; k < layout::MAX_BLOCKS; ++k)
+            blocks_[k] = nullptr;
+        nblocks_ = 0;
+        size_ = 0;
+        tail_ = nullptr;
+        tail_end_ = nullptr;
+    }
+
+    // 构造函数中的操作失败时释放已申请的资源，析构函数不会被调用
+    template <class Fun>
+    void guarded(Fun fun) {
+        try {
+            fun();
+        } catch (...) {
+            destroy_and_recover();
+            throw;
+        }
+    }
+
+    void take(stable_vector& rhs) noexcept {
+        for (size_type k = 0; k < layout::MAX_BLOCKS; ++k)
+            blocks_[k] = rhs.blocks_[k];
+        nblocks_ = rhs.nblocks_;
+        size_ = rhs.size_;
+        tail_ = rhs.tail_;
+        tail_end_ = rhs.tail_end_;
+        rhs.empty_init();
+    }
+
+    T* locate(size_type i) const noexcept {
+        const size_type k = layout::block_of(i);
+        return blocks_[k] + (i - layout::block_start(k));
+    }
+
+    // 根据 size_ 重新确定 tail_，所在的块尚未分配时两者为空
+    void set_tail() noexcept {
+        const size_type k = layout::block_of(size_);
+        if (k < nblocks_) {
+            tail_ = blocks_[k] + (size_ - layout::block_start(k));
+            tail_end_ = blocks_[k] + layout::block_size(k);
+        } else {
+            tail_ = nullptr;
+            tail_end_ = nullptr;
+        }
+    }
+
+    void allocate_block() {
+        THROW_LENGTH_ERROR_IF(nblocks_ + 1 >= layout::MAX_BLOCKS, "stable_vector<T>'s size too big");
+        blocks_[nblocks_] = alloc_traits::allocate(get_alloc(), layout::block_size(nblocks_));
+        ++nblocks_;
+    }
+
+    // 析构下标不小于 n 的元素
+    void destroy_from(size_type n) noexcept {
+        if (n >= size_) return;
+        for (size_type k = layout::block_of(n); k < nblocks_; ++k) {
+            const size_type start = layout::block_start(k);
+            if (start >= size_) break;
+            const size_type from = n > start ? n - start : 0;
+            const size_type to = MySTL::min(size_ - start, layout::block_size(k));
+            alloc_traits::destroy(get_alloc(), blocks_[k] + from, blocks_[k] + to);
+        }
+        size_ = n;
+        set_tail();
+    }
+
+    void destroy_and_recover() noexcept {
+        destroy_from(0);
+        for (size_type k = 0; k < nblocks_; ++k) {
+            alloc_traits::deallocate(get_alloc(), blocks_[k], layout::block_size(k));
+            blocks_[k] = nullptr;
+        }
+        nblocks_ = 0;
+        tail_ = nullptr;
+        tail_end_ = nullptr;
+    }
+
+    template <class Iter>
+    void append_range(Iter first, Iter last) {
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+};
+
+/*********************************** 容器操作 ***********************************/
+
+template <class T, class Alloc>
+void stable_vector<T, Alloc>::shrink_to_fit() {
+    const size_type keep = size_ == 0 ? 0 : layout::block_of(size_ - 1) + 1;
+    while (nblocks_ > keep) {
+        --nblocks_;
+        alloc_traits::deallocate(get_alloc(), blocks_[nblocks_], layout::block_size(nblocks_));
+        blocks_[nblocks_] = nullptr;
+    }
+    set_tail();
+}
+
+template <class T, class Alloc>
+typename stable_vector<T, Alloc>::iterator
+stable_vector<T, Alloc>::erase(const_iterator first, const_iterator last) {
+    MYSTL_DEBUG(first.index <= last.index && last.index <= size_);
+    const size_type n = first.index;
+    iterator        pos = begin() + n;
+    iterator        new_end = MySTL::move(begin() + last.index, end(), pos);
+    destroy_from(new_end.index);
+    return begin() + n;
+}
+
+template <class T, class Alloc>
+void stable_vector<T, Alloc>::resize(size_type new_size, const value_type& value) {
+    if (new_size < size_) {
+        destroy_from(new_size);
+    } else {
+        reserve(new_size);
+        while (size_ < new_size)
+            emplace_back(value);
+    }
+}
+
+template <class T, class Alloc>
+void stable_vector<T, Alloc>::swap(stable_vector& rhs) noexcept {
+    if (this != &rhs) {
+        MySTL::alloc_on_swap(get_alloc(), rhs.get_alloc());
+        for (size_type k = 0; k < layout::MAX_BLOCKS; ++k)
+            MySTL::swap(blocks_[k], rhs.blocks_[k]);
+        MySTL::swap(nblocks_, rhs.nblocks_);
+        MySTL::swap(size_, rhs.size_);
+        MySTL::swap(tail_, rhs.tail_);
+        MySTL::swap(tail_end_, rhs.tail_end_);
+    }
+}
+
+/*********************************** 重载比较运算 ***********************************/
+
+template <class T, class Alloc>
+bool operator==(const stable_vector<T, Alloc>& lhs, const stable_vector<T, Alloc>& rhs) {
+    return lhs.size() == rhs.size() && MySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Alloc>
+bool operator!=(const stable_vector<T, Alloc>& lhs, const stable_vector<T, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, class Alloc>
+bool operator<(const stable_vector<T, Alloc>& lhs, const stable_vector<T, Alloc>& rhs) {
+    return MySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, class Alloc>
+bool operator>(const stable_vector<T, Alloc>& lhs, const stable_vector<T, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, class Alloc>
+bool operator<=(const stable_vector<T, Alloc>& lhs, const stable_vector<T, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, class Alloc>
+bool operator>=(const stable_vector<T, Alloc>& lhs, const stable_vector<T, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+template <class T, class Alloc>
+void swap(stable_vector<T, Alloc>& lhs, stable_vector<T, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// 元素都在堆上的块中，搬动容器对象只会使迭代器失效
+template <class T, class Alloc>
+struct is_trivially_relocatable<stable_vector<T, Alloc>> : is_trivially_relocatable<Alloc> {};
+
+}  // namespace MySTL
+
+#endif /* MY_STABLE_VECTOR_H */
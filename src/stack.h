@@ -11,6 +11,7 @@
 
 namespace MySTL {
 
+// 底层 deque 的缓冲区大小通过 Container 指定，如 stack<int, deque<int, allocator<int>, 1024>>
 template <class T, typename Container = MySTL::deque<T>>
 class stack {
 public:
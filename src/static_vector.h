@@ -0,0 +1,416 @@
+#ifndef MY_STATIC_VECTOR_H
+#define MY_STATIC_VECTOR_H
+
+// static_vector 容器实现
+// 容量在编译期确定为 N，元素连续保存在对象内部，任何操作都不会申请堆内存
+// T 可平凡复制时 static_vector 本身也可平凡复制
+// 超出容量时的行为由 OverflowPolicy 决定：
+//   static_vector_throw  : 抛出 std::length_error(默认)
+//   static_vector_assert : 只在调试版本中断言，发布版本中不检查
+// 另外提供 try_push_back / try_emplace_back，容量不足时返回 false 而不改变容器
+
+#include <initializer_list>
+#include <type_traits>
+
+#include "algo.h"
+#include "construct.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "type_traits.h"
+#include "uninitialize.h"
+#include "util.h"
+
+namespace MySTL {
+
+struct static_vector_throw {
+    static void check(bool overflow) {
+        THROW_LENGTH_ERROR_IF(overflow, "static_vector<T, N>'s size too big");
+    }
+};
+
+struct static_vector_assert {
+    static void check(bool overflow) noexcept {
+        MYSTL_DEBUG(!overflow);
+        (void)overflow;
+    }
+};
+
+/*********************************** static_vector_storage ***********************************/
+// 保存元素和元素个数，T 可平凡复制时复制、移动、析构全部使用编译器生成的平凡版本
+template <class T, size_t N, bool = std::is_trivially_copyable<T>::value>
+class static_vector_storage {
+protected:
+    size_t size_;
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type data_;
+
+    static_vector_storage() noexcept : size_(0) {}
+
+    T*       ptr() noexcept { return reinterpret_cast<T*>(&data_); }
+    const T* ptr() const noexcept { return reinterpret_cast<const T*>(&data_); }
+};
+
+template <class T, size_t N>
+class static_vector_storage<T, N, false> {
+protected:
+    size_t size_;
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type data_;
+
+    static_vector_storage() noexcept : size_(0) {}
+
+    static_vector_storage(const static_vector_storage& rhs) : size_(0) {
+        MySTL::uninitialized_copy(rhs.ptr(), rhs.ptr() + rhs.size_, ptr());
+        size_ = rhs.size_;
+    }
+
+    static_vector_storage(static_vector_storage&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value) :
+        size_(0) {
+        MySTL::uninitialized_move(rhs.ptr(), rhs.ptr() + rhs.size_, ptr());
+        size_ = rhs.size_;
+    }
+
+    static_vector_storage& operator=(const static_vector_storage& rhs) {
+        if (this != &rhs)
+            assign_from(rhs.ptr(), rhs.size_, false);
+        return *this;
+    }
+
+    static_vector_storage& operator=(static_vector_storage&& rhs) noexcept(std::is_nothrow_move_assignable<T>::value &&
+                                                                           std::is_nothrow_move_constructible<T>::value) {
+        if (this != &rhs)
+            assign_from(rhs.ptr(), rhs.size_, true);
+        return *this;
+    }
+
+    ~static_vector_storage() { MySTL::destroy(ptr(), ptr() + size_); }
+
+    T*       ptr() noexcept { return reinterpret_cast<T*>(&data_); }
+    const T* ptr() const noexcept { return reinterpret_cast<const T*>(&data_); }
+
+private:
+    // 已有的元素赋值，多出的元素析构，不足的部分构造
+    void assign_from(const T* src, size_t n, bool move) {
+        T*        dst = ptr();
+        T*        src_mut = const_cast<T*>(src);
+        const size_t common = n < size_ ? n : size_;
+        for (size_t i = 0; i < common; ++i) {
+            if (move)
+                dst[i] = MySTL::move(src_mut[i]);
+            else
+                dst[i] = src[i];
+        }
+        if (n < size_) {
+            MySTL::destroy(dst + n, dst + size_);
+        } else if (move) {
+            MySTL::uninitialized_move(src_mut + common, src_mut + n, dst + common);
+        } else {
+            MySTL::uninitialized_copy(src + common, src + n, dst + common);
+        }
+        size_ = n;
+    }
+};
+
+/*********************************** static_vector ***********************************/
+
+template <class T, size_t N, class OverflowPolicy = static_vector_throw>
+class static_vector : private static_vector_storage<T, N> {
+    typedef static_vector_storage<T, N> storage_base;
+
+    using storage_base::size_;
+    using storage_base::ptr;
+
+public:
+    typedef T                                           value_type;
+    typedef T*                                          pointer;
+    typedef const T*                                    const_pointer;
+    typedef T&                                          reference;
+    typedef const T&                                    const_reference;
+    typedef size_t                                      size_type;
+    typedef ptrdiff_t                                   difference_type;
+
+    typedef value_type*                                 iterator;
+    typedef const value_type*                           const_iterator;
+    typedef MySTL::reverse_iterator<iterator>           reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator>     const_reverse_iterator;
+
+public:
+    /*********************************** 构造，复制，移动，析构 ***********************************/
+
+    static_vector() noexcept = default;
+
+    // 构造时直接追加，不把指向未初始化存储的 const_iterator 传给 insert
+    explicit static_vector(size_type n) { append_fill(n, value_type()); }
+
+    static_vector(size_type n, const value_type& value) { append_fill(n, value); }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    static_vector(Iter first, Iter last) { append_range(first, last); }
+
+    static_vector(std::initializer_list<value_type> ilist) { append_range(ilist.begin(), ilist.end()); }
+
+    // 复制、移动、析构由 static_vector_storage 决定是否平凡
+    static_vector(const static_vector&) = default;
+    static_vector(static_vector&&) = default;
+    static_vector& operator=(const static_vector&) = default;
+    static_vector& operator=(static_vector&&) = default;
+    ~static_vector() = default;
+
+    static_vector& operator=(std::initializer_list<value_type> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+public:
+    /*********************************** 迭代器相关操作 ***********************************/
+
+    iterator               begin() noexcept { return ptr(); }
+    const_iterator         begin() const noexcept { return ptr(); }
+    iterator               end() noexcept { return ptr() + size_; }
+    const_iterator         end() const noexcept { return ptr() + size_; }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin() const noexcept { return begin(); }
+    const_iterator         cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    /*********************************** 容器相关操作 ***********************************/
+
+    bool      empty() const noexcept { return size_ == 0; }
+    bool      full() const noexcept { return size_ == N; }
+    size_type size() const noexcept { return size_; }
+    static constexpr size_type max_size() noexcept { return N; }
+    static constexpr size_type capacity() noexcept { return N; }
+
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size());
+        return ptr()[n];
+    }
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size());
+        return ptr()[n];
+    }
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "static_vector<T, N> : out of range");
+        return ptr()[n];
+    }
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "static_vector<T, N> : out of range");
+        return ptr()[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return ptr()[0];
+    }
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return ptr()[0];
+    }
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return ptr()[size_ - 1];
+    }
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return ptr()[size_ - 1];
+    }
+
+    pointer       data() noexcept { return ptr(); }
+    const_pointer data() const noexcept { return ptr(); }
+
+    /*********************************** 修改容器相关操作 ***********************************/
+
+    void assign(size_type n, const value_type& value) {
+        clear();
+        append_fill(n, value);
+    }
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    void assign(Iter first, Iter last) {
+        clear();
+        append_range(first, last);
+    }
+    void assign(std::initializer_list<value_type> il) { assign(il.begin(), il.end()); }
+
+    template <class... Args>
+    void emplace_back(Args&&... args) {
+        OverflowPolicy::check(full());
+        MySTL::construct(ptr() + size_, MySTL::forward<Args>(args)...);
+        ++size_;
+    }
+
+    void push_back(const value_type& value) { emplace_back(value); }
+    void push_back(value_type&& value) { emplace_back(MySTL::move(value)); }
+
+    // 容量不足时返回 false，容器保持不变
+    template <class... Args>
+    bool try_emplace_back(Args&&... args) {
+        if (full()) return false;
+        MySTL::construct(ptr() + size_, MySTL::forward<Args>(args)...);
+        ++size_;
+        return true;
+    }
+
+    bool try_push_back(const value_type& value) { return try_emplace_back(value); }
+    bool try_push_back(value_type&& value) { return try_emplace_back(MySTL::move(value)); }
+
+    void pop_back() {
+        MYSTL_DEBUG(!empty());
+        --size_;
+        MySTL::destroy(ptr() + size_);
+    }
+
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+
+    iterator insert(const_iterator pos, const value_type& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, value_type&& value) { return emplace(pos, MySTL::move(value)); }
+    iterator insert(const_iterator pos, size_type n, const value_type& value);
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    iterator insert(const_iterator pos, Iter first, Iter last);
+
+    iterator insert(const_iterator pos, std::initializer_list<value_type> il) {
+        return insert(pos, il.begin(), il.end());
+    }
+
+    iterator erase(const_iterator pos) {
+        MYSTL_DEBUG(pos < end() && pos >= begin());
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+        iterator r = begin() + (first - begin());
+        iterator new_end = MySTL::move(r + (last - first), end(), r);
+        MySTL::destroy(new_end, end());
+        size_ = static_cast<size_type>(new_end - begin());
+        return r;
+    }
+
+    void clear() noexcept {
+        MySTL::destroy(begin(), end());
+        size_ = 0;
+    }
+
+    void resize(size_type new_size) { resize(new_size, value_type()); }
+    void resize(size_type new_size, const value_type& value) {
+        if (new_size < size_)
+            erase(begin() + new_size, end());
+        else
+            append_fill(new_size - size_, value);
+    }
+
+    void swap(static_vector& rhs) {
+        static_vector tmp(MySTL::move(rhs));
+        rhs = MySTL::move(*this);
+        *this = MySTL::move(tmp);
+    }
+
+private:
+    /*********************************** helper functions ***********************************/
+
+    // 在尾部追加 n 个 value
+    void append_fill(size_type n, const value_type& value) {
+        OverflowPolicy::check(n > N - size_);
+        MySTL::uninitialized_fill_n(end(), n, value);
+        size_ += n;
+    }
+
+    // 在尾部追加 [first, last)，中途抛出异常时已追加的元素被析构
+    template <class Iter>
+    void append_range(Iter first, Iter last) {
+        const size_type old_size = size_;
+        try {
+            for (; first != last; ++first)
+                emplace_back(*first);
+        } catch (...) {
+            MySTL::destroy(begin() + old_size, end());
+            size_ = old_size;
+            throw;
+        }
+    }
+};
+
+template <class T, size_t N, class OverflowPolicy>
+template <class... Args>
+typename static_vector<T, N, OverflowPolicy>::iterator
+static_vector<T, N, OverflowPolicy>::emplace(const_iterator pos, Args&&... args) {
+    MYSTL_DEBUG(pos >= begin() && pos <= end());
+    const size_type n = pos - begin();
+    emplace_back(MySTL::forward<Args>(args)...);
+    MySTL::rotate(begin() + n, end() - 1, end());
+    return begin() + n;
+}
+
+// 先在尾部构造新元素，再旋转到 pos 处
+template <class T, size_t N, class OverflowPolicy>
+typename static_vector<T, N, OverflowPolicy>::iterator
+static_vector<T, N, OverflowPolicy>::insert(const_iterator pos, size_type n, const value_type& value) {
+    MYSTL_DEBUG(pos >= begin() && pos <= end());
+    const size_type xpos = pos - begin();
+    const size_type old_size = size_;
+    append_fill(n, value);
+    MySTL::rotate(begin() + xpos, begin() + old_size, end());
+    return begin() + xpos;
+}
+
+template <class T, size_t N, class OverflowPolicy>
+template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type>
+typename static_vector<T, N, OverflowPolicy>::iterator
+static_vector<T, N, OverflowPolicy>::insert(const_iterator pos, Iter first, Iter last) {
+    MYSTL_DEBUG(pos >= begin() && pos <= end());
+    const size_type xpos = pos - begin();
+    const size_type old_size = size_;
+    append_range(first, last);
+    MySTL::rotate(begin() + xpos, begin() + old_size, end());
+    return begin() + xpos;
+}
+
+/*********************************** 重载比较运算 ***********************************/
+
+template <class T, size_t N, class P>
+bool operator==(const static_vector<T, N, P>& lhs, const static_vector<T, N, P>& rhs) {
+    return lhs.size() == rhs.size() && MySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, size_t N, class P>
+bool operator!=(const static_vector<T, N, P>& lhs, const static_vector<T, N, P>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, size_t N, class P>
+bool operator<(const static_vector<T, N, P>& lhs, const static_vector<T, N, P>& rhs) {
+    return MySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, size_t N, class P>
+bool operator>(const static_vector<T, N, P>& lhs, const static_vector<T, N, P>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, size_t N, class P>
+bool operator<=(const static_vector<T, N, P>& lhs, const static_vector<T, N, P>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, size_t N, class P>
+bool operator>=(const static_vector<T, N, P>& lhs, const static_vector<T, N, P>& rhs) {
+    return !(lhs < rhs);
+}
+
+template <class T, size_t N, class P>
+void swap(static_vector<T, N, P>& lhs, static_vector<T, N, P>& rhs) {
+    lhs.swap(rhs);
+}
+
+// 元素保存在对象内部，可平凡重定位当且仅当元素可平凡重定位
+template <class T, size_t N, class P>
+struct is_trivially_relocatable<static_vector<T, N, P>> : is_trivially_relocatable<T> {};
+
+}  // namespace MySTL
+
+#endif /* MY_STATIC_VECTOR_H */
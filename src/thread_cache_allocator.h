@@ -0,0 +1,304 @@
+#ifndef MY_THREAD_CACHE_ALLOCATOR_H
+#define MY_THREAD_CACHE_ALLOCATOR_H
+
+// 线程缓存分配器，适用于多个线程频繁创建、销毁 list / rb_tree 结点的场景
+// 每个线程为每个 size class 维护一条私有自由链表，分配和释放都不加锁
+// 私有链表为空时从中央池一次取回 TCACHE_BATCH 个对象，超过 TCACHE_HIGH_WATER 时批量归还一半
+// 中央池每个 size class 一把锁，只在批量搬运时加锁
+// 内存块不归属于任何线程：A 线程分配、B 线程释放的块直接进入 B 的缓存，
+// 之后被 B 复用或随批量归还回到中央池，因此跨线程释放无需额外的远程释放队列
+// 线程退出时其缓存中的对象全部归还中央池；中央池的 slab 在程序结束前不会归还给系统
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+#include "construct.h"
+#include "util.h"
+
+namespace MySTL {
+
+enum { TCACHE_ALIGN = 8 };
+enum { TCACHE_MAX_BYTES = 256 };
+enum { TCACHE_NCLASSES = TCACHE_MAX_BYTES / TCACHE_ALIGN };
+enum { TCACHE_BATCH = 64 };
+enum { TCACHE_HIGH_WATER = 2 * TCACHE_BATCH };
+enum { TCACHE_SLAB_BYTES = 64 * 1024 };
+
+struct tcache_obj {
+    tcache_obj* next;
+};
+
+/*********************************** central_pool ***********************************/
+// 模板参数仅用于让静态成员可以定义在头文件中
+template <int Inst>
+class central_pool_template {
+private:
+    struct bucket {
+        std::mutex  lock;
+        tcache_obj* head;
+        size_t      count;
+    };
+
+    static bucket buckets_[TCACHE_NCLASSES];
+
+public:
+    static tcache_obj* fetch(size_t cls, size_t n, size_t& got);
+    static void        give_back(size_t cls, tcache_obj* first, tcache_obj* last, size_t n);
+
+    static size_t size_of(size_t cls) { return (cls + 1) * TCACHE_ALIGN; }
+
+    static size_t index(size_t bytes) { return (bytes + TCACHE_ALIGN - 1) / TCACHE_ALIGN - 1; }
+
+    // 请求是否由线程缓存负责
+    static bool is_cached(size_t bytes, size_t align) {
+        return bytes <= TCACHE_MAX_BYTES && align <= TCACHE_ALIGN;
+    }
+
+private:
+    static void refill(bucket& b, size_t cls);
+};
+
+template <int Inst>
+typename central_pool_template<Inst>::bucket central_pool_template<Inst>::buckets_[TCACHE_NCLASSES];
+
+/**
+ * @brief 从中央池取出至多 n 个对象，组成以 nullptr 结尾的链表
+ * @param got 传出实际取得的数量(至少为 1)
+ */
+template <int Inst>
+tcache_obj* central_pool_template<Inst>::fetch(size_t cls, size_t n, size_t& got) {
+    bucket&                     b = buckets_[cls];
+    std::lock_guard<std::mutex> guard(b.lock);
+    if (b.head == nullptr) {
+        refill(b, cls);
+    }
+    tcache_obj* first = b.head;
+    tcache_obj* last = first;
+    got = 1;
+    while (got < n && last->next != nullptr) {
+        last = last->next;
+        ++got;
+    }
+    b.head = last->next;
+    b.count -= got;
+    last->next = nullptr;
+    return first;
+}
+
+// 将链表 [first, last] 上的 n 个对象挂回中央池
+template <int Inst>
+void central_pool_template<Inst>::give_back(size_t cls, tcache_obj* first, tcache_obj* last, size_t n) {
+    bucket&                     b = buckets_[cls];
+    std::lock_guard<std::mutex> guard(b.lock);
+    last->next = b.head;
+    b.head = first;
+    b.count += n;
+}
+
+// 申请一块 slab 并全部切分成对象挂入中央池，调用者持有 b.lock
+template <int Inst>
+void central_pool_template<Inst>::refill(bucket& b, size_t cls) {
+    const size_t bytes = size_of(cls);
+    const size_t nobjs = TCACHE_SLAB_BYTES / bytes;
+    char*        slab = static_cast<char*>(::operator new(nobjs * bytes));
+    for (size_t i = nobjs; i > 0; --i) {
+        tcache_obj* q = reinterpret_cast<tcache_obj*>(slab + (i - 1) * bytes);
+        q->next = b.head;
+        b.head = q;
+    }
+    b.count += nobjs;
+}
+
+typedef central_pool_template<0> central_pool;
+
+/*********************************** thread_cache ***********************************/
+class thread_cache {
+private:
+    struct free_list {
+        tcache_obj* head;
+        size_t      count;
+    };
+
+    free_list lists_[TCACHE_NCLASSES];
+
+    thread_cache() noexcept : lists_() {}
+
+public:
+    thread_cache(const thread_cache&) = delete;
+    thread_cache& operator=(const thread_cache&) = delete;
+
+    // 线程退出时归还所有缓存的对象
+    ~thread_cache() {
+        for (size_t cls = 0; cls < TCACHE_NCLASSES; ++cls) {
+            free_list& fl = lists_[cls];
+            if (fl.head != nullptr) {
+                tcache_obj* last = fl.head;
+                while (last->next != nullptr)
+                    last = last->next;
+                central_pool::give_back(cls, fl.head, last, fl.count);
+            }
+        }
+    }
+
+    // 当前线程的缓存
+    static thread_cache& local() {
+        static thread_local thread_cache cache;
+        return cache;
+    }
+
+    void* allocate(size_t bytes) {
+        const size_t cls = central_pool::index(bytes);
+        free_list&   fl = lists_[cls];
+        if (fl.head == nullptr) {
+            fl.head = central_pool::fetch(cls, TCACHE_BATCH, fl.count);
+        }
+        tcache_obj* result = fl.head;
+        fl.head = result->next;
+        --fl.count;
+        return result;
+    }
+
+    void deallocate(void* ptr, size_t bytes) {
+        const size_t cls = central_pool::index(bytes);
+        free_list&   fl = lists_[cls];
+        tcache_obj*  q = static_cast<tcache_obj*>(ptr);
+        q->next = fl.head;
+        fl.head = q;
+        if (++fl.count > TCACHE_HIGH_WATER) {
+            release_batch(cls);
+        }
+    }
+
+    // 当前线程缓存中某个 size class 的对象个数
+    size_t cached(size_t bytes) const { return lists_[central_pool::index(bytes)].count; }
+
+private:
+    // 把链表头部 TCACHE_BATCH 个对象归还中央池
+    void release_batch(size_t cls) {
+        free_list&  fl = lists_[cls];
+        tcache_obj* first = fl.head;
+        tcache_obj* last = first;
+        for (size_t i = 1; i < TCACHE_BATCH; ++i)
+            last = last->next;
+        fl.head = last->next;
+        fl.count -= TCACHE_BATCH;
+        central_pool::give_back(cls, first, last, TCACHE_BATCH);
+    }
+};
+
+/*********************************** thread_cache_allocator ***********************************/
+// 接口与 MySTL::allocator 保持一致，可作为 list / rb_tree / map / set 的 Alloc 参数
+template <class T>
+class thread_cache_allocator {
+public:
+    typedef T           value_type;
+    typedef T*          pointer;
+    typedef const T*    const_pointer;
+    typedef T&          reference;
+    typedef const T&    const_reference;
+    typedef size_t      size_type;
+    typedef ptrdiff_t   difference_type;
+
+    template <class U>
+    struct rebind {
+        typedef thread_cache_allocator<U> other;
+    };
+
+public:
+    thread_cache_allocator() noexcept = default;
+
+    template <class U>
+    thread_cache_allocator(const thread_cache_allocator<U>&) noexcept {}
+
+public:
+    static T*   allocate();
+    static T*   allocate(size_type n);
+
+    static void deallocate(T* ptr);
+    static void deallocate(T* ptr, size_type n);
+
+    static void construct(T* ptr);
+    static void construct(T* ptr, const T& value);
+    static void construct(T* ptr, T&& value);
+
+    template <class... Args>
+    static void construct(T* ptr, Args&& ...args);
+
+    static void destroy(T* ptr);
+    static void destroy(T* first, T* last);
+};
+
+template <class T>
+T* thread_cache_allocator<T>::allocate() {
+    return allocate(1);
+}
+
+template <class T>
+T* thread_cache_allocator<T>::allocate(size_type n) {
+    if (n == 0) return nullptr;
+    const size_t bytes = sizeof(T) * n;
+    if (central_pool::is_cached(bytes, alignof(T))) {
+        return static_cast<T*>(thread_cache::local().allocate(bytes));
+    }
+    return static_cast<T*>(::operator new(bytes));
+}
+
+template <class T>
+void thread_cache_allocator<T>::deallocate(T* ptr) {
+    deallocate(ptr, 1);
+}
+
+template <class T>
+void thread_cache_allocator<T>::deallocate(T* ptr, size_type n) {
+    if (ptr == nullptr) return;
+    const size_t bytes = sizeof(T) * n;
+    if (central_pool::is_cached(bytes, alignof(T))) {
+        thread_cache::local().deallocate(ptr, bytes);
+    }
+    else {
+        ::operator delete(ptr);
+    }
+}
+
+template <class T>
+void thread_cache_allocator<T>::construct(T* ptr) {
+    MySTL::construct(ptr);
+}
+
+template <class T>
+void thread_cache_allocator<T>::construct(T* ptr, const T& value) {
+    MySTL::construct(ptr, value);
+}
+
+template <class T>
+void thread_cache_allocator<T>::construct(T* ptr, T&& value) {
+    MySTL::construct(ptr, MySTL::move(value));
+}
+
+template <class T>
+template <class... Args>
+void thread_cache_allocator<T>::construct(T* ptr, Args&&... args) {
+    MySTL::construct(ptr, MySTL::forward<Args>(args)...);
+}
+
+template <class T>
+void thread_cache_allocator<T>::destroy(T* ptr) {
+    MySTL::destroy(ptr);
+}
+
+template <class T>
+void thread_cache_allocator<T>::destroy(T* first, T* last) {
+    MySTL::destroy(first, last);
+}
+
+// 所有线程共享同一个中央池，任意实例分配的内存都可以由另一个实例释放
+template <class T, class U>
+bool operator==(const thread_cache_allocator<T>&, const thread_cache_allocator<U>&) noexcept { return true; }
+
+template <class T, class U>
+bool operator!=(const thread_cache_allocator<T>&, const thread_cache_allocator<U>&) noexcept { return false; }
+
+}  // namespace MySTL
+
+#endif /* MY_THREAD_CACHE_ALLOCATOR_H */
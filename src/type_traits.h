@@ -30,6 +30,19 @@ struct is_pair : MySTL::m_false_type {};
 template <class T1, class T2>
 struct is_pair<MySTL::pair<T1, T2>> : MySTL::m_true_type {};
 
+// is_trivially_relocatable
+// 移动构造一个新对象并立即析构原对象，若等价于按字节复制，则称该类型可平凡重定位
+// 平凡可复制的类型默认满足；只保存指向堆内存指针的类型(如 MySTL 的容器)也满足，
+// 用户类型可以特化本模板声明自己满足，容器重新分配时将直接 memcpy 而不逐个移动、析构
+// 注意：对象内部保存了指向自身的指针(如小字符串优化、侵入式链表头)的类型不能特化
+template <class T>
+struct is_trivially_relocatable : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+template <class T1, class T2>
+struct is_trivially_relocatable<MySTL::pair<T1, T2>>
+    : std::integral_constant<bool, is_trivially_relocatable<T1>::value &&
+                                   is_trivially_relocatable<T2>::value> {};
+
 }  // namespace MySTL
 
 #endif /* MY_TYPE_TRAITS_H */
@@ -3,6 +3,8 @@
 
 // 这个头文件用于对未初始化空间构造元素
 
+#include <cstring>
+
 #include "construct.h"
 #include "type_traits.h"
 #include "algobase.h"
@@ -28,8 +30,9 @@ unchecked_uninitialized_copy(InputIter first, InputIter last, ForwardIter result
         for (; first != last; ++first, ++cur)
             MySTL::construct(&*cur, *first);
     } catch (...) {
-        for (; first != result; ++result)
+        for (; result != cur; ++result)
             MySTL::destroy(&*result);
+        throw;
     }
     return cur;
 }
@@ -60,11 +63,12 @@ ForwardIter
 unchecked_uninitialized_copy_n(InputIter first, Size n, ForwardIter result, std::false_type) {
     auto cur = result;
     try {
-        for (; n > 0; ++first, ++cur)
+        for (; n > 0; --n, ++first, ++cur)
             MySTL::construct(&*cur, *first);
     } catch (...) {
-        for (; result != cur; cur--)
+        for (; result != cur; ++result)
             MySTL::destroy(&*result);
+        throw;
     }
     return cur;
 }
@@ -99,6 +103,7 @@ void unchecked_uninitialized_fill(ForwardIter first, ForwardIter last, const T&
     } catch (...) {
         for (; first != cur; ++first)
             MySTL::destroy(&*first);
+        throw;
     }
 }
 
@@ -127,11 +132,12 @@ unchecked_uninitialized_fill_n(ForwardIter first, Size n, const T& value, std::f
     auto cur = first;
     try {
         for (; n > 0; n--, cur++) {
-            MySTL::construct(&*cur, *first);
+            MySTL::construct(&*cur, value);
         }
     } catch (...) {
         for (; first != cur; ++first)
             MySTL::destroy(&*first);
+        throw;
     }
     return cur;
 }
@@ -147,6 +153,44 @@ uninitialized_fill_n(ForwardIter first, Size n, const T& value) {
                                           std::is_trivially_copy_assignable<typename iterator_traits<ForwardIter>::value_type>{});
 }
 
+/*****************************************************************************************/
+// uninitialized_default_construct_n
+// 在 [first, first + n) 上默认初始化元素，平凡类型不写入任何内容
+/*****************************************************************************************/
+template <class ForwardIter, class Size>
+ForwardIter
+unchecked_uninitialized_default_construct_n(ForwardIter first, Size n, std::true_type) {
+    MySTL::advance(first, n);
+    return first;
+}
+
+template <class ForwardIter, class Size>
+ForwardIter
+unchecked_uninitialized_default_construct_n(ForwardIter first, Size n, std::false_type) {
+    typedef typename iterator_traits<ForwardIter>::value_type value_type;
+    auto cur = first;
+    try {
+        for (; n > 0; n--, cur++)
+            ::new ((void*)&*cur) value_type;
+    } catch (...) {
+        for (; first != cur; ++first)
+            MySTL::destroy(&*first);
+        throw;
+    }
+    return cur;
+}
+
+/**
+ * @brief 默认初始化 [first, first + n)，与 uninitialized_fill_n 不同，平凡类型的元素保持未定值
+ * @return 返回构造结束的位置
+ */
+template <class ForwardIter, class Size>
+ForwardIter
+uninitialized_default_construct_n(ForwardIter first, Size n) {
+    return unchecked_uninitialized_default_construct_n(
+        first, n, std::is_trivially_default_constructible<typename iterator_traits<ForwardIter>::value_type>{});
+}
+
 /*****************************************************************************************/
 // uninitialized_move
 // move [first, last) to the begin of result
@@ -164,14 +208,14 @@ unchecked_uninitialized_move(InputIter first, InputIter last,
                              ForwardIter result, std::false_type) {
     auto cur = result;
     try {
-        for (; cur != last; cur++, result++) {
+        for (; first != last; ++first, ++cur) {
             MySTL::construct(&*cur, MySTL::move(*first));
         }
     } catch (...) {
-        for (; first != cur; cur++)
-            MySTL::destroy(result, cur);
+        MySTL::destroy(result, cur);
+        throw;
     }
-    return result;
+    return cur;
 }
 
 /**
@@ -194,16 +238,17 @@ unchecked_uninitialized_move_n(InputIter first, Size n, ForwradIter result, std:
 
 template <class InputIter, class Size, class ForwardIter>
 ForwardIter
-unchecked_unitialized_move_n(InputIter first, Size n, ForwardIter result, std::false_type) {
+unchecked_uninitialized_move_n(InputIter first, Size n, ForwardIter result, std::false_type) {
     auto cur = result;
     try {
         for (; n > 0; n--, cur++, first++) {
             MySTL::construct(&*cur, MySTL::move(*first));
         }
     } catch (...) {
-        MySTL::destroy(&*cur);
+        MySTL::destroy(result, cur);
+        throw;
     }
-    return result;
+    return cur;
 }
 
 /**
@@ -215,5 +260,35 @@ uninitialized_move_n(InputIter first, Size n, ForwardIter result) {
     return unchecked_uninitialized_move_n(first, n, result, std::is_trivially_move_assignable<typename iterator_traits<ForwardIter>::value_type>{});
 }
 
+/*****************************************************************************************/
+// uninitialized_relocate
+// 把 [first, last) 上的对象搬到以 result 为起始处的未初始化空间，并结束原对象的生命周期
+/*****************************************************************************************/
+template <class T>
+T* unchecked_uninitialized_relocate(T* first, T* last, T* result, std::true_type) {
+    const size_t n = static_cast<size_t>(last - first);
+    if (n != 0)
+        std::memcpy(static_cast<void*>(result), static_cast<const void*>(first), n * sizeof(T));
+    return result + n;
+}
+
+template <class T>
+T* unchecked_uninitialized_relocate(T* first, T* last, T* result, std::false_type) {
+    T* cur = MySTL::uninitialized_move(first, last, result);
+    MySTL::destroy(first, last);
+    return cur;
+}
+
+/**
+ * @brief 把 [first, last) 上的对象搬到 result 处，原位置变为未初始化空间
+ * @note 可平凡重定位的类型直接 memcpy，不会抛出异常；其余类型逐个移动构造后析构原对象
+ * @return 返回搬移结束的位置
+ */
+template <class T>
+T* uninitialized_relocate(T* first, T* last, T* result) {
+    return unchecked_uninitialized_relocate(first, last, result,
+                                            std::integral_constant<bool, is_trivially_relocatable<T>::value>{});
+}
+
 } // namespace MySTL
 #endif /* MY_UNINITIALIZE_H */
@@ -0,0 +1,801 @@
+#ifndef MYSTL_UNROLLED_LIST_H
+#define MYSTL_UNROLLED_LIST_H
+
+// 展开链表 unrolled_list 的实现
+// 每个结点保存一小段连续的元素，结点大小为缓存行的整数倍，顺序遍历时每个结点只有一次缓存缺失
+// 插入时在结点内移动元素，结点满了先尝试放到前一个结点末尾，否则对半拆分；删除后过空的结点与后继合并
+// 迭代器为 (结点, 下标)，双向迭代；插入、删除会使所在结点及被拆分、合并的结点上的迭代器失效
+// splice 整结点重新链接，可以在两个容器之间或同一个容器内移动一段元素
+// 迭代器特化了 segmented_iterator_traits，copy、for_each、find、accumulate 等算法逐个结点处理
+// 结点的链接复用 list.h 中的 list_link_nodes / list_unlink_nodes / list_take_head
+
+#include <initializer_list>
+#include <type_traits>
+
+#include "algobase.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "list.h"
+#include "memory.h"
+#include "myallocator.h"
+#include "uninitialize.h"
+#include "util.h"
+
+namespace MySTL {
+
+// 每个结点(包括链接部分)的目标字节数，应为缓存行(64 字节)的整数倍
+#ifndef UNROLLED_LIST_NODE_BYTES
+#define UNROLLED_LIST_NODE_BYTES 256
+#endif
+
+// unrolled_list 结点的链接部分，count 为结点中的元素个数，哨兵结点的 count 为 0
+struct unrolled_list_node_base {
+    unrolled_list_node_base* prev;
+    unrolled_list_node_base* next;
+    size_t                   count;
+
+    void unlink() { prev = next = this; }
+
+    unrolled_list_node_base* self() { return this; }
+};
+
+// 每个结点容纳的元素个数
+// NodeSize 不为 0 时就是 NodeSize，否则为 UNROLLED_LIST_NODE_BYTES 去掉链接部分后能放下的元素个数，至少为 4
+template <class T, size_t NodeSize = 0>
+struct unrolled_list_node_size {
+    static constexpr size_t fit = (UNROLLED_LIST_NODE_BYTES - sizeof(unrolled_list_node_base)) / sizeof(T);
+    static constexpr size_t value = NodeSize != 0 ? NodeSize : fit < 4 ? 4 : fit;
+};
+
+template <class T, size_t NodeSize = 0>
+struct unrolled_list_node : public unrolled_list_node_base {
+    static constexpr size_t capacity = unrolled_list_node_size<T, NodeSize>::value;
+
+    typename std::aligned_storage<sizeof(T) * capacity, alignof(T)>::type storage;  // 前 count 个位置上有元素
+
+    T* data() noexcept { return reinterpret_cast<T*>(&storage); }
+};
+
+template <class T, size_t NodeSize>
+constexpr size_t unrolled_list_node<T, NodeSize>::capacity;
+
+// unrolled_list 迭代器设计
+template <class T, class Ref, class Ptr, size_t NodeSize = 0>
+struct unrolled_list_iterator : public MySTL::iterator<MySTL::bidirectional_iterator_tag, T> {
+    typedef unrolled_list_iterator<T, T&, T*, NodeSize>             iterator;
+    typedef unrolled_list_iterator<T, const T&, const T*, NodeSize> const_iterator;
+    typedef unrolled_list_iterator                                  self;
+
+    typedef T                                  value_type;
+    typedef Ptr                                pointer;
+    typedef Ref                                reference;
+    typedef size_t                             size_type;
+    typedef unrolled_list_node_base*           base_ptr;
+    typedef unrolled_list_node<T, NodeSize>*   node_ptr;
+
+    base_ptr  node;   // 所在结点，end() 为哨兵结点
+    size_type index;  // 在结点中的下标，end() 为 0
+
+    unrolled_list_iterator() noexcept : node(nullptr), index(0) {}
+
+    unrolled_list_iterator(base_ptr n, size_type i) noexcept : node(n), index(i) {}
+
+    unrolled_list_iterator(const unrolled_list_iterator&) = default;
+    unrolled_list_iterator& operator=(const unrolled_list_iterator&) = default;
+
+    // iterator 可以隐式转换为 const_iterator
+    template <class It, typename std::enable_if<std::is_same<It, iterator>::value &&
+                                                    std::is_same<self, const_iterator>::value, int>::type = 0>
+    unrolled_list_iterator(const It& rhs) noexcept : node(rhs.node), index(rhs.index) {}
+
+    reference operator*() const { return static_cast<node_ptr>(node)->data()[index]; }
+    pointer   operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        MYSTL_DEBUG(node != nullptr && index < node->count);
+        if (++index == node->count) {
+            node = node->next;
+            index = 0;
+        }
+        return *this;
+    }
+
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    self& operator--() {
+        MYSTL_DEBUG(node != nullptr);
+        if (index == 0) {
+            node = node->prev;
+            index = node->count;
+        }
+        --index;
+        return *this;
+    }
+
+    self operator--(int) {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node == rhs.node && index == rhs.index; }
+    bool operator!=(const self& rhs) const { return !(*this == rhs); }
+};
+
+// unrolled_list 的段迭代器，每个结点是一段
+struct unrolled_list_segment {
+    unrolled_list_node_base* node;
+
+    unrolled_list_segment& operator++() {
+        node = node->next;
+        return *this;
+    }
+
+    unrolled_list_segment& operator--() {
+        node = node->prev;
+        return *this;
+    }
+
+    bool operator==(const unrolled_list_segment& rhs) const { return node == rhs.node; }
+    bool operator!=(const unrolled_list_segment& rhs) const { return node != rhs.node; }
+};
+
+// 哨兵结点没有存放元素的空间，它对应的段为空指针区间
+// 其余结点都不为空，所以 compose 中 local 等于 end(seg) 时可以直接落到下一个结点的开头
+template <class T, class Ref, class Ptr, size_t NodeSize>
+struct segmented_iterator_traits<unrolled_list_iterator<T, Ref, Ptr, NodeSize>> {
+    typedef m_true_type                                   is_segmented;
+    typedef unrolled_list_iterator<T, Ref, Ptr, NodeSize> iterator;
+    typedef unrolled_list_segment                         segment_iterator;
+    typedef Ptr                                           local_iterator;
+
+    static segment_iterator segment(const iterator& it) noexcept { return segment_iterator{it.node}; }
+    static local_iterator   local(const iterator& it) noexcept { return begin(segment(it)) + it.index; }
+
+    static local_iterator begin(segment_iterator seg) noexcept {
+        return seg.node->count == 0 ? nullptr : static_cast<typename iterator::node_ptr>(seg.node)->data();
+    }
+    static local_iterator end(segment_iterator seg) noexcept { return begin(seg) + seg.node->count; }
+
+    static iterator compose(segment_iterator seg, local_iterator pos) noexcept {
+        if (seg.node->count != 0 && pos == end(seg)) {
+            ++seg;
+            pos = begin(seg);
+        }
+        return iterator(seg.node, static_cast<size_t>(pos - begin(seg)));
+    }
+};
+
+// 模板类 unrolled_list
+// 模板参数 T 代表数据类型，Alloc 代表分配器类型
+// NodeSize 为每个结点的元素个数，0 表示使用 unrolled_list_node_size<T> 的默认值
+template <class T, class Alloc = MySTL::allocator<T>, size_t NodeSize = 0>
+class unrolled_list
+    : private alloc_holder<
+          typename allocator_traits<Alloc>::template rebind_alloc<unrolled_list_node<T, NodeSize>>> {
+public:
+    typedef Alloc                                                                                  allocator_type;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<unrolled_list_node<T, NodeSize>> node_allocator;
+    typedef MySTL::allocator_traits<node_allocator>                                                node_alloc_traits;
+
+    typedef T         value_type;
+    typedef T*        pointer;
+    typedef const T*  const_pointer;
+    typedef T&        reference;
+    typedef const T&  const_reference;
+    typedef size_t    size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef unrolled_list_iterator<T, T&, T*, NodeSize>             iterator;
+    typedef unrolled_list_iterator<T, const T&, const T*, NodeSize> const_iterator;
+    typedef MySTL::reverse_iterator<iterator>                       reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator>                 const_reverse_iterator;
+
+    typedef unrolled_list_node_base*         base_ptr;
+    typedef unrolled_list_node<T, NodeSize>* node_ptr;
+
+    static constexpr size_type node_capacity = unrolled_list_node<T, NodeSize>::capacity;
+
+    allocator_type get_allocator() const { return allocator_type(get_alloc()); }
+
+private:
+    typedef alloc_holder<node_allocator> alloc_base;
+    using alloc_base::get_alloc;
+
+    unrolled_list_node_base head_;  // 哨兵结点直接嵌在对象中，空 unrolled_list 不需要分配内存
+    size_type               size_;
+
+public:
+    /*********************************** 构造，复制，移动，析构 ***********************************/
+
+    unrolled_list() noexcept : size_(0) { init_head(); }
+
+    explicit unrolled_list(const allocator_type& alloc) noexcept : alloc_base(node_allocator(alloc)), size_(0) {
+        init_head();
+    }
+
+    explicit unrolled_list(size_type n, const allocator_type& alloc = allocator_type()) :
+        alloc_base(node_allocator(alloc)), size_(0) {
+        init_head();
+        fill_init(n, value_type());
+    }
+
+    unrolled_list(size_type n, const T& value, const allocator_type& alloc = allocator_type()) :
+        alloc_base(node_allocator(alloc)), size_(0) {
+        init_head();
+        fill_init(n, value);
+    }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    unrolled_list(Iter first, Iter last, const allocator_type& alloc = allocator_type()) :
+        alloc_base(node_allocator(alloc)), size_(0) {
+        init_head();
+        copy_init(first, last);
+    }
+
+    unrolled_list(std::initializer_list<T> ilist, const allocator_type& alloc = allocator_type()) :
+        alloc_base(node_allocator(alloc)), size_(0) {
+        init_head();
+        copy_init(ilist.begin(), ilist.end());
+    }
+
+    // 复制，分配器由 select_on_container_copy_construction 决定
+    unrolled_list(const unrolled_list& rhs) :
+        alloc_base(node_alloc_traits::select_on_container_copy_construction(rhs.get_alloc())), size_(0) {
+        init_head();
+        copy_init(rhs.begin(), rhs.end());
+    }
+
+    unrolled_list(const unrolled_list& rhs, const allocator_type& alloc) :
+        alloc_base(node_allocator(alloc)), size_(0) {
+        init_head();
+        copy_init(rhs.begin(), rhs.end());
+    }
+
+    // 移动，接管 rhs 的全部结点
+    unrolled_list(unrolled_list&& rhs) noexcept : alloc_base(MySTL::move(rhs.get_alloc())), size_(rhs.size_) {
+        init_head();
+        list_take_head(head(), rhs.head());
+        rhs.size_ = 0;
+    }
+
+    unrolled_list& operator=(const unrolled_list& rhs) {
+        if (this != &rhs) {
+            clear();
+            MySTL::alloc_on_copy(get_alloc(), rhs.get_alloc());
+            copy_init(rhs.begin(), rhs.end());
+        }
+        return *this;
+    }
+
+    unrolled_list& operator=(unrolled_list&& rhs) {
+        if (this == &rhs) return *this;
+        clear();
+        MySTL::alloc_on_move(get_alloc(), rhs.get_alloc());
+        if (MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+            list_take_head(head(), rhs.head());
+            size_ = rhs.size_;
+            rhs.size_ = 0;
+        } else {
+            // 分配器不相等且不传播，不能接管 rhs 的结点，只能逐个移动元素
+            for (auto it = rhs.begin(); it != rhs.end(); ++it)
+                emplace_back(MySTL::move(*it));
+            rhs.clear();
+        }
+        return *this;
+    }
+
+    unrolled_list& operator=(std::initializer_list<T> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~unrolled_list() { clear(); }
+
+public:
+    /*********************************** 迭代器相关操作 ***********************************/
+
+    iterator       begin() noexcept { return iterator(head_.next, 0); }
+    const_iterator begin() const noexcept { return const_iterator(head_.next, 0); }
+    iterator       end() noexcept { return iterator(head(), 0); }
+    const_iterator end() const noexcept { return const_iterator(head(), 0); }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin() const noexcept { return begin(); }
+    const_iterator         cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    /*********************************** 容量相关操作 ***********************************/
+
+    bool      empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(T); }
+
+    /*********************************** 访问元素相关操作 ***********************************/
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return data_of(head_.next)[0];
+    }
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return data_of(head_.next)[0];
+    }
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return data_of(head_.prev)[head_.prev->count - 1];
+    }
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return data_of(head_.prev)[head_.prev->count - 1];
+    }
+
+    /*********************************** 修改容器相关操作 ***********************************/
+
+    // assign
+
+    void assign(size_type n, const value_type& value) {
+        clear();
+        fill_init(n, value);
+    }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    void assign(Iter first, Iter last) {
+        clear();
+        copy_init(first, last);
+    }
+
+    void assign(std::initializer_list<T> ilist) { assign(ilist.begin(), ilist.end()); }
+
+    // emplace / insert，返回指向新元素的迭代器
+
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+
+    template <class... Args>
+    reference emplace_front(Args&&... args) {
+        return *emplace(cbegin(), MySTL::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    reference emplace_back(Args&&... args) {
+        return *emplace(cend(), MySTL::forward<Args>(args)...);
+    }
+
+    iterator insert(const_iterator pos, const value_type& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, value_type&& value) { return emplace(pos, MySTL::move(value)); }
+
+    // 插入多个元素，返回指向第一个新元素的迭代器；没有插入元素时返回 pos
+    iterator insert(const_iterator pos, size_type n, const value_type& value);
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    iterator insert(const_iterator pos, Iter first, Iter last);
+
+    iterator insert(const_iterator pos, std::initializer_list<T> ilist) {
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    void push_front(const value_type& value) { emplace(cbegin(), value); }
+    void push_front(value_type&& value) { emplace(cbegin(), MySTL::move(value)); }
+    void push_back(const value_type& value) { emplace(cend(), value); }
+    void push_back(value_type&& value) { emplace(cend(), MySTL::move(value)); }
+
+    void pop_front() {
+        MYSTL_DEBUG(!empty());
+        erase(cbegin());
+    }
+    void pop_back() {
+        MYSTL_DEBUG(!empty());
+        erase(const_iterator(head_.prev, head_.prev->count - 1));
+    }
+
+    // erase，返回被删除元素之后的位置
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+
+    void clear() noexcept;
+
+    void resize(size_type new_size) { resize(new_size, value_type()); }
+    void resize(size_type new_size, const value_type& value);
+
+    void swap(unrolled_list& rhs) noexcept {
+        unrolled_list_node_base tmp;
+        list_take_head(tmp.self(), head());
+        list_take_head(head(), rhs.head());
+        list_take_head(rhs.head(), tmp.self());
+        MySTL::swap(size_, rhs.size_);
+        MySTL::alloc_on_swap(get_alloc(), rhs.get_alloc());
+    }
+
+    /*********************************** 链表相关操作 ***********************************/
+
+    // 把 x 中 [first, last) 内的元素移到 pos 之前，两者的分配器必须相等；x 是 *this 时 pos 不能在 (first, last) 内
+    // 整结点直接摘下重新链接，不移动元素；区间端点与 pos 落在结点中间时先拆分该结点
+    void splice(const_iterator pos, unrolled_list& x, const_iterator first, const_iterator last) {
+        transfer(pos, x, first, last);
+    }
+    void splice(const_iterator pos, unrolled_list&& x, const_iterator first, const_iterator last) {
+        splice(pos, x, first, last);
+    }
+
+    void splice(const_iterator pos, unrolled_list& x) { splice(pos, x, x.cbegin(), x.cend()); }
+    void splice(const_iterator pos, unrolled_list&& x) { splice(pos, x, x.cbegin(), x.cend()); }
+
+    void splice(const_iterator pos, unrolled_list& x, const_iterator it) {
+        const_iterator next = it;
+        splice(pos, x, it, ++next);
+    }
+    void splice(const_iterator pos, unrolled_list&& x, const_iterator it) { splice(pos, x, it); }
+
+private:
+    /*********************************** helper functions ***********************************/
+
+    void init_head() noexcept {
+        head_.unlink();
+        head_.count = 0;
+    }
+
+    base_ptr head() const noexcept { return const_cast<base_ptr>(&head_); }
+
+    static pointer data_of(base_ptr p) noexcept { return static_cast<node_ptr>(p)->data(); }
+
+    // 申请一个空结点并链接到 pos 之前
+    base_ptr create_node_before(base_ptr pos);
+
+    // 销毁结点上的元素并释放结点，结点必须已经断开
+    void destroy_node(base_ptr p) noexcept;
+
+    // 从 p 的下标 idx 处拆开，[idx, count) 移到紧随其后的新结点中，返回 idx 处元素所在的结点
+    base_ptr split_node(base_ptr p, size_type idx);
+
+    // p 与后继的元素加起来不超过 3/4 个结点时，把后继的元素移到 p 的末尾并释放后继
+    // 移动构造抛出异常时不合并，两个结点仍然留在链表中
+    void merge_next(base_ptr p);
+
+    // 删除结点 p 中 [first, last) 内的元素
+    void erase_in_node(base_ptr p, size_type first, size_type last);
+
+    // 删除后整理结点 p：空结点释放，过空的结点与后继合并；返回原来 p 中下标 idx 处的位置
+    iterator settle_after_erase(base_ptr p, size_type idx);
+
+    // 结点 p 从下标 idx 处拆出了结点 q，原来指向 p 中 idx 及以后的迭代器改为指向 q
+    static void follow_split(const_iterator& it, base_ptr p, size_type idx, base_ptr q) noexcept {
+        if (it.node == p && idx != 0 && it.index >= idx) {
+            it.node = q;
+            it.index -= idx;
+        }
+    }
+
+    // splice 的实现，返回指向第一个移入元素的迭代器，没有移入元素时返回 pos
+    iterator transfer(const_iterator pos, unrolled_list& x, const_iterator first, const_iterator last);
+
+    void fill_init(size_type n, const value_type& value);
+    template <class Iter>
+    void copy_init(Iter first, Iter last);
+};
+
+template <class T, class Alloc, size_t NodeSize>
+constexpr typename unrolled_list<T, Alloc, NodeSize>::size_type unrolled_list<T, Alloc, NodeSize>::node_capacity;
+
+/*****************************************************************************************/
+
+// 在 pos 之前构造元素
+// 先在结点之外构造出新元素，参数引用本容器中的元素时也不受后面移动元素的影响
+template <class T, class Alloc, size_t NodeSize>
+template <class... Args>
+typename unrolled_list<T, Alloc, NodeSize>::iterator
+unrolled_list<T, Alloc, NodeSize>::emplace(const_iterator pos, Args&&... args) {
+    THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "unrolled_list<T>'s size too big");
+    value_type tmp(MySTL::forward<Args>(args)...);
+    base_ptr   p = pos.node;
+    size_type  idx = pos.index;
+    if (idx == 0 && (p == head() || p->count == node_capacity)) {
+        // 在 end() 或满结点的开头插入：前一个结点还有空位就放到它的末尾，否则在前面新开一个结点
+        base_ptr prev = p->prev;
+        if (prev != head() && prev->count < node_capacity) {
+            p = prev;
+            idx = prev->count;
+        } else {
+            p = create_node_before(p);
+        }
+    } else if (p->count == node_capacity) {
+        // 在满结点中间插入，对半拆分
+        base_ptr q = split_node(p, node_capacity / 2);
+        if (idx >= p->count) {
+            idx -= p->count;
+            p = q;
+        }
+    }
+    pointer d = data_of(p);
+    if (idx == p->count) {
+        try {
+            node_alloc_traits::construct(get_alloc(), d + idx, MySTL::move(tmp));
+        } catch (...) {
+            if (p->count == 0) {  // 刚新开的结点不能空着留在链表中
+                list_unlink_nodes(p, p);
+                destroy_node(p);
+            }
+            throw;
+        }
+    } else {
+        node_alloc_traits::construct(get_alloc(), d + p->count, MySTL::move(d[p->count - 1]));
+        MySTL::move_backward(d + idx, d + p->count - 1, d + p->count);
+        d[idx] = MySTL::move(tmp);
+    }
+    ++p->count;
+    ++size_;
+    return iterator(p, idx);
+}
+
+// 在 pos 之前插入 n 个 value
+template <class T, class Alloc, size_t NodeSize>
+typename unrolled_list<T, Alloc, NodeSize>::iterator
+unrolled_list<T, Alloc, NodeSize>::insert(const_iterator pos, size_type n, const value_type& value) {
+    if (n == 0)
+        return iterator(pos.node, pos.index);
+    unrolled_list tmp(n, value, get_allocator());
+    return transfer(pos, tmp, tmp.cbegin(), tmp.cend());
+}
+
+// 在 pos 之前插入 [first, last)，新元素先放入一个临时 unrolled_list，再整结点接入
+template <class T, class Alloc, size_t NodeSize>
+template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type>
+typename unrolled_list<T, Alloc, NodeSize>::iterator
+unrolled_list<T, Alloc, NodeSize>::insert(const_iterator pos, Iter first, Iter last) {
+    unrolled_list tmp(first, last, get_allocator());
+    return transfer(pos, tmp, tmp.cbegin(), tmp.cend());
+}
+
+// 删除 pos 处的元素
+template <class T, class Alloc, size_t NodeSize>
+typename unrolled_list<T, Alloc, NodeSize>::iterator
+unrolled_list<T, Alloc, NodeSize>::erase(const_iterator pos) {
+    MYSTL_DEBUG(pos != cend());
+    erase_in_node(pos.node, pos.index, pos.index + 1);
+    return settle_after_erase(pos.node, pos.index);
+}
+
+// 删除 [first, last) 内的元素：首尾结点内移动元素，中间的结点整个释放
+template <class T, class Alloc, size_t NodeSize>
+typename unrolled_list<T, Alloc, NodeSize>::iterator
+unrolled_list<T, Alloc, NodeSize>::erase(const_iterator first, const_iterator last) {
+    if (first == last)
+        return iterator(last.node, last.index);
+    base_ptr fp = first.node;
+    if (fp == last.node) {
+        erase_in_node(fp, first.index, last.index);
+    } else {
+        erase_in_node(fp, first.index, fp->count);
+        base_ptr cur = fp->next;
+        while (cur != last.node) {
+            base_ptr next = cur->next;
+            list_unlink_nodes(cur, cur);
+            size_ -= cur->count;
+            destroy_node(cur);
+            cur = next;
+        }
+        if (cur != head())
+            erase_in_node(cur, 0, last.index);
+    }
+    return settle_after_erase(fp, first.index);
+}
+
+// 清空，释放所有结点
+template <class T, class Alloc, size_t NodeSize>
+void unrolled_list<T, Alloc, NodeSize>::clear() noexcept {
+    base_ptr cur = head_.next;
+    while (cur != head()) {
+        base_ptr next = cur->next;
+        destroy_node(cur);
+        cur = next;
+    }
+    init_head();
+    size_ = 0;
+}
+
+// 重置容器大小
+template <class T, class Alloc, size_t NodeSize>
+void unrolled_list<T, Alloc, NodeSize>::resize(size_type new_size, const value_type& value) {
+    if (new_size < size_) {
+        // 从尾部向前找到第 new_size 个元素所在的结点
+        base_ptr  p = head_.prev;
+        size_type before = size_ - p->count;
+        while (before > new_size) {
+            p = p->prev;
+            before -= p->count;
+        }
+        erase(const_iterator(p, new_size - before), cend());
+    } else {
+        for (size_type n = new_size - size_; n > 0; --n)
+            emplace_back(value);
+    }
+}
+
+/*********************************** helper functions ***********************************/
+
+// 把 x 中 [first, last) 内的元素移到 pos 之前
+// 先完成所有可能申请内存的拆分再改动链接，拆分失败时两个容器的元素都不变
+// x 是 *this 时，拆分 last、first 所在的结点可能把 pos 指向的元素移到新结点，先修正 pos
+template <class T, class Alloc, size_t NodeSize>
+typename unrolled_list<T, Alloc, NodeSize>::iterator
+unrolled_list<T, Alloc, NodeSize>::transfer(const_iterator pos, unrolled_list& x,
+                                            const_iterator first, const_iterator last) {
+    MYSTL_DEBUG(MySTL::alloc_equal(get_alloc(), x.get_alloc()));
+    if (first == last)
+        return iterator(pos.node, pos.index);
+    if (this == &x && (pos == first || pos == last))  // 移到原来的位置上
+        return iterator(first.node, first.index);
+    base_ptr l = x.split_node(last.node, last.index);
+    if (this == &x)
+        follow_split(pos, last.node, last.index, l);
+    base_ptr f = x.split_node(first.node, first.index);
+    if (this == &x)
+        follow_split(pos, first.node, first.index, f);
+    base_ptr  p = split_node(pos.node, pos.index);
+    base_ptr  lp = l->prev;
+    size_type n = 0;
+    if (f == x.head_.next && l == x.head()) {
+        n = x.size_;
+    } else {
+        for (base_ptr cur = f; cur != l; cur = cur->next)
+            n += cur->count;
+    }
+    THROW_LENGTH_ERROR_IF(this != &x && size_ > max_size() - n, "unrolled_list<T>'s size too big");
+
+    base_ptr xprev = f->prev;
+    list_unlink_nodes(f, lp);
+    x.size_ -= n;
+    list_link_nodes(p, f, lp);
+    size_ += n;
+
+    // 拆分留下的小结点在接缝处与邻居合并
+    if (xprev != x.head())
+        x.merge_next(xprev);
+    merge_next(lp);
+    base_ptr fp = f->prev;
+    if (fp != head()) {
+        const size_type fidx = fp->count;
+        merge_next(fp);
+        if (fp->count != fidx)  // f 已并入前一个结点
+            return iterator(fp, fidx);
+    }
+    return iterator(f, 0);
+}
+
+template <class T, class Alloc, size_t NodeSize>
+typename unrolled_list<T, Alloc, NodeSize>::base_ptr
+unrolled_list<T, Alloc, NodeSize>::create_node_before(base_ptr pos) {
+    base_ptr p = node_alloc_traits::allocate(get_alloc(), 1);
+    p->count = 0;
+    list_link_nodes(pos, p, p);
+    return p;
+}
+
+template <class T, class Alloc, size_t NodeSize>
+void unrolled_list<T, Alloc, NodeSize>::destroy_node(base_ptr p) noexcept {
+    pointer d = data_of(p);
+    for (size_type i = 0; i < p->count; ++i)
+        node_alloc_traits::destroy(get_alloc(), d + i);
+    node_alloc_traits::deallocate(get_alloc(), static_cast<node_ptr>(p), 1);
+}
+
+template <class T, class Alloc, size_t NodeSize>
+typename unrolled_list<T, Alloc, NodeSize>::base_ptr
+unrolled_list<T, Alloc, NodeSize>::split_node(base_ptr p, size_type idx) {
+    if (idx == 0)
+        return p;
+    if (idx == p->count)
+        return p->next;
+    base_ptr q = create_node_before(p->next);
+    pointer  d = data_of(p);
+    MySTL::uninitialized_move(d + idx, d + p->count, data_of(q));
+    for (size_type i = idx; i < p->count; ++i)
+        node_alloc_traits::destroy(get_alloc(), d + i);
+    q->count = p->count - idx;
+    p->count = idx;
+    return q;
+}
+
+template <class T, class Alloc, size_t NodeSize>
+void unrolled_list<T, Alloc, NodeSize>::merge_next(base_ptr p) {
+    base_ptr q = p->next;
+    if (q == head() || p->count + q->count > node_capacity * 3 / 4)
+        return;
+    pointer d = data_of(q);
+    MySTL::uninitialized_move(d, d + q->count, data_of(p) + p->count);
+    p->count += q->count;
+    list_unlink_nodes(q, q);
+    destroy_node(q);  // 其中的元素已被移走，只剩下被移动过的对象
+}
+
+template <class T, class Alloc, size_t NodeSize>
+void unrolled_list<T, Alloc, NodeSize>::erase_in_node(base_ptr p, size_type first, size_type last) {
+    if (first == last)
+        return;
+    pointer d = data_of(p);
+    MySTL::move(d + last, d + p->count, d + first);
+    const size_type n = last - first;
+    for (size_type i = p->count - n; i < p->count; ++i)
+        node_alloc_traits::destroy(get_alloc(), d + i);
+    p->count -= n;
+    size_ -= n;
+}
+
+template <class T, class Alloc, size_t NodeSize>
+typename unrolled_list<T, Alloc, NodeSize>::iterator
+unrolled_list<T, Alloc, NodeSize>::settle_after_erase(base_ptr p, size_type idx) {
+    if (p->count == 0) {
+        base_ptr next = p->next;
+        list_unlink_nodes(p, p);
+        destroy_node(p);
+        return iterator(next, 0);
+    }
+    merge_next(p);
+    if (idx < p->count)
+        return iterator(p, idx);
+    return iterator(p->next, 0);
+}
+
+// 逐结点填满，最后一个结点可能不满
+template <class T, class Alloc, size_t NodeSize>
+void unrolled_list<T, Alloc, NodeSize>::fill_init(size_type n, const value_type& value) {
+    for (; n > 0; --n)
+        emplace_back(value);
+}
+
+template <class T, class Alloc, size_t NodeSize>
+template <class Iter>
+void unrolled_list<T, Alloc, NodeSize>::copy_init(Iter first, Iter last) {
+    for (; first != last; ++first)
+        emplace_back(*first);
+}
+
+// 重载比较操作符
+template <class T, class Alloc, size_t NodeSize>
+bool operator==(const unrolled_list<T, Alloc, NodeSize>& lhs, const unrolled_list<T, Alloc, NodeSize>& rhs) {
+    return lhs.size() == rhs.size() && MySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Alloc, size_t NodeSize>
+bool operator!=(const unrolled_list<T, Alloc, NodeSize>& lhs, const unrolled_list<T, Alloc, NodeSize>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, class Alloc, size_t NodeSize>
+bool operator<(const unrolled_list<T, Alloc, NodeSize>& lhs, const unrolled_list<T, Alloc, NodeSize>& rhs) {
+    return MySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, class Alloc, size_t NodeSize>
+bool operator>(const unrolled_list<T, Alloc, NodeSize>& lhs, const unrolled_list<T, Alloc, NodeSize>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, class Alloc, size_t NodeSize>
+bool operator<=(const unrolled_list<T, Alloc, NodeSize>& lhs, const unrolled_list<T, Alloc, NodeSize>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, class Alloc, size_t NodeSize>
+bool operator>=(const unrolled_list<T, Alloc, NodeSize>& lhs, const unrolled_list<T, Alloc, NodeSize>& rhs) {
+    return !(lhs < rhs);
+}
+
+// 重载 MySTL 的 swap
+template <class T, class Alloc, size_t NodeSize>
+void swap(unrolled_list<T, Alloc, NodeSize>& lhs, unrolled_list<T, Alloc, NodeSize>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // namespace MySTL
+
+#endif /* MYSTL_UNROLLED_LIST_H */
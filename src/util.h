@@ -43,9 +43,9 @@ constexpr T&& forward(typename std::remove_reference<T>::type&& arg) noexcept {
  */
 template <typename Tp>
 void swap(Tp& a, Tp& b) noexcept {
-    Tp tmp = move(a);
-    a = move(b);
-    b = move(tmp);
+    Tp tmp = MySTL::move(a);
+    a = MySTL::move(b);
+    b = MySTL::move(tmp);
 }
 
 /**
@@ -117,7 +117,7 @@ struct pair {
                                       std::is_convertible<Other1&&, Ty1>::value &&
                                       std::is_convertible<Other2&&, Ty2>::value,
                                       int>::type = 0>
-    constexpr pair(Other1&& a, Other2&& b) : first(forward<Other1>(a)), second(forward<Other2>(b)) {}
+    constexpr pair(Other1&& a, Other2&& b) : first(MySTL::forward<Other1>(a)), second(MySTL::forward<Other2>(b)) {}
 
     /// explict constructible for other type
     template <class Other1, class Other2,
@@ -126,7 +126,7 @@ struct pair {
                                     (!std::is_convertible<Other1, Ty1>::value ||
                                      !std::is_convertible<Other2, Ty2>::value),
                                       int>::type = 0>
-    explicit constexpr pair(Other1&& a, Other2&& b) : first(forward<Other1>(a)), second(forward<Other2>(b)) {}
+    explicit constexpr pair(Other1&& a, Other2&& b) : first(MySTL::forward<Other1>(a)), second(MySTL::forward<Other2>(b)) {}
 
     /// implicit constructiable for other pair, const 左值
     template <class Other1, class Other2,
@@ -153,7 +153,7 @@ struct pair {
                                       std::is_convertible<Other1, Ty1>::value &&
                                       std::is_convertible<Other2, Ty2>::value,
                                       int>::type = 0>
-    constexpr pair(pair<Other1, Other2>&& other) : first(forward<Other1>(other.first)), second(forward<Other2>(other.second)) {}
+    constexpr pair(pair<Other1, Other2>&& other) : first(MySTL::forward<Other1>(other.first)), second(MySTL::forward<Other2>(other.second)) {}
 
     /// explicit constructiable for other pair
     template <class Other1, class Other2,
@@ -162,7 +162,7 @@ struct pair {
                                     (!std::is_convertible<Other1, Ty1>::value ||
                                      !std::is_convertible<Other2, Ty2>::value),
                                       int>::type = 0>
-    explicit constexpr pair(pair<Other1, Other2>&& other) : first(forward<Other1>(other.first)), second(forward<Other2>(other.second)) {}
+    explicit constexpr pair(pair<Other1, Other2>&& other) : first(MySTL::forward<Other1>(other.first)), second(MySTL::forward<Other2>(other.second)) {}
 
     /// copy assign for this pair
     pair& operator=(const pair& rval) {
@@ -176,8 +176,8 @@ struct pair {
     /// move assign for this pair
     pair& operator=(pair&& rval) {
         if (this != &rval) {
-            first = move(rval.first);
-            second = move(rval.second);
+            first = MySTL::move(rval.first);
+            second = MySTL::move(rval.second);
         }
         return *this;
     }
@@ -193,8 +193,8 @@ struct pair {
     /// move assign for other pair
     template <class Other1, class Other2>
     pair& operator=(pair<Other1, Other2>&& other) {
-        first = forward<Other1>(other.first);
-        second = forward<Other2>(other.second);
+        first = MySTL::forward<Other1>(other.first);
+        second = MySTL::forward<Other2>(other.second);
         return *this;
     }
 
@@ -254,7 +254,7 @@ void swap(pair<Ty1, Ty2>& lhs, pair<Ty1, Ty2>& rhs) {
 // 两个变量成为pair
 template <class T1, class T2>
 pair<T1, T2> make_pair(T1&& first, T2&& second) {
-    return pair<T1, T2>(forward<T1>(first), forward<T2>(second));
+    return pair<T1, T2>(MySTL::forward<T1>(first), MySTL::forward<T2>(second));
 }
 
 }  // namespace MySTL
@@ -5,6 +5,7 @@
 #include <initializer_list>
 #include <type_traits>
 
+#include "growth_policy.h"
 #include "memory.h"
 #include "iterator.h"
 #include "uninitialize.h"
@@ -14,30 +15,36 @@
 
 namespace MySTL {
 
-template <class T>
-class vector {
-    static_assert(!std::is_same<bool, T>::value, "vector<bool> is abandoned in MySTL");
-
+// Growth 为扩容策略，见 growth_policy.h
+template <class T, class Alloc = MySTL::allocator<T>, class Growth = MySTL::default_growth>
+class vector : private alloc_holder<Alloc> {
 public:
-    typedef MySTL::allocator<T>                         allocator_type;
-    typedef MySTL::allocator<T>                         data_allocator;
+    typedef Alloc                                       allocator_type;
+    typedef MySTL::allocator_traits<Alloc>              alloc_traits;
 
-    typedef typename allocator_type::value_type         value_type;
-    typedef typename allocator_type::pointer            pointer;
-    typedef typename allocator_type::const_pointer      const_pointer;
-    typedef typename allocator_type::reference          reference;
-    typedef typename allocator_type::const_reference    const_reference;
-    typedef typename allocator_type::size_type          size_type;
-    typedef typename allocator_type::difference_type    difference_type;
+    typedef typename alloc_traits::value_type           value_type;
+    typedef typename alloc_traits::pointer              pointer;
+    typedef typename alloc_traits::const_pointer        const_pointer;
+    typedef value_type&                                 reference;
+    typedef const value_type&                           const_reference;
+    typedef typename alloc_traits::size_type            size_type;
+    typedef typename alloc_traits::difference_type      difference_type;
 
     typedef value_type*                                 iterator;
     typedef const value_type*                           const_iterator;
     typedef MySTL::reverse_iterator<iterator>           reverse_iterator;
     typedef MySTL::reverse_iterator<const_iterator>     const_reverse_iterator;
 
-    allocator_type get_allocator() {return data_allocator();}
+    allocator_type get_allocator() const { return get_alloc(); }
 
 private:
+    typedef alloc_holder<Alloc>                         alloc_base;
+    using alloc_base::get_alloc;
+
+    // 分配器提供 reallocate 且元素可平凡重定位时，扩容整块交给分配器完成，元素保持原有偏移
+    typedef std::integral_constant<bool, alloc_traits::has_reallocate::value &&
+                                         MySTL::is_trivially_relocatable<T>::value> realloc_in_place;
+
     iterator begin_;
     iterator end_;
     iterator cap_;
@@ -49,26 +56,39 @@ public:
 
     vector() noexcept { try_init(); }
 
-    explicit vector(size_type n) { fill_init(n, value_type()); }
+    explicit vector(const allocator_type& alloc) noexcept : alloc_base(alloc) { try_init(); }
+
+    explicit vector(size_type n, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc) { fill_init(n, value_type()); }
 
-    vector(size_type n, const value_type& value) { fill_init(n, value); }
+    vector(size_type n, const value_type& value, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc) { fill_init(n, value); }
 
     template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
-    vector(Iter first, Iter last) {
-        MYSTL_DEBUG(!(last < first));
-        range_init(first, last);
+    vector(Iter first, Iter last, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc) {
+        range_init(first, last, iterator_category(first));
     }
 
-    vector(std::initializer_list<value_type> ilist) {
+    vector(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type()) :
+        alloc_base(alloc) {
         range_init(ilist.begin(), ilist.end());
     }
 
-    // 复制
-    vector(const vector& rhs) { range_init(rhs.begin_, rhs.end_); }
+    // 复制，分配器由 select_on_container_copy_construction 决定
+    vector(const vector& rhs) :
+        alloc_base(alloc_traits::select_on_container_copy_construction(rhs.get_alloc())) {
+        range_init(rhs.begin_, rhs.end_);
+    }
+
+    vector(const vector& rhs, const allocator_type& alloc) :
+        alloc_base(alloc) {
+        range_init(rhs.begin_, rhs.end_);
+    }
 
     // 移动
     vector(vector&& rhs) noexcept :
-        begin_(rhs.begin_), end_(rhs.end_), cap_(rhs.cap_) {
+        alloc_base(MySTL::move(rhs.get_alloc())), begin_(rhs.begin_), end_(rhs.end_), cap_(rhs.cap_) {
         rhs.begin_ = nullptr;
         rhs.end_ = nullptr;
         rhs.cap_ = nullptr;
@@ -77,37 +97,58 @@ public:
     // 复制赋值
     vector& operator=(const vector& rhs) {
         if (this != &rhs) {
+            if (alloc_traits::propagate_on_container_copy_assignment::value &&
+                !MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+                // 分配器将被替换，旧空间必须先由旧分配器释放
+                destroy_and_recover(begin_, end_, cap_ - begin_);
+                begin_ = end_ = cap_ = nullptr;
+            }
+            MySTL::alloc_on_copy(get_alloc(), rhs.get_alloc());
             const auto len = rhs.size();
             if (len > capacity()) {
-                vector tmp(rhs.begin(), rhs.end());
+                vector tmp(rhs.begin(), rhs.end(), get_alloc());
                 swap(tmp);
             } else if (size() >= len) {
                 auto i = MySTL::copy(rhs.begin(), rhs.end(), begin_);
-                data_allocator::destroy(i, end_);
+                alloc_traits::destroy(get_alloc(), i, end_);
                 end_ = begin_ + len;
             } else {
                 MySTL::copy(rhs.begin(), rhs.begin() + size(), begin_);
                 MySTL::uninitialized_copy(rhs.begin() + size(), rhs.end(), end_);
-                cap_ = end_ = begin_ + len;
+                end_ = begin_ + len;
             }
         }
         return *this;
     }
 
     // 移动赋值操作
-    vector& operator=(vector&& rhs) noexcept {
-        destroy_and_recover(begin_, end_, cap_ - begin_);
-        begin_ = rhs.begin_;
-        end_ = rhs.end_;
-        cap_ = rhs.cap_;
-        rhs.begin_ = nullptr;
-        rhs.end_ = nullptr;
-        rhs.cap_ = nullptr;
+    // 分配器不传播且不相等时要重新分配并逐个移动元素，可能抛出异常
+    vector& operator=(vector&& rhs) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                             alloc_traits::is_always_equal::value) {
+        if (this == &rhs) return *this;
+        if (alloc_traits::propagate_on_container_move_assignment::value ||
+            MySTL::alloc_equal(get_alloc(), rhs.get_alloc())) {
+            destroy_and_recover(begin_, end_, cap_ - begin_);
+            MySTL::alloc_on_move(get_alloc(), rhs.get_alloc());
+            begin_ = rhs.begin_;
+            end_ = rhs.end_;
+            cap_ = rhs.cap_;
+            rhs.begin_ = nullptr;
+            rhs.end_ = nullptr;
+            rhs.cap_ = nullptr;
+        } else {
+            // 分配器不相等且不传播，不能接管 rhs 的空间，只能逐个移动元素
+            clear();
+            reserve(rhs.size());
+            for (auto it = rhs.begin_; it != rhs.end_; ++it)
+                emplace_back(MySTL::move(*it));
+            rhs.clear();
+        }
         return *this;
     }
 
     vector& operator=(std::initializer_list<value_type> ilist) {
-        vector tmp(ilist.begin(), ilist.end());
+        vector tmp(ilist.begin(), ilist.end(), get_alloc());
         swap(tmp);
         return *this;
     }
@@ -195,7 +236,6 @@ public:
     void assign(size_type n, const value_type& value) { fill_assign(n, value); }
     template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
     void assign(Iter first, Iter last) {
-        MYSTL_DEBUG(!(last < first));
         copy_assign(first, last, iterator_category(first));
     }
     void assign(std::initializer_list<value_type> il) {
@@ -229,9 +269,28 @@ public:
     }
 
     template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
-    void insert(const_iterator pos, Iter first, Iter last) {
-        MYSTL_DEBUG(pos >= begin() && pos <= end() && !(last < first));
-        copy_insert(const_cast<iterator>(pos), first, last);
+    iterator insert(const_iterator pos, Iter first, Iter last) {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        return copy_insert(const_cast<iterator>(pos), first, last, iterator_category(first));
+    }
+
+    // 追加、插入、赋值整个区间(容器或内置数组)
+    // 能预先得到长度时只分配一次，单趟的输入迭代器按 Growth 成块扩容，块内不再逐个检查容量
+    template <class Range>
+    void append_range(Range&& rg) {
+        copy_insert(end_, MySTL::range_begin(rg), MySTL::range_end(rg), iterator_category(MySTL::range_begin(rg)));
+    }
+
+    template <class Range>
+    iterator insert_range(const_iterator pos, Range&& rg) {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        return copy_insert(const_cast<iterator>(pos), MySTL::range_begin(rg), MySTL::range_end(rg),
+                           iterator_category(MySTL::range_begin(rg)));
+    }
+
+    template <class Range>
+    void assign_range(Range&& rg) {
+        copy_assign(MySTL::range_begin(rg), MySTL::range_end(rg), iterator_category(MySTL::range_begin(rg)));
     }
 
     // erase & clear
@@ -244,6 +303,13 @@ public:
     void resize(size_type new_size) { return resize(new_size, value_type()); }
     void resize(size_type new_size, const value_type& value);
 
+    // 新增的元素只做默认初始化，平凡类型不写入任何内容，适合随后由 read() 等直接填充的缓冲区
+    void resize_default_init(size_type new_size);
+
+    // 先按 resize_default_init 扩展到 n 个元素，再由 op(data(), n) 写入内容，其返回值作为最终大小
+    template <class Operation>
+    void resize_and_overwrite(size_type n, Operation op);
+
     void reverse() { MySTL::reverse(begin(), end()); }
 
     // swap
@@ -262,9 +328,23 @@ private:
 
     template <class Iter>
     void range_init(Iter first, Iter last);
+    template <class Iter>
+    void range_init(Iter first, Iter last, input_iterator_tag);
+    template <class Iter>
+    void range_init(Iter first, Iter last, forward_iterator_tag) { range_init(first, last); }
 
     void destroy_and_recover(iterator first, iterator last, size_type n);
 
+    // 重新分配时把旧元素搬到新空间并释放旧空间
+    iterator relocate_and_recover(iterator pos, iterator new_begin, iterator new_after, size_type new_cap);
+    iterator relocate_and_recover(iterator pos, iterator new_begin, iterator new_after, size_type new_cap, std::true_type);
+    iterator relocate_and_recover(iterator pos, iterator new_begin, iterator new_after, size_type new_cap, std::false_type);
+
+    // 把容量调整为 new_cap，[begin_, end_) 中的元素保持原有偏移
+    void resize_storage(size_type new_cap);
+    void resize_storage(size_type new_cap, std::true_type);
+    void resize_storage(size_type new_cap, std::false_type);
+
     // 增长容量
     size_type get_new_cap(size_type add_size);
 
@@ -286,7 +366,13 @@ private:
 
     iterator fill_insert(iterator pos, size_type n, const value_type& value);
     template <class Iter>
-    void copy_insert(iterator pos, Iter first, Iter last);
+    iterator copy_insert(iterator pos, Iter first, Iter last, input_iterator_tag);
+    template <class Iter>
+    iterator copy_insert(iterator pos, Iter first, Iter last, forward_iterator_tag);
+
+    // 在尾部追加单趟区间，容量用完时按 Growth 扩容一次
+    template <class Iter>
+    void append_input(Iter first, Iter last);
 
     // shrink_to_fit
     void reinsert(size_type size);
@@ -295,43 +381,37 @@ private:
 /*********************************** 容器操作 ***********************************/
 
 // 预留空间大小，当原容量小于要求大小时，重新分配
-template <class T>
-void vector<T>::reserve(size_type n) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::reserve(size_type n) {
     if (capacity() < n) {
         THROW_LENGTH_ERROR_IF(n > max_size(), "n can not bigger than max_size()"
-                                              "in vector<T>::reserve(n)");
-        const auto old_size = size();
-        auto       tmp = data_allocator::allocate(n);
-        MySTL::uninitialized_move(begin_, end_, tmp);
-        data_allocator::deallocate(begin_, cap_ - begin_);
-        begin_ = tmp;
-        end_ = tmp + old_size;
-        cap_ = begin_ + n;
+                                              "in vector<T, Alloc, Growth>::reserve(n)");
+        resize_storage(n);
     }
 }
 
 // 舍弃多余空间
-template <class T>
-void vector<T>::shrink_to_fit() {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::shrink_to_fit() {
     if (end_ < cap_) {
         reinsert(size());
     }
 }
 
 // 在pos处构造元素, 避免额外复制或移动开销
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class... Args>
-typename vector<T>::iterator
-vector<T>::emplace(const_iterator pos, Args&& ...args) {
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::emplace(const_iterator pos, Args&& ...args) {
     MYSTL_DEBUG(pos >= begin() && pos <= end());
     iterator        xpos = const_cast<iterator>(pos);
     const size_type n = xpos - begin_;
     if (end_ != cap_ && xpos == end_) {
-        data_allocator::construct(MySTL::address_of(*end_), MySTL::forward<Args>(args)...);
+        alloc_traits::construct(get_alloc(), MySTL::address_of(*end_), MySTL::forward<Args>(args)...);
         ++end_;
     } else if (end_ != cap_) {
         auto new_end = end_;
-        data_allocator::construct(MySTL::address_of(*end_), *(end_ - 1));
+        alloc_traits::construct(get_alloc(), MySTL::address_of(*end_), *(end_ - 1));
         ++new_end;
         MySTL::copy_backward(xpos, end_ - 1, end_);
         *xpos = value_type(MySTL::forward<Args>(args)...);
@@ -343,11 +423,11 @@ vector<T>::emplace(const_iterator pos, Args&& ...args) {
 }
 
 // 在尾部就地构造元素，避免额外的复制和移动开销
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class... Args>
-void vector<T>::emplace_back(Args&&... args) {
+void vector<T, Alloc, Growth>::emplace_back(Args&&... args) {
     if (end_ < cap_) {
-        data_allocator::construct(MySTL::address_of(*end_), MySTL::forward<Args>(args)...);
+        alloc_traits::construct(get_alloc(), MySTL::address_of(*end_), MySTL::forward<Args>(args)...);
         ++end_;
     } else {
         reallocate_emplace(end_, MySTL::forward<Args>(args)...);
@@ -355,10 +435,10 @@ void vector<T>::emplace_back(Args&&... args) {
 }
 
 // 在尾部插入元素
-template <class T>
-void vector<T>::push_back(const value_type& value) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::push_back(const value_type& value) {
     if (end_ != cap_) {
-        data_allocator::construct(MySTL::address_of(*end_), value);
+        alloc_traits::construct(get_alloc(), MySTL::address_of(*end_), value);
         ++end_;
     } else {
         reallocate_insert(end_, value);
@@ -366,26 +446,26 @@ void vector<T>::push_back(const value_type& value) {
 }
 
 // 弹出
-template <class T>
-void vector<T>::pop_back() {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::pop_back() {
     MYSTL_DEBUG(!empty());
-    data_allocator::destroy(end_ - 1);
+    alloc_traits::destroy(get_alloc(), end_ - 1);
     --end_;
 }
 
 // insert to pos
-template <class T>
-typename vector<T>::iterator
-vector<T>::insert(const_iterator pos, const value_type& value) {
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::insert(const_iterator pos, const value_type& value) {
     MYSTL_DEBUG(pos >= begin() && pos <= end());
     iterator        xpos = const_cast<iterator>(pos);
     const size_type n = pos - begin_;
     if (end_ != cap_ && xpos == end_) {
-        data_allocator::construct(MySTL::address_of(*end_), value);
+        alloc_traits::construct(get_alloc(), MySTL::address_of(*end_), value);
         ++end_;
     } else if (end_ != cap_) {
         auto new_end = end_;
-        data_allocator::construct(MySTL::address_of(*end_), *(end_ - 1));
+        alloc_traits::construct(get_alloc(), MySTL::address_of(*end_), *(end_ - 1));
         ++new_end;
         auto value_copy = value;  // 防止value被篡改
         MySTL::copy_backward(xpos, end_ - 1, end_);
@@ -398,32 +478,32 @@ vector<T>::insert(const_iterator pos, const value_type& value) {
 }
 
 // 删除pos上的元素
-template <class T>
-typename vector<T>::iterator
-vector<T>::erase(const_iterator pos) {
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::erase(const_iterator pos) {
     MYSTL_DEBUG(pos < end() && pos >= begin());
     iterator xpos = begin_ + (pos - begin());
     MySTL::move(xpos + 1, end_, xpos);
-    data_allocator::destroy(end_ - 1);
+    alloc_traits::destroy(get_alloc(), end_ - 1);
     --end_;
     return xpos;
 }
 
 // 删除 [first, last)
-template <class T>
-typename vector<T>::iterator
-vector<T>::erase(const_iterator first, const_iterator last) {
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::erase(const_iterator first, const_iterator last) {
     MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
     const auto n = first - begin();
     iterator   r = begin_ + n;
-    data_allocator::destroy(MySTL::move(r + (last - first), end_, r), end_);
+    alloc_traits::destroy(get_alloc(), MySTL::move(r + (last - first), end_, r), end_);
     end_ = end_ - (last - first);
     return begin_ + n;
 }
 
 // 重置容器大小
-template <class T>
-void vector<T>::resize(size_type new_size, const value_type& value) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::resize(size_type new_size, const value_type& value) {
     if (new_size < size()) {
         erase(begin() + new_size, end());
     } else {
@@ -431,9 +511,32 @@ void vector<T>::resize(size_type new_size, const value_type& value) {
     }
 }
 
-template <class T>
-void vector<T>::swap(vector<T>& rhs) noexcept {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::resize_default_init(size_type new_size) {
+    if (new_size < size()) {
+        erase(begin() + new_size, end());
+        return;
+    }
+    if (new_size > capacity()) {
+        THROW_LENGTH_ERROR_IF(new_size > max_size(), "vector<T>'s size too big");
+        resize_storage(get_new_cap(new_size - capacity()));
+    }
+    end_ = MySTL::uninitialized_default_construct_n(end_, new_size - size());
+}
+
+template <class T, class Alloc, class Growth>
+template <class Operation>
+void vector<T, Alloc, Growth>::resize_and_overwrite(size_type n, Operation op) {
+    resize_default_init(n);
+    const size_type r = static_cast<size_type>(op(data(), n));
+    THROW_OUT_OF_RANGE_IF(r > n, "vector<T>::resize_and_overwrite: result size out of range");
+    erase(begin() + r, end());
+}
+
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::swap(vector<T, Alloc, Growth>& rhs) noexcept {
     if (this != &rhs) {
+        MySTL::alloc_on_swap(get_alloc(), rhs.get_alloc());
         MySTL::swap(begin_, rhs.begin_);
         MySTL::swap(end_, rhs.end_);
         MySTL::swap(cap_, rhs.cap_);
@@ -442,18 +545,12 @@ void vector<T>::swap(vector<T>& rhs) noexcept {
 
 /*********************************** helper function ***********************************/
 
-// 不抛出， 分配初始内存
-template <class T>
-void vector<T>::try_init() noexcept {
-    try {
-        begin_ = data_allocator::allocate(16);
-        end_ = begin_;
-        cap_ = begin_ + 16;
-    } catch (...) {
-        begin_ = nullptr;
-        end_ = nullptr;
-        cap_ = nullptr;
-    }
+// 空 vector 不分配内存，第一次插入时由 get_new_cap 按 Growth 分配空间
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::try_init() noexcept {
+    begin_ = nullptr;
+    end_ = nullptr;
+    cap_ = nullptr;
 }
 
 /**
@@ -461,10 +558,10 @@ void vector<T>::try_init() noexcept {
  * @param size 初始化大小
  * @param cap  初始化容量
 */
-template <class T>
-void vector<T>::init_space(size_type size, size_type cap) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::init_space(size_type size, size_type cap) {
     try {
-        begin_ = data_allocator::allocate(cap);
+        begin_ = alloc_traits::allocate(get_alloc(), cap);
         end_ = begin_ + size;
         cap_ = begin_ + cap;
     } catch (...) {
@@ -476,50 +573,128 @@ void vector<T>::init_space(size_type size, size_type cap) {
 }
 
 // fill_init
-template <class T>
-void vector<T>::fill_init(size_type n, const value_type& value) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::fill_init(size_type n, const value_type& value) {
     const size_type init_size = MySTL::max(static_cast<size_type>(16), n);
     init_space(n, init_size);
     MySTL::uninitialized_fill_n(begin_, n, value);
 }
 
 // range_init
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class Iter>
-void vector<T>::range_init(Iter first, Iter last) {
+void vector<T, Alloc, Growth>::range_init(Iter first, Iter last) {
     const size_type len = MySTL::distance(first, last);
     const size_type init_size = MySTL::max(len, static_cast<size_type>(16));
     init_space(len, init_size);
     MySTL::uninitialized_copy(first, last, begin_);
 }
 
-template <class T>
-void vector<T>::destroy_and_recover(iterator first, iterator last, size_type n) {
-    data_allocator::destroy(first, last);
-    data_allocator::deallocate(first, n);
+// 单趟输入迭代器不能先求长度，逐块追加
+template <class T, class Alloc, class Growth>
+template <class Iter>
+void vector<T, Alloc, Growth>::range_init(Iter first, Iter last, input_iterator_tag) {
+    try_init();
+    try {
+        append_input(first, last);
+    } catch (...) {
+        destroy_and_recover(begin_, end_, cap_ - begin_);
+        throw;
+    }
 }
 
-// get_new_cap
-template <class T>
-typename vector<T>::size_type
-vector<T>::get_new_cap(size_type add_size) {
-    const auto old_size = capacity();
-    THROW_LENGTH_ERROR_IF(old_size + add_size > max_size(),
-                          "vector<T>'s size too big");
-    if (old_size + add_size / 2 > max_size()) {
-        return old_size + old_size > max_size() - 16 ? old_size + add_size : old_size + add_size + 16;
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::destroy_and_recover(iterator first, iterator last, size_type n) {
+    if (first == nullptr) return;
+    alloc_traits::destroy(get_alloc(), first, last);
+    alloc_traits::deallocate(get_alloc(), first, n);
+}
+
+/**
+ * @brief 把 [begin_, pos) 搬到 new_begin 处，[pos, end_) 搬到 new_after 处，然后释放旧空间
+ * @note  新空间中两段之间的插入元素已由调用者构造好；搬移失败时析构这些元素并释放新空间
+ * @return 新空间中最后一个元素的下一个位置
+ */
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::relocate_and_recover(iterator pos, iterator new_begin, iterator new_after, size_type new_cap) {
+    return relocate_and_recover(pos, new_begin, new_after, new_cap,
+                                std::integral_constant<bool, MySTL::is_trivially_relocatable<T>::value>{});
+}
+
+// 可平凡重定位：按字节复制，不会失败，旧元素无需析构
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::relocate_and_recover(iterator pos, iterator new_begin, iterator new_after, size_type, std::true_type) {
+    MySTL::uninitialized_relocate(begin_, pos, new_begin);
+    auto new_end = MySTL::uninitialized_relocate(pos, end_, new_after);
+    if (begin_ != nullptr)
+        alloc_traits::deallocate(get_alloc(), begin_, cap_ - begin_);
+    return new_end;
+}
+
+// 逐个移动构造，全部成功后才析构旧元素，失败时旧空间保持不变
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::relocate_and_recover(iterator pos, iterator new_begin, iterator new_after, size_type new_cap, std::false_type) {
+    auto new_pos = new_begin + (pos - begin_);
+    auto new_end = new_after;
+    try {
+        MySTL::uninitialized_move(begin_, pos, new_begin);
+        try {
+            new_end = MySTL::uninitialized_move(pos, end_, new_after);
+        } catch (...) {
+            alloc_traits::destroy(get_alloc(), new_begin, new_pos);
+            throw;
+        }
+    } catch (...) {
+        alloc_traits::destroy(get_alloc(), new_pos, new_after);
+        alloc_traits::deallocate(get_alloc(), new_begin, new_cap);
+        throw;
     }
-    const size_type new_size = old_size == 0 
-    ? MySTL::max(add_size, static_cast<size_type>(16)) 
-    : MySTL::max(old_size + old_size / 2, old_size + add_size);
-    return new_size;
+    destroy_and_recover(begin_, end_, cap_ - begin_);
+    return new_end;
+}
+
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::resize_storage(size_type new_cap) {
+    resize_storage(new_cap, realloc_in_place{});
+}
+
+// 由分配器原地调整(例如 mremap)，失败时旧空间保持不变
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::resize_storage(size_type new_cap, std::true_type) {
+    const size_type old_size = size();
+    begin_ = alloc_traits::reallocate(get_alloc(), begin_, capacity(), new_cap);
+    end_ = begin_ + old_size;
+    cap_ = begin_ + new_cap;
+}
+
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::resize_storage(size_type new_cap, std::false_type) {
+    auto new_begin = alloc_traits::allocate(get_alloc(), new_cap);
+    end_ = relocate_and_recover(end_, new_begin, new_begin + size(), new_cap);
+    begin_ = new_begin;
+    cap_ = begin_ + new_cap;
+}
+
+// get_new_cap, 由 Growth 决定新的容量，至少增加 add_size 个元素
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::size_type
+vector<T, Alloc, Growth>::get_new_cap(size_type add_size) {
+    const auto old_cap = capacity();
+    THROW_LENGTH_ERROR_IF(add_size > max_size() - old_cap,
+                          "vector<T>'s size too big");
+    const size_type need = old_cap + add_size;
+    const size_type new_cap = Growth::next_capacity(old_cap, need, sizeof(T));
+    return MySTL::min(MySTL::max(new_cap, need), max_size());
 }
 
 // fill_assign
-template <class T>
-void vector<T>::fill_assign(size_type n, const value_type& value) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::fill_assign(size_type n, const value_type& value) {
     if (n > capacity()) {
-        vector tmp(n, value);
+        vector tmp(n, value, get_alloc());
         swap(tmp);
     } else if (n > size()) {
         MySTL::fill(begin(), end(), value);
@@ -530,9 +705,9 @@ void vector<T>::fill_assign(size_type n, const value_type& value) {
 }
 
 // copy_assign, assign the vector with [first, last)
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class Iter>
-void vector<T>::copy_assign(Iter first, Iter last, input_iterator_tag) {
+void vector<T, Alloc, Growth>::copy_assign(Iter first, Iter last, input_iterator_tag) {
     auto cur = begin_;
     for (; first != last && cur != end_; ++first, ++cur) {
         *cur = *first;
@@ -544,16 +719,16 @@ void vector<T>::copy_assign(Iter first, Iter last, input_iterator_tag) {
     }
 }
 
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class Iter>
-void vector<T>::copy_assign(Iter first, Iter last, forward_iterator_tag) {
+void vector<T, Alloc, Growth>::copy_assign(Iter first, Iter last, forward_iterator_tag) {
     const size_type len = MySTL::distance(first, last);
     if (len > capacity()) {
-        vector tmp(first, last);
+        vector tmp(first, last, get_alloc());
         swap(tmp);
     } else if (size() >= len) {
         auto new_end = MySTL::copy(first, last, begin_);
-        data_allocator::destroy(new_end, end_);
+        alloc_traits::destroy(get_alloc(), new_end, end_);
         end_ = new_end;
     } else {
         auto mid = first;
@@ -565,53 +740,62 @@ void vector<T>::copy_assign(Iter first, Iter last, forward_iterator_tag) {
 }
 
 // 从新分配空间并在pos处构造元素
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class... Args>
-void vector<T>::reallocate_emplace(iterator pos, Args&&... args) {
+void vector<T, Alloc, Growth>::reallocate_emplace(iterator pos, Args&&... args) {
+    if (realloc_in_place::value && pos == end_) {
+        // args 可能引用旧空间中的元素，先在栈上构造好再扩容
+        value_type tmp(MySTL::forward<Args>(args)...);
+        resize_storage(get_new_cap(1));
+        alloc_traits::construct(get_alloc(), end_, MySTL::move(tmp));
+        ++end_;
+        return;
+    }
     const auto new_size = get_new_cap(1);
-    auto       new_begin = data_allocator::allocate(new_size);
-    auto       new_end = new_begin;
+    auto       new_begin = alloc_traits::allocate(get_alloc(), new_size);
+    auto       new_pos = new_begin + (pos - begin_);
+    // 先构造新元素：args 可能引用旧空间中的元素，且构造失败时旧元素还未搬动
     try {
-        new_end = MySTL::uninitialized_move(begin_, pos, new_begin);
-        data_allocator::construct(MySTL::address_of(*new_end), MySTL::forward<Args>(args)...);
-        ++new_end;
-        new_end = MySTL::uninitialized_move(pos, end_, new_end);
+        alloc_traits::construct(get_alloc(), MySTL::address_of(*new_pos), MySTL::forward<Args>(args)...);
     } catch (...) {
-        data_allocator::deallocate(new_begin, new_size);
+        alloc_traits::deallocate(get_alloc(), new_begin, new_size);
         throw;
     }
-    destroy_and_recover(begin_, end_, cap_ - begin_);
+    auto new_end = relocate_and_recover(pos, new_begin, new_pos + 1, new_size);
     begin_ = new_begin;
     end_ = new_end;
     cap_ = new_begin + new_size;
 }
 
 // 重新分配空间，在pos处插入元素
-template <class T>
-void vector<T>::reallocate_insert(iterator pos, const value_type& value) {
-    const auto        new_size = get_new_cap(1);
-    auto              new_begin = data_allocator::allocate(new_size);
-    auto              new_end(new_begin); // okay
-    const value_type& value_copy = value;
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::reallocate_insert(iterator pos, const value_type& value) {
+    if (realloc_in_place::value && pos == end_) {
+        value_type tmp(value);
+        resize_storage(get_new_cap(1));
+        alloc_traits::construct(get_alloc(), end_, MySTL::move(tmp));
+        ++end_;
+        return;
+    }
+    const auto new_size = get_new_cap(1);
+    auto       new_begin = alloc_traits::allocate(get_alloc(), new_size);
+    auto       new_pos = new_begin + (pos - begin_);
     try {
-        new_end = MySTL::uninitialized_move(begin_, pos, new_begin);
-        data_allocator::construct(MySTL::address_of(*new_end), value_copy);
-        ++new_end;
-        new_end = MySTL::uninitialized_move(pos, end_, new_end);
+        alloc_traits::construct(get_alloc(), MySTL::address_of(*new_pos), value);
     } catch (...) {
-        data_allocator::deallocate(new_begin, new_size);
+        alloc_traits::deallocate(get_alloc(), new_begin, new_size);
         throw;
     }
-    destroy_and_recover(begin_, end_, cap_ - begin_);
+    auto new_end = relocate_and_recover(pos, new_begin, new_pos + 1, new_size);
     begin_ = new_begin;
     end_ = new_end;
     cap_ = new_begin + new_size;
 }
 
 // fill_insert
-template <class T>
-typename vector<T>::iterator
-vector<T>::fill_insert(iterator pos, size_type n, const value_type& value) {
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::fill_insert(iterator pos, size_type n, const value_type& value) {
     if (n == 0)
         return pos;
     const size_type  xpos = pos - begin_;
@@ -629,19 +813,20 @@ vector<T>::fill_insert(iterator pos, size_type n, const value_type& value) {
             end_ = MySTL::uninitialized_move(pos, old_end, end_);
             MySTL::uninitialized_fill_n(pos, after_elems, value_copy);
         }
+    } else if (realloc_in_place::value && pos == end_) {  // 空间不足，在尾部追加
+        resize_storage(get_new_cap(n));
+        end_ = MySTL::uninitialized_fill_n(end_, n, value_copy);
     } else {  // 空间不足
-        const auto new_size = get_new_cap(1);
-        auto       new_begin = data_allocator::allocate(new_size);
-        auto       new_end = new_begin;
+        const auto new_size = get_new_cap(n);
+        auto       new_begin = alloc_traits::allocate(get_alloc(), new_size);
+        auto       new_pos = new_begin + xpos;
         try {
-            new_end = MySTL::uninitialized_move(begin_, pos, new_begin);
-            new_end = MySTL::uninitialized_fill_n(new_end, n, value);
-            new_end = MySTL::uninitialized_move(pos, end_, new_end);
+            MySTL::uninitialized_fill_n(new_pos, n, value_copy);
         } catch (...) {
-            destroy_and_recover(new_begin, new_end, new_size);
+            alloc_traits::deallocate(get_alloc(), new_begin, new_size);
             throw;
         }
-        data_allocator::deallocate(begin_, cap_ - begin_);
+        auto new_end = relocate_and_recover(pos, new_begin, new_pos + n, new_size);
         begin_ = new_begin;
         end_ = new_end;
         cap_ = begin_ + new_size;
@@ -650,12 +835,27 @@ vector<T>::fill_insert(iterator pos, size_type n, const value_type& value) {
 }
 
 // copy_insert，把[first, last) 插入到pos之前
-template <class T>
+// 单趟输入迭代器：先追加到尾部，再旋转到 pos 处
+template <class T, class Alloc, class Growth>
+template <class Iter>
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::copy_insert(iterator pos, Iter first, Iter last, input_iterator_tag) {
+    const size_type xpos = pos - begin_;
+    const size_type old_size = size();
+    append_input(first, last);
+    MySTL::rotate(begin_ + xpos, begin_ + old_size, end_);
+    return begin_ + xpos;
+}
+
+// 长度已知：至多分配一次，平凡类型从指针区间复制时由 copy 转为 memmove
+template <class T, class Alloc, class Growth>
 template <class Iter>
-void vector<T>::copy_insert(iterator pos, Iter first, Iter last) {
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::copy_insert(iterator pos, Iter first, Iter last, forward_iterator_tag) {
     if (first == last)
-        return;
-    const auto n = MySTL::distance(first, last);
+        return pos;
+    const size_type xpos = pos - begin_;
+    const size_type n = MySTL::distance(first, last);
     if (end_ + n <= cap_) {
         const size_type after_elems = end_ - pos;
         auto            old_end = end_;
@@ -672,77 +872,84 @@ void vector<T>::copy_insert(iterator pos, Iter first, Iter last) {
         }
     } else {  // 空间不足
         const auto new_size = get_new_cap(n);
-        auto       new_begin = data_allocator::allocate(new_size);
-        auto       new_end = new_begin;
+        auto       new_begin = alloc_traits::allocate(get_alloc(), new_size);
+        auto       new_pos = new_begin + (pos - begin_);
         try {
-            new_end = MySTL::uninitialized_move(begin_, pos, new_begin);
-            new_end = MySTL::uninitialized_copy(first, last, new_end);
-            new_end = MySTL::uninitialized_move(pos, end_, new_end);
+            MySTL::uninitialized_copy(first, last, new_pos);
         } catch (...) {
-            destroy_and_recover(new_begin, new_end, new_size);
+            alloc_traits::deallocate(get_alloc(), new_begin, new_size);
             throw;
         }
-        data_allocator::deallocate(begin_, cap_ - begin_);
+        auto new_end = relocate_and_recover(pos, new_begin, new_pos + n, new_size);
         begin_ = new_begin;
         end_ = new_end;
         cap_ = begin_ + new_size;
     }
+    return begin_ + xpos;
 }
 
-// reinsert, 重新分配空间
-template <class T>
-void vector<T>::reinsert(size_type size) {
-    auto new_begin = data_allocator::allocate(size);
-    try {
-        MySTL::uninitialized_move(begin_, end_, new_begin);
-    } catch (...) {
-        data_allocator::deallocate(new_begin, size);
-        throw;
+template <class T, class Alloc, class Growth>
+template <class Iter>
+void vector<T, Alloc, Growth>::append_input(Iter first, Iter last) {
+    while (first != last) {
+        if (end_ == cap_)
+            resize_storage(get_new_cap(1));
+        for (; first != last && end_ != cap_; ++first, ++end_)
+            alloc_traits::construct(get_alloc(), end_, *first);
     }
-    data_allocator::deallocate(begin_, cap_ - begin_);
-    begin_ = new_begin;
-    end_ = begin_ + size;
-    cap_ = begin_ + size;
+}
+
+// reinsert, 重新分配空间
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::reinsert(size_type size) {
+    resize_storage(size);
 }
 
 /*********************************** 重载比较运算 ***********************************/
 
-template <class T>
-bool operator==(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator==(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     return lhs.size() == rhs.size() && MySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T>
-bool operator!=(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator!=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class T>
-bool operator<(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator<(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     return MySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class T>
-bool operator>(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator>(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     return rhs < lhs;
 }
 
-template <class T>
-bool operator<=(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator<=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class T>
-bool operator>=(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator>=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     return !(lhs < rhs);
 }
 
 // 重载 MySTL的swap
-template <class T>
-void swap(vector<T>& lhs, vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+void swap(vector<T, Alloc, Growth>& lhs, vector<T, Alloc, Growth>& rhs) {
     lhs.swap(rhs);
 }
 
+// vector 只保存指向堆空间的指针，可以按字节搬移
+template <class T, class Alloc, class Growth>
+struct is_trivially_relocatable<vector<T, Alloc, Growth>> : is_trivially_relocatable<Alloc> {};
+
 }  // namespace MySTL
 
+// vector<bool> 特化版本
+#include "bit_vector.h"
+
 #endif /* MY_VECTOR_H */
\ No newline at end of file